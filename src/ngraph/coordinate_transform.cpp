@@ -378,6 +378,33 @@ const Shape& CoordinateTransform::get_target_shape() const
     return m_target_shape;
 }
 
+Strides CoordinateTransform::get_source_index_strides() const
+{
+    for (size_t axis = 0; axis < m_n_axes; axis++)
+    {
+        if (m_target_padding_below[axis] != 0 || m_target_padding_above[axis] != 0 ||
+            m_target_dilation_strides[axis] != 1)
+        {
+            throw std::domain_error(
+                "Source index strides are not defined for a padded or dilated transform");
+        }
+    }
+
+    Strides source_shape_strides = row_major_strides(m_source_shape);
+    Strides result(m_n_axes);
+    for (size_t target_axis = 0; target_axis < m_n_axes; target_axis++)
+    {
+        size_t source_axis = m_source_axis_order[target_axis];
+        result[target_axis] = m_source_strides[source_axis] * source_shape_strides[source_axis];
+    }
+    return result;
+}
+
+size_t CoordinateTransform::get_source_start_index() const
+{
+    return index(Coordinate(m_n_axes, 0));
+}
+
 // The "is_end" parameter is true if we want the "end()" iterator.
 CoordinateTransform::Iterator::Iterator(const Shape& target_shape, bool is_end)
     : m_target_shape(target_shape)
@@ -490,3 +517,104 @@ bool CoordinateTransform::Iterator::operator==(const Iterator& it)
 
     return true;
 }
+
+CoordinateWalker::CoordinateWalker(const Shape& shape,
+                                   const std::vector<Strides>& strides,
+                                   const std::vector<size_t>& offsets)
+    : m_run_length(1)
+    , m_run_strides(strides.size(), 0)
+    , m_indices(strides.size(), 0)
+    , m_done(false)
+{
+    size_t buffer_count = strides.size();
+    for (const Strides& buffer_strides : strides)
+    {
+        if (buffer_strides.size() != shape.size())
+        {
+            throw std::domain_error(
+                "Buffer strides do not have the same number of axes as the walked shape");
+        }
+    }
+    if (!offsets.empty())
+    {
+        if (offsets.size() != buffer_count)
+        {
+            throw std::domain_error("Number of buffer offsets does not match number of buffers");
+        }
+        m_indices = offsets;
+    }
+
+    // Group the axes into runs of axes that are contiguous in every buffer, innermost first.
+    // Axes of length 1 do not move any index and are dropped.
+    Shape group_lengths;
+    std::vector<Strides> group_strides;
+    for (size_t axis = shape.size(); axis-- > 0;)
+    {
+        if (shape[axis] == 0)
+        {
+            m_run_length = 0;
+            m_done = true;
+            return;
+        }
+        if (shape[axis] == 1)
+        {
+            continue;
+        }
+        bool contiguous = !group_lengths.empty();
+        for (size_t buffer = 0; contiguous && buffer < buffer_count; buffer++)
+        {
+            contiguous = strides[buffer][axis] ==
+                         group_strides.back()[buffer] * group_lengths.back();
+        }
+        if (contiguous)
+        {
+            group_lengths.back() *= shape[axis];
+        }
+        else
+        {
+            group_lengths.push_back(shape[axis]);
+            group_strides.emplace_back(buffer_count);
+            for (size_t buffer = 0; buffer < buffer_count; buffer++)
+            {
+                group_strides.back()[buffer] = strides[buffer][axis];
+            }
+        }
+    }
+
+    if (group_lengths.empty())
+    {
+        return;
+    }
+    m_run_length = group_lengths.front();
+    m_run_strides = group_strides.front();
+    for (size_t group = group_lengths.size(); group-- > 1;)
+    {
+        m_outer_shape.push_back(group_lengths[group]);
+        m_outer_strides.insert(
+            m_outer_strides.end(), group_strides[group].begin(), group_strides[group].end());
+    }
+    m_position = Coordinate(m_outer_shape.size(), 0);
+}
+
+Strides CoordinateWalker::expanded_strides(const Shape& shape, const AxisSet& added_axes)
+{
+    Strides shape_strides = row_major_strides(shape);
+    Strides result(shape.size() + added_axes.size());
+    size_t shape_axis = 0;
+    for (size_t axis = 0; axis < result.size(); axis++)
+    {
+        if (added_axes.count(axis) != 0)
+        {
+            result[axis] = 0;
+        }
+        else
+        {
+            if (shape_axis == shape.size())
+            {
+                throw std::domain_error("Added axes are out of range of the expanded shape");
+            }
+            result[axis] = shape_strides[shape_axis++];
+        }
+    }
+    return result;
+}
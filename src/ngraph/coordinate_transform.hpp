@@ -16,6 +16,9 @@
 
 #pragma once
 
+#include <vector>
+
+#include "ngraph/axis_set.hpp"
 #include "ngraph/axis_vector.hpp"
 #include "ngraph/coordinate.hpp"
 #include "ngraph/coordinate_diff.hpp"
@@ -72,6 +75,12 @@ namespace ngraph
         const Strides& get_source_strides() const { return m_source_strides; }
         const AxisVector& get_source_axis_order() const { return m_source_axis_order; }
         const Strides& get_target_dilation_strides() const { return m_target_dilation_strides; }
+        /// \brief The distance in the source buffer between neighbouring target coordinates
+        ///        along each target axis. Only defined when there is no padding or dilation.
+        Strides get_source_index_strides() const;
+        /// \brief The index in the source buffer of the first target coordinate
+        size_t get_source_start_index() const;
+
         class Iterator
         {
         public:
@@ -114,4 +123,79 @@ namespace ngraph
         size_t m_n_axes;
         Iterator m_end_iterator;
     };
+
+    /// \brief Walks a shape in row-major order one run of its innermost axis at a time while
+    ///        keeping the flat index of the current element in several buffers.
+    ///
+    /// Each buffer has an element stride along every axis of the shape. A stride of 0 repeats
+    /// the buffer along that axis, as when broadcasting. Moving to the next run adds precomputed
+    /// increments to the indices instead of building a Coordinate and taking its dot product with
+    /// the strides. Adjacent axes that are contiguous in every buffer are merged, so runs are as
+    /// long as possible; a dense copy is a single run.
+    ///
+    ///     for (CoordinateWalker walker(shape, {out_strides, in_strides}); !walker.is_done();
+    ///          walker.next_run())
+    ///     {
+    ///         size_t out_index = walker.get_index(0);
+    ///         size_t in_index = walker.get_index(1);
+    ///         for (size_t i = 0; i < walker.get_run_length(); i++)
+    ///         {
+    ///             out[out_index + i * walker.get_run_stride(0)] =
+    ///                 in[in_index + i * walker.get_run_stride(1)];
+    ///         }
+    ///     }
+    class CoordinateWalker
+    {
+    public:
+        /// \param shape The shape to walk
+        /// \param strides For each buffer, its element stride along each axis of shape
+        /// \param offsets For each buffer, the index of the element at coordinate (0,...,0).
+        ///        All zero if empty.
+        CoordinateWalker(const Shape& shape,
+                         const std::vector<Strides>& strides,
+                         const std::vector<size_t>& offsets = {});
+
+        /// \brief The strides of a dense tensor of shape within a space that has the additional
+        ///        axes added_axes, such as the output space of a broadcast or the input space of
+        ///        a reduction. The added axes get stride 0.
+        static Strides expanded_strides(const Shape& shape, const AxisSet& added_axes);
+
+        bool is_done() const { return m_done; }
+        /// \brief The index in buffer of the first element of the current run
+        size_t get_index(size_t buffer) const { return m_indices[buffer]; }
+        size_t get_run_length() const { return m_run_length; }
+        /// \brief The distance in buffer between consecutive elements of a run
+        size_t get_run_stride(size_t buffer) const { return m_run_strides[buffer]; }
+        void next_run()
+        {
+            for (size_t axis = m_outer_shape.size(); axis-- > 0;)
+            {
+                const size_t* strides = &m_outer_strides[axis * m_indices.size()];
+                if (++m_position[axis] < m_outer_shape[axis])
+                {
+                    for (size_t buffer = 0; buffer < m_indices.size(); buffer++)
+                    {
+                        m_indices[buffer] += strides[buffer];
+                    }
+                    return;
+                }
+                m_position[axis] = 0;
+                for (size_t buffer = 0; buffer < m_indices.size(); buffer++)
+                {
+                    m_indices[buffer] -= strides[buffer] * (m_outer_shape[axis] - 1);
+                }
+            }
+            m_done = true;
+        }
+
+    private:
+        size_t m_run_length;
+        Strides m_run_strides;
+        Shape m_outer_shape;
+        // The stride of buffer b along outer axis a is at a * buffer count + b
+        Strides m_outer_strides;
+        Coordinate m_position;
+        std::vector<size_t> m_indices;
+        bool m_done;
+    };
 }
@@ -188,6 +188,45 @@ void cpio::Writer::write(const string& record_name, const void* data, uint32_t s
     }
 }
 
+// Size of a record header plus its name, including the terminator and pad byte
+static size_t header_size(const string& name)
+{
+    size_t namesize = name.size() + 1;
+    return 26 + namesize + (namesize % 2);
+}
+
+void cpio::Writer::write(const string& record_name,
+                         const void* data,
+                         uint32_t size_in_bytes,
+                         size_t alignment)
+{
+    if (m_stream == nullptr)
+    {
+        throw runtime_error("cpio writer output not set");
+    }
+
+    auto pos = m_stream->tellp();
+    if (alignment > 1 && pos != streampos(-1))
+    {
+        const string pad_name = ".pad";
+        size_t data_offset = static_cast<size_t>(pos) + header_size(record_name);
+        if (data_offset % alignment != 0)
+        {
+            // Records always start at even offsets, so an even pad size always exists when
+            // alignment is even.
+            data_offset += header_size(pad_name);
+            size_t pad_size = (alignment - data_offset % alignment) % alignment;
+            if (pad_size % 2)
+            {
+                pad_size += alignment;
+            }
+            vector<char> pad(pad_size, 0);
+            write(pad_name, pad.data(), static_cast<uint32_t>(pad_size));
+        }
+    }
+    write(record_name, data, size_in_bytes);
+}
+
 cpio::Reader::Reader()
     : m_stream(nullptr)
 {
@@ -254,6 +293,7 @@ const vector<cpio::FileInfo>& cpio::Reader::get_file_info()
             }
 
             size_t offset = m_stream->tellg();
+            m_file_index.insert({file_name, m_file_info.size()});
             m_file_info.emplace_back(file_name, header.filesize, offset);
 
             m_stream->seekg((header.filesize % 2) + header.filesize, ios_base::cur);
@@ -266,27 +306,31 @@ const vector<cpio::FileInfo>& cpio::Reader::get_file_info()
 bool cpio::Reader::read(const string& file_name, void* data, size_t size_in_bytes)
 {
     bool rc = false;
-    for (const FileInfo& info : get_file_info())
+    const vector<FileInfo>& file_info = get_file_info();
+    auto it = m_file_index.find(file_name);
+    if (it != m_file_index.end())
     {
-        if (info.get_name() == file_name)
-        {
-            if (size_in_bytes != info.get_size())
-            {
-                throw runtime_error("Buffer size does not match file size");
-            }
-            m_stream->seekg(info.get_offset(), ios_base::beg);
-            m_stream->read(reinterpret_cast<char*>(data), size_in_bytes);
-            rc = true;
-            break;
-        }
+        read(file_info[it->second], data, size_in_bytes);
+        rc = true;
     }
     return rc;
 }
 
+void cpio::Reader::read(const FileInfo& info, void* data, size_t size_in_bytes)
+{
+    if (size_in_bytes != info.get_size())
+    {
+        throw runtime_error("Buffer size does not match file size");
+    }
+    m_stream->clear();
+    m_stream->seekg(info.get_offset(), ios_base::beg);
+    m_stream->read(reinterpret_cast<char*>(data), size_in_bytes);
+}
+
 vector<char> cpio::Reader::read(const FileInfo& info)
 {
     vector<char> buffer(info.get_size());
-    read(info.get_name(), buffer.data(), info.get_size());
+    read(info, buffer.data(), info.get_size());
     return buffer;
 }
 
@@ -301,7 +345,7 @@ bool cpio::is_cpio(istream& in)
     size_t offset = in.tellg();
     in.seekg(0, ios_base::beg);
     bool rc = false;
-    uint8_t ch;
+    uint8_t ch = 0;
     in.read(reinterpret_cast<char*>(&ch), 1);
     switch (ch)
     {
@@ -321,6 +365,8 @@ bool cpio::is_cpio(istream& in)
         break;
     default: break;
     }
+    // A short read leaves the stream failed, which would also fail the seek
+    in.clear();
     in.seekg(offset, ios_base::beg);
     return rc;
 }
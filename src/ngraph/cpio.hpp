@@ -19,6 +19,7 @@
 #include <fstream>
 #include <iostream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 // The CPIO file format can be found at
@@ -89,6 +90,14 @@ public:
     void open(std::ostream& out);
     void open(const std::string& filename);
     void write(const std::string& file_name, const void* data, uint32_t size_in_bytes);
+    /// \brief Write a record whose data starts at a multiple of alignment bytes from the
+    ///        start of the stream, so that a memory mapped reader can use it in place. Padding
+    ///        records named ".pad" are inserted as needed. If the stream position is unknown
+    ///        the record is written unaligned.
+    void write(const std::string& file_name,
+               const void* data,
+               uint32_t size_in_bytes,
+               size_t alignment);
 
 private:
     std::ostream* m_stream;
@@ -108,10 +117,15 @@ public:
     void close();
     const std::vector<FileInfo>& get_file_info();
     bool read(const std::string& file_name, void* data, size_t size_in_bytes);
+    /// \brief Read the file described by info, one of the entries of get_file_info, without
+    ///        looking it up by name
+    void read(const FileInfo& info, void* data, size_t size_in_bytes);
     std::vector<char> read(const FileInfo& info);
 
 private:
     std::istream* m_stream;
     std::ifstream m_my_stream;
     std::vector<cpio::FileInfo> m_file_info;
+    // Index of each file name in m_file_info
+    std::unordered_map<std::string, size_t> m_file_index;
 };
@@ -20,6 +20,7 @@
 
 #include "distributed.hpp"
 #include "event_tracing.hpp"
+#include "ngraph/runtime/chrome_trace.hpp"
 #include "nlohmann/json.hpp"
 
 using namespace std;
@@ -29,20 +30,14 @@ static bool read_tracing_env_var()
     return (std::getenv("NGRAPH_ENABLE_TRACING") != nullptr);
 }
 
-mutex ngraph::Event::s_file_mutex;
-ofstream ngraph::Event::s_event_log;
 bool ngraph::Event::s_tracing_enabled = read_tracing_env_var();
 
 void ngraph::Event::write_trace(const ngraph::Event& event)
 {
     if (is_tracing_enabled())
     {
-        lock_guard<mutex> lock(s_file_mutex);
-
-        static bool so_initialized = false;
-        if (!so_initialized)
-        {
-            // Open the file
+        static once_flag s_open_flag;
+        call_once(s_open_flag, []() {
             std::string file_name = "ngraph_event_trace.json";
             if (get_distributed_interface()->get_size() > 1)
             {
@@ -51,16 +46,16 @@ void ngraph::Event::write_trace(const ngraph::Event& event)
                 std::string prefix = std::string(num_zero - rank.length(), '0') + rank + "_";
                 file_name.insert(0, prefix);
             }
-            s_event_log.open(file_name, ios_base::trunc);
-            s_event_log << "[\n";
-            so_initialized = true;
-        }
-        else
-        {
-            s_event_log << ",\n";
-        }
+            runtime::event::Manager::open(file_name);
+        });
 
-        s_event_log << event.to_json() << "\n" << flush;
+        using namespace std::chrono;
+        runtime::event::Manager::record_duration(
+            runtime::event::Manager::intern(event.m_name),
+            runtime::event::Manager::intern(event.m_category),
+            nlohmann::json(event.m_args).dump(),
+            duration_cast<nanoseconds>(event.m_start.time_since_epoch()).count(),
+            duration_cast<nanoseconds>(event.m_stop - event.m_start).count());
     }
 }
 
@@ -63,6 +63,9 @@ namespace ngraph
     //
     // More information about this is at:
     // http://dev.chromium.org/developers/how-tos/trace-event-profiling-tool
+    //
+    // write_trace() records events with runtime::event::Manager, so they go to the trace file
+    // that is open there, or to ngraph_event_trace.json when none is.
 
     class Event
     {
@@ -71,7 +74,7 @@ namespace ngraph
                        const std::string& category,
                        const std::string& args)
             : m_pid(getpid())
-            , m_start(std::chrono::high_resolution_clock::now())
+            , m_start(std::chrono::steady_clock::now())
             , m_stopped(false)
             , m_name(name)
             , m_category(category)
@@ -87,7 +90,7 @@ namespace ngraph
                 return;
             }
             m_stopped = true;
-            m_stop = std::chrono::high_resolution_clock::now();
+            m_stop = std::chrono::steady_clock::now();
         }
 
         static void write_trace(const Event& event);
@@ -101,15 +104,13 @@ namespace ngraph
 
     private:
         int m_pid;
-        std::chrono::time_point<std::chrono::high_resolution_clock> m_start;
-        std::chrono::time_point<std::chrono::high_resolution_clock> m_stop;
+        std::chrono::time_point<std::chrono::steady_clock> m_start;
+        std::chrono::time_point<std::chrono::steady_clock> m_stop;
         bool m_stopped;
         std::string m_name;
         std::string m_category;
         std::string m_args;
 
-        static std::mutex s_file_mutex;
-        static std::ofstream s_event_log;
         static bool s_tracing_enabled;
     };
 
@@ -119,8 +119,62 @@ void Function::init()
                    true /*include control dependencies*/);
 }
 
+shared_ptr<const OrderedOpsCache::Ops> OrderedOpsCache::get(bool include_control_deps)
+{
+    lock_guard<mutex> lock(m_mutex);
+    return m_ops[include_control_deps ? 1 : 0];
+}
+
+void OrderedOpsCache::set(bool include_control_deps, const shared_ptr<const Ops>& ops)
+{
+    shared_ptr<OrderedOpsCache> self = shared_from_this();
+    for (const shared_ptr<Node>& node : *ops)
+    {
+        // Caches are compared by owner rather than locked, so that no cache can be destroyed
+        // while the node is locked
+        Node::OrderedOpsCachesLock lock(*node);
+        vector<weak_ptr<OrderedOpsCache>>& caches = node->m_ordered_ops_caches;
+        caches.erase(remove_if(caches.begin(),
+                               caches.end(),
+                               [](const weak_ptr<OrderedOpsCache>& cache) {
+                                   return cache.expired();
+                               }),
+                     caches.end());
+        if (none_of(caches.begin(), caches.end(), [&](const weak_ptr<OrderedOpsCache>& cache) {
+                return !cache.owner_before(self) && !self.owner_before(cache);
+            }))
+        {
+            caches.push_back(self);
+        }
+    }
+    lock_guard<mutex> lock(m_mutex);
+    m_ops[include_control_deps ? 1 : 0] = ops;
+}
+
+void OrderedOpsCache::clear()
+{
+    // Released outside of the lock, since releasing may destroy nodes
+    shared_ptr<const Ops> dropped[2];
+    lock_guard<mutex> lock(m_mutex);
+    dropped[0].swap(m_ops[0]);
+    dropped[1].swap(m_ops[1]);
+}
+
 std::list<shared_ptr<Node>> Function::get_ordered_ops(bool include_control_deps) const
 {
+    return *get_shared_ordered_ops(include_control_deps);
+}
+
+shared_ptr<const std::list<shared_ptr<Node>>>
+    Function::get_shared_ordered_ops(bool include_control_deps) const
+{
+    lock_guard<mutex> lock(m_ordered_ops_mutex);
+    shared_ptr<const OrderedOpsCache::Ops> ops = m_ordered_ops->get(include_control_deps);
+    if (ops)
+    {
+        return ops;
+    }
+
     NodeVector nodes;
     for (auto& r : get_results())
     {
@@ -131,7 +185,9 @@ std::list<shared_ptr<Node>> Function::get_ordered_ops(bool include_control_deps)
         nodes.push_back(param);
     }
 
-    return topological_sort(nodes, include_control_deps);
+    ops = make_shared<const OrderedOpsCache::Ops>(topological_sort(nodes, include_control_deps));
+    m_ordered_ops->set(include_control_deps, ops);
+    return ops;
 }
 
 void Function::map_unordered_ops(std::function<void(Node*)> f) const
@@ -317,4 +373,6 @@ void Function::replace_parameter(size_t parameter_index, const shared_ptr<op::Pa
                  " parameters.");
     replace_node(m_parameters[parameter_index], parameter);
     m_parameters[parameter_index] = parameter;
+    // The parameters are roots of the order, and an unused parameter has no edges to replace
+    m_ordered_ops->clear();
 }
@@ -20,6 +20,7 @@
 #include <initializer_list>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -29,6 +30,26 @@
 
 namespace ngraph
 {
+    /// \brief The topological orders of the ops of a Function. Every node in an order refers
+    ///        back to the cache, and an edit of such a node drops the orders, so that they are
+    ///        sorted again on next use and removed nodes are not kept alive.
+    class OrderedOpsCache : public std::enable_shared_from_this<OrderedOpsCache>
+    {
+    public:
+        using Ops = std::list<std::shared_ptr<Node>>;
+
+        /// \brief The order, or nullptr if it was dropped or never sorted
+        std::shared_ptr<const Ops> get(bool include_control_deps);
+        /// \brief Caches the order and registers the cache with the nodes in it
+        void set(bool include_control_deps, const std::shared_ptr<const Ops>& ops);
+        void clear();
+
+    private:
+        std::mutex m_mutex;
+        // Indexed by include_control_deps
+        std::shared_ptr<const Ops> m_ops[2];
+    };
+
     /// A user-defined function.
     class Function
     {
@@ -94,7 +115,13 @@ namespace ngraph
         const std::string& get_friendly_name() const;
 
         std::list<std::shared_ptr<Node>> get_ops(bool include_control_deps = true) const;
+        /// \brief Returns the ops in topological order. The order is cached and only sorted
+        ///        again after a node in it has been edited.
         std::list<std::shared_ptr<Node>> get_ordered_ops(bool include_control_deps = true) const;
+        /// \brief Returns the cached ops in topological order without copying them. The list
+        ///        does not change when the graph is edited; a later call returns a new one.
+        std::shared_ptr<const std::list<std::shared_ptr<Node>>>
+            get_shared_ordered_ops(bool include_control_deps = true) const;
         void map_unordered_ops(std::function<void(Node*)> f) const;
 
         friend std::ostream& operator<<(std::ostream&, const Function&);
@@ -142,5 +169,9 @@ namespace ngraph
         std::string m_name;
         const std::string m_unique_name;
         size_t m_placement{0};
+        // Shared with the nodes in the cached orders, which outlive the function
+        std::shared_ptr<OrderedOpsCache> m_ordered_ops{std::make_shared<OrderedOpsCache>()};
+        // Held while sorting, so concurrent callers sort once
+        mutable std::mutex m_ordered_ops_mutex;
     };
 }
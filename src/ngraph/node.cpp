@@ -22,6 +22,7 @@
 #include "ngraph/autodiff/adjoints.hpp"
 #include "ngraph/descriptor/input.hpp"
 #include "ngraph/descriptor/layout/tensor_layout.hpp"
+#include "ngraph/function.hpp"
 #include "ngraph/graph_util.hpp"
 #include "ngraph/node.hpp"
 #include "ngraph/op/get_output_element.hpp"
@@ -468,6 +469,23 @@ NodeVector Node::get_arguments() const
     return result;
 }
 
+void Node::graph_changed()
+{
+    // Detach the list under the lock of this node only, and clear the caches outside of it
+    vector<weak_ptr<OrderedOpsCache>> caches;
+    {
+        OrderedOpsCachesLock lock(*this);
+        caches.swap(m_ordered_ops_caches);
+    }
+    for (const weak_ptr<OrderedOpsCache>& cache : caches)
+    {
+        if (auto locked = cache.lock())
+        {
+            locked->clear();
+        }
+    }
+}
+
 const std::vector<std::shared_ptr<Node>>& Node::get_control_dependencies() const
 {
     return m_control_dependencies;
@@ -484,6 +502,7 @@ void Node::add_control_dependency(std::shared_ptr<Node> node)
         m_control_dependencies.end())
     {
         m_control_dependencies.push_back(node);
+        graph_changed();
         if (find(node->m_control_dependents.begin(), node->m_control_dependents.end(), this) ==
             node->m_control_dependents.end())
         {
@@ -515,6 +534,7 @@ void Node::remove_control_dependency(std::shared_ptr<Node> node)
         if (it != m_control_dependencies.end())
         {
             m_control_dependencies.erase(it);
+            graph_changed();
         }
     }
     {
@@ -537,6 +557,7 @@ void Node::clear_control_dependencies()
         }
     }
     m_control_dependencies.clear();
+    graph_changed();
 }
 
 void Node::clear_control_dependents()
@@ -54,6 +54,7 @@ namespace ngraph
     using OutputVector = std::vector<Output<Node>>;
 
     class Function;
+    class OrderedOpsCache;
 
     namespace op
     {
@@ -92,9 +93,12 @@ namespace ngraph
         // For access to generate_adjoints.
         friend class autodiff::Adjoints;
 
-        // For access to m_outputs.
+        // For access to m_outputs and graph_changed.
         friend class descriptor::Input;
 
+        // For access to m_ordered_ops_caches.
+        friend class OrderedOpsCache;
+
         // For access to m_inputs and m_outputs.
         template <typename NodeType>
         friend class Input;
@@ -497,6 +501,31 @@ namespace ngraph
         std::string m_unique_name;
         NGRAPH_API
         static std::atomic<size_t> m_next_instance_id;
+        // Drops the ordered ops cached by the functions this node is in, after the source of
+        // an input or a control dependency of this node changed
+        void graph_changed();
+        // The caches of the functions whose ordered ops hold this node
+        std::vector<std::weak_ptr<OrderedOpsCache>> m_ordered_ops_caches;
+        // Guards m_ordered_ops_caches. A spin lock per node rather than one mutex for every
+        // node, since it is only held to swap or append to the vector, and a mutex per node
+        // would be much larger.
+        std::atomic_flag m_ordered_ops_caches_lock = ATOMIC_FLAG_INIT;
+        // Holds the lock of m_ordered_ops_caches of a node for a scope
+        class OrderedOpsCachesLock
+        {
+        public:
+            explicit OrderedOpsCachesLock(Node& node)
+                : m_flag(node.m_ordered_ops_caches_lock)
+            {
+                while (m_flag.test_and_set(std::memory_order_acquire))
+                {
+                }
+            }
+            ~OrderedOpsCachesLock() { m_flag.clear(std::memory_order_release); }
+
+        private:
+            std::atomic_flag& m_flag;
+        };
         std::unordered_set<std::string> m_provenance_tags;
         std::set<std::shared_ptr<Node>> m_provenance_group;
         std::deque<descriptor::Input> m_inputs;
@@ -260,7 +260,18 @@ AxisSet op::Constant::get_axis_set_val() const
 shared_ptr<Node> op::Constant::copy_with_new_args(const NodeVector& new_args) const
 {
     check_new_args_count(this, new_args);
-    return make_shared<Constant>(m_element_type, m_shape, m_data->get_ptr());
+    return make_shared<Constant>(m_element_type, m_shape, m_data);
+}
+
+void* op::Constant::get_data_ptr_nc()
+{
+    if (m_data && m_data.use_count() > 1)
+    {
+        auto data = make_shared<runtime::AlignedBuffer>(m_data->size(), host_alignment());
+        memcpy(data->get_ptr(), m_data->get_ptr(), m_data->size());
+        m_data = data;
+    }
+    return (m_data ? m_data->get_ptr() : nullptr);
 }
 
 template <typename T>
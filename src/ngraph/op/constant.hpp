@@ -148,6 +148,28 @@ namespace ngraph
                 constructor_validate_and_infer_types();
             }
 
+            /// \brief Constructs a tensor constant that refers to existing data instead of
+            ///        copying it. This constructor is to support zero-copy deserialization.
+            ///
+            /// \param type The element type of the tensor constant.
+            /// \param shape The shape of the tensor constant.
+            /// \param data A buffer holding at least shape_size(shape) * type.size() bytes.
+            Constant(const element::Type& type,
+                     const Shape& shape,
+                     const std::shared_ptr<runtime::AlignedBuffer>& data)
+                : m_element_type(type)
+                , m_shape(shape)
+                , m_data(data)
+            {
+                NODE_VALIDATION_CHECK(this,
+                                      m_data->size() >= shape_size(m_shape) * type.size(),
+                                      "Buffer of ",
+                                      m_data->size(),
+                                      " bytes is too small for a constant of shape ",
+                                      m_shape);
+                constructor_validate_and_infer_types();
+            }
+
             virtual ~Constant() override;
 
             void validate_and_infer_types() override
@@ -214,6 +236,8 @@ namespace ngraph
                 return result;
             }
 
+            /// \brief Returns a constant that shares the data of this one. The data is only
+            ///        copied if one of them writes to it.
             virtual std::shared_ptr<Node>
                 copy_with_new_args(const NodeVector& new_args) const override;
 
@@ -237,7 +261,16 @@ namespace ngraph
                 return rc;
             }
 
+            /// \brief Returns the data, which may be shared with copies of this constant made
+            ///        by copy_with_new_args or clone_function. Callers that const_cast the
+            ///        pointer for an API taking void* must still only read through it.
             const void* get_data_ptr() const { return (m_data ? m_data->get_ptr() : nullptr); }
+            /// \brief Returns the buffer holding the data. It may be shared with other
+            ///        constants, so it must not be modified.
+            const std::shared_ptr<runtime::AlignedBuffer>& get_data_buffer() const
+            {
+                return m_data;
+            }
             template <typename T>
             const T* get_data_ptr() const
             {
@@ -249,7 +282,10 @@ namespace ngraph
             std::string convert_value_to_string(size_t index) const;
 
         protected:
-            void* get_data_ptr_nc() { return (m_data ? m_data->get_ptr() : nullptr); }
+            /// \brief Returns a writable pointer to the data. Copies made with
+            ///        copy_with_new_args share the data with this constant, so the data is
+            ///        copied first if it is shared.
+            void* get_data_ptr_nc();
             Constant(const OutputVector& args)
                 : Node(args)
                 , m_shape({})
@@ -342,7 +378,7 @@ namespace ngraph
             static constexpr size_t host_alignment() { return 64; }
             element::Type m_element_type;
             Shape m_shape{};
-            std::unique_ptr<runtime::AlignedBuffer> m_data;
+            std::shared_ptr<runtime::AlignedBuffer> m_data;
             Constant(const Constant&) = delete;
             Constant operator=(const Constant&) = delete;
         };
@@ -14,6 +14,8 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <cstdlib>
+
 #include "constant_folding.hpp"
 
 using namespace std;
@@ -31,3 +33,22 @@ bool ngraph::pass::revalidate_and_ensure_static(shared_ptr<Node> n)
     }
     return true;
 }
+
+shared_ptr<runtime::ThreadPool> pass::ConstantFolding::get_default_thread_pool()
+{
+    // Created by the first pass that runs, not when passes are constructed
+    static shared_ptr<runtime::ThreadPool> s_pool = []() -> shared_ptr<runtime::ThreadPool> {
+        const char* env_threads = getenv("NGRAPH_CONSTANT_FOLDING_THREADS");
+        size_t thread_count = env_threads == nullptr ? 1 : strtoul(env_threads, nullptr, 10);
+        return thread_count > 1 ? make_shared<runtime::ThreadPool>(thread_count) : nullptr;
+    }();
+    return s_pool;
+}
+
+bool pass::ConstantFolding::run_on_function(shared_ptr<Function> f)
+{
+    shared_ptr<runtime::ThreadPool> pool =
+        m_thread_pool_set ? m_thread_pool : get_default_thread_pool();
+    runtime::ThreadPool::Scope scope(pool.get());
+    return GraphRewrite::run_on_function(f);
+}
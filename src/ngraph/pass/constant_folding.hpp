@@ -17,6 +17,7 @@
 #pragma once
 
 #include "ngraph/pass/graph_rewrite.hpp"
+#include "ngraph/runtime/thread_pool.hpp"
 #include "ngraph/util.hpp"
 
 namespace ngraph
@@ -123,7 +124,23 @@ public:
         }
     }
 
+    /// \brief Folds with the reference kernels running on the thread pool. The executors in
+    ///        the BuildNodeExecutorMap manage their own threads.
+    virtual bool run_on_function(std::shared_ptr<ngraph::Function> f) override;
+
+    /// \brief Sets the pool the reference kernels run on, nullptr to fold on one thread.
+    ///
+    /// By default the passes fold on one thread. If NGRAPH_CONSTANT_FOLDING_THREADS is set to
+    /// more than one, they share a pool with that many threads, created on first use.
+    void set_thread_pool(const std::shared_ptr<runtime::ThreadPool>& pool)
+    {
+        m_thread_pool = pool;
+        m_thread_pool_set = true;
+    }
+
 private:
+    static std::shared_ptr<runtime::ThreadPool> get_default_thread_pool();
+
     void construct_constant_reshape();
     void construct_constant_broadcast();
     void construct_constant_dyn_broadcast();
@@ -147,4 +164,6 @@ private:
     void construct_constant_select();
 
     ngraph::BuildNodeExecutorMap m_cfmap;
+    std::shared_ptr<runtime::ThreadPool> m_thread_pool;
+    bool m_thread_pool_set{false};
 };
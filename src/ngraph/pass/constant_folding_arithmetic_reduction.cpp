@@ -37,7 +37,7 @@ static shared_ptr<op::Constant>
 
     if (auto max = as_type_ptr<op::Max>(reduction_node))
     {
-        runtime::reference::max<T>(constant->get_vector<T>().data(),
+        runtime::reference::max<T>(constant->get_data_ptr<T>(),
                                    out_vec.data(),
                                    constant->get_output_shape(0),
                                    reduction_node->get_shape(),
@@ -45,7 +45,7 @@ static shared_ptr<op::Constant>
     }
     else if (auto min = as_type_ptr<op::Min>(reduction_node))
     {
-        runtime::reference::min<T>(constant->get_vector<T>().data(),
+        runtime::reference::min<T>(constant->get_data_ptr<T>(),
                                    out_vec.data(),
                                    constant->get_output_shape(0),
                                    reduction_node->get_shape(),
@@ -53,7 +53,7 @@ static shared_ptr<op::Constant>
     }
     else if (auto prod = as_type_ptr<op::Product>(reduction_node))
     {
-        runtime::reference::product<T>(constant->get_vector<T>().data(),
+        runtime::reference::product<T>(constant->get_data_ptr<T>(),
                                        out_vec.data(),
                                        constant->get_output_shape(0),
                                        reduction_node->get_shape(),
@@ -61,7 +61,7 @@ static shared_ptr<op::Constant>
     }
     else if (auto sum = as_type_ptr<op::Sum>(reduction_node))
     {
-        runtime::reference::sum<T>(constant->get_vector<T>().data(),
+        runtime::reference::sum<T>(constant->get_data_ptr<T>(),
                                    out_vec.data(),
                                    constant->get_output_shape(0),
                                    reduction_node->get_shape(),
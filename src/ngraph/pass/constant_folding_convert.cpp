@@ -16,6 +16,7 @@
 
 #include "constant_folding.hpp"
 #include "ngraph/op/convert.hpp"
+#include "ngraph/runtime/aligned_buffer.hpp"
 #include "ngraph/runtime/reference/convert.hpp"
 
 using namespace std;
@@ -32,7 +33,7 @@ shared_ptr<op::Constant> fold_constant_convert_helper1(shared_ptr<op::Constant>
     vector<TO> out_vec(shape_size(out_shape));
 
     runtime::reference::convert<TI, TO>(
-        constant->get_vector<TI>().data(), out_vec.data(), shape_size(out_shape));
+        constant->get_data_ptr<TI>(), out_vec.data(), shape_size(out_shape));
 
     return make_shared<op::Constant>(output_element_type, out_shape, out_vec);
 }
@@ -92,7 +93,8 @@ shared_ptr<op::Constant> fold_constant_convert_helper0(shared_ptr<op::Constant>
 }
 
 static shared_ptr<op::Constant> fold_constant_convert(shared_ptr<op::Constant> constant,
-                                                      const element::Type& output_element_type)
+                                                      const element::Type& output_element_type,
+                                                      NodeExecutorTy func)
 {
     auto& input_element_type = constant->get_output_element_type(0);
 
@@ -101,6 +103,18 @@ static shared_ptr<op::Constant> fold_constant_convert(shared_ptr<op::Constant> c
         return constant;
     }
 
+    if (func != nullptr)
+    {
+        auto out_shape = constant->get_shape();
+        auto buffer = make_shared<runtime::AlignedBuffer>(
+            shape_size(out_shape) * output_element_type.size(), 64);
+        vector<void*> inputs{const_cast<void*>(constant->get_data_ptr())};
+        vector<void*> outputs{buffer->get_ptr()};
+        func(inputs, outputs);
+        // The constant takes the buffer instead of copying it
+        return make_shared<op::Constant>(output_element_type, out_shape, buffer);
+    }
+
 #if defined(__GNUC__) && !(__GNUC__ == 4 && __GNUC_MINOR__ == 8)
 #pragma GCC diagnostic push
 #pragma GCC diagnostic error "-Wswitch"
@@ -154,7 +168,7 @@ void pass::ConstantFolding::construct_constant_convert()
         element::i32, Shape{2, 3, 4}, pattern::has_class<op::Constant>());
     auto convert_op = make_shared<op::Convert>(constant_label, element::i64);
 
-    auto constant_convert_callback = [constant_label](pattern::Matcher& m) {
+    auto constant_convert_callback = [this, constant_label](pattern::Matcher& m) {
         NGRAPH_DEBUG << "In callback for constant_convert_callback against node = "
                      << m.get_match_root()->get_name();
 
@@ -165,9 +179,17 @@ void pass::ConstantFolding::construct_constant_convert()
 
         NGRAPH_CHECK(revalidate_and_ensure_static(convert_match));
 
-        replace_node(
-            m.get_match_root(),
-            fold_constant_convert(constant_match, convert_match->get_output_element_type(0)));
+        // Not every backend has a Convert executor, and an executor may not support the types
+        NodeExecutorTy func = nullptr;
+        auto handler = m_cfmap.find(type_index(typeid(ngraph::op::Convert)));
+        if (handler != m_cfmap.end())
+        {
+            func = handler->second(convert_match.get());
+        }
+
+        replace_node(m.get_match_root(),
+                     fold_constant_convert(
+                         constant_match, convert_match->get_output_element_type(0), func));
         return true;
     };
 
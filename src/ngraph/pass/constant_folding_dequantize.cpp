@@ -30,9 +30,9 @@ shared_ptr<op::Constant> fold_constant_dequantize(shared_ptr<op::Constant> const
     auto out_shape = constant->get_shape();
     vector<REAL> out_vec(shape_size(out_shape));
 
-    runtime::reference::dequantize<QUANT, REAL>(constant->get_vector<QUANT>().data(),
-                                                scale->get_vector<REAL>().data(),
-                                                offset->get_vector<QUANT>().data(),
+    runtime::reference::dequantize<QUANT, REAL>(constant->get_data_ptr<QUANT>(),
+                                                scale->get_data_ptr<REAL>(),
+                                                offset->get_data_ptr<QUANT>(),
                                                 out_vec.data(),
                                                 constant->get_shape(),
                                                 scale->get_shape(),
@@ -30,7 +30,7 @@ static shared_ptr<op::Constant> fold_constant_logical_reduction(shared_ptr<op::C
 
     if (auto all = as_type_ptr<::ngraph::op::All>(reduction_node))
     {
-        runtime::reference::all(constant->get_vector<char>().data(),
+        runtime::reference::all(constant->get_data_ptr<char>(),
                                 out_vec.data(),
                                 constant->get_output_shape(0),
                                 reduction_node->get_shape(),
@@ -38,7 +38,7 @@ static shared_ptr<op::Constant> fold_constant_logical_reduction(shared_ptr<op::C
     }
     else if (auto any = as_type_ptr<::ngraph::op::Any>(reduction_node))
     {
-        runtime::reference::any(constant->get_vector<char>().data(),
+        runtime::reference::any(constant->get_data_ptr<char>(),
                                 out_vec.data(),
                                 constant->get_output_shape(0),
                                 reduction_node->get_shape(),
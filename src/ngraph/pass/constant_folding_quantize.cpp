@@ -30,9 +30,9 @@ shared_ptr<op::Constant> fold_constant_quantize(shared_ptr<op::Constant> constan
     auto out_shape = constant->get_shape();
     vector<QUANT> out_vec(shape_size(out_shape));
 
-    runtime::reference::quantize<REAL, QUANT>(constant->get_vector<REAL>().data(),
-                                              scale->get_vector<REAL>().data(),
-                                              offset->get_vector<QUANT>().data(),
+    runtime::reference::quantize<REAL, QUANT>(constant->get_data_ptr<REAL>(),
+                                              scale->get_data_ptr<REAL>(),
+                                              offset->get_data_ptr<QUANT>(),
                                               out_vec.data(),
                                               constant->get_shape(),
                                               scale->get_shape(),
@@ -29,7 +29,7 @@ static shared_ptr<op::Constant> fold_constant_reverse_helper(shared_ptr<op::Cons
     vector<T> out_vec(shape_size(out_shape));
 
     runtime::reference::reverse<T>(
-        constant->get_vector<T>().data(), out_vec.data(), out_shape, out_shape, reversed_axes);
+        constant->get_data_ptr<T>(), out_vec.data(), out_shape, out_shape, reversed_axes);
 
     return make_shared<op::Constant>(constant->get_output_element_type(0), out_shape, out_vec);
 }
@@ -15,13 +15,18 @@
 //*****************************************************************************
 
 #include <algorithm>
+#include <iomanip>
 #include <iostream>
+#include <map>
 #include <regex>
+#include <typeindex>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include "graph_rewrite.hpp"
 #include "ngraph/log.hpp"
+#include "ngraph/util.hpp"
 
 using namespace std;
 using namespace ngraph;
@@ -60,8 +65,29 @@ using namespace ngraph;
 //    the correct final fusion. i.e. the same fusion needs to occur before and after some other
 //    fusion
 
+namespace
+{
+    struct MatcherStats
+    {
+        size_t attempts = 0;
+        size_t matches = 0;
+        size_t rewrites = 0;
+        stopwatch timer;
+    };
+}
+
+// Matchers are dispatched on the type of each node. A matcher is only run on nodes whose type
+// it can match at its root (see pattern::Matcher::get_root_types), and matchers with a wildcard
+// root are run on every node. The matchers for a node type keep their registration order, so
+// the result is the same as running every matcher on every node.
+//
+// With NGRAPH_PROFILE_PASS_ENABLE set, the number of attempts, matches and rewrites and the
+// time spent matching is printed per matcher name after the pass.
+
 bool pass::GraphRewrite::run_on_function(shared_ptr<Function> f)
 {
+    static bool s_profile_enabled = getenv("NGRAPH_PROFILE_PASS_ENABLE") != nullptr;
+
     bool rewritten = false;
     const size_t NUM_TRIES = 10;
     size_t tries = NUM_TRIES;
@@ -71,6 +97,7 @@ bool pass::GraphRewrite::run_on_function(shared_ptr<Function> f)
     static bool s_rerun_dynamic_check =
         (std::getenv("NGRAPH_GRAPH_REWRITE_RERUN_DYNAMIC_CHECK") != nullptr);
     bool is_dyn_func = s_rerun_dynamic_check && f->is_dynamic();
+    map<string, MatcherStats> stats;
     do
     {
         rewritten = false;
@@ -78,11 +105,40 @@ bool pass::GraphRewrite::run_on_function(shared_ptr<Function> f)
         // that need multiple passes. See comments above.
         vector<MatchClosure> matchers_to_run{m_matchers};
         m_matchers.clear();
-        for (auto node : f->get_ordered_ops())
+
+        vector<vector<type_index>> root_types;
+        for (auto& closure : matchers_to_run)
         {
-            for (auto& closure : matchers_to_run)
+            root_types.push_back(closure.matcher->get_root_types());
+        }
+        // Filled in the first time a node of each type is seen
+        unordered_map<type_index, vector<MatchClosure*>> matchers_by_type;
+
+        // Held while matching, since a replacement drops the cached order
+        auto ordered_ops = f->get_shared_ordered_ops();
+        for (auto node : *ordered_ops)
+        {
+            Node* p_node = node.get();
+            type_index node_type(typeid(*p_node));
+            auto it = matchers_by_type.find(node_type);
+            if (it == matchers_by_type.end())
             {
-                if (is_dyn_func && closure.property[PassProperty::REQUIRE_STATIC_SHAPE])
+                vector<MatchClosure*> candidates;
+                for (size_t i = 0; i < matchers_to_run.size(); i++)
+                {
+                    if (root_types[i].empty() ||
+                        find(root_types[i].begin(), root_types[i].end(), node_type) !=
+                            root_types[i].end())
+                    {
+                        candidates.push_back(&matchers_to_run[i]);
+                    }
+                }
+                it = matchers_by_type.emplace(node_type, move(candidates)).first;
+            }
+
+            for (MatchClosure* closure : it->second)
+            {
+                if (is_dyn_func && closure->property[PassProperty::REQUIRE_STATIC_SHAPE])
                 {
                     NGRAPH_DEBUG << "matcher callback requires static shape but the "
                                     "function is dynamic, skipping this "
@@ -90,19 +146,40 @@ bool pass::GraphRewrite::run_on_function(shared_ptr<Function> f)
                                     "materialized";
                     continue;
                 }
-                NGRAPH_DEBUG << "Running matcher " << closure.matcher->get_name() << "("
-                             << closure.matcher->get_pattern()->get_name() << ") on "
+                NGRAPH_DEBUG << "Running matcher " << closure->matcher->get_name() << "("
+                             << closure->matcher->get_pattern()->get_name() << ") on "
                              << node->get_name();
-                if (closure.matcher->match(node))
+                MatcherStats* matcher_stats = nullptr;
+                if (s_profile_enabled)
                 {
-                    NGRAPH_DEBUG << "Matcher " << closure.matcher << closure.matcher->get_name()
-                                 << " matched " << node->get_name();
-                    if (closure.callback(*closure.matcher.get()))
+                    matcher_stats = &stats[closure->matcher->get_name()];
+                    matcher_stats->attempts++;
+                    matcher_stats->timer.start();
+                }
+                bool matched = closure->matcher->match(node);
+                if (matcher_stats)
+                {
+                    matcher_stats->timer.stop();
+                }
+                if (matched)
+                {
+                    NGRAPH_DEBUG << "Matcher " << closure->matcher
+                                 << closure->matcher->get_name() << " matched "
+                                 << node->get_name();
+                    if (matcher_stats)
+                    {
+                        matcher_stats->matches++;
+                    }
+                    if (closure->callback(*closure->matcher.get()))
                     {
+                        if (matcher_stats)
+                        {
+                            matcher_stats->rewrites++;
+                        }
                         rewritten = true;
                         // If call back may change function's is_dynamic state, we need to
                         // update the cached value.
-                        if (closure.property.is_set(PassProperty::CHANGE_DYNAMIC_STATE))
+                        if (closure->property.is_set(PassProperty::CHANGE_DYNAMIC_STATE))
                         {
                             is_dyn_func = s_rerun_dynamic_check && f->is_dynamic();
                         }
@@ -114,6 +191,18 @@ bool pass::GraphRewrite::run_on_function(shared_ptr<Function> f)
 
     } while (rewritten && m_matchers.size() > 0 && tries--);
 
+    if (s_profile_enabled)
+    {
+        for (auto& entry : stats)
+        {
+            const MatcherStats& matcher_stats = entry.second;
+            cout << setw(7) << matcher_stats.timer.get_total_microseconds() << "us "
+                 << setw(8) << matcher_stats.attempts << " attempts " << setw(6)
+                 << matcher_stats.matches << " matches " << setw(6) << matcher_stats.rewrites
+                 << " rewrites  matcher " << entry.first << "\n";
+        }
+    }
+
     m_matchers.assign(original_matchers.begin(), original_matchers.end());
     return (NUM_TRIES - tries) > 1; // this means a graph was transformed
 }
@@ -129,7 +129,8 @@ void pass::Manager::run_passes(shared_ptr<Function> func, bool /* transitive */)
                 {
                     continue;
                 }
-                bool function_modified = call_graph_pass->run_on_call_graph(f->get_ordered_ops());
+                bool function_modified =
+                    call_graph_pass->run_on_call_graph(*f->get_shared_ordered_ops());
                 f_pair.second = (function_modified == true) ? f->is_dynamic() : f_pair.second;
             }
         }
@@ -14,7 +14,9 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <algorithm>
 #include <exception>
+#include <map>
 #include <sstream>
 
 #include "ngraph/log.hpp"
@@ -290,3 +292,296 @@ size_t pass::MemoryManager::align(size_t size, size_t alignment)
     }
     return size;
 }
+
+pass::MemoryPlanner::MemoryPlanner(size_t alignment)
+    : m_alignment{alignment}
+    , m_max_allocated{0}
+{
+    if (m_alignment == 0)
+    {
+        throw invalid_argument("Memory alignment must be > 0");
+    }
+}
+
+size_t pass::MemoryPlanner::add_buffer(size_t size, size_t first, size_t last)
+{
+    if (last < first)
+    {
+        throw invalid_argument("Buffer cannot be freed before it is allocated");
+    }
+    m_buffers.push_back({MemoryManager::align(size, m_alignment), first, last, 0});
+    return m_buffers.size() - 1;
+}
+
+void pass::MemoryPlanner::set_last_use(size_t id, size_t last)
+{
+    Buffer& buffer = m_buffers.at(id);
+    if (last < buffer.first)
+    {
+        throw invalid_argument("Buffer cannot be freed before it is allocated");
+    }
+    buffer.last = last;
+}
+
+size_t pass::MemoryPlanner::get_offset(size_t id) const
+{
+    return m_buffers.at(id).offset;
+}
+
+size_t pass::MemoryPlanner::get_lower_bound() const
+{
+    // Sweep over the steps at which the live bytes change
+    vector<pair<size_t, size_t>> allocations;
+    vector<pair<size_t, size_t>> frees;
+    for (const Buffer& buffer : m_buffers)
+    {
+        allocations.push_back({buffer.first, buffer.size});
+        if (buffer.last != numeric_limits<size_t>::max())
+        {
+            frees.push_back({buffer.last, buffer.size});
+        }
+    }
+    sort(allocations.begin(), allocations.end());
+    sort(frees.begin(), frees.end());
+
+    size_t live = 0;
+    size_t peak = 0;
+    auto free_it = frees.begin();
+    for (const auto& allocation : allocations)
+    {
+        // Buffers freed at an earlier step are gone; those freed at this step are still live
+        for (; free_it != frees.end() && free_it->first < allocation.first; ++free_it)
+        {
+            live -= free_it->second;
+        }
+        live += allocation.second;
+        peak = max(peak, live);
+    }
+    return peak;
+}
+
+size_t pass::MemoryPlanner::place_in_allocation_order(vector<size_t>& offsets) const
+{
+    vector<size_t> frees;
+    for (size_t id = 0; id < m_buffers.size(); id++)
+    {
+        if (m_buffers[id].last != numeric_limits<size_t>::max())
+        {
+            frees.push_back(id);
+        }
+    }
+    stable_sort(frees.begin(), frees.end(), [this](size_t a, size_t b) {
+        return m_buffers[a].last < m_buffers[b].last;
+    });
+
+    // At each step, the new buffers are allocated before the buffers of that step are freed
+    MemoryManager mm(m_alignment);
+    auto free_it = frees.begin();
+    for (size_t id = 0; id < m_buffers.size(); id++)
+    {
+        for (; free_it != frees.end() && m_buffers[*free_it].last < m_buffers[id].first;
+             ++free_it)
+        {
+            mm.free(offsets[*free_it]);
+        }
+        offsets[id] = mm.allocate(m_buffers[id].size);
+    }
+    return mm.max_allocated();
+}
+
+vector<vector<size_t>> pass::MemoryPlanner::find_overlaps() const
+{
+    vector<vector<size_t>> overlaps(m_buffers.size());
+    vector<size_t> by_first(m_buffers.size());
+    for (size_t id = 0; id < by_first.size(); id++)
+    {
+        by_first[id] = id;
+    }
+    stable_sort(by_first.begin(), by_first.end(), [this](size_t a, size_t b) {
+        return m_buffers[a].first < m_buffers[b].first;
+    });
+
+    // Sweep over the buffers in the order they become live. The buffers still live when a
+    // buffer starts are exactly the earlier buffers overlapping it.
+    multimap<size_t, size_t> live_by_last;
+    for (size_t id : by_first)
+    {
+        const Buffer& buffer = m_buffers[id];
+        live_by_last.erase(live_by_last.begin(), live_by_last.lower_bound(buffer.first));
+        for (const auto& live : live_by_last)
+        {
+            overlaps[id].push_back(live.second);
+            overlaps[live.second].push_back(id);
+        }
+        live_by_last.insert({buffer.last, id});
+    }
+    return overlaps;
+}
+
+size_t pass::MemoryPlanner::place_in_order(const vector<size_t>& order,
+                                           const vector<vector<size_t>>& overlaps,
+                                           vector<size_t>& offsets) const
+{
+    size_t max_allocated = 0;
+    vector<bool> placed(m_buffers.size(), false);
+    // Start and end offsets of the placed buffers overlapping the one being placed
+    vector<pair<size_t, size_t>> neighbors;
+    for (size_t id : order)
+    {
+        const Buffer& buffer = m_buffers[id];
+        neighbors.clear();
+        for (size_t other : overlaps[id])
+        {
+            if (placed[other])
+            {
+                neighbors.push_back({offsets[other], offsets[other] + m_buffers[other].size});
+            }
+        }
+        sort(neighbors.begin(), neighbors.end());
+
+        size_t best_offset = 0;
+        size_t best_gap = numeric_limits<size_t>::max();
+        size_t end = 0;
+        for (const auto& neighbor : neighbors)
+        {
+            if (neighbor.first >= end)
+            {
+                size_t gap = neighbor.first - end;
+                if (gap >= buffer.size && gap < best_gap)
+                {
+                    best_gap = gap;
+                    best_offset = end;
+                }
+            }
+            end = max(end, neighbor.second);
+        }
+        offsets[id] = best_gap == numeric_limits<size_t>::max() ? end : best_offset;
+        max_allocated = max(max_allocated, offsets[id] + buffer.size);
+        placed[id] = true;
+    }
+    return max_allocated;
+}
+
+void pass::MemoryPlanner::plan()
+{
+    size_t count = m_buffers.size();
+    vector<size_t> best_offsets(count);
+    m_max_allocated = place_in_allocation_order(best_offsets);
+    if (count == 0)
+    {
+        return;
+    }
+
+    vector<vector<size_t>> overlaps = find_overlaps();
+    auto try_order = [&](const vector<size_t>& order) {
+        vector<size_t> offsets(count);
+        size_t max_allocated = place_in_order(order, overlaps, offsets);
+        if (max_allocated < m_max_allocated)
+        {
+            m_max_allocated = max_allocated;
+            best_offsets = offsets;
+        }
+    };
+
+    vector<size_t> by_size(count);
+    for (size_t id = 0; id < count; id++)
+    {
+        by_size[id] = id;
+    }
+    stable_sort(by_size.begin(), by_size.end(), [this](size_t a, size_t b) {
+        return m_buffers[a].size > m_buffers[b].size;
+    });
+    try_order(by_size);
+
+    // Breadth of a step is the number of bytes live at it. Buffers live at the broadest step
+    // go first, largest first, then those of the next broadest step, and so on.
+    //
+    // The steps are those at which a buffer is allocated or freed. Breadths come from a sweep
+    // over the bytes allocated and freed at each step.
+    vector<size_t> steps;
+    for (const Buffer& buffer : m_buffers)
+    {
+        steps.push_back(buffer.first);
+        if (buffer.last != numeric_limits<size_t>::max())
+        {
+            steps.push_back(buffer.last);
+        }
+    }
+    sort(steps.begin(), steps.end());
+    steps.erase(unique(steps.begin(), steps.end()), steps.end());
+    auto step_index = [&steps](size_t step) {
+        return static_cast<size_t>(lower_bound(steps.begin(), steps.end(), step) - steps.begin());
+    };
+    // Range of step indices at which each buffer is live
+    vector<pair<size_t, size_t>> live_steps(count);
+    vector<size_t> allocated(steps.size(), 0);
+    vector<size_t> freed(steps.size() + 1, 0);
+    for (size_t id = 0; id < count; id++)
+    {
+        const Buffer& buffer = m_buffers[id];
+        size_t first = step_index(buffer.first);
+        size_t last = buffer.last == numeric_limits<size_t>::max() ? steps.size() - 1
+                                                                    : step_index(buffer.last);
+        live_steps[id] = {first, last};
+        allocated[first] += buffer.size;
+        freed[last + 1] += buffer.size;
+    }
+    vector<size_t> breadth(steps.size());
+    size_t live = 0;
+    for (size_t i = 0; i < steps.size(); i++)
+    {
+        live = live + allocated[i] - freed[i];
+        breadth[i] = live;
+    }
+
+    // Rank the steps from broadest to narrowest, earlier steps first among equals
+    vector<size_t> by_breadth_rank(steps.size());
+    for (size_t i = 0; i < steps.size(); i++)
+    {
+        by_breadth_rank[i] = i;
+    }
+    stable_sort(by_breadth_rank.begin(),
+                by_breadth_rank.end(),
+                [&breadth](size_t a, size_t b) { return breadth[a] > breadth[b]; });
+    vector<size_t> rank(steps.size());
+    for (size_t r = 0; r < steps.size(); r++)
+    {
+        rank[by_breadth_rank[r]] = r;
+    }
+
+    // Each buffer goes with the best ranked step of its lifetime. min_rank[k][i] is the
+    // smallest rank of the steps i through i + 2^k - 1.
+    vector<vector<size_t>> min_rank{rank};
+    for (size_t width = 1; 2 * width <= steps.size(); width *= 2)
+    {
+        const vector<size_t>& previous = min_rank.back();
+        vector<size_t> next(previous.size() - width);
+        for (size_t i = 0; i < next.size(); i++)
+        {
+            next[i] = min(previous[i], previous[i + width]);
+        }
+        min_rank.push_back(move(next));
+    }
+    vector<size_t> buffer_rank(count);
+    for (size_t id = 0; id < count; id++)
+    {
+        size_t length = live_steps[id].second - live_steps[id].first + 1;
+        size_t k = 0;
+        while ((size_t(2) << k) <= length)
+        {
+            k++;
+        }
+        buffer_rank[id] = min(min_rank[k][live_steps[id].first],
+                              min_rank[k][live_steps[id].second + 1 - (size_t(1) << k)]);
+    }
+    vector<size_t> by_breadth(by_size);
+    stable_sort(by_breadth.begin(), by_breadth.end(), [&buffer_rank](size_t a, size_t b) {
+        return buffer_rank[a] < buffer_rank[b];
+    });
+    try_order(by_breadth);
+
+    for (size_t id = 0; id < count; id++)
+    {
+        m_buffers[id].offset = best_offsets[id];
+    }
+}
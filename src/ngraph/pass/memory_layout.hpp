@@ -19,6 +19,7 @@
 #include <limits>
 #include <list>
 #include <sstream>
+#include <vector>
 
 #include "ngraph/pass/pass.hpp"
 
@@ -29,6 +30,7 @@ namespace ngraph
         class MemoryLayout;
         class MemoryNode;
         class MemoryManager;
+        class MemoryPlanner;
     }
 }
 
@@ -95,3 +97,57 @@ private:
     allocation_scheme m_scheme;
     size_t m_max_allocated;
 };
+
+/// \brief Places buffers whose lifetimes are all known before any is placed.
+///
+/// Unlike MemoryManager, which places each buffer when it is allocated, the planner sees every
+/// buffer at once. plan() tries the following orders and keeps the one with the smallest arena:
+/// - allocation order with first fit, the same result as MemoryManager;
+/// - largest buffer first (greedy by size);
+/// - buffers of the steps with the most live bytes first (greedy by breadth).
+/// In the last two orders, each buffer goes into the smallest gap that fits between the placed
+/// buffers whose lifetimes overlap its own. Overlaps and breadths are found by sweeping over the
+/// sorted lifetimes, which avoids comparing pairs of buffers whose lifetimes do not overlap;
+/// every overlapping pair is still visited.
+class ngraph::pass::MemoryPlanner
+{
+public:
+    MemoryPlanner(size_t alignment = 1);
+
+    /// \brief Add a buffer that is live from step first through step last.
+    ///        Buffers must be added in allocation order.
+    /// \returns The id of the buffer
+    size_t add_buffer(size_t size, size_t first, size_t last = std::numeric_limits<size_t>::max());
+    /// \brief Set the last step at which buffer id is live
+    void set_last_use(size_t id, size_t last);
+
+    void plan();
+
+    size_t get_offset(size_t id) const;
+    size_t get_buffer_count() const { return m_buffers.size(); }
+    /// \brief The size of the arena holding every buffer
+    size_t max_allocated() const { return m_max_allocated; }
+    /// \brief The largest number of bytes live at any one step. No placement can use an arena
+    ///        smaller than this.
+    size_t get_lower_bound() const;
+
+private:
+    struct Buffer
+    {
+        size_t size;
+        size_t first;
+        size_t last;
+        size_t offset;
+    };
+
+    size_t place_in_allocation_order(std::vector<size_t>& offsets) const;
+    /// \returns For each buffer, the buffers whose lifetimes overlap its own
+    std::vector<std::vector<size_t>> find_overlaps() const;
+    size_t place_in_order(const std::vector<size_t>& order,
+                          const std::vector<std::vector<size_t>>& overlaps,
+                          std::vector<size_t>& offsets) const;
+
+    std::vector<Buffer> m_buffers;
+    size_t m_alignment;
+    size_t m_max_allocated;
+};
@@ -26,7 +26,8 @@ using namespace ngraph;
 
 bool pass::PropagateCacheability::run_on_function(shared_ptr<Function> function)
 {
-    for (auto& node : function->get_ordered_ops())
+    auto ordered_ops = function->get_shared_ordered_ops();
+    for (auto& node : *ordered_ops)
     {
         if (node->is_op())
         {
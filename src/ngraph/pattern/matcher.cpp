@@ -34,6 +34,36 @@ namespace ngraph
         constexpr NodeTypeInfo op::Skip::type_info;
 
         std::shared_ptr<Node> Matcher::get_match_root() { return m_match_root; }
+        // Returns false if pattern_node can match a graph node of any type
+        static bool collect_root_types(const std::shared_ptr<Node>& pattern_node,
+                                       std::vector<std::type_index>& root_types)
+        {
+            if (!pattern_node || is_type<op::Skip>(pattern_node) ||
+                is_type<op::Any>(pattern_node) || is_type<op::AnyOf>(pattern_node))
+            {
+                return false;
+            }
+            if (is_type<op::Label>(pattern_node))
+            {
+                // A label only restricts its sub-pattern further with its predicate
+                return pattern_node->get_input_size() == 1 &&
+                       collect_root_types(pattern_node->get_argument(0), root_types);
+            }
+            auto p_pattern_node = pattern_node.get();
+            root_types.push_back(std::type_index(typeid(*p_pattern_node)));
+            return true;
+        }
+
+        std::vector<std::type_index> Matcher::get_root_types() const
+        {
+            std::vector<std::type_index> root_types;
+            if (!collect_root_types(m_pattern_node, root_types))
+            {
+                root_types.clear();
+            }
+            return root_types;
+        }
+
         bool Matcher::match_pattern(const std::shared_ptr<op::Label>& label,
                                     const std::shared_ptr<Node>& graph_node,
                                     PatternMap& pattern_map)
@@ -18,6 +18,8 @@
 
 #include <functional>
 #include <memory.h>
+#include <typeindex>
+#include <vector>
 
 #include "ngraph/node.hpp"
 #include "ngraph/op/constant.hpp"
@@ -129,6 +131,13 @@ namespace ngraph
             std::shared_ptr<Node> get_pattern() { return m_pattern_node; }
             std::shared_ptr<Node> get_match_root();
             PatternMap get_pattern_map() { return PatternMap{m_pattern_map}; }
+            /// \brief Returns the types of graph node this matcher can match at its root
+            ///
+            /// The types are derived from the pattern graph. An empty vector means the root can
+            /// be a node of any type, which is the case for a Label without a sub-pattern, Any,
+            /// AnyOf and Skip. Matchers that override match_node should override this too if
+            /// they accept other types at the root.
+            virtual std::vector<std::type_index> get_root_types() const;
             /// \brief Low-level helper to match recurring patterns
             ///
             /// \param graph is a graph to be matched against
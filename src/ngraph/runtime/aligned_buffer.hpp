@@ -40,7 +40,7 @@ public:
     AlignedBuffer(size_t byte_size, size_t alignment, Allocator* allocator = nullptr);
 
     AlignedBuffer();
-    ~AlignedBuffer();
+    virtual ~AlignedBuffer();
 
     AlignedBuffer(AlignedBuffer&& other);
     AlignedBuffer& operator=(AlignedBuffer&& other);
@@ -52,6 +52,7 @@ private:
     AlignedBuffer(const AlignedBuffer&) = delete;
     AlignedBuffer& operator=(const AlignedBuffer&) = delete;
 
+protected:
     Allocator* m_allocator;
     char* m_allocated_buffer;
     char* m_aligned_buffer;
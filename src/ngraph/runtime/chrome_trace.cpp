@@ -14,10 +14,15 @@
 // limitations under the License.
 //*****************************************************************************
 
-#include <iostream>
-#include <map>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "chrome_trace.hpp"
 #include "ngraph/log.hpp"
@@ -32,176 +37,638 @@ static bool read_tracing_env_var()
     return is_enabled;
 }
 
-mutex runtime::event::Manager::s_file_mutex;
 bool runtime::event::Manager::s_tracing_enabled = read_tracing_env_var();
 
-runtime::event::Duration::Duration(const string& name, const string& category, const string& args)
+struct runtime::event::Manager::Record
 {
-    if (Manager::is_tracing_enabled())
+    uint64_t timestamp;
+    // The duration of an 'X' event or the id of an object event
+    uint64_t value;
+    uint32_t name;
+    uint32_t category;
+    // An interned JSON object, 0 for none. Ignored if inline_args_size is not 0.
+    uint32_t args;
+    // The id of the trace file, 0 for the default one
+    uint32_t file;
+    uint8_t phase;
+    uint8_t inline_args_size;
+    // Args that often differ from event to event, copied rather than interned
+    char inline_args[max_inline_args];
+};
+
+// A ring buffer written only by its thread and drained only by the flusher, so each index is
+// written by one side and read by the other
+class runtime::event::Manager::ThreadBuffer
+{
+public:
+    explicit ThreadBuffer(uint32_t thread_index)
+        : m_records(s_capacity)
+        , m_thread_index(thread_index)
     {
-        m_start = Manager::get_current_microseconds();
-        m_stop = 0;
-        m_name = name;
-        m_category = category;
-        m_args = args;
     }
-}
 
-void runtime::event::Duration::stop()
+    void push(const Record& record)
+    {
+        uint64_t head = m_head.load(memory_order_relaxed);
+        if (head - m_tail.load(memory_order_acquire) == s_capacity)
+        {
+            m_dropped.store(m_dropped.load(memory_order_relaxed) + 1, memory_order_relaxed);
+            return;
+        }
+        m_records[head & (s_capacity - 1)] = record;
+        m_head.store(head + 1, memory_order_release);
+    }
+
+    template <typename F>
+    void drain(F f)
+    {
+        uint64_t head = m_head.load(memory_order_acquire);
+        uint64_t tail = m_tail.load(memory_order_relaxed);
+        for (; tail != head; tail++)
+        {
+            f(m_records[tail & (s_capacity - 1)]);
+        }
+        m_tail.store(tail, memory_order_release);
+    }
+
+    bool is_empty() const
+    {
+        return m_head.load(memory_order_acquire) == m_tail.load(memory_order_relaxed);
+    }
+    uint32_t get_thread_index() const { return m_thread_index; }
+    size_t get_dropped_count() const { return m_dropped.load(memory_order_relaxed); }
+    // Set when the thread exits, after which the buffer is released once it is drained
+    atomic<bool> m_thread_exited{false};
+
+private:
+    // 2MB per thread holds 10ms of events at over a million events per second
+    static constexpr size_t s_capacity = 1 << 14;
+    vector<Record> m_records;
+    const uint32_t m_thread_index;
+    atomic<uint64_t> m_head{0};
+    atomic<uint64_t> m_tail{0};
+    atomic<size_t> m_dropped{0};
+};
+
+constexpr size_t runtime::event::Manager::ThreadBuffer::s_capacity;
+constexpr const char* runtime::event::Manager::default_trace_path;
+constexpr size_t runtime::event::Manager::max_inline_args;
+
+namespace
 {
-    if (Manager::is_tracing_enabled())
+    // Set while the flusher has any trace file open
+    atomic<bool> s_trace_open{false};
+    // Set while the default trace file is open
+    atomic<bool> s_default_open{false};
+    // Set by close() until the next open, so that later events are dropped rather than
+    // truncating the default file by reopening it
+    atomic<bool> s_closed{false};
+
+    // Never destroyed, so events recorded during static destruction still find their strings
+    struct StringTable
+    {
+        mutex m_mutex;
+        unordered_map<string, uint32_t> m_ids{{"", 0}};
+        deque<string> m_strings{""};
+    };
+
+    StringTable& get_string_table()
     {
-        m_stop = Manager::get_current_microseconds();
+        static StringTable* s_string_table = new StringTable();
+        return *s_string_table;
+    }
+
+    void append_json_string(string& out, const string& str)
+    {
+        out += '"';
+        for (char c : str)
+        {
+            if (c == '"' || c == '\\')
+            {
+                out += '\\';
+                out += c;
+            }
+            else if (static_cast<unsigned char>(c) < 0x20)
+            {
+                out += ' ';
+            }
+            else
+            {
+                out += c;
+            }
+        }
+        out += '"';
+    }
+
+    // Copies args to a buffer of max_inline_args bytes, or a note if they do not fit, and
+    // returns the size copied
+    uint8_t copy_inline_args(char* buffer, const string& args)
+    {
+        static const string s_too_long = R"({"note":"args longer than )" +
+                                         to_string(runtime::event::Manager::max_inline_args) +
+                                         R"( bytes left out"})";
+        const string& copied = args.size() <= runtime::event::Manager::max_inline_args
+                                   ? args
+                                   : s_too_long;
+        memcpy(buffer, copied.data(), copied.size());
+        return static_cast<uint8_t>(copied.size());
+    }
+
+    // Chrome trace timestamps are in microseconds and may have a fraction
+    void append_microseconds(string& out, uint64_t nanoseconds)
+    {
+        uint64_t fraction = nanoseconds % 1000;
+        out += to_string(nanoseconds / 1000);
+        out += '.';
+        out += static_cast<char>('0' + fraction / 100);
+        out += static_cast<char>('0' + fraction / 10 % 10);
+        out += static_cast<char>('0' + fraction % 10);
     }
 }
 
-void runtime::event::Duration::write()
+// Owns the thread buffers and the trace file, and drains the buffers to the file on a
+// background thread while the file is open
+class runtime::event::Manager::Flusher
 {
-    if (Manager::is_tracing_enabled())
+public:
+    static Flusher& get()
     {
-        size_t stop_time = (m_stop != 0 ? m_stop : Manager::get_current_microseconds());
+        static Flusher s_flusher;
+        return s_flusher;
+    }
 
-        lock_guard<mutex> lock(Manager::get_mutex());
+    ~Flusher() { close(); }
+    // Opens the default trace file. A default file open at another path is closed first if
+    // replace is set and kept otherwise.
+    void open_default(const string& path, bool replace)
+    {
+        lock_guard<mutex> lock(m_file_mutex);
+        TraceFile& file = m_files[0];
+        if (file.m_out.is_open())
+        {
+            if (!replace || file.m_path == path)
+            {
+                return;
+            }
+            drain();
+            finish(file);
+        }
+        start(file, path);
+        s_default_open.store(true, memory_order_release);
+    }
 
-        ofstream& out = runtime::event::Manager::get_output_stream();
-        if (out.is_open() == false)
+    uint32_t open_file(const string& path)
+    {
+        lock_guard<mutex> lock(m_file_mutex);
+        for (size_t i = 0; i < m_files.size(); i++)
         {
-            runtime::event::Manager::open();
+            if (m_files[i].m_out.is_open() && m_files[i].m_path == path)
+            {
+                return static_cast<uint32_t>(i);
+            }
         }
-        else
+        // Ids are not reused, so events of a closed file never reach a later one
+        m_files.emplace_back();
+        start(m_files.back(), path);
+        return static_cast<uint32_t>(m_files.size() - 1);
+    }
+
+    void close()
+    {
         {
-            Manager::get_output_stream() << ",\n";
+            lock_guard<mutex> lock(m_file_mutex);
+            if (!m_thread.joinable() || m_stop)
+            {
+                return;
+            }
+            m_stop = true;
+            s_closed.store(true, memory_order_release);
+            s_default_open.store(false, memory_order_release);
+            s_trace_open.store(false, memory_order_release);
         }
+        m_condition.notify_all();
+        m_thread.join();
 
-        Manager::get_output_stream() <<
-            R"({"name":")" << m_name << R"(","cat":")" << m_category << R"(","ph":"X","pid":)"
-                                     << Manager::get_process_id() << R"(,"tid":)"
-                                     << Manager::get_thread_id() <<
-            R"(,"ts":)" << m_start << R"(,"dur":)" << (stop_time - m_start);
-        if (!m_args.empty())
+        lock_guard<mutex> lock(m_file_mutex);
+        drain();
+        for (TraceFile& file : m_files)
         {
-            out <<
-                R"(,"args":)" << m_args;
+            if (file.m_out.is_open())
+            {
+                finish(file);
+            }
         }
-        out << "}";
     }
-}
 
-runtime::event::Object::Object(const string& name, const string& args)
-    : m_name{name}
-    , m_id{static_cast<size_t>(chrono::high_resolution_clock::now().time_since_epoch().count())}
-{
-    if (Manager::is_tracing_enabled())
+    void flush()
     {
-        lock_guard<mutex> lock(Manager::get_mutex());
+        lock_guard<mutex> lock(m_file_mutex);
+        drain();
+        for (TraceFile& file : m_files)
+        {
+            if (file.m_out.is_open())
+            {
+                file.m_out.flush();
+            }
+        }
+    }
+
+    shared_ptr<ThreadBuffer> add_thread_buffer()
+    {
+        lock_guard<mutex> lock(m_buffers_mutex);
+        m_buffers.push_back(make_shared<ThreadBuffer>(m_next_thread_index++));
+        return m_buffers.back();
+    }
 
-        ofstream& out = runtime::event::Manager::get_output_stream();
-        if (out.is_open() == false)
+    size_t get_dropped_count()
+    {
+        lock_guard<mutex> lock(m_buffers_mutex);
+        size_t dropped = m_released_dropped_count;
+        for (const shared_ptr<ThreadBuffer>& buffer : m_buffers)
         {
-            runtime::event::Manager::open();
+            dropped += buffer->get_dropped_count();
         }
-        else
+        return dropped;
+    }
+
+private:
+    struct TraceFile
+    {
+        string m_path;
+        ofstream m_out;
+        string m_text;
+        bool m_first_event = true;
+    };
+
+    // The default trace file is always the first
+    Flusher()
+        : m_files(1)
+    {
+    }
+
+    // Must be called with m_file_mutex held
+    void start(TraceFile& file, const string& path)
+    {
+        file.m_path = path;
+        file.m_out.open(path, ios_base::trunc);
+        file.m_out << "[\n";
+        file.m_first_event = true;
+        if (!m_thread.joinable())
         {
-            Manager::get_output_stream() << ",\n";
+            m_stop = false;
+            m_thread = thread(&Flusher::run, this);
         }
-        out << R"({"name":")" << m_name << R"(","ph":"N","id":")" << m_id <<
-            R"(","ts":)" << Manager::get_current_microseconds() <<
-            R"(,"pid":)" << Manager::get_process_id() << R"(,"tid":)" << Manager::get_thread_id();
-        if (!args.empty())
+        s_closed.store(false, memory_order_release);
+        s_trace_open.store(true, memory_order_release);
+    }
+
+    // Must be called with m_file_mutex held and the buffers drained
+    void finish(TraceFile& file)
+    {
+        file.m_out << "\n]\n";
+        file.m_out.close();
+    }
+
+    void run()
+    {
+        unique_lock<mutex> lock(m_file_mutex);
+        while (!m_stop)
+        {
+            m_condition.wait_for(lock, chrono::milliseconds(10));
+            drain();
+        }
+    }
+
+    // Must be called with m_file_mutex held
+    void drain()
+    {
+        vector<shared_ptr<ThreadBuffer>> buffers;
+        {
+            lock_guard<mutex> lock(m_buffers_mutex);
+            buffers = m_buffers;
+        }
+
+        {
+            StringTable& strings = get_string_table();
+            lock_guard<mutex> lock(strings.m_mutex);
+            for (const shared_ptr<ThreadBuffer>& buffer : buffers)
+            {
+                buffer->drain([&](const Record& record) {
+                    // Events of a file closed since they were recorded are dropped
+                    if (record.file < m_files.size() && m_files[record.file].m_out.is_open())
+                    {
+                        append_record(m_files[record.file],
+                                      record,
+                                      buffer->get_thread_index(),
+                                      strings.m_strings);
+                    }
+                });
+            }
+        }
+        for (TraceFile& file : m_files)
         {
-            out <<
-                R"(,"args":)" << args;
+            file.m_out.write(file.m_text.data(), file.m_text.size());
+            file.m_text.clear();
         }
-        out << "}";
 
-        write_snapshot(out, args);
+        lock_guard<mutex> lock(m_buffers_mutex);
+        for (auto it = m_buffers.begin(); it != m_buffers.end();)
+        {
+            if ((*it)->m_thread_exited && (*it)->is_empty())
+            {
+                m_released_dropped_count += (*it)->get_dropped_count();
+                it = m_buffers.erase(it);
+            }
+            else
+            {
+                it++;
+            }
+        }
     }
-}
 
-void runtime::event::Object::snapshot(const string& args)
-{
-    if (Manager::is_tracing_enabled())
+    void append_record(TraceFile& file,
+                       const Record& record,
+                       uint32_t thread_index,
+                       const deque<string>& strings)
     {
-        lock_guard<mutex> lock(Manager::get_mutex());
+        string& text = file.m_text;
+        if (!file.m_first_event)
+        {
+            text += ",\n";
+        }
+        file.m_first_event = false;
 
-        ofstream& out = runtime::event::Manager::get_output_stream();
-        if (out.is_open() == false)
+        text += R"({"name":)";
+        append_json_string(text, strings[record.name]);
+        if (record.phase == 'X')
+        {
+            text += R"(,"cat":)";
+            append_json_string(text, strings[record.category]);
+        }
+        text += R"(,"ph":")";
+        text += static_cast<char>(record.phase);
+        text += R"(","pid":)" + s_pid + R"(,"tid":)" + to_string(thread_index) + R"(,"ts":)";
+        append_microseconds(text, record.timestamp);
+        if (record.phase == 'X')
         {
-            runtime::event::Manager::open();
+            text += R"(,"dur":)";
+            append_microseconds(text, record.value);
         }
         else
         {
-            Manager::get_output_stream() << ",\n";
+            text += R"(,"id":")" + to_string(record.value) + '"';
+        }
+        if (record.inline_args_size != 0)
+        {
+            text += R"(,"args":)";
+            text.append(record.inline_args, record.inline_args_size);
         }
-        write_snapshot(out, args);
+        else if (record.args != 0)
+        {
+            text += R"(,"args":)";
+            text += strings[record.args];
+        }
+        text += "}";
     }
+
+    static const string s_pid;
+    mutex m_buffers_mutex;
+    vector<shared_ptr<ThreadBuffer>> m_buffers;
+    uint32_t m_next_thread_index = 1;
+    size_t m_released_dropped_count = 0;
+
+    mutex m_file_mutex;
+    condition_variable m_condition;
+    // Indexed by file id
+    deque<TraceFile> m_files;
+    bool m_stop = false;
+    thread m_thread;
+};
+
+const string runtime::event::Manager::Flusher::s_pid = to_string(getpid());
+
+// Keeps the buffer of a thread alive until the flusher drained it after the thread exits
+struct runtime::event::Manager::ThreadBufferHolder
+{
+    ~ThreadBufferHolder()
+    {
+        if (m_buffer)
+        {
+            m_buffer->m_thread_exited = true;
+        }
+    }
+    shared_ptr<ThreadBuffer> m_buffer;
+};
+
+void runtime::event::Manager::record(const Record& record)
+{
+    static_assert(sizeof(Record) == 128, "A trace record should fill two cache lines");
+    // A plain pointer is cheaper to reach than the holder, which has a destructor
+    static thread_local ThreadBuffer* s_buffer = nullptr;
+    if (record.file == 0 ? !s_default_open.load(memory_order_acquire)
+                         : !s_trace_open.load(memory_order_acquire))
+    {
+        // Events before the first open go to the default path, but none after a close()
+        if (record.file != 0 || s_closed.load(memory_order_acquire))
+        {
+            return;
+        }
+        Flusher::get().open_default(default_trace_path, false);
+    }
+    if (s_buffer == nullptr)
+    {
+        static thread_local ThreadBufferHolder s_holder;
+        s_holder.m_buffer = Flusher::get().add_thread_buffer();
+        s_buffer = s_holder.m_buffer.get();
+    }
+    s_buffer->push(record);
+}
+
+void runtime::event::Manager::record_duration(uint32_t name,
+                                              uint32_t category,
+                                              uint32_t args,
+                                              uint64_t start_nanoseconds,
+                                              uint64_t duration_nanoseconds,
+                                              uint32_t file)
+{
+    Record record;
+    record.timestamp = start_nanoseconds;
+    record.value = duration_nanoseconds;
+    record.name = name;
+    record.category = category;
+    record.args = args;
+    record.file = file;
+    record.phase = 'X';
+    record.inline_args_size = 0;
+    Manager::record(record);
+}
+
+void runtime::event::Manager::record_duration(uint32_t name,
+                                              uint32_t category,
+                                              const string& args,
+                                              uint64_t start_nanoseconds,
+                                              uint64_t duration_nanoseconds,
+                                              uint32_t file)
+{
+    Record record;
+    record.timestamp = start_nanoseconds;
+    record.value = duration_nanoseconds;
+    record.name = name;
+    record.category = category;
+    record.args = 0;
+    record.file = file;
+    record.phase = 'X';
+    record.inline_args_size = copy_inline_args(record.inline_args, args);
+    Manager::record(record);
 }
 
-void runtime::event::Object::write_snapshot(ostream& out, const string& args)
+uint32_t runtime::event::Manager::intern(const string& str)
 {
-    out << R"({"name":")" << m_name << R"(","ph":"O","id":")" << m_id <<
-        R"(","ts":)" << Manager::get_current_microseconds() <<
-        R"(,"pid":)" << Manager::get_process_id() << R"(,"tid":)" << Manager::get_thread_id();
-    if (!args.empty())
+    static thread_local unordered_map<string, uint32_t> s_cache;
+    auto it = s_cache.find(str);
+    if (it != s_cache.end())
     {
-        out <<
-            R"(,"args":)" << args;
+        return it->second;
     }
-    out << "}";
+
+    StringTable& strings = get_string_table();
+    lock_guard<mutex> lock(strings.m_mutex);
+    auto inserted = strings.m_ids.insert({str, static_cast<uint32_t>(strings.m_strings.size())});
+    if (inserted.second)
+    {
+        strings.m_strings.push_back(str);
+    }
+    s_cache.insert(*inserted.first);
+    return inserted.first->second;
 }
 
-void runtime::event::Object::destroy()
+size_t runtime::event::Manager::get_dropped_count()
+{
+    return Flusher::get().get_dropped_count();
+}
+
+runtime::event::Duration::Duration(const string& name, const string& category, const string& args)
 {
     if (Manager::is_tracing_enabled())
     {
-        lock_guard<mutex> lock(Manager::get_mutex());
+        m_name = Manager::intern(name);
+        m_category = Manager::intern(category);
+        m_args_size = copy_inline_args(m_args, args);
+        m_start = Manager::get_current_nanoseconds();
+    }
+    else
+    {
+        m_written = true;
+    }
+}
 
-        ofstream& out = runtime::event::Manager::get_output_stream();
-        if (out.is_open() == false)
-        {
-            runtime::event::Manager::open();
-        }
-        else
-        {
-            Manager::get_output_stream() << ",\n";
-        }
-        out << R"({"name":")" << m_name << R"(","ph":"D","id":")" << m_id <<
-            R"(","ts":)" << Manager::get_current_microseconds() <<
-            R"(,"pid":)" << Manager::get_process_id() << R"(,"tid":)" << Manager::get_thread_id()
-            << "}";
+runtime::event::Duration::Duration(uint32_t name, uint32_t category, const string& args)
+    : m_name(name)
+    , m_category(category)
+{
+    if (Manager::is_tracing_enabled())
+    {
+        m_args_size = copy_inline_args(m_args, args);
+        m_start = Manager::get_current_nanoseconds();
+    }
+    else
+    {
+        m_written = true;
     }
 }
 
-void runtime::event::Manager::open(const string& path)
+void runtime::event::Duration::stop()
 {
-    ofstream& out = get_output_stream();
-    if (out.is_open() == false)
+    if (!m_written)
     {
-        out.open(path, ios_base::trunc);
-        out << "[\n";
+        m_stop = Manager::get_current_nanoseconds();
     }
 }
 
-void runtime::event::Manager::close()
+void runtime::event::Duration::write()
 {
-    ofstream& out = get_output_stream();
-    if (out.is_open())
+    if (!m_written)
     {
-        out << "\n]\n";
-        out.close();
+        uint64_t stop_time = (m_stop != 0 ? m_stop : Manager::get_current_nanoseconds());
+        Manager::Record record;
+        record.timestamp = m_start;
+        record.value = stop_time - m_start;
+        record.name = m_name;
+        record.category = m_category;
+        record.args = 0;
+        record.file = 0;
+        record.phase = 'X';
+        record.inline_args_size = m_args_size;
+        memcpy(record.inline_args, m_args, m_args_size);
+        Manager::record(record);
+        m_written = true;
     }
 }
 
-ofstream& runtime::event::Manager::get_output_stream()
+runtime::event::Object::Object(const string& name, const string& args)
+    : m_name{name}
+    , m_id{static_cast<size_t>(chrono::high_resolution_clock::now().time_since_epoch().count())}
 {
-    static ofstream s_event_log;
-    return s_event_log;
+    if (Manager::is_tracing_enabled())
+    {
+        write_event('N', args);
+        write_snapshot(args);
+    }
 }
 
-const string& runtime::event::Manager::get_process_id()
+void runtime::event::Object::snapshot(const string& args)
 {
-    static const string s_pid = to_string(getpid());
-    return s_pid;
+    if (Manager::is_tracing_enabled())
+    {
+        write_snapshot(args);
+    }
+}
+
+void runtime::event::Object::write_snapshot(const string& args)
+{
+    write_event('O', args);
+}
+
+void runtime::event::Object::destroy()
+{
+    if (Manager::is_tracing_enabled())
+    {
+        write_event('D', "");
+    }
+}
+
+void runtime::event::Object::write_event(char phase, const string& args)
+{
+    Manager::Record record;
+    record.timestamp = Manager::get_current_nanoseconds();
+    record.value = m_id;
+    record.name = Manager::intern(m_name);
+    record.category = 0;
+    record.args = 0;
+    record.file = 0;
+    record.phase = static_cast<uint8_t>(phase);
+    record.inline_args_size = copy_inline_args(record.inline_args, args);
+    Manager::record(record);
+}
+
+void runtime::event::Manager::open(const string& path)
+{
+    Flusher::get().open_default(path, true);
+}
+
+uint32_t runtime::event::Manager::open_file(const string& path)
+{
+    return Flusher::get().open_file(path);
+}
+
+void runtime::event::Manager::close()
+{
+    Flusher::get().close();
+}
+
+void runtime::event::Manager::flush()
+{
+    Flusher::get().flush();
 }
 
 void runtime::event::Manager::enable_event_tracing()
@@ -218,23 +685,3 @@ bool runtime::event::Manager::is_event_tracing_enabled()
 {
     return s_tracing_enabled;
 }
-
-string runtime::event::Manager::get_thread_id()
-{
-    thread::id tid = this_thread::get_id();
-    static map<thread::id, string> tid_map;
-    auto it = tid_map.find(tid);
-    string rc;
-    if (it == tid_map.end())
-    {
-        stringstream ss;
-        ss << "\"" << tid << "\"";
-        rc = ss.str();
-        tid_map.insert({tid, rc});
-    }
-    else
-    {
-        rc = it->second;
-    }
-    return rc;
-}
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
 #include <mutex>
@@ -75,39 +76,90 @@ namespace ngraph
 // More information about this is at:
 // http://dev.chromium.org/developers/how-tos/trace-event-profiling-tool
 
+//
+// Events are recorded as binary records in a ring buffer of the recording thread, which only
+// that thread writes, so recording takes no lock. A background thread drains the buffers into
+// the trace files every few milliseconds. Names, categories and args that repeat are interned
+// to ids, and a thread looks up strings it used before in its own cache. Args that differ from
+// event to event are copied into a fixed buffer in the record, so recording never allocates.
+// When a buffer is full because the flusher fell behind, its events are dropped and counted
+// rather than waited for.
+
 class ngraph::runtime::event::Manager
 {
     friend class Duration;
     friend class Object;
 
 public:
-    static void open(const std::string& path = "runtime_event_trace.json");
+    static constexpr const char* default_trace_path = "runtime_event_trace.json";
+    /// \brief The longest args that Duration and Object copy into an event. Longer args are
+    ///        replaced by a note that they were left out.
+    static constexpr size_t max_inline_args = 94;
+
+    /// \brief Opens the default trace file and starts the flusher, closing a default file
+    ///        open at another path first. Events recorded before the first open() are written
+    ///        to default_trace_path; events recorded after close() are dropped.
+    static void open(const std::string& path = default_trace_path);
+    /// \brief Opens a trace file of its own for the events recorded with the returned id,
+    ///        such as the timeline of one function. Opening a path that is open returns its id.
+    static uint32_t open_file(const std::string& path);
+    /// \brief Stops the flusher, writes the events recorded so far and closes the trace files
     static void close();
+    /// \brief Writes the events recorded so far to the trace files
+    static void flush();
     static bool is_tracing_enabled() { return s_tracing_enabled; }
     static void enable_event_tracing();
     static void disable_event_tracing();
     static bool is_event_tracing_enabled();
 
-private:
-    static std::ofstream& get_output_stream();
-    static const std::string& get_process_id();
-    static size_t get_current_microseconds()
+    /// \brief The id of a name, category or args string. Interned strings live until exit.
+    static uint32_t intern(const std::string& str);
+    /// \brief Records a complete event on the buffer of this thread, whether or not tracing
+    ///        is enabled
+    /// \param args The id from intern() of a JSON object, or 0 for none
+    /// \param file An id from open_file(), or 0 for the default trace file
+    static void record_duration(uint32_t name,
+                                uint32_t category,
+                                uint32_t args,
+                                uint64_t start_nanoseconds,
+                                uint64_t duration_nanoseconds,
+                                uint32_t file = 0);
+    /// \brief Records a complete event with args that differ from event to event, which are
+    ///        copied into the event like those of Duration
+    static void record_duration(uint32_t name,
+                                uint32_t category,
+                                const std::string& args,
+                                uint64_t start_nanoseconds,
+                                uint64_t duration_nanoseconds,
+                                uint32_t file = 0);
+    static uint64_t get_current_nanoseconds()
     {
-        return std::chrono::high_resolution_clock::now().time_since_epoch().count() / 1000;
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
     }
-    static std::string get_thread_id();
-    static std::mutex& get_mutex() { return s_file_mutex; }
-    static std::ostream s_ostream;
-    static std::mutex s_file_mutex;
+    /// \brief The number of events dropped because a buffer was full
+    static size_t get_dropped_count();
+
+private:
+    struct Record;
+    class ThreadBuffer;
+    struct ThreadBufferHolder;
+    class Flusher;
+
+    static void record(const Record& record);
     static bool s_tracing_enabled;
 };
 
 class ngraph::runtime::event::Duration
 {
 public:
+    /// \param args A JSON object of at most Manager::max_inline_args bytes, or empty for none
     explicit Duration(const std::string& name,
                       const std::string& category,
                       const std::string& args = "");
+    /// \brief An event with interned strings, for callers that record the same events often
+    Duration(uint32_t name, uint32_t category, const std::string& args = "");
     ~Duration() { write(); }
     /// \brief stop the timer without writing the data to the log file. To write the data
     /// call the `write` method
@@ -122,12 +174,13 @@ public:
     Duration& operator=(Duration const&) = delete;
 
 private:
-    std::string to_json() const;
-    size_t m_start{0};
-    size_t m_stop{0};
-    std::string m_name;
-    std::string m_category;
-    std::string m_args;
+    uint64_t m_start{0};
+    uint64_t m_stop{0};
+    uint32_t m_name{0};
+    uint32_t m_category{0};
+    bool m_written{false};
+    uint8_t m_args_size{0};
+    char m_args[Manager::max_inline_args];
 };
 
 class ngraph::runtime::event::Object
@@ -138,7 +191,8 @@ public:
     void destroy();
 
 private:
-    void write_snapshot(std::ostream& out, const std::string& args);
+    void write_snapshot(const std::string& args);
+    void write_event(char phase, const std::string& args);
     const std::string m_name;
     size_t m_id{0};
 };
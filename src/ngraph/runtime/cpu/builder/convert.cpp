@@ -27,81 +27,78 @@ namespace ngraph
     {
         namespace cpu
         {
-            template <>
-            void Builder::BUILDER_DECL(ngraph::op::Convert)
+            static std::function<decltype(runtime::cpu::kernel::convert<float, int>)>
+                get_convert_kernel(const element::Type& input_type,
+                                   const element::Type& output_type)
             {
-                (void)node;
-                auto& functors = external_function->get_functors();
-
-                auto arg_buffer_index = external_function->get_buffer_index(args[0].get_name());
-                auto out_buffer_index = external_function->get_buffer_index(out[0].get_name());
-
-                auto element_count = out[0].get_size();
-
                 std::function<decltype(runtime::cpu::kernel::convert<float, int>)> kernel;
 
-                if (out[0].get_element_type() == element::boolean)
+                if (output_type == element::boolean)
                 {
-                    SELECT_KERNEL(
-                        kernel, args[0].get_element_type(), runtime::cpu::kernel::convert_to_bool)
+                    SELECT_KERNEL(kernel, input_type, runtime::cpu::kernel::convert_to_bool)
                 }
-                else if (out[0].get_element_type() == element::f32)
+                else if (output_type == element::f32)
                 {
-                    SELECT_KERNEL(kernel,
-                                  args[0].get_element_type(),
-                                  runtime::cpu::kernel::convert_to_float32)
+                    SELECT_KERNEL(kernel, input_type, runtime::cpu::kernel::convert_to_float32)
                 }
-                else if (out[0].get_element_type() == element::f64)
+                else if (output_type == element::f64)
                 {
-                    SELECT_KERNEL(kernel,
-                                  args[0].get_element_type(),
-                                  runtime::cpu::kernel::convert_to_float64)
+                    SELECT_KERNEL(kernel, input_type, runtime::cpu::kernel::convert_to_float64)
                 }
-                else if (out[0].get_element_type() == element::i8)
+                else if (output_type == element::i8)
                 {
-                    SELECT_KERNEL(
-                        kernel, args[0].get_element_type(), runtime::cpu::kernel::convert_to_i8)
+                    SELECT_KERNEL(kernel, input_type, runtime::cpu::kernel::convert_to_i8)
                 }
-                else if (out[0].get_element_type() == element::i16)
+                else if (output_type == element::i16)
                 {
-                    SELECT_KERNEL(
-                        kernel, args[0].get_element_type(), runtime::cpu::kernel::convert_to_i16)
+                    SELECT_KERNEL(kernel, input_type, runtime::cpu::kernel::convert_to_i16)
                 }
-                else if (out[0].get_element_type() == element::i32)
+                else if (output_type == element::i32)
                 {
-                    SELECT_KERNEL(
-                        kernel, args[0].get_element_type(), runtime::cpu::kernel::convert_to_i32)
+                    SELECT_KERNEL(kernel, input_type, runtime::cpu::kernel::convert_to_i32)
                 }
-                else if (out[0].get_element_type() == element::i64)
+                else if (output_type == element::i64)
                 {
-                    SELECT_KERNEL(
-                        kernel, args[0].get_element_type(), runtime::cpu::kernel::convert_to_i64)
+                    SELECT_KERNEL(kernel, input_type, runtime::cpu::kernel::convert_to_i64)
                 }
-                else if (out[0].get_element_type() == element::u8)
+                else if (output_type == element::u8)
                 {
-                    SELECT_KERNEL(
-                        kernel, args[0].get_element_type(), runtime::cpu::kernel::convert_to_u8)
+                    SELECT_KERNEL(kernel, input_type, runtime::cpu::kernel::convert_to_u8)
                 }
-                else if (out[0].get_element_type() == element::u16)
+                else if (output_type == element::u16)
                 {
-                    SELECT_KERNEL(
-                        kernel, args[0].get_element_type(), runtime::cpu::kernel::convert_to_u16)
+                    SELECT_KERNEL(kernel, input_type, runtime::cpu::kernel::convert_to_u16)
                 }
-                else if (out[0].get_element_type() == element::u32)
+                else if (output_type == element::u32)
                 {
-                    SELECT_KERNEL(
-                        kernel, args[0].get_element_type(), runtime::cpu::kernel::convert_to_u32)
+                    SELECT_KERNEL(kernel, input_type, runtime::cpu::kernel::convert_to_u32)
                 }
-                else if (out[0].get_element_type() == element::u64)
+                else if (output_type == element::u64)
                 {
-                    SELECT_KERNEL(
-                        kernel, args[0].get_element_type(), runtime::cpu::kernel::convert_to_u64)
+                    SELECT_KERNEL(kernel, input_type, runtime::cpu::kernel::convert_to_u64)
                 }
                 else
                 {
                     throw ngraph_error("Cannot convert from an invalid input element type");
                 }
 
+                return kernel;
+            }
+
+            template <>
+            void Builder::BUILDER_DECL(ngraph::op::Convert)
+            {
+                (void)node;
+                auto& functors = external_function->get_functors();
+
+                auto arg_buffer_index = external_function->get_buffer_index(args[0].get_name());
+                auto out_buffer_index = external_function->get_buffer_index(out[0].get_name());
+
+                auto element_count = out[0].get_size();
+
+                auto kernel =
+                    get_convert_kernel(args[0].get_element_type(), out[0].get_element_type());
+
                 auto functor = [&, kernel, element_count, arg_buffer_index, out_buffer_index](
                     CPURuntimeContext* ctx, CPUExecutionContext* ectx) {
                     if (ctx->buffer_data[arg_buffer_index] != ctx->buffer_data[out_buffer_index])
@@ -115,7 +112,36 @@ namespace ngraph
                 functors.emplace_back(functor);
             }
 
-            void register_builders_convert_cpp() { REGISTER_OP_BUILDER(Convert); }
+            template <>
+            NodeExecutorTy Builder::BUILDER_CF_DECL(ngraph::op::Convert)
+            {
+                const element::Type& input_type = node->get_input_element_type(0);
+                const element::Type& output_type = node->get_output_element_type(0);
+                // There are no CPU kernels for these types, so constant folding uses the
+                // reference kernel
+                for (const element::Type& type : {input_type, output_type})
+                {
+                    if (type == element::bf16 || type == element::f16)
+                    {
+                        return nullptr;
+                    }
+                }
+
+                auto kernel = get_convert_kernel(input_type, output_type);
+                auto element_count = shape_size(node->get_shape());
+
+                auto functor = [kernel, element_count](const std::vector<void*>& inputs,
+                                                       std::vector<void*>& outputs) {
+                    kernel(inputs[0], outputs[0], element_count, 0);
+                };
+                return functor;
+            }
+
+            void register_builders_convert_cpp()
+            {
+                REGISTER_CF_BUILDER(Convert);
+                REGISTER_OP_BUILDER(Convert);
+            }
         }
     }
 }
@@ -0,0 +1,232 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+
+#include "ngraph/op/abs.hpp"
+#include "ngraph/op/add.hpp"
+#include "ngraph/op/divide.hpp"
+#include "ngraph/op/exp.hpp"
+#include "ngraph/op/log.hpp"
+#include "ngraph/op/maximum.hpp"
+#include "ngraph/op/minimum.hpp"
+#include "ngraph/op/multiply.hpp"
+#include "ngraph/op/negative.hpp"
+#include "ngraph/op/relu.hpp"
+#include "ngraph/op/sigmoid.hpp"
+#include "ngraph/op/sqrt.hpp"
+#include "ngraph/op/subtract.hpp"
+#include "ngraph/op/tanh.hpp"
+#include "ngraph/runtime/cpu/cpu_builder.hpp"
+#include "ngraph/runtime/cpu/kernel/loop_kernel.hpp"
+#include "ngraph/runtime/cpu/op/loop_kernel.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+#define TI(x) type_index(typeid(x))
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            static const unordered_map<type_index, kernel::loop::Opcode>& get_loop_opcodes()
+            {
+                static const unordered_map<type_index, kernel::loop::Opcode> opcodes{
+                    {TI(ngraph::op::Abs), kernel::loop::Opcode::Abs},
+                    {TI(ngraph::op::Add), kernel::loop::Opcode::Add},
+                    {TI(ngraph::op::Divide), kernel::loop::Opcode::Divide},
+                    {TI(ngraph::op::Exp), kernel::loop::Opcode::Exp},
+                    {TI(ngraph::op::Log), kernel::loop::Opcode::Log},
+                    {TI(ngraph::op::Maximum), kernel::loop::Opcode::Maximum},
+                    {TI(ngraph::op::Minimum), kernel::loop::Opcode::Minimum},
+                    {TI(ngraph::op::Multiply), kernel::loop::Opcode::Multiply},
+                    {TI(ngraph::op::Negative), kernel::loop::Opcode::Negative},
+                    {TI(ngraph::op::Relu), kernel::loop::Opcode::Relu},
+                    {TI(ngraph::op::Sigmoid), kernel::loop::Opcode::Sigmoid},
+                    {TI(ngraph::op::Sqrt), kernel::loop::Opcode::Sqrt},
+                    {TI(ngraph::op::Subtract), kernel::loop::Opcode::Subtract},
+                    {TI(ngraph::op::Tanh), kernel::loop::Opcode::Tanh}};
+                return opcodes;
+            }
+
+            static kernel::loop::Program
+                build_loop_program(const ngraph::runtime::cpu::op::LoopKernel& loop_kernel)
+            {
+                using BroadcastKind = ngraph::runtime::cpu::op::LoopKernel::BroadcastKind;
+                kernel::loop::Program program;
+                program.count = shape_size(loop_kernel.get_output_shape(0));
+
+                unordered_map<const Node*, size_t> parameter_index;
+                const ParameterVector& parameters = loop_kernel.get_kernel_parameters();
+                for (size_t i = 0; i < parameters.size(); i++)
+                {
+                    parameter_index[parameters[i].get()] = i;
+                }
+
+                // Inputs are numbered first, then instruction results
+                unordered_map<const Node*, size_t> input_value;
+                for (const shared_ptr<Node>& node : loop_kernel.get_node_list())
+                {
+                    if (auto broadcast = as_type_ptr<ngraph::op::Broadcast>(node))
+                    {
+                        // A Broadcast is a read of its input with its own access pattern
+                        const Node* source_node = broadcast->input_value(0).get_node();
+                        size_t in_size = shape_size(broadcast->get_input_shape(0));
+                        kernel::loop::Input input{
+                            parameter_index.at(source_node), kernel::loop::Access::Direct, in_size};
+                        switch (
+                            ngraph::runtime::cpu::op::LoopKernel::get_broadcast_kind(*broadcast))
+                        {
+                        case BroadcastKind::Scalar:
+                            input.access = kernel::loop::Access::Scalar;
+                            break;
+                        case BroadcastKind::Tile:
+                            input.access = kernel::loop::Access::Tile;
+                            break;
+                        case BroadcastKind::Repeat:
+                            input.access = kernel::loop::Access::Repeat;
+                            input.size = shape_size(broadcast->get_shape()) / in_size;
+                            break;
+                        case BroadcastKind::Unsupported:
+                            throw ngraph_error("Unsupported Broadcast in LoopKernel");
+                        }
+                        input_value[node.get()] = program.inputs.size();
+                        program.inputs.push_back(input);
+                        continue;
+                    }
+                    for (const auto& source : node->input_values())
+                    {
+                        const Node* source_node = source.get_node();
+                        if (parameter_index.count(source_node) != 0 &&
+                            input_value.count(source_node) == 0)
+                        {
+                            input_value[source_node] = program.inputs.size();
+                            program.inputs.push_back({parameter_index.at(source_node),
+                                                      kernel::loop::Access::Direct,
+                                                      shape_size(source_node->get_shape())});
+                        }
+                    }
+                }
+
+                unordered_map<const Node*, size_t> value = input_value;
+                size_t next_value = program.inputs.size();
+                const auto& opcodes = get_loop_opcodes();
+                for (const shared_ptr<Node>& node : loop_kernel.get_node_list())
+                {
+                    if (is_type<ngraph::op::Broadcast>(node))
+                    {
+                        continue;
+                    }
+                    auto opcode = opcodes.find(TI(*node));
+                    if (opcode == opcodes.end())
+                    {
+                        throw ngraph_error("Unsupported op in LoopKernel: " + node->description());
+                    }
+                    kernel::loop::Instruction instruction;
+                    instruction.opcode = opcode->second;
+                    instruction.dst = next_value++;
+                    instruction.src0 = value.at(node->input_value(0).get_node());
+                    instruction.src1 = node->get_input_size() > 1
+                                           ? value.at(node->input_value(1).get_node())
+                                           : instruction.src0;
+                    value[node.get()] = instruction.dst;
+                    program.instructions.push_back(instruction);
+                }
+
+                for (const shared_ptr<Node>& output : loop_kernel.get_kernel_outputs())
+                {
+                    program.outputs.push_back(value.at(output.get()));
+                }
+                return program;
+            }
+
+            template <typename ElementType>
+            static CPUKernelFunctor make_loop_functor(const kernel::loop::Program& program,
+                                                      const vector<size_t>& arg_buffer_indices,
+                                                      const vector<size_t>& out_buffer_indices)
+            {
+                return [program, arg_buffer_indices, out_buffer_indices](
+                    CPURuntimeContext* ctx, CPUExecutionContext* ectx) {
+                    vector<ElementType*> arg_ptrs;
+                    for (size_t index : arg_buffer_indices)
+                    {
+                        arg_ptrs.push_back(static_cast<ElementType*>(ctx->buffer_data[index]));
+                    }
+                    vector<ElementType*> out_ptrs;
+                    for (size_t index : out_buffer_indices)
+                    {
+                        out_ptrs.push_back(static_cast<ElementType*>(ctx->buffer_data[index]));
+                    }
+                    runtime::cpu::kernel::loop_kernel<ElementType>(
+                        program, arg_ptrs, out_ptrs, ectx->arena);
+                };
+            }
+
+            template <>
+            void Builder::BUILDER_DECL(ngraph::runtime::cpu::op::LoopKernel)
+            {
+                auto loop_kernel = static_cast<const ngraph::runtime::cpu::op::LoopKernel*>(node);
+                auto& functors = external_function->get_functors();
+
+                kernel::loop::Program program = build_loop_program(*loop_kernel);
+                for (size_t output : program.outputs)
+                {
+                    if (output < program.inputs.size())
+                    {
+                        throw ngraph_error("LoopKernel output must be computed by the kernel");
+                    }
+                }
+
+                vector<size_t> arg_buffer_indices;
+                for (const auto& arg : args)
+                {
+                    arg_buffer_indices.push_back(
+                        external_function->get_buffer_index(arg.get_name()));
+                }
+                vector<size_t> out_buffer_indices;
+                for (const auto& result : out)
+                {
+                    out_buffer_indices.push_back(
+                        external_function->get_buffer_index(result.get_name()));
+                }
+
+                auto element_type = out[0].get_element_type();
+                if (element_type == element::f32)
+                {
+                    functors.emplace_back(
+                        make_loop_functor<float>(program, arg_buffer_indices, out_buffer_indices));
+                }
+                else if (element_type == element::f64)
+                {
+                    functors.emplace_back(
+                        make_loop_functor<double>(program, arg_buffer_indices, out_buffer_indices));
+                }
+                else
+                {
+                    throw ngraph_error("Unsupported element type " + element_type.c_type_string() +
+                                       " for LoopKernel");
+                }
+            }
+
+            void register_builders_loop_kernel_cpp() { REGISTER_CPU_OP_BUILDER(LoopKernel); }
+        }
+    }
+}
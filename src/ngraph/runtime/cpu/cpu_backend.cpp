@@ -18,17 +18,32 @@
 #include <tbb/tbb_stddef.h>
 #endif
 
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+
+#include <mkldnn.hpp>
+
 #include "cpu_backend_visibility.h"
 
 #include "ngraph/component_manager.hpp"
+#include "ngraph/cpio.hpp"
+#include "ngraph/except.hpp"
+#include "ngraph/file_util.hpp"
 #include "ngraph/graph_util.hpp"
+#include "ngraph/op/constant.hpp"
 #include "ngraph/runtime/backend_manager.hpp"
 #include "ngraph/runtime/cpu/cpu_backend.hpp"
 #include "ngraph/runtime/cpu/cpu_builder_registry.hpp"
 #include "ngraph/runtime/cpu/cpu_call_frame.hpp"
+#include "ngraph/runtime/cpu/cpu_executor.hpp"
 #include "ngraph/runtime/cpu/cpu_external_function.hpp"
+#include "ngraph/runtime/cpu/cpu_op_serializers.hpp"
 #include "ngraph/runtime/cpu/cpu_tensor_view.hpp"
 #include "ngraph/runtime/cpu/static_initialize.hpp"
+#include "ngraph/serializer.hpp"
 #include "ngraph/util.hpp"
 
 #ifdef NGRAPH_MLIR_ENABLE
@@ -49,15 +64,27 @@ extern "C" CPU_BACKEND_API void ngraph_register_cpu_backend()
             tbb::TBB_runtime_interface_version();
 #endif
             ngraph::runtime::cpu::register_builders();
+            ngraph::runtime::cpu::register_op_serializers();
             is_initialized = true;
         }
         return make_shared<runtime::cpu::CPU_Backend>();
     });
 }
 
+runtime::cpu::CPU_Backend::CPU_Backend()
+    : m_allocator(nullptr)
+{
+    const char* cache_dir = std::getenv("NGRAPH_CPU_COMPILE_CACHE_DIR");
+    if (cache_dir != nullptr)
+    {
+        m_compile_cache_dir = cache_dir;
+    }
+}
+
 runtime::cpu::CPU_Backend::~CPU_Backend()
 {
     m_exec_map.clear();
+    m_structural_exec_map.clear();
 }
 shared_ptr<runtime::cpu::CPU_CallFrame> runtime::cpu::CPU_Backend::make_call_frame(
     const shared_ptr<runtime::cpu::CPU_ExternalFunction>& external_function,
@@ -86,6 +113,69 @@ shared_ptr<runtime::Executable>
     return compile(func, pass_config, performance_counters_enabled);
 }
 
+#ifndef NGRAPH_JSON_DISABLE
+// The compile options that, besides the function, determine the compiled code
+static string compile_options(const ngraph::pass::PassConfig& pass_config,
+                              bool performance_counters_enabled)
+{
+    stringstream ss;
+    ss << (performance_counters_enabled ? "perf" : "");
+    for (auto& enable : pass_config.get_enables())
+    {
+        ss << ";" << enable.first << ":" << enable.second;
+    }
+    for (auto& attribute : pass_config.get_pass_attributes())
+    {
+        ss << ";" << attribute.first << "=" << attribute.second;
+    }
+    return ss.str();
+}
+
+// The Constants of func in op order. Functions with equal structures have their Constants
+// at the same positions of this list.
+static vector<shared_ptr<op::Constant>> get_constants(const shared_ptr<Function>& func)
+{
+    vector<shared_ptr<op::Constant>> constants;
+    for (auto& node : func->get_ordered_ops())
+    {
+        if (auto constant = as_type_ptr<op::Constant>(node))
+        {
+            constants.push_back(constant);
+        }
+    }
+    return constants;
+}
+
+static size_t get_constant_size(const op::Constant& constant)
+{
+    return shape_size(constant.get_shape()) * constant.get_element_type().size();
+}
+
+static bool constants_equal(const vector<shared_ptr<op::Constant>>& a,
+                            const vector<shared_ptr<op::Constant>>& b)
+{
+    if (a.size() != b.size())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        size_t size = get_constant_size(*a[i]);
+        if (size != get_constant_size(*b[i]))
+        {
+            return false;
+        }
+        const void* a_data = a[i]->get_data_ptr();
+        const void* b_data = b[i]->get_data_ptr();
+        if (a_data != b_data && memcmp(a_data, b_data, size) != 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
 shared_ptr<runtime::Executable>
     runtime::cpu::CPU_Backend::compile(shared_ptr<Function> func,
                                        ngraph::pass::PassConfig& pass_config,
@@ -112,31 +202,137 @@ shared_ptr<runtime::Executable>
             return rc;
         }
     }
-    rc = make_shared<CPU_Executable>(
-        func, pass_config, get_host_memory_allocator(), performance_counters_enabled);
+
+    // Functions are also cached by content, so that structurally identical functions (e.g. the
+    // same model imported twice) share one executable. The key is the compile options and the
+    // serialized structure of func, which holds only digests of constant data, so a key match
+    // is confirmed by comparing the constant bytes. The key and constants must be taken
+    // before compiling since the CPU passes rewrite func in place.
+    string key;
+    string cache_path;
+    vector<shared_ptr<op::Constant>> constants;
+#ifndef NGRAPH_JSON_DISABLE
+    try
+    {
+        string options = compile_options(pass_config, performance_counters_enabled);
+        string structure = serialize_structure(func);
+        key = options + "\n" + structure;
+        if (!m_compile_cache_dir.empty())
+        {
+            stringstream name;
+            name << hash_function(func) << "_" << hex << setfill('0') << setw(16)
+                 << std::hash<string>()(options) << ".cpio";
+            cache_path = file_util::path_join(m_compile_cache_dir, name.str());
+        }
+    }
+    catch (const unsupported_op&)
+    {
+        // Functions containing ops whose attributes the serializer does not know have no
+        // structure to compare; they are only cached by pointer.
+    }
+    if (!key.empty())
+    {
+        constants = get_constants(func);
+        std::lock_guard<std::mutex> guard(m_exec_map_mutex);
+        auto it = m_structural_exec_map.find(key);
+        if (it != m_structural_exec_map.end())
+        {
+            if (constants_equal(it->second.constants, constants))
+            {
+                // Share the compiled code, but bind to the parameters and results of func
+                rc = make_shared<CPU_Executable>(*it->second.exec, func);
+                m_exec_map.insert({func, rc});
+                return rc;
+            }
+            // Same structure and digests but different constant data; compile func without
+            // replacing the cached executable
+            key.clear();
+            cache_path.clear();
+        }
+    }
+    if (!cache_path.empty())
+    {
+        if (auto loaded = load_from_compile_cache(cache_path, key, constants))
+        {
+            rc = make_shared<CPU_Executable>(*loaded, func);
+            std::lock_guard<std::mutex> guard(m_exec_map_mutex);
+            m_exec_map.insert({func, rc});
+            m_structural_exec_map.insert({key, StructuralEntry{loaded, constants}});
+            return rc;
+        }
+    }
+#endif
+
+    auto exec = make_shared<CPU_Executable>(func,
+                                            pass_config,
+                                            get_host_memory_allocator(),
+                                            performance_counters_enabled,
+                                            m_weight_pool);
+    if (!cache_path.empty())
+    {
+        save_to_compile_cache(cache_path, key, constants, exec);
+    }
     {
         std::lock_guard<std::mutex> guard(m_exec_map_mutex);
-        m_exec_map.insert({func, rc});
-        return rc;
+        m_exec_map.insert({func, exec});
+        if (!key.empty())
+        {
+            m_structural_exec_map.insert({key, StructuralEntry{exec, constants}});
+        }
+        return exec;
     }
 }
 
 runtime::cpu::CPU_Executable::CPU_Executable(shared_ptr<Function> func,
                                              ngraph::pass::PassConfig& pass_config,
                                              Allocator* allocator,
-                                             bool performance_counters_enabled)
+                                             bool performance_counters_enabled,
+                                             const shared_ptr<CPUWeightPool>& weight_pool)
+    : m_function(func)
+    , m_pass_config(pass_config)
 {
     FunctionInstance& instance = m_function_instance;
     if (instance.m_external_function == nullptr)
     {
         instance.m_external_function = make_shared<CPU_ExternalFunction>(func);
         instance.m_external_function->m_emit_timing = performance_counters_enabled;
+        instance.m_external_function->m_weight_pool = weight_pool;
+        instance.m_performance_counters_enabled = performance_counters_enabled;
         auto cf = instance.m_external_function->make_call_frame(pass_config, allocator);
         instance.m_call_frame = dynamic_pointer_cast<CPU_CallFrame>(cf);
     }
     set_parameters_and_results(*func);
 }
 
+runtime::cpu::CPU_Executable::CPU_Executable(shared_ptr<Function> func,
+                                             const string& compiled_state,
+                                             ngraph::pass::PassConfig& pass_config,
+                                             Allocator* allocator,
+                                             bool performance_counters_enabled,
+                                             const shared_ptr<CPUWeightPool>& weight_pool)
+    : m_function(func)
+    , m_pass_config(pass_config)
+{
+    FunctionInstance& instance = m_function_instance;
+    instance.m_external_function = make_shared<CPU_ExternalFunction>(func);
+    instance.m_external_function->m_emit_timing = performance_counters_enabled;
+    instance.m_external_function->m_weight_pool = weight_pool;
+    instance.m_external_function->set_compiled_state(compiled_state);
+    instance.m_performance_counters_enabled = performance_counters_enabled;
+    auto cf = instance.m_external_function->make_call_frame(pass_config, allocator);
+    instance.m_call_frame = dynamic_pointer_cast<CPU_CallFrame>(cf);
+    set_parameters_and_results(*func);
+}
+
+runtime::cpu::CPU_Executable::CPU_Executable(const CPU_Executable& compiled,
+                                             shared_ptr<Function> func)
+    : m_function(compiled.m_function)
+    , m_pass_config(compiled.m_pass_config)
+    , m_function_instance(compiled.m_function_instance)
+{
+    set_parameters_and_results(*func);
+}
+
 std::shared_ptr<ngraph::runtime::cpu::CPU_CallFrame> runtime::cpu::CPU_Executable::get_call_frame()
 {
     FunctionInstance& instance = m_function_instance;
@@ -160,15 +356,321 @@ bool runtime::cpu::CPU_Executable::call(const vector<shared_ptr<runtime::Tensor>
     return rc;
 }
 
+bool runtime::cpu::CPU_Executable::try_call(const vector<shared_ptr<runtime::Tensor>>& outputs,
+                                            const vector<shared_ptr<runtime::Tensor>>& inputs)
+{
+    FunctionInstance& instance = m_function_instance;
+    if (instance.m_external_function == nullptr)
+    {
+        throw runtime_error("compile() must be called before call().");
+    }
+
+    return instance.m_call_frame->try_call(outputs, inputs);
+}
+
+future<bool>
+    runtime::cpu::CPU_Executable::begin_call(const vector<shared_ptr<runtime::Tensor>>& outputs,
+                                             const vector<shared_ptr<runtime::Tensor>>& inputs,
+                                             CallCallback callback)
+{
+    FunctionInstance& instance = m_function_instance;
+    if (instance.m_external_function == nullptr)
+    {
+        throw runtime_error("compile() must be called before call().");
+    }
+
+    // The call frame is captured by value so it outlives the executable if need be
+    shared_ptr<CPU_CallFrame> call_frame = instance.m_call_frame;
+    auto task = make_shared<packaged_task<bool()>>(make_call_task(
+        [call_frame, outputs, inputs]() {
+            call_frame->call(outputs, inputs);
+            return true;
+        },
+        callback));
+    future<bool> result = task->get_future();
+    executor::GetCPUExecutor().schedule([task]() { (*task)(); });
+    return result;
+}
+
+void runtime::cpu::CPU_Executable::set_concurrency(size_t num_contexts)
+{
+    m_function_instance.m_call_frame->set_concurrency(num_contexts);
+}
+
+size_t runtime::cpu::CPU_Executable::get_concurrency() const
+{
+    return m_function_instance.m_call_frame->get_concurrency();
+}
+
+void runtime::cpu::CPU_Executable::set_inter_op_parallelism(size_t width)
+{
+    m_function_instance.m_external_function->set_inter_op_parallelism(width);
+}
+
+size_t runtime::cpu::CPU_Executable::get_inter_op_parallelism() const
+{
+    return m_function_instance.m_external_function->get_inter_op_parallelism();
+}
+
+static const string s_save_info = "CPU Save File 2.0";
+
+// mkldnn memory descriptors are saved as raw bytes, so they are only valid for the same
+// MKLDNN version
+static string get_mkldnn_info()
+{
+    stringstream ss;
+#if defined(MKLDNN_VERSION_MAJOR) && defined(MKLDNN_VERSION_MINOR) && defined(MKLDNN_VERSION_PATCH)
+    ss << MKLDNN_VERSION_MAJOR << "." << MKLDNN_VERSION_MINOR << "." << MKLDNN_VERSION_PATCH;
+#else
+    ss << "unknown";
+#endif
+    ss << ";" << sizeof(mkldnn_memory_desc_t);
+    return ss.str();
+}
+
+void runtime::cpu::CPU_Executable::save(ostream& out)
+{
+    cpio::Writer writer(out);
+    write_entries(writer);
+}
+
+void runtime::cpu::CPU_Executable::write_entries(cpio::Writer& writer)
+{
+    FunctionInstance& instance = m_function_instance;
+    // The CPU passes rewrote m_function in place, so this is the compiled graph
+    string state = instance.m_external_function->get_compiled_state(m_function);
+    stringstream graph;
+    serialize_cpio(graph, m_function);
+    string graph_data = graph.str();
+
+    writer.write("save_info", s_save_info.data(), s_save_info.size());
+    string mkldnn_info = get_mkldnn_info();
+    writer.write("mkldnn_info", mkldnn_info.data(), mkldnn_info.size());
+    writer.write("graph", graph_data.data(), graph_data.size());
+    writer.write("state", state.data(), state.size());
+
+    // One "enable:<name>=<0|1>" or "attribute:<name>=<0|1>" entry per line
+    stringstream config;
+    for (auto& enable : m_pass_config.get_enables())
+    {
+        config << "enable:" << enable.first << "=" << enable.second << "\n";
+    }
+    for (auto& attribute : m_pass_config.get_pass_attributes())
+    {
+        config << "attribute:" << attribute.first << "=" << attribute.second << "\n";
+    }
+    string pc = config.str();
+    writer.write("pass_config", pc.data(), pc.size());
+
+    string perf = instance.m_performance_counters_enabled ? "1" : "0";
+    writer.write("performance_counters", perf.data(), perf.size());
+}
+
+static map<string, string> read_entries(istream& in)
+{
+    if (!cpio::is_cpio(in))
+    {
+        throw ngraph_error("Input is not a saved CPU executable");
+    }
+    cpio::Reader reader(in);
+    map<string, string> entries;
+    for (const cpio::FileInfo& info : reader.get_file_info())
+    {
+        vector<char> buffer = reader.read(info);
+        entries[info.get_name()] = string(buffer.data(), buffer.size());
+    }
+    return entries;
+}
+
+shared_ptr<runtime::Executable> runtime::cpu::CPU_Backend::load(istream& in)
+{
+    map<string, string> entries = read_entries(in);
+    auto exec = load_entries(entries);
+    {
+        std::lock_guard<std::mutex> guard(m_exec_map_mutex);
+        m_exec_map.insert({exec->m_function, exec});
+    }
+    return exec;
+}
+
+shared_ptr<runtime::cpu::CPU_Executable>
+    runtime::cpu::CPU_Backend::load_entries(map<string, string>& entries)
+{
+    for (const string& name :
+         {"save_info", "mkldnn_info", "graph", "state", "pass_config", "performance_counters"})
+    {
+        if (entries.find(name) == entries.end())
+        {
+            throw ngraph_error("Saved CPU executable is missing its " + name + " entry");
+        }
+    }
+    if (entries["save_info"] != s_save_info)
+    {
+        throw ngraph_error("Unsupported CPU save file version: " + entries["save_info"]);
+    }
+    if (entries["mkldnn_info"] != get_mkldnn_info())
+    {
+        throw ngraph_error("CPU executable was saved with MKLDNN " + entries["mkldnn_info"] +
+                           ", this backend uses " + get_mkldnn_info());
+    }
+
+    ngraph::pass::PassConfig pass_config;
+    stringstream config(entries["pass_config"]);
+    string line;
+    while (getline(config, line))
+    {
+        auto colon = line.find(':');
+        auto equals = line.rfind('=');
+        if (colon == string::npos || equals == string::npos || equals < colon)
+        {
+            throw ngraph_error("Malformed pass_config entry in CPU save file: " + line);
+        }
+        string kind = line.substr(0, colon);
+        string name = line.substr(colon + 1, equals - colon - 1);
+        bool value = parse_string<bool>(line.substr(equals + 1));
+        if (kind == "enable")
+        {
+            pass_config.set_pass_enable(name, value);
+        }
+        else
+        {
+            pass_config.set_pass_attribute(name, value);
+        }
+    }
+
+    stringstream graph(entries["graph"]);
+    shared_ptr<Function> func = deserialize(graph);
+    auto exec = make_shared<CPU_Executable>(func,
+                                            entries["state"],
+                                            pass_config,
+                                            get_host_memory_allocator(),
+                                            entries["performance_counters"] == "1",
+                                            m_weight_pool);
+    return exec;
+}
+
+#ifndef NGRAPH_JSON_DISABLE
+// A compile cache file is a saved executable with two more kinds of entries: source_key, the
+// structural key of the function it was compiled from, and source_constant_<i>, the data of
+// the i-th Constant of that function. Since the structural key only holds digests of constant
+// data, both are compared before the file is used.
+shared_ptr<runtime::cpu::CPU_Executable> runtime::cpu::CPU_Backend::load_from_compile_cache(
+    const string& path, const string& key, const vector<shared_ptr<op::Constant>>& constants)
+{
+    ifstream in(path, ios_base::binary);
+    if (!in)
+    {
+        return nullptr;
+    }
+    try
+    {
+        map<string, string> entries = read_entries(in);
+        if (entries["source_key"] != key)
+        {
+            return nullptr;
+        }
+        for (size_t i = 0; i <= constants.size(); i++)
+        {
+            auto it = entries.find("source_constant_" + to_string(i));
+            if (i == constants.size())
+            {
+                if (it != entries.end())
+                {
+                    return nullptr;
+                }
+                break;
+            }
+            if (it == entries.end() || it->second.size() != get_constant_size(*constants[i]) ||
+                memcmp(it->second.data(), constants[i]->get_data_ptr(), it->second.size()) != 0)
+            {
+                return nullptr;
+            }
+        }
+        return load_entries(entries);
+    }
+    catch (const exception&)
+    {
+        // A file that is truncated, or was saved by another version, is treated as a miss and
+        // replaced by the next save
+        return nullptr;
+    }
+}
+
+void runtime::cpu::CPU_Backend::save_to_compile_cache(
+    const string& path,
+    const string& key,
+    const vector<shared_ptr<op::Constant>>& constants,
+    const shared_ptr<CPU_Executable>& exec)
+{
+    // Write to a file of our own and rename it into place, so that processes sharing the
+    // directory never read a partly written file
+    stringstream tmp;
+    tmp << path << "." << chrono::steady_clock::now().time_since_epoch().count() << ".tmp";
+    string tmp_path = tmp.str();
+    try
+    {
+        if (!file_util::exists(m_compile_cache_dir))
+        {
+            file_util::make_directory(m_compile_cache_dir);
+        }
+        {
+            ofstream out(tmp_path, ios_base::binary);
+            if (!out)
+            {
+                return;
+            }
+            cpio::Writer writer(out);
+            exec->write_entries(writer);
+            writer.write("source_key", key.data(), key.size());
+            for (size_t i = 0; i < constants.size(); i++)
+            {
+                writer.write("source_constant_" + to_string(i),
+                             constants[i]->get_data_ptr(),
+                             get_constant_size(*constants[i]));
+            }
+        }
+        if (std::rename(tmp_path.c_str(), path.c_str()) != 0)
+        {
+            std::remove(tmp_path.c_str());
+        }
+    }
+    catch (const exception&)
+    {
+        // The compiled graph may hold an op with no serializer; it is then only cached in
+        // memory
+        std::remove(tmp_path.c_str());
+    }
+}
+#endif
+
 void runtime::cpu::CPU_Backend::remove_compiled_function(shared_ptr<Executable> exec)
 {
     std::lock_guard<std::mutex> guard(m_exec_map_mutex);
-    for (auto it = m_exec_map.begin(); it != m_exec_map.end(); ++it)
+    for (auto it = m_exec_map.begin(); it != m_exec_map.end();)
     {
         if (it->second == exec)
         {
-            m_exec_map.erase(it);
-            break;
+            it = m_exec_map.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    // Executables of structurally identical functions share a call frame; removing any of
+    // them stops later compiles from sharing it
+    auto cpu_exec = dynamic_pointer_cast<CPU_Executable>(exec);
+    auto call_frame = cpu_exec ? cpu_exec->get_call_frame() : nullptr;
+    for (auto it = m_structural_exec_map.begin(); it != m_structural_exec_map.end();)
+    {
+        if (it->second.exec == exec ||
+            (call_frame && it->second.exec->get_call_frame() == call_frame))
+        {
+            it = m_structural_exec_map.erase(it);
+        }
+        else
+        {
+            ++it;
         }
     }
 }
@@ -16,28 +16,43 @@
 
 #pragma once
 
+#include <future>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 #include "cpu_backend_visibility.h"
 #include "ngraph/pass/pass_config.hpp"
 #include "ngraph/runtime/allocator.hpp"
 #include "ngraph/runtime/backend.hpp"
 #include "ngraph/runtime/backend_manager.hpp"
+#include "ngraph/runtime/cpu/cpu_weight_pool.hpp"
 
 namespace ngraph
 {
+    namespace cpio
+    {
+        class Writer;
+    }
+
+    namespace op
+    {
+        class Constant;
+    }
+
     namespace runtime
     {
         namespace cpu
         {
             class CPU_ExternalFunction;
             class CPU_CallFrame;
+            class CPU_Executable;
             BackendConstructor CPU_BACKEND_API get_backend_constructor_pointer();
             class CPU_BACKEND_API CPU_Backend : public runtime::Backend
             {
             public:
+                CPU_Backend();
                 ~CPU_Backend() override;
 
                 std::shared_ptr<CPU_CallFrame>
@@ -65,19 +80,69 @@ namespace ngraph
 
                 void remove_compiled_function(std::shared_ptr<Executable> exec) override;
 
+                /// \brief Loads an executable saved with CPU_Executable::save. The saved
+                ///        graph is already compiled, so the CPU passes are not run again.
+                ///        Throws ngraph_error if input_stream is not a saved CPU executable
+                ///        or was saved with a different MKLDNN version.
+                std::shared_ptr<ngraph::runtime::Executable>
+                    load(std::istream& input_stream) override;
+
                 Allocator* get_host_memory_allocator() override;
                 void set_host_memory_allocator(Allocator* allocator) override;
 
                 bool is_supported(const Node& node) const override;
                 bool is_supported_property(const Property prop) const override;
 
+                /// \brief The pool through which the executables compiled by this backend
+                ///        share identical constants, including layout-converted weights.
+                const std::shared_ptr<CPUWeightPool>& get_weight_pool() const
+                {
+                    return m_weight_pool;
+                }
+
+                /// \brief Set the directory in which compiled executables are saved, so that
+                ///        compiling an identical function with identical options in a later
+                ///        process loads the saved executable instead of running the CPU passes.
+                ///        Defaults to NGRAPH_CPU_COMPILE_CACHE_DIR; an empty path disables the
+                ///        cache. The directory is created on the first save.
+                void set_compile_cache_dir(const std::string& dir) { m_compile_cache_dir = dir; }
+                const std::string& get_compile_cache_dir() const { return m_compile_cache_dir; }
+
             private:
+                // A compiled executable and the Constants of the function it was compiled
+                // from, in op order. The structural key only holds digests of constant data,
+                // so a key match is confirmed by comparing the constant bytes.
+                struct StructuralEntry
+                {
+                    std::shared_ptr<CPU_Executable> exec;
+                    std::vector<std::shared_ptr<op::Constant>> constants;
+                };
+
+                std::shared_ptr<CPU_Executable>
+                    load_from_compile_cache(const std::string& path,
+                                            const std::string& key,
+                                            const std::vector<std::shared_ptr<op::Constant>>&
+                                                constants);
+                void save_to_compile_cache(
+                    const std::string& path,
+                    const std::string& key,
+                    const std::vector<std::shared_ptr<op::Constant>>& constants,
+                    const std::shared_ptr<CPU_Executable>& exec);
+                std::shared_ptr<CPU_Executable>
+                    load_entries(std::map<std::string, std::string>& entries);
+
                 // this mutex will be used to protect the addition and deletion
                 // of function to m_exec_map across multiple threads
                 std::mutex m_exec_map_mutex;
                 std::unordered_map<std::shared_ptr<Function>, std::shared_ptr<Executable>>
                     m_exec_map;
+                // Executables keyed by the serialized structure of the function they compiled
+                // and the compile options, so that structurally identical functions are
+                // compiled once
+                std::unordered_map<std::string, StructuralEntry> m_structural_exec_map;
                 Allocator* m_allocator;
+                std::string m_compile_cache_dir;
+                std::shared_ptr<CPUWeightPool> m_weight_pool = std::make_shared<CPUWeightPool>();
             };
 
             class CPU_BACKEND_API CPU_Executable : public runtime::Executable
@@ -86,15 +151,68 @@ namespace ngraph
                 CPU_Executable(std::shared_ptr<Function> func,
                                ngraph::pass::PassConfig& pass_config,
                                Allocator* allocator,
-                               bool performance_counters_enabled);
+                               bool performance_counters_enabled,
+                               const std::shared_ptr<CPUWeightPool>& weight_pool = nullptr);
+                /// \brief Create an executable for func, a graph compiled and saved by
+                ///        CPU_Executable::save, with the compiled state saved with it.
+                CPU_Executable(std::shared_ptr<Function> func,
+                               const std::string& compiled_state,
+                               ngraph::pass::PassConfig& pass_config,
+                               Allocator* allocator,
+                               bool performance_counters_enabled,
+                               const std::shared_ptr<CPUWeightPool>& weight_pool = nullptr);
+                /// \brief Create an executable for func, which must be structurally identical
+                ///        to the function compiled by compiled. The compiled code and execution
+                ///        contexts are shared with compiled; the parameters and results are
+                ///        those of func.
+                CPU_Executable(const CPU_Executable& compiled, std::shared_ptr<Function> func);
                 bool call(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
                           const std::vector<std::shared_ptr<runtime::Tensor>>& inputs) override;
 
+                /// \brief Run the function if an execution context is free.
+                /// \returns false without running anything if every context is busy
+                bool try_call(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
+                              const std::vector<std::shared_ptr<runtime::Tensor>>& inputs);
+
+                /// \brief Run the function on the executor's dispatch pool. Calls in flight
+                ///        are limited by the concurrency of the executable.
+                std::future<bool>
+                    begin_call(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
+                               const std::vector<std::shared_ptr<runtime::Tensor>>& inputs,
+                               CallCallback callback = nullptr) override;
+
+                /// \brief Set the number of execution contexts, which is the number of calls
+                ///        that can run concurrently. May be changed while calls are running.
+                void set_concurrency(size_t num_contexts);
+                size_t get_concurrency() const;
+
+                /// \brief Set the number of independent ops that may run at once within a
+                ///        call in DEX mode. Defaults to NGRAPH_INTER_OP_PARALLELISM.
+                void set_inter_op_parallelism(size_t width);
+                /// \brief The number of ops that run at once within a call, after capping the
+                ///        requested value to the executor thread pools and the cores available
+                ///        per intra-op thread team.
+                size_t get_inter_op_parallelism() const;
+
                 std::shared_ptr<CPU_CallFrame> get_call_frame();
 
                 std::vector<PerformanceCounter> get_performance_data() const override;
 
+                /// \brief Save the compiled graph, with its layouts and memory assignment, to
+                ///        a cpio stream readable by CPU_Backend::load. Throws unsupported_op
+                ///        if the compiled graph holds an op that has no serializer.
+                void save(std::ostream& output_stream) override;
+
             private:
+                friend class CPU_Backend;
+                // Write the entries read by CPU_Backend::load, leaving writer open for more
+                void write_entries(cpio::Writer& writer);
+
+                // The function after the CPU passes rewrote it, and the pass configuration
+                // used to compile it
+                std::shared_ptr<Function> m_function;
+                ngraph::pass::PassConfig m_pass_config;
+
                 class FunctionInstance
                 {
                 public:
@@ -44,6 +44,7 @@ namespace ngraph
                 register_builders_gather_nd_cpp();
                 register_builders_get_output_element_cpp();
                 register_builders_leaky_relu_cpp();
+                register_builders_loop_kernel_cpp();
                 register_builders_lrn_cpp();
                 register_builders_lstm_cpp();
                 register_builders_matmul_bias_cpp();
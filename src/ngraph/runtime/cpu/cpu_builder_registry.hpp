@@ -43,6 +43,7 @@ namespace ngraph
             void register_builders_gather_nd_cpp();
             void register_builders_get_output_element_cpp();
             void register_builders_leaky_relu_cpp();
+            void register_builders_loop_kernel_cpp();
             void register_builders_lrn_cpp();
             void register_builders_lstm_cpp();
             void register_builders_matmul_bias_cpp();
@@ -18,7 +18,9 @@
 #include <thread>
 
 #include "ngraph/runtime/aligned_buffer.hpp"
+#include "ngraph/runtime/chrome_trace.hpp"
 #include "ngraph/runtime/cpu/cpu_call_frame.hpp"
+#include "ngraph/runtime/cpu/cpu_executor.hpp"
 #include "ngraph/runtime/cpu/cpu_external_function.hpp"
 #include "ngraph/runtime/cpu/cpu_tensor_view.hpp"
 #include "ngraph/runtime/cpu/cpu_tracing.hpp"
@@ -33,6 +35,7 @@ runtime::cpu::CPU_CallFrame::CPU_CallFrame(std::shared_ptr<CPU_ExternalFunction>
                                            EntryPoint compiled_function,
                                            runtime::Allocator* allocator)
     : m_external_function(external_function)
+    , m_allocator(allocator)
     , m_compiled_init_ctx_func(compiled_init_ctx_func)
     , m_compiled_destroy_ctx_func(compiled_destroy_ctx_func)
     , m_compiled_function(compiled_function)
@@ -48,6 +51,19 @@ runtime::cpu::CPU_CallFrame::CPU_CallFrame(std::shared_ptr<CPU_ExternalFunction>
             std::to_string(std::thread::hardware_concurrency()) + "]");
     }
 
+    const auto envIdleTimeout = std::getenv("NGRAPH_CPU_CONTEXT_IDLE_TIMEOUT");
+    if (envIdleTimeout != nullptr)
+    {
+        m_idle_timeout = std::chrono::milliseconds(std::atol(envIdleTimeout));
+    }
+
+    if (runtime::cpu::IsTracingEnabled())
+    {
+        m_timeline.reset(new TimelineRecorder(m_external_function->get_op_attrs(),
+                                              m_external_function->get_function_name() +
+                                                  ".timeline.json"));
+    }
+
     setup_runtime_context(allocator);
     if (!m_external_function->is_direct_execution())
     {
@@ -69,7 +85,7 @@ runtime::cpu::CPU_CallFrame::~CPU_CallFrame()
 void runtime::cpu::CPU_CallFrame::inner_call(
     const std::vector<std::shared_ptr<runtime::Tensor>>& output_tvs,
     const std::vector<std::shared_ptr<runtime::Tensor>>& input_tvs,
-    const size_t id,
+    CPURuntimeContext* ctx,
     const bool disable_caching)
 {
     vector<void*> inputs;
@@ -81,11 +97,11 @@ void runtime::cpu::CPU_CallFrame::inner_call(
             static_pointer_cast<runtime::cpu::CPUTensorView>(input_tvs[i]);
         if (disable_caching)
         {
-            m_ctx_vec[id]->p_en[i] = true;
+            ctx->p_en[i] = true;
         }
         else
         {
-            m_ctx_vec[id]->p_en[i] = tv->get_stale();
+            ctx->p_en[i] = tv->get_stale();
         }
 
         inputs.push_back(tv->get_data_ptr());
@@ -97,66 +113,278 @@ void runtime::cpu::CPU_CallFrame::inner_call(
         outputs.push_back(tv->get_data_ptr());
     }
 
+    uint64_t start_nanoseconds = m_timeline ? event::Manager::get_current_nanoseconds() : 0;
+
     // Invoke compiled computation
     if (!m_external_function->is_direct_execution())
     {
-        m_compiled_function(inputs.data(), outputs.data(), m_ctx_vec[id], cg_ctx);
+        m_compiled_function(inputs.data(), outputs.data(), ctx, cg_ctx);
     }
     else
     {
-        m_external_function->get_executor()(m_ctx_vec[id], inputs, outputs);
+        m_external_function->get_executor()(ctx, inputs, outputs);
     }
 
-    if (runtime::cpu::IsTracingEnabled())
+    if (m_timeline)
+    {
+        m_timeline->record(start_nanoseconds, ctx->op_durations);
+    }
+}
+
+bool runtime::cpu::CPU_CallFrame::acquire_context(size_t& id,
+                                                  CPURuntimeContext*& ctx,
+                                                  bool& disable_caching)
+{
+    // Prefer a free context that already exists over an empty slot
+    size_t slot = m_num_ctx;
+    for (size_t i = 0; i < m_num_ctx; i++)
+    {
+        if (m_id_pool[i])
+        {
+            if (m_ctx_vec[i] != nullptr)
+            {
+                slot = i;
+                break;
+            }
+            if (slot == m_num_ctx)
+            {
+                slot = i;
+            }
+        }
+    }
+    if (slot == m_num_ctx)
+    {
+        return false;
+    }
+
+    id = slot;
+    ctx = m_ctx_vec[id];
+    m_id_pool[id] = false;
+    // Disable caching since staleness hints are no longer
+    // applicable to this context, or the context is new
+    disable_caching = (id != m_prev_ctx || ctx == nullptr);
+    m_prev_ctx = id;
+    m_num_ctx_available--;
+    return true;
+}
+
+void runtime::cpu::CPU_CallFrame::release_context(size_t id)
+{
+    vector<CPURuntimeContext*> idle;
+    {
+        std::lock_guard<std::mutex> lck(m_mutex);
+        m_id_pool[id] = true;
+        m_last_used[id] = std::chrono::steady_clock::now();
+        if (id < m_num_ctx)
+        {
+            m_num_ctx_available++;
+        }
+        take_idle_contexts(idle);
+    }
+    // Wake both waiting calls and set_concurrency
+    m_cv.notify_all();
+
+    for (CPURuntimeContext* ctx : idle)
+    {
+        destroy_runtime_context(ctx);
+    }
+}
+
+void runtime::cpu::CPU_CallFrame::take_idle_contexts(vector<CPURuntimeContext*>& idle)
+{
+    auto now = std::chrono::steady_clock::now();
+    // The first context is kept so a single caller never pays for context creation
+    for (size_t i = 1; i < m_ctx_vec.size(); i++)
+    {
+        if (m_ctx_vec[i] != nullptr && m_id_pool[i] && now - m_last_used[i] >= m_idle_timeout)
+        {
+            idle.push_back(m_ctx_vec[i]);
+            m_ctx_vec[i] = nullptr;
+        }
+    }
+
+    // Free contexts that remain are released by a sweep on the executor once they time out,
+    // whether or not another call completes before then
+    if (m_idle_sweep_deadline <= now)
     {
-        GenerateTimeline(m_external_function->get_op_attrs(),
-                         m_ctx_vec[id]->op_durations,
-                         m_external_function->get_function_name() + ".timeline.json");
+        m_idle_sweep_deadline = std::chrono::steady_clock::time_point::max();
+    }
+    auto next = std::chrono::steady_clock::time_point::max();
+    for (size_t i = 1; i < m_ctx_vec.size(); i++)
+    {
+        if (m_ctx_vec[i] != nullptr && m_id_pool[i])
+        {
+            next = std::min(next, m_last_used[i] + m_idle_timeout);
+        }
+    }
+    if (next < m_idle_sweep_deadline)
+    {
+        m_idle_sweep_deadline = next;
+        std::weak_ptr<CPU_CallFrame> frame = shared_from_this();
+        executor::GetCPUExecutor().schedule_at(next, [frame]() {
+            if (auto call_frame = frame.lock())
+            {
+                call_frame->release_idle_contexts();
+            }
+        });
     }
 }
 
+void runtime::cpu::CPU_CallFrame::execute(
+    const std::vector<std::shared_ptr<runtime::Tensor>>& output_tvs,
+    const std::vector<std::shared_ptr<runtime::Tensor>>& input_tvs,
+    size_t id,
+    CPURuntimeContext* ctx,
+    bool disable_caching)
+{
+    try
+    {
+        if (ctx == nullptr)
+        {
+            // The slot is reserved for this call, so the context can be created unlocked
+            ctx = create_runtime_context();
+            std::lock_guard<std::mutex> lck(m_mutex);
+            m_ctx_vec[id] = ctx;
+        }
+        ctx->pc = 0;
+        propagate_layouts(output_tvs, m_external_function->get_result_layout_descriptors());
+        inner_call(output_tvs, input_tvs, ctx, disable_caching);
+    }
+    catch (...)
+    {
+        release_context(id);
+        throw;
+    }
+    release_context(id);
+}
+
 void runtime::cpu::CPU_CallFrame::call(
     const std::vector<std::shared_ptr<runtime::Tensor>>& output_tvs,
     const std::vector<std::shared_ptr<runtime::Tensor>>& input_tvs)
 {
     size_t id = 0;
-    auto disable_caching = false;
+    bool disable_caching = false;
+    CPURuntimeContext* ctx = nullptr;
     {
         std::unique_lock<std::mutex> lck(m_mutex);
-        while (m_num_ctx_available == 0)
+        while (!acquire_context(id, ctx, disable_caching))
         {
             m_cv.wait(lck);
         }
+    }
+    execute(output_tvs, input_tvs, id, ctx, disable_caching);
+}
 
-        for (size_t i = 0; i < m_num_ctx; i++)
+bool runtime::cpu::CPU_CallFrame::try_call(
+    const std::vector<std::shared_ptr<runtime::Tensor>>& output_tvs,
+    const std::vector<std::shared_ptr<runtime::Tensor>>& input_tvs)
+{
+    size_t id = 0;
+    bool disable_caching = false;
+    CPURuntimeContext* ctx = nullptr;
+    {
+        std::lock_guard<std::mutex> lck(m_mutex);
+        if (!acquire_context(id, ctx, disable_caching))
         {
-            if (m_id_pool[i])
+            return false;
+        }
+    }
+    execute(output_tvs, input_tvs, id, ctx, disable_caching);
+    return true;
+}
+
+void runtime::cpu::CPU_CallFrame::set_concurrency(size_t num_ctx)
+{
+    NGRAPH_CHECK(num_ctx > 0, "At least one execution context is required");
+    NGRAPH_CHECK(num_ctx == 1 || m_external_function->is_direct_execution(),
+                 "Codegen mode supports a single execution context");
+    std::lock_guard<std::mutex> resize_lock(m_resize_mutex);
+
+    vector<CPURuntimeContext*> removed;
+    {
+        std::unique_lock<std::mutex> lck(m_mutex);
+        // New slots stay empty until a call needs them
+        while (m_ctx_vec.size() < num_ctx)
+        {
+            m_id_pool[m_ctx_vec.size()] = true;
+            m_ctx_vec.push_back(nullptr);
+            m_last_used.push_back(std::chrono::steady_clock::now());
+        }
+        // No new call is given a context at or beyond num_ctx. Wait for the ones running.
+        m_num_ctx = num_ctx;
+        m_cv.wait(lck, [&]() {
+            for (size_t i = num_ctx; i < m_ctx_vec.size(); i++)
             {
-                id = i;
-                break;
+                if (!m_id_pool[i])
+                {
+                    return false;
+                }
             }
+            return true;
+        });
+        while (m_ctx_vec.size() > num_ctx)
+        {
+            m_id_pool.erase(m_ctx_vec.size() - 1);
+            if (m_ctx_vec.back() != nullptr)
+            {
+                removed.push_back(m_ctx_vec.back());
+            }
+            m_ctx_vec.pop_back();
+            m_last_used.pop_back();
         }
-        NGRAPH_CHECK(id != m_num_ctx);
-        m_id_pool[id] = false;
-        if (id != m_prev_ctx)
+        m_num_ctx_available = 0;
+        for (size_t i = 0; i < num_ctx; i++)
         {
-            // Disable caching since staleness hints are no longer
-            // applicable to this context
-            disable_caching = true;
+            if (m_id_pool[i])
+            {
+                m_num_ctx_available++;
+            }
         }
-        m_prev_ctx = id;
-        m_num_ctx_available--;
     }
+    m_cv.notify_all();
 
-    m_ctx_vec[id]->pc = 0;
-    propagate_layouts(output_tvs, m_external_function->get_result_layout_descriptors());
-    inner_call(output_tvs, input_tvs, id, disable_caching);
+    for (CPURuntimeContext* ctx : removed)
+    {
+        destroy_runtime_context(ctx);
+    }
+}
+
+size_t runtime::cpu::CPU_CallFrame::get_concurrency() const
+{
+    std::lock_guard<std::mutex> lck(m_mutex);
+    return m_num_ctx;
+}
 
-    m_mutex.lock();
-    m_id_pool[id] = true;
-    m_num_ctx_available++;
-    m_mutex.unlock();
-    m_cv.notify_one();
+void runtime::cpu::CPU_CallFrame::set_idle_timeout(std::chrono::milliseconds timeout)
+{
+    {
+        std::lock_guard<std::mutex> lck(m_mutex);
+        m_idle_timeout = timeout;
+        // The sweep already scheduled may be later than the new timeout allows
+        m_idle_sweep_deadline = std::chrono::steady_clock::time_point::max();
+    }
+    release_idle_contexts();
+}
+
+void runtime::cpu::CPU_CallFrame::release_idle_contexts()
+{
+    vector<CPURuntimeContext*> idle;
+    {
+        std::lock_guard<std::mutex> lck(m_mutex);
+        take_idle_contexts(idle);
+    }
+    for (CPURuntimeContext* ctx : idle)
+    {
+        destroy_runtime_context(ctx);
+    }
+}
+
+size_t runtime::cpu::CPU_CallFrame::get_context_count() const
+{
+    std::lock_guard<std::mutex> lck(m_mutex);
+    return count_if(m_ctx_vec.begin(), m_ctx_vec.end(), [](CPURuntimeContext* ctx) {
+        return ctx != nullptr;
+    });
 }
 
 void runtime::cpu::CPU_CallFrame::propagate_layouts(
@@ -181,121 +409,136 @@ void runtime::cpu::CPU_CallFrame::propagate_layouts(
 
 void runtime::cpu::CPU_CallFrame::setup_runtime_context(Allocator* allocator)
 {
+    m_allocator = allocator;
+    if (!m_external_function->is_direct_execution())
+    {
+        // single thread for codegen
+        NGRAPH_CHECK(m_num_ctx == 1);
+    }
+    // Only the first context is created up front, the others when concurrent calls need them
     for (size_t i = 0; i < m_num_ctx; i++)
     {
         m_id_pool[i] = true;
-        auto ctx = new CPURuntimeContext;
-        m_ctx_vec.push_back(ctx);
+        m_ctx_vec.push_back(i == 0 ? create_runtime_context() : nullptr);
+        m_last_used.push_back(std::chrono::steady_clock::now());
+    }
+    m_num_ctx_available = m_num_ctx;
+}
 
-        ctx->pc = 0;
-        ctx->op_durations = nullptr;
-        if (runtime::cpu::IsTracingEnabled())
-        {
-            ctx->op_durations = new int64_t[m_external_function->get_op_attrs().size()];
-        }
-        ctx->p_en = new bool[m_external_function->get_parameter_layout_descriptors().size()];
+runtime::cpu::CPURuntimeContext* runtime::cpu::CPU_CallFrame::create_runtime_context()
+{
+    auto ctx = new CPURuntimeContext;
 
-        ctx->first_iteration = true;
+    ctx->pc = 0;
+    ctx->op_durations = nullptr;
+    if (runtime::cpu::IsTracingEnabled())
+    {
+        ctx->op_durations = new int64_t[m_external_function->get_op_attrs().size()];
+    }
+    ctx->p_en = new bool[m_external_function->get_parameter_layout_descriptors().size()];
 
-        ctx->buffer_data = std::vector<void*>(m_external_function->get_buffer_size());
+    ctx->first_iteration = true;
 
-        // Create temporary buffer pools
-        size_t alignment = runtime::cpu::CPU_ExternalFunction::s_memory_pool_alignment;
-        for (auto buffer_size : m_external_function->get_memory_buffer_sizes())
-        {
-            auto buffer = new AlignedBuffer(buffer_size, alignment, allocator);
-            ctx->memory_buffers.push_back(buffer);
-        }
-        const auto& mkldnn_emitter = m_external_function->get_mkldnn_emitter();
-        // Create scratchpad
-        auto scratchpad_size = mkldnn_emitter->get_max_scratchpad_size();
-        if (m_external_function->is_direct_execution())
-        {
-            ctx->mkldnn_primitives =
-                std::vector<mkldnn::primitive*>(mkldnn_emitter->get_mkldnn_primitives().size());
-            ctx->mkldnn_memories =
-                std::vector<mkldnn::memory*>(mkldnn_emitter->get_mkldnn_memories().size());
-            ctx->mkldnn_scratchpad_mds = std::vector<mkldnn::memory::desc*>(
-                mkldnn_emitter->get_mkldnn_scratchpad_mds().size());
-            ctx->scratchpad_buffer = new AlignedBuffer(scratchpad_size, alignment);
-        }
-        else
-        {
-            // single thread for codegen
-            NGRAPH_CHECK(m_num_ctx == 1);
-        }
+    ctx->buffer_data = std::vector<void*>(m_external_function->get_buffer_size());
 
-        ctx->states = m_external_function->m_states.data();
+    // Create temporary buffer pools
+    size_t alignment = runtime::cpu::CPU_ExternalFunction::s_memory_pool_alignment;
+    for (auto buffer_size : m_external_function->get_memory_buffer_sizes())
+    {
+        auto buffer = new AlignedBuffer(buffer_size, alignment, m_allocator);
+        ctx->memory_buffers.push_back(buffer);
+    }
+    const auto& mkldnn_emitter = m_external_function->get_mkldnn_emitter();
+    // Create scratchpad
+    auto scratchpad_size = mkldnn_emitter->get_max_scratchpad_size();
+    if (m_external_function->is_direct_execution())
+    {
+        ctx->mkldnn_primitives =
+            std::vector<mkldnn::primitive*>(mkldnn_emitter->get_mkldnn_primitives().size());
+        ctx->mkldnn_memories =
+            std::vector<mkldnn::memory*>(mkldnn_emitter->get_mkldnn_memories().size());
+        ctx->mkldnn_scratchpad_mds = std::vector<mkldnn::memory::desc*>(
+            mkldnn_emitter->get_mkldnn_scratchpad_mds().size());
+        ctx->scratchpad_buffer = new AlignedBuffer(scratchpad_size, alignment);
+    }
+
+    ctx->states = m_external_function->m_states.data();
 #if defined(NGRAPH_TBB_ENABLE)
-        if (m_external_function->is_direct_execution() &&
-            std::getenv("NGRAPH_CPU_USE_TBB") != nullptr)
-        {
-            // For codegen mode, graph and global control are now part of the code generated
-            // CPURuntimeContextCG class.
-            ctx->G = new tbb::flow::graph;
-            const auto envParallelism = std::getenv("NGRAPH_INTER_OP_PARALLELISM");
-            const auto parallelism = envParallelism == nullptr ? 1 : std::atoi(envParallelism);
-            ctx->c =
-                new tbb::global_control(tbb::global_control::max_allowed_parallelism, parallelism);
-        }
-#endif
+    if (m_external_function->is_direct_execution() &&
+        std::getenv("NGRAPH_CPU_USE_TBB") != nullptr)
+    {
+        // For codegen mode, graph and global control are now part of the code generated
+        // CPURuntimeContextCG class.
+        ctx->G = new tbb::flow::graph;
+        const auto envParallelism = std::getenv("NGRAPH_INTER_OP_PARALLELISM");
+        const auto parallelism = envParallelism == nullptr ? 1 : std::atoi(envParallelism);
+        ctx->c = new tbb::global_control(tbb::global_control::max_allowed_parallelism, parallelism);
     }
-    m_num_ctx_available = m_num_ctx;
+#endif
+    return ctx;
 }
 
 void runtime::cpu::CPU_CallFrame::cleanup_runtime_context()
 {
-    for (size_t i = 0; i < m_num_ctx; i++)
+    while (!m_ctx_vec.empty())
     {
-        auto ctx = m_ctx_vec.back();
-        m_ctx_vec.pop_back();
-
-        delete[] ctx->op_durations;
-        delete[] ctx->p_en;
-        for (auto p : ctx->mkldnn_primitives)
-        {
-            delete p;
-        }
-        for (auto m : ctx->mkldnn_memories)
-        {
-            delete m;
-        }
-        for (auto buffer : ctx->memory_buffers)
-        {
-            delete buffer;
-        }
-        for (auto s : ctx->mkldnn_scratchpad_mds)
+        if (m_ctx_vec.back() != nullptr)
         {
-            delete s;
-        }
-        if (m_external_function->is_direct_execution())
-        {
-            delete ctx->scratchpad_buffer;
+            destroy_runtime_context(m_ctx_vec.back());
         }
+        m_ctx_vec.pop_back();
+    }
+    m_last_used.clear();
+    m_id_pool.clear();
+    m_num_ctx_available = 0;
+}
+
+void runtime::cpu::CPU_CallFrame::destroy_runtime_context(CPURuntimeContext* ctx)
+{
+    delete[] ctx->op_durations;
+    delete[] ctx->p_en;
+    for (auto p : ctx->mkldnn_primitives)
+    {
+        delete p;
+    }
+    for (auto m : ctx->mkldnn_memories)
+    {
+        delete m;
+    }
+    for (auto buffer : ctx->memory_buffers)
+    {
+        delete buffer;
+    }
+    for (auto s : ctx->mkldnn_scratchpad_mds)
+    {
+        delete s;
+    }
+    if (m_external_function->is_direct_execution())
+    {
+        delete ctx->scratchpad_buffer;
+    }
 
 #if defined(NGRAPH_TBB_ENABLE)
-        if (m_external_function->is_direct_execution() &&
-            std::getenv("NGRAPH_CPU_USE_TBB") != nullptr)
-        {
-            // For codegen mode, graph and global control are now part of a code generated
-            // CPURuntimeContext class.
+    if (m_external_function->is_direct_execution() &&
+        std::getenv("NGRAPH_CPU_USE_TBB") != nullptr)
+    {
+        // For codegen mode, graph and global control are now part of a code generated
+        // CPURuntimeContext class.
 
-            // delete graph G and nodes in G
-            ctx->G->wait_for_all();
-            std::vector<tbb::flow::graph_node*> to_be_deleted;
-            for (auto it = ctx->G->begin(); it != ctx->G->end(); it++)
-            {
-                to_be_deleted.push_back(&(*it));
-            }
-            delete ctx->G;
-            for (auto node : to_be_deleted)
-            {
-                delete node;
-            }
-            delete ctx->c;
+        // delete graph G and nodes in G
+        ctx->G->wait_for_all();
+        std::vector<tbb::flow::graph_node*> to_be_deleted;
+        for (auto it = ctx->G->begin(); it != ctx->G->end(); it++)
+        {
+            to_be_deleted.push_back(&(*it));
         }
-#endif
-        delete ctx;
+        delete ctx->G;
+        for (auto node : to_be_deleted)
+        {
+            delete node;
+        }
+        delete ctx->c;
     }
-    m_num_ctx_available = 0;
+#endif
+    delete ctx;
 }
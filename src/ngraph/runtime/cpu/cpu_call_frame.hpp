@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <condition_variable>
 #include <functional>
 #include <memory>
@@ -39,6 +40,7 @@ namespace ngraph
         {
             class CPU_ExternalFunction;
             class CPU_Debugger;
+            class TimelineRecorder;
 
             using InitContextFuncTy = CPURuntimeContextCG*();
             using DestroyContextFuncTy = void(CPURuntimeContextCG*);
@@ -52,7 +54,7 @@ namespace ngraph
             using EntryPoint = std::function<EntryPointTy>;
 
             // Compile and execute graphs
-            class CPU_CallFrame
+            class CPU_CallFrame : public std::enable_shared_from_this<CPU_CallFrame>
             {
             public:
                 friend class CPU_Debugger;
@@ -70,6 +72,33 @@ namespace ngraph
                 void call(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
                           const std::vector<std::shared_ptr<runtime::Tensor>>& inputs);
 
+                /// \brief Invoke the function if an execution context is free.
+                /// \returns false without running anything if every context is busy
+                bool try_call(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
+                              const std::vector<std::shared_ptr<runtime::Tensor>>& inputs);
+
+                /// \brief Set the maximum number of execution contexts, which bounds the number
+                ///        of concurrent calls. Contexts being removed are released once the calls
+                ///        running on them complete. The initial value is taken from
+                ///        NGRAPH_CPU_CONCURRENCY, or 1 if it is not set.
+                void set_concurrency(size_t num_ctx);
+                size_t get_concurrency() const;
+
+                /// \brief Set how long an additional context may stay unused before its memory
+                ///        is released. The first context is never released. The initial value
+                ///        is taken from NGRAPH_CPU_CONTEXT_IDLE_TIMEOUT in milliseconds, or 10s
+                ///        if it is not set. Idle contexts are released by a timer on the
+                ///        executor, so callers need not poll release_idle_contexts.
+                void set_idle_timeout(std::chrono::milliseconds timeout);
+
+                /// \brief Release the contexts that have been idle for longer than the idle
+                ///        timeout now, rather than when the timer next fires.
+                void release_idle_contexts();
+
+                /// \brief The number of contexts currently allocated. Contexts beyond the first
+                ///        are only allocated when concurrent calls need them.
+                size_t get_context_count() const;
+
                 void propagate_layouts(const std::vector<std::shared_ptr<runtime::Tensor>>& tvs,
                                        const LayoutDescriptorPtrs& layouts) const;
 
@@ -84,18 +113,44 @@ namespace ngraph
 
                 void inner_call(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
                                 const std::vector<std::shared_ptr<runtime::Tensor>>& inputs,
-                                const size_t id,
+                                CPURuntimeContext* ctx,
                                 const bool disable_caching = true);
 
+                CPURuntimeContext* create_runtime_context();
+                void destroy_runtime_context(CPURuntimeContext* ctx);
+
+                // Must be called with m_mutex held. Returns false if no context is free. ctx is
+                // nullptr if the slot that was reserved has no context yet.
+                bool acquire_context(size_t& id, CPURuntimeContext*& ctx, bool& disable_caching);
+                void release_context(size_t id);
+                // Must be called with m_mutex held. Detaches idle contexts for destruction and
+                // schedules a sweep for when the remaining free contexts time out.
+                void take_idle_contexts(std::vector<CPURuntimeContext*>& idle);
+                void execute(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
+                             const std::vector<std::shared_ptr<runtime::Tensor>>& inputs,
+                             size_t id,
+                             CPURuntimeContext* ctx,
+                             bool disable_caching);
+
                 std::shared_ptr<CPU_ExternalFunction> m_external_function;
+                runtime::Allocator* m_allocator = nullptr;
 
-                std::mutex m_mutex;
+                mutable std::mutex m_mutex;
+                std::mutex m_resize_mutex;
                 std::condition_variable m_cv;
                 volatile size_t m_num_ctx_available = 0;
                 size_t m_prev_ctx = 0;
                 size_t m_num_ctx = 1;
                 std::unordered_map<size_t, bool> m_id_pool;
+                // One slot per context id, nullptr until the context is first needed
                 std::vector<CPURuntimeContext*> m_ctx_vec;
+                std::vector<std::chrono::steady_clock::time_point> m_last_used;
+                std::chrono::milliseconds m_idle_timeout{10000};
+                // When the next scheduled sweep of idle contexts runs, max() if none is
+                std::chrono::steady_clock::time_point m_idle_sweep_deadline =
+                    std::chrono::steady_clock::time_point::max();
+                // Only set when NGRAPH_CPU_TRACING is set
+                std::unique_ptr<TimelineRecorder> m_timeline;
 
                 // Codegen specific
 
@@ -57,7 +57,7 @@ bool runtime::cpu::CPU_Debugger::step()
 
     bool is_set = ctx->breakpoints.count(ctx->pc + 1) != 0;
     ctx->breakpoints.insert(ctx->pc + 1);
-    m_callframe.inner_call(m_outputs, m_inputs, 0);
+    m_callframe.inner_call(m_outputs, m_inputs, m_callframe.m_ctx_vec[0]);
     if (!is_set)
     {
         ctx->breakpoints.erase(ctx->pc);
@@ -73,7 +73,7 @@ void runtime::cpu::CPU_Debugger::resume()
         return;
     }
 
-    m_callframe.inner_call(m_outputs, m_inputs, 0);
+    m_callframe.inner_call(m_outputs, m_inputs, m_callframe.m_ctx_vec[0]);
     return;
 }
 
@@ -83,7 +83,7 @@ void runtime::cpu::CPU_Debugger::call(const std::vector<std::shared_ptr<runtime:
     m_outputs.assign(outputs.begin(), outputs.end());
     m_inputs.assign(inputs.begin(), inputs.end());
     m_callframe.m_ctx_vec[0]->pc = 0;
-    m_callframe.inner_call(m_outputs, m_inputs, 0);
+    m_callframe.inner_call(m_outputs, m_inputs, m_callframe.m_ctx_vec[0]);
 }
 
 std::tuple<bool, size_t> runtime::cpu::CPU_Debugger::find_pc_for_node(std::shared_ptr<Node> op)
@@ -67,6 +67,23 @@ static int GetNumThreadPools()
     return count < 1 ? 1 : count;
 }
 
+static int GetNumAsyncThreads()
+{
+    const auto ngraph_async_threads = std::getenv("NGRAPH_CPU_ASYNC_THREADS");
+    int count = 0;
+
+    if (ngraph_async_threads)
+    {
+        count = std::atoi(ngraph_async_threads);
+    }
+    else
+    {
+        count = std::thread::hardware_concurrency() / 2;
+    }
+
+    return count < 1 ? 1 : count;
+}
+
 namespace ngraph
 {
     namespace runtime
@@ -140,6 +157,71 @@ namespace ngraph
                 }
 #endif
 
+                void CPUExecutor::schedule(std::function<void()> task)
+                {
+                    std::call_once(m_dispatch_pool_flag, [this]() {
+                        m_dispatch_pool.reset(new Eigen::ThreadPool(GetNumAsyncThreads()));
+                    });
+                    m_dispatch_pool->Schedule(std::move(task));
+                }
+
+                void CPUExecutor::schedule_at(std::chrono::steady_clock::time_point deadline,
+                                              std::function<void()> task)
+                {
+                    std::lock_guard<std::mutex> lock(m_timer_mutex);
+                    if (!m_timer_thread.joinable())
+                    {
+                        m_timer_thread = std::thread([this]() { run_timers(); });
+                    }
+                    m_timers.emplace(deadline, std::move(task));
+                    m_timer_cv.notify_one();
+                }
+
+                void CPUExecutor::run_timers()
+                {
+                    std::unique_lock<std::mutex> lock(m_timer_mutex);
+                    while (!m_timer_stop)
+                    {
+                        if (m_timers.empty())
+                        {
+                            m_timer_cv.wait(lock);
+                            continue;
+                        }
+                        auto first = m_timers.begin();
+                        if (first->first > std::chrono::steady_clock::now())
+                        {
+                            m_timer_cv.wait_until(lock, first->first);
+                            continue;
+                        }
+                        std::function<void()> task = std::move(first->second);
+                        m_timers.erase(first);
+                        lock.unlock();
+                        schedule(std::move(task));
+                        lock.lock();
+                    }
+                }
+
+                CPUExecutor::~CPUExecutor()
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(m_timer_mutex);
+                        m_timer_stop = true;
+                    }
+                    m_timer_cv.notify_one();
+                    if (m_timer_thread.joinable())
+                    {
+                        m_timer_thread.join();
+                    }
+                }
+
+                void CPUExecutor::schedule_inter_op(std::function<void()> task)
+                {
+                    std::call_once(m_inter_op_pool_flag, [this]() {
+                        m_inter_op_pool.reset(new Eigen::ThreadPool(m_num_thread_pools));
+                    });
+                    m_inter_op_pool->Schedule(std::move(task));
+                }
+
                 CPUExecutor& GetCPUExecutor()
                 {
                     static int num_thread_pools = GetNumThreadPools();
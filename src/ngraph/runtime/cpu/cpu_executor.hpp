@@ -16,7 +16,11 @@
 
 #pragma once
 
+#include <chrono>
+#include <condition_variable>
 #include <functional>
+#include <map>
+#include <mutex>
 #include <thread>
 
 #include <mkldnn.hpp>
@@ -45,6 +49,7 @@ namespace ngraph
                 {
                 public:
                     explicit CPUExecutor(int num_thread_pools);
+                    ~CPUExecutor();
 
                     Eigen::ThreadPoolDevice& get_device(int id)
                     {
@@ -63,12 +68,40 @@ namespace ngraph
 #endif
                     int get_num_thread_pools() { return m_num_thread_pools; }
                     int get_num_cores() { return m_num_cores; }
+                    /// \brief Run task on the dispatch pool used for asynchronous calls.
+                    ///        The dispatch pool is separate from the compute pools so a
+                    ///        call blocking on kernels never starves the kernels it waits on.
+                    ///        Its size is set by NGRAPH_CPU_ASYNC_THREADS.
+                    void schedule(std::function<void()> task);
+                    /// \brief Run task on the dispatch pool once deadline has passed. Tasks
+                    ///        still pending when the executor is destroyed are dropped.
+                    void schedule_at(std::chrono::steady_clock::time_point deadline,
+                                     std::function<void()> task);
+                    /// \brief Run task on the pool that runs the helper workers of the
+                    ///        inter-op scheduler. Kernels still run on the compute pools, so
+                    ///        a worker waiting on a parallel kernel never blocks the kernel.
+                    void schedule_inter_op(std::function<void()> task);
+
                 private:
+                    // Body of m_timer_thread, which hands the tasks given to schedule_at
+                    // to the dispatch pool when they are due
+                    void run_timers();
+
                     std::vector<std::unique_ptr<Eigen::ThreadPool>> m_thread_pools;
                     std::vector<std::unique_ptr<Eigen::ThreadPoolDevice>> m_thread_pool_devices;
 #if defined(NGRAPH_TBB_ENABLE)
                     std::vector<tbb::task_arena> m_tbb_arenas;
 #endif
+                    std::unique_ptr<Eigen::ThreadPool> m_dispatch_pool;
+                    std::once_flag m_dispatch_pool_flag;
+                    std::unique_ptr<Eigen::ThreadPool> m_inter_op_pool;
+                    std::once_flag m_inter_op_pool_flag;
+                    std::thread m_timer_thread;
+                    std::mutex m_timer_mutex;
+                    std::condition_variable m_timer_cv;
+                    std::multimap<std::chrono::steady_clock::time_point, std::function<void()>>
+                        m_timers;
+                    bool m_timer_stop = false;
                     int m_num_thread_pools;
                     int m_num_cores;
                 };
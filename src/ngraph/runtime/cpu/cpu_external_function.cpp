@@ -14,10 +14,12 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <algorithm>
 #include <cstdlib>
 #include <fstream>
 #include <memory>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <typeindex>
 #include <typeinfo>
@@ -39,6 +41,10 @@
 #include "contrib/mlir/compiler/pass/mlir_subgraph_extraction.hpp"
 #endif
 
+#ifndef NGRAPH_JSON_DISABLE
+#include "nlohmann/json.hpp"
+#endif
+
 #include "ngraph/descriptor/input.hpp"
 #include "ngraph/descriptor/output.hpp"
 #include "ngraph/file_util.hpp"
@@ -192,12 +198,14 @@
 #include "ngraph/runtime/cpu/pass/cpu_fusion.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_horizontal_fusion.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_layout.hpp"
+#include "ngraph/runtime/cpu/pass/cpu_loop_kernel_fusion.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_mat_fusion.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_memory_assignment.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_memory_optimization.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_mkldnn_primitive_build.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_post_layout_optimizations.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_rnn_fusion.hpp"
+#include "ngraph/runtime/cpu/pass/cpu_weight_pooling.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_workspace_insertion.hpp"
 #include "ngraph/runtime/cpu/pass/halide_subgraph_extraction.hpp"
 
@@ -250,6 +258,7 @@ runtime::cpu::CPU_ExternalFunction::CPU_ExternalFunction(
     , m_compiled_function(nullptr)
     , m_function_name(function->get_name())
     , m_is_built(false)
+    , m_inter_op_parallelism(executor::GetCPUExecutor().get_num_thread_pools())
 {
 }
 
@@ -1258,20 +1267,41 @@ void runtime::cpu::CPU_ExternalFunction::register_common_passes(
     NodeVector nv_cwi; // We dont need CPUWorkspaceInsertion to return list of indices
     REGISTER_KNOBBED_PASS_WITH_ARGS(CPUWorkspaceInsertion, true, runtime::cpu::pass, nv_cwi, false)
     REGISTER_KNOBBED_PASS_WITH_ARGS(CPUAssignment, true, runtime::cpu::pass, this)
+    // Ops with a CPU executor fold through the CPU kernels, which manage their own threads.
+    // The reference kernels used for the rest keep the ConstantFolding default of one thread
+    // unless NGRAPH_CONSTANT_FOLDING_THREADS asks for a pool: the backend has no ThreadPool to
+    // lend, and one created for compiling would compete with the compute pools whenever a
+    // model is compiled while other executables run.
     REGISTER_KNOBBED_PASS_WITH_ARGS(ConstantFolding, true, ngraph::pass, GetGlobalCFDispatcherCPU())
+    if (dex)
+    {
+        REGISTER_KNOBBED_PASS(CPULoopKernelFusion, true, runtime::cpu::pass)
+    }
     REGISTER_KNOBBED_PASS_WITH_ARGS(CPULayout, true, runtime::cpu::pass, this)
     REGISTER_KNOBBED_PASS_WITH_ARGS(
         CommonSubexpressionElimination, true, ngraph::pass, runtime::cpu::get_cse_handlers_map())
     REGISTER_KNOBBED_PASS(CPUPostLayoutOptimizations, true, runtime::cpu::pass)
     REGISTER_KNOBBED_PASS(CPUConvertLayoutConstantFolding, true, runtime::cpu::pass)
+    if (m_weight_pool)
+    {
+        REGISTER_KNOBBED_PASS_WITH_ARGS(CPUWeightPooling, true, runtime::cpu::pass, m_weight_pool)
+    }
     REGISTER_KNOBBED_PASS(CPUMemoryOptimization, true, runtime::cpu::pass)
     REGISTER_KNOBBED_PASS(GetOutputElementElimination, false, ngraph::pass)
     REGISTER_KNOBBED_PASS_WITH_ARGS(
         PropagateCacheability, true, ngraph::pass, runtime::cpu::get_annotations_factory())
     bool reuse_memory = pass_config.get_pass_attribute("CPUMemoryAssignment::ReuseMemory") ||
                         pass_config.get_pass_attribute("ReuseMemory");
+    // Elementwise ops overwrite dead inputs unless the attribute is explicitly false
+    auto in_place_elementwise =
+        pass_config.get_pass_attributes().find("CPUMemoryAssignment::InPlaceElementwise");
     pass_manager.register_pass<runtime::cpu::pass::CPUMemoryAssignment>(
-        bufferID_to_tensorSets, tensor_to_bufferID, size_t(s_memory_pool_alignment), !reuse_memory);
+        bufferID_to_tensorSets,
+        tensor_to_bufferID,
+        size_t(s_memory_pool_alignment),
+        !reuse_memory,
+        in_place_elementwise == pass_config.get_pass_attributes().end() ||
+            in_place_elementwise->second);
 
     pass_manager.get_state().set_visualize_tree_ops_map(runtime::cpu::get_visualize_tree_ops_map());
 }
@@ -1400,9 +1430,16 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
     static const string s_debug_dir = "cpu_codegen";
     static StaticInitializers s_static_initializers(s_debug_dir);
     m_mkldnn_emitter.reset(new MKLDNNEmitter());
-    ngraph::pass::Manager pass_manager;
-    register_common_passes(pass_manager, pass_config);
-    pass_manager.run_passes(m_function, false);
+    if (m_compiled_state.empty())
+    {
+        ngraph::pass::Manager pass_manager;
+        register_common_passes(pass_manager, pass_config);
+        pass_manager.run_passes(m_function, false);
+    }
+    else
+    {
+        restore_compiled_state();
+    }
 
     static runtime::cpu::CPU_DebugTracer debug_tracer;
     if (std::getenv("NGRAPH_CPU_DEBUG_TRACER") != nullptr)
@@ -1475,6 +1512,8 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
         {
             auto output_tensor = &node->get_output_tensor();
             m_buffer_indices[output_tensor->get_name()] = buffer_index;
+            // The data may be shared with other Constants, so no kernel may write it. Memory
+            // assignment never makes a constant the target of a destructive in-place op.
             constant_tensor_data.emplace_back(
                 buffer_index,
                 const_cast<void*>(static_pointer_cast<ngraph::op::Constant>(node)->get_data_ptr()));
@@ -1539,6 +1578,38 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
     // After processing inputs, outputs, constants, and intermediates, set the buffer size.
     m_buffer_size = buffer_index;
 
+    // Ops can only run concurrently if there is an executor thread pool for each of them.
+    // To order ops that share memory, every buffer except the read-only constants is mapped
+    // to its memory space and offset. Space 0 stands for the MKLDNN scratchpad, which all
+    // MKLDNN primitives share.
+    bool schedule_inter_op = executor::GetCPUExecutor().get_num_thread_pools() > 1;
+#if defined(NGRAPH_TBB_ENABLE)
+    schedule_inter_op = schedule_inter_op && !m_use_tbb;
+#endif
+    unordered_map<size_t, pair<size_t, size_t>> buffer_space_offsets;
+    for (const auto& p : intermediates_offsets)
+    {
+        buffer_space_offsets[p.first] = {1, p.second};
+    }
+    for (const auto& p : function_input_index_offset)
+    {
+        buffer_space_offsets[get<0>(p)] = {2 + get<1>(p), get<2>(p)};
+    }
+    for (const auto& p : function_output_index_offset)
+    {
+        buffer_space_offsets[get<0>(p)] = {2 + arg_index + get<1>(p), get<2>(p)};
+    }
+    auto get_region = [&](const descriptor::Tensor& tensor,
+                          vector<InterOpScheduler::Region>& regions) {
+        auto it = buffer_space_offsets.find(get_buffer_index(tensor.get_name()));
+        if (it != buffer_space_offsets.end())
+        {
+            regions.push_back(
+                {it->second.first, it->second.second, it->second.second + tensor.size()});
+        }
+    };
+    unordered_map<const Node*, size_t> functor_index;
+
     for (shared_ptr<Node> node : m_function->get_ordered_ops())
     {
         if (node->is_parameter() || node->is_constant())
@@ -1581,6 +1652,35 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
         op_names.push_back(node->get_name());
         handler->second(this, node.get(), in, out);
 
+        if (schedule_inter_op)
+        {
+            vector<InterOpScheduler::Region> reads;
+            vector<InterOpScheduler::Region> writes;
+            for (const descriptor::Input& input : node->get_inputs())
+            {
+                get_region(input.get_output().get_tensor(), reads);
+            }
+            for (const descriptor::Output& output : node->get_outputs())
+            {
+                get_region(output.get_tensor(), writes);
+            }
+            if (mkldnn_utils::use_mkldnn_kernel(node.get()))
+            {
+                writes.push_back({0, 0, 1});
+            }
+            vector<size_t> after;
+            for (const auto& dependency : node->get_control_dependencies())
+            {
+                auto it = functor_index.find(dependency.get());
+                if (it != functor_index.end())
+                {
+                    after.push_back(it->second);
+                }
+            }
+            functor_index[node.get()] = m_inter_op_scheduler.get_op_count();
+            m_inter_op_scheduler.add_op(reads, writes, after);
+        }
+
         auto cacheable = true;
         auto reuse_memory = pass_config.get_pass_attribute("CPUMemoryAssignment::ReuseMemory") ||
                             pass_config.get_pass_attribute("ReuseMemory");
@@ -1750,6 +1850,13 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
             ctx->buffer_data[get<0>(p)] = static_cast<uint8_t*>(outputs[get<1>(p)]) + get<2>(p);
         }
 
+        // Breakpoints and the debug tracer step through ops in order, and the first iteration
+        // builds MKLDNN primitives, so those runs stay sequential
+        size_t inter_op_parallelism = get_inter_op_parallelism();
+        bool run_concurrently = inter_op_parallelism > 1 && !ctx->first_iteration &&
+                                ctx->pc == 0 && ctx->breakpoints.empty() &&
+                                !debug_tracer.tracing_is_enabled();
+
         auto functor = functors.begin();
 #if defined(NGRAPH_TBB_ENABLE)
         if (m_use_tbb)
@@ -1860,6 +1967,53 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
         }
         else
 #endif
+            if (run_concurrently)
+        {
+            m_inter_op_scheduler.run(inter_op_parallelism, [&](size_t index, size_t worker) {
+                if (!(enables.at(index))(ctx))
+                {
+                    if (runtime::cpu::IsTracingEnabled())
+                    {
+                        ctx->op_durations[index] = 0;
+                    }
+                    if (m_emit_timing)
+                    {
+                        m_perf_counters[index].m_call_count++;
+                    }
+                    return;
+                }
+
+                cpu::Timestamp op_start_ts;
+                if (runtime::cpu::IsTracingEnabled() || m_emit_timing)
+                {
+                    op_start_ts = cpu::Clock::now();
+                }
+                // Each worker runs its kernels on its own thread pool
+                CPUExecutionContext ectx{static_cast<int>(worker)};
+                executor::GetCPUExecutor().execute(functors.at(index), ctx, &ectx);
+                if (runtime::cpu::IsTracingEnabled() || m_emit_timing)
+                {
+                    auto op_end_ts = cpu::Clock::now();
+                    if (runtime::cpu::IsTracingEnabled())
+                    {
+                        ctx->op_durations[index] =
+                            (std::chrono::duration_cast<cpu::Timescale>(op_end_ts - op_start_ts))
+                                .count();
+                    }
+                    if (m_emit_timing)
+                    {
+                        m_perf_counters[index].m_total_microseconds +=
+                            std::chrono::duration_cast<std::chrono::microseconds>(op_end_ts -
+                                                                                  op_start_ts)
+                                .count();
+                        m_perf_counters[index].m_call_count++;
+                    }
+                }
+            });
+            ctx->pc = functors.size();
+            profiler_count = functors.size();
+        }
+        else
         {
             static const auto ddebug = std::getenv("NGRAPH_DEX_DEBUG");
             if (ddebug != nullptr)
@@ -1977,6 +2131,16 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
     }
 }
 
+size_t runtime::cpu::CPU_ExternalFunction::get_inter_op_parallelism() const
+{
+    auto& cpu_executor = executor::GetCPUExecutor();
+    size_t max_by_cores = std::thread::hardware_concurrency() /
+                          static_cast<size_t>(std::max(cpu_executor.get_num_cores(), 1));
+    size_t max_width =
+        std::min(static_cast<size_t>(cpu_executor.get_num_thread_pools()), max_by_cores);
+    return std::max<size_t>(1, std::min<size_t>(m_inter_op_parallelism, max_width));
+}
+
 size_t runtime::cpu::CPU_ExternalFunction::get_buffer_index(const std::string& name)
 {
     if (tensor_alias.count(name))
@@ -2013,8 +2177,8 @@ shared_ptr<ngraph::runtime::cpu::CPU_CallFrame>
                        "back to DEX instead";
     }
 #else
-    // Override DEX if pass_config requests CODEGEN
-    if (is_codegen(pass_config))
+    // Override DEX if pass_config requests CODEGEN. Restored functions only run in DEX.
+    if (is_codegen(pass_config) && m_compiled_state.empty())
     {
         m_direct_execution = false;
     }
@@ -2255,3 +2419,183 @@ std::unordered_set<descriptor::Tensor*>&
     NGRAPH_CHECK(output_buffer_it != bufferID_to_tensorSets.end());
     return output_buffer_it->second.second;
 }
+
+#ifndef NGRAPH_JSON_DISABLE
+string runtime::cpu::CPU_ExternalFunction::get_compiled_state(const shared_ptr<Function>& function)
+{
+    using json = nlohmann::json;
+    unordered_map<const descriptor::Tensor*, pair<size_t, size_t>> tensor_positions;
+    json nodes = json::array();
+    size_t ordinal = 0;
+    for (const shared_ptr<Node>& node : function->get_ordered_ops())
+    {
+        json node_js;
+        node_js["op"] = node->description();
+        json outputs = json::array();
+        for (size_t i = 0; i < node->get_output_size(); i++)
+        {
+            const descriptor::Tensor& tensor = node->get_output_tensor(i);
+            tensor_positions[&tensor] = {ordinal, i};
+            json output;
+            output["pool_offset"] = tensor.get_pool_offset();
+            auto layout = dynamic_pointer_cast<LayoutDescriptor>(tensor.get_tensor_layout());
+            if (!layout)
+            {
+                throw ngraph_error("Cannot save " + node->get_name() + " without a CPU layout");
+            }
+            if (layout->is_mkldnn_layout())
+            {
+                output["mkldnn_md"] = mkldnn_utils::mkldnn_md_to_string(layout->get_mkldnn_md());
+            }
+            outputs.push_back(output);
+        }
+        node_js["outputs"] = outputs;
+
+        auto op = dynamic_pointer_cast<ngraph::op::Op>(node);
+        if (op && op->get_op_annotations())
+        {
+            auto annotations = op->get_op_annotations();
+            json annotations_js;
+            auto cpu_annotations = dynamic_pointer_cast<CPUOpAnnotations>(annotations);
+            annotations_js["mkldnn_op"] = cpu_annotations && cpu_annotations->is_mkldnn_op();
+            annotations_js["cacheable"] = annotations->is_cacheable();
+            json in_place = json::array();
+            for (auto& oi : annotations->get_in_place_oi_pairs())
+            {
+                in_place.push_back({oi.output, oi.input, oi.destructive});
+            }
+            annotations_js["in_place"] = in_place;
+            node_js["annotations"] = annotations_js;
+        }
+        nodes.push_back(node_js);
+        ordinal++;
+    }
+
+    json buffers = json::array();
+    for (auto& buffer : bufferID_to_tensorSets)
+    {
+        json tensors = json::array();
+        for (descriptor::Tensor* tensor : buffer.second.second)
+        {
+            auto it = tensor_positions.find(tensor);
+            // Tensors of nodes the passes removed are no longer in the graph
+            if (it != tensor_positions.end())
+            {
+                tensors.push_back({it->second.first, it->second.second});
+            }
+        }
+        json buffer_js;
+        buffer_js["id"] = buffer.first;
+        buffer_js["role"] = static_cast<int>(buffer.second.first);
+        buffer_js["tensors"] = tensors;
+        buffers.push_back(buffer_js);
+    }
+
+    json state;
+    state["nodes"] = nodes;
+    state["buffers"] = buffers;
+    state["temporary_pool_size"] = function->get_temporary_pool_size();
+    return state.dump();
+}
+
+void runtime::cpu::CPU_ExternalFunction::set_compiled_state(const string& state)
+{
+    m_compiled_state = state;
+    m_direct_execution = true;
+}
+
+void runtime::cpu::CPU_ExternalFunction::restore_compiled_state()
+{
+    using json = nlohmann::json;
+    // Constants are replaced by pooled ones in place, so the node positions do not change
+    if (m_weight_pool)
+    {
+        runtime::cpu::pass::CPUWeightPooling(m_weight_pool).run_on_function(m_function);
+    }
+
+    json state = json::parse(m_compiled_state);
+    const json& nodes = state.at("nodes");
+    auto ordered_ops = m_function->get_ordered_ops();
+    vector<shared_ptr<Node>> ops(ordered_ops.begin(), ordered_ops.end());
+    if (nodes.size() != ops.size())
+    {
+        throw ngraph_error("Saved CPU state has " + to_string(nodes.size()) +
+                           " ops but the saved graph has " + to_string(ops.size()));
+    }
+    for (size_t ordinal = 0; ordinal < ops.size(); ordinal++)
+    {
+        const shared_ptr<Node>& node = ops[ordinal];
+        const json& node_js = nodes[ordinal];
+        const json& outputs = node_js.at("outputs");
+        if (node_js.at("op").get<string>() != node->description() ||
+            outputs.size() != node->get_output_size())
+        {
+            throw ngraph_error("Saved CPU state does not match the saved graph at " +
+                               node->get_name());
+        }
+        for (size_t i = 0; i < outputs.size(); i++)
+        {
+            descriptor::Tensor& tensor = node->get_output_tensor(i);
+            auto layout = make_shared<LayoutDescriptor>(tensor);
+            if (outputs[i].count("mkldnn_md"))
+            {
+                layout->set_mkldnn_md(
+                    mkldnn_utils::mkldnn_md_from_string(outputs[i].at("mkldnn_md")));
+            }
+            tensor.set_tensor_layout(layout);
+            tensor.set_pool_offset(outputs[i].at("pool_offset").get<size_t>());
+        }
+
+        auto op = dynamic_pointer_cast<ngraph::op::Op>(node);
+        if (op && node_js.count("annotations"))
+        {
+            const json& annotations_js = node_js.at("annotations");
+            auto annotations = make_shared<CPUOpAnnotations>();
+            annotations->set_mkldnn_op(annotations_js.at("mkldnn_op").get<bool>());
+            annotations->set_cacheable(annotations_js.at("cacheable").get<bool>());
+            for (const json& oi : annotations_js.at("in_place"))
+            {
+                annotations->add_in_place_oi_pair(
+                    {oi.at(0).get<size_t>(), oi.at(1).get<size_t>(), oi.at(2).get<bool>()});
+            }
+            op->set_op_annotations(annotations);
+        }
+    }
+
+    bufferID_to_tensorSets.clear();
+    tensor_to_bufferID.clear();
+    for (const json& buffer : state.at("buffers"))
+    {
+        size_t id = buffer.at("id").get<size_t>();
+        auto& tensor_set = bufferID_to_tensorSets[id];
+        tensor_set.first = static_cast<TensorRole>(buffer.at("role").get<int>());
+        for (const json& position : buffer.at("tensors"))
+        {
+            size_t ordinal = position.at(0).get<size_t>();
+            size_t output = position.at(1).get<size_t>();
+            if (ordinal >= ops.size() || output >= ops[ordinal]->get_output_size())
+            {
+                throw ngraph_error("Saved CPU buffer refers to a tensor not in the saved graph");
+            }
+            descriptor::Tensor* tensor = &ops[ordinal]->get_output_tensor(output);
+            tensor_set.second.insert(tensor);
+            tensor_to_bufferID[tensor] = id;
+        }
+    }
+    m_function->set_temporary_pool_size(state.at("temporary_pool_size").get<size_t>());
+}
+#else
+string runtime::cpu::CPU_ExternalFunction::get_compiled_state(const shared_ptr<Function>&)
+{
+    throw ngraph_error("CPU executables cannot be saved without JSON support");
+}
+
+void runtime::cpu::CPU_ExternalFunction::set_compiled_state(const string&)
+{
+    throw ngraph_error("CPU executables cannot be loaded without JSON support");
+}
+
+void runtime::cpu::CPU_ExternalFunction::restore_compiled_state()
+{
+}
+#endif
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <functional>
 #include <list>
 #include <map>
@@ -45,8 +46,10 @@
 #include "ngraph/pass/pass_config.hpp"
 #include "ngraph/runtime/cpu/cpu_call_frame.hpp"
 #include "ngraph/runtime/cpu/cpu_debug_tracer.hpp"
+#include "ngraph/runtime/cpu/cpu_inter_op_scheduler.hpp"
 #include "ngraph/runtime/cpu/cpu_layout_descriptor.hpp"
 #include "ngraph/runtime/cpu/cpu_tensor_view_wrapper.hpp"
+#include "ngraph/runtime/cpu/cpu_weight_pool.hpp"
 #include "ngraph/runtime/cpu/mkldnn_emitter.hpp"
 #include "ngraph/runtime/performance_counter.hpp"
 #include "ngraph/state/state.hpp"
@@ -177,12 +180,28 @@ namespace ngraph
                     return callees;
                 }
                 bool is_direct_execution() const { return m_direct_execution; }
+                /// \brief Set the number of ops that may run at once in DEX mode. Defaults to
+                ///        NGRAPH_INTER_OP_PARALLELISM.
+                void set_inter_op_parallelism(size_t width) { m_inter_op_parallelism = width; }
+                /// \brief The number of ops that run at once in DEX mode. Each running op uses
+                ///        its own executor thread pool for intra-op parallelism, so this is at
+                ///        most the number of pools and at most the number of cores divided by
+                ///        the intra-op threads of an op.
+                size_t get_inter_op_parallelism() const;
                 void write_to_file(const std::string& code,
                                    const std::string& directory,
                                    const std::string& filename);
 
                 const std::vector<PerformanceCounter>& get_perf_counters();
 
+                /// \brief The layouts, op annotations and memory assignment that the CPU passes
+                ///        left on function, the graph this external function was built from.
+                ///        Nodes are identified by their position in function's ordered ops.
+                std::string get_compiled_state(const std::shared_ptr<Function>& function);
+                /// \brief Use state from get_compiled_state instead of running the CPU passes.
+                ///        The function of this external function must be the saved graph.
+                void set_compiled_state(const std::string& state);
+
 #if defined(NGRAPH_HALIDE)
                 std::unordered_map<std::string, Halide::Func>& get_halide_functions()
                 {
@@ -221,6 +240,8 @@ namespace ngraph
                 // Register passes that are common to codegen and DEX
                 void register_common_passes(ngraph::pass::Manager& pass_manager,
                                             ngraph::pass::PassConfig& pass_config);
+                // Apply m_compiled_state to m_function
+                void restore_compiled_state();
 
                 bool computes_result(Node* node);
                 void release_function() { m_function = nullptr; }
@@ -261,6 +282,12 @@ namespace ngraph
                     get_tensor_set(descriptor::Tensor* output_tensor);
 
                 std::shared_ptr<ngraph::Function> m_function;
+                // Set when the function was compiled before it was saved, in which case
+                // build() restores this instead of running the passes
+                std::string m_compiled_state;
+                // Pool the constants are shared through, set by the backend that compiles
+                // the function
+                std::shared_ptr<CPUWeightPool> m_weight_pool;
                 bool m_release_function;
                 bool m_emit_timing;
 
@@ -342,6 +369,9 @@ namespace ngraph
                 std::unordered_map<std::string, std::shared_ptr<CPU_ExternalFunction>> callees;
                 bool m_is_built;
                 std::vector<runtime::PerformanceCounter> m_perf_counters;
+                // Dependencies of the ops in functors, used when ops run concurrently
+                InterOpScheduler m_inter_op_scheduler;
+                std::atomic<size_t> m_inter_op_parallelism;
 
 #if defined(NGRAPH_HALIDE)
                 std::unordered_map<std::string, Halide::Func> halide_functions;
@@ -0,0 +1,282 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <set>
+
+#include "ngraph/check.hpp"
+#include "ngraph/runtime/cpu/cpu_executor.hpp"
+#include "ngraph/runtime/cpu/cpu_inter_op_scheduler.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+static bool overlaps(const runtime::cpu::InterOpScheduler::Region& a,
+                     const runtime::cpu::InterOpScheduler::Region& b)
+{
+    return a.space == b.space && a.begin < b.end && b.begin < a.end;
+}
+
+static bool contains(const runtime::cpu::InterOpScheduler::Region& outer,
+                     const runtime::cpu::InterOpScheduler::Region& inner)
+{
+    return outer.space == inner.space && outer.begin <= inner.begin && inner.end <= outer.end;
+}
+
+void runtime::cpu::InterOpScheduler::add_op(const vector<Region>& reads,
+                                            const vector<Region>& writes,
+                                            const vector<size_t>& after)
+{
+    size_t op = m_predecessors.size();
+    set<size_t> predecessors;
+    for (size_t predecessor : after)
+    {
+        NGRAPH_CHECK(predecessor < op, "Op ", op, " cannot run after op ", predecessor);
+        predecessors.insert(predecessor);
+    }
+    for (const Access& access : m_accesses)
+    {
+        // Reads of the same memory do not conflict
+        if (access.write)
+        {
+            for (const Region& region : reads)
+            {
+                if (overlaps(access.region, region))
+                {
+                    predecessors.insert(access.op);
+                }
+            }
+        }
+        for (const Region& region : writes)
+        {
+            if (overlaps(access.region, region))
+            {
+                predecessors.insert(access.op);
+            }
+        }
+    }
+
+    m_accesses.erase(remove_if(m_accesses.begin(),
+                               m_accesses.end(),
+                               [&writes](const Access& access) {
+                                   for (const Region& region : writes)
+                                   {
+                                       if (contains(region, access.region))
+                                       {
+                                           return true;
+                                       }
+                                   }
+                                   return false;
+                               }),
+                     m_accesses.end());
+    for (const Region& region : reads)
+    {
+        m_accesses.push_back({op, region, false});
+    }
+    for (const Region& region : writes)
+    {
+        m_accesses.push_back({op, region, true});
+    }
+
+    m_predecessors.emplace_back(predecessors.begin(), predecessors.end());
+    m_successors.emplace_back();
+    for (size_t predecessor : predecessors)
+    {
+        m_successors[predecessor].push_back(op);
+    }
+    if (predecessors.empty())
+    {
+        m_roots.push_back(op);
+    }
+}
+
+namespace
+{
+    struct WorkQueue
+    {
+        mutex queue_mutex;
+        deque<size_t> ops;
+    };
+
+    // Per-run state. Workers that start after the run is over only touch this state, so it is
+    // shared with them rather than owned by the caller.
+    struct RunState
+    {
+        RunState(size_t op_count, size_t width)
+            : pending(new atomic<size_t>[op_count])
+            , queues(width)
+            , remaining(op_count)
+            , ready(0)
+            , failed(false)
+        {
+        }
+
+        unique_ptr<atomic<size_t>[]> pending;
+        vector<WorkQueue> queues;
+        atomic<size_t> remaining;
+        atomic<size_t> ready;
+        atomic<bool> failed;
+        exception_ptr error;
+        mutex error_mutex;
+        mutex idle_mutex;
+        condition_variable idle;
+
+        void push(size_t worker, size_t op)
+        {
+            {
+                lock_guard<mutex> lock(queues[worker].queue_mutex);
+                queues[worker].ops.push_back(op);
+            }
+            ready++;
+        }
+
+        // Take the most recent op from the worker's own queue, which likely uses data that is
+        // still in cache, or else the oldest op of another worker
+        bool pop(size_t worker, size_t& op)
+        {
+            for (size_t i = 0; i < queues.size(); i++)
+            {
+                WorkQueue& queue = queues[(worker + i) % queues.size()];
+                lock_guard<mutex> lock(queue.queue_mutex);
+                if (!queue.ops.empty())
+                {
+                    if (i == 0)
+                    {
+                        op = queue.ops.back();
+                        queue.ops.pop_back();
+                    }
+                    else
+                    {
+                        op = queue.ops.front();
+                        queue.ops.pop_front();
+                    }
+                    ready--;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void notify(bool all)
+        {
+            // Taking the lock orders the notification after a waiter's predicate check
+            lock_guard<mutex> lock(idle_mutex);
+            if (all)
+            {
+                idle.notify_all();
+            }
+            else
+            {
+                idle.notify_one();
+            }
+        }
+    };
+}
+
+void runtime::cpu::InterOpScheduler::run(size_t width,
+                                         const function<void(size_t, size_t)>& execute) const
+{
+    size_t op_count = m_predecessors.size();
+    if (op_count == 0)
+    {
+        return;
+    }
+    width = max<size_t>(1, min(width, op_count));
+
+    auto state = make_shared<RunState>(op_count, width);
+    for (size_t op = 0; op < op_count; op++)
+    {
+        state->pending[op] = m_predecessors[op].size();
+    }
+    for (size_t i = 0; i < m_roots.size(); i++)
+    {
+        state->push(i % width, m_roots[i]);
+    }
+
+    auto work = [this, state, &execute](size_t worker) {
+        while (true)
+        {
+            size_t op;
+            if (!state->pop(worker, op))
+            {
+                unique_lock<mutex> lock(state->idle_mutex);
+                state->idle.wait(lock,
+                                 [&state]() { return state->ready > 0 || state->remaining == 0; });
+                if (state->remaining == 0)
+                {
+                    return;
+                }
+                continue;
+            }
+
+            if (!state->failed)
+            {
+                try
+                {
+                    execute(op, worker);
+                }
+                catch (...)
+                {
+                    lock_guard<mutex> lock(state->error_mutex);
+                    if (!state->error)
+                    {
+                        state->error = current_exception();
+                    }
+                    state->failed = true;
+                }
+            }
+
+            size_t released = 0;
+            for (size_t successor : m_successors[op])
+            {
+                if (--state->pending[successor] == 0)
+                {
+                    state->push(worker, successor);
+                    released++;
+                }
+            }
+            if (--state->remaining == 0)
+            {
+                state->notify(true);
+                return;
+            }
+            // This worker takes one of the released ops itself
+            if (released > 1)
+            {
+                state->notify(released > 2);
+            }
+        }
+    };
+
+    for (size_t worker = 1; worker < width; worker++)
+    {
+        // A helper that starts after the run is over finds nothing to do. It cannot pick up
+        // an op once remaining is zero, so it never calls execute after run returns.
+        executor::GetCPUExecutor().schedule_inter_op([work, worker]() { work(worker); });
+    }
+    work(0);
+
+    if (state->error)
+    {
+        rethrow_exception(state->error);
+    }
+}
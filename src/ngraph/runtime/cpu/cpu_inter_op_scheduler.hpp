@@ -0,0 +1,91 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include "ngraph/runtime/cpu/cpu_backend_visibility.h"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            /// \brief Runs the ops of a DEX executor concurrently, in dependency order.
+            ///
+            /// Ops are added in their sequential execution order together with the memory they
+            /// read and write. An op depends on every earlier op whose accesses conflict with its
+            /// own, so buffers reused by memory assignment or updated in place keep the order of
+            /// the sequential schedule. Each worker runs ops from its own ready queue and steals
+            /// from the other workers when that queue is empty.
+            class CPU_BACKEND_API InterOpScheduler
+            {
+            public:
+                /// \brief A byte range [begin, end) within one memory space, such as the
+                ///        temporary pool or one function input.
+                struct Region
+                {
+                    size_t space;
+                    size_t begin;
+                    size_t end;
+                };
+
+                /// \brief Add the next op of the sequential schedule.
+                /// \param reads Memory read by the op
+                /// \param writes Memory written by the op
+                /// \param after Earlier ops that must complete first regardless of memory
+                void add_op(const std::vector<Region>& reads,
+                            const std::vector<Region>& writes,
+                            const std::vector<size_t>& after = {});
+
+                size_t get_op_count() const { return m_predecessors.size(); }
+                /// \brief The ops that must complete before op can start
+                const std::vector<size_t>& get_predecessors(size_t op) const
+                {
+                    return m_predecessors.at(op);
+                }
+
+                /// \brief Run every op once.
+                /// \param width Number of workers. The calling thread is worker 0, the others
+                ///        run on the executor's inter-op pool.
+                /// \param execute Called as execute(op, worker) for each op.
+                ///
+                /// If execute throws, ops that have not started are skipped and the first
+                /// exception is rethrown once the running ops finish.
+                void run(size_t width, const std::function<void(size_t, size_t)>& execute) const;
+
+            private:
+                struct Access
+                {
+                    size_t op;
+                    Region region;
+                    bool write;
+                };
+
+                std::vector<std::vector<size_t>> m_successors;
+                std::vector<std::vector<size_t>> m_predecessors;
+                std::vector<size_t> m_roots;
+                // Accesses that later ops may conflict with. An access is dropped once an
+                // overwrite of its whole range orders every later conflict after it.
+                std::vector<Access> m_accesses;
+            };
+        }
+    }
+}
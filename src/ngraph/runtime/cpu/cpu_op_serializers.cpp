@@ -0,0 +1,522 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include "ngraph/runtime/cpu/cpu_op_serializers.hpp"
+
+#ifndef NGRAPH_JSON_DISABLE
+#include "nlohmann/json.hpp"
+
+#include "ngraph/function.hpp"
+#include "ngraph/graph_util.hpp"
+#include "ngraph/op/parameter.hpp"
+#include "ngraph/op/result.hpp"
+#include "ngraph/runtime/cpu/cpu_layout_descriptor.hpp"
+#include "ngraph/runtime/cpu/mkldnn_utils.hpp"
+#include "ngraph/runtime/cpu/op/batch_mat_mul_transpose.hpp"
+#include "ngraph/runtime/cpu/op/batch_norm_relu.hpp"
+#include "ngraph/runtime/cpu/op/bounded_relu.hpp"
+#include "ngraph/runtime/cpu/op/conv_add.hpp"
+#include "ngraph/runtime/cpu/op/conv_relu.hpp"
+#include "ngraph/runtime/cpu/op/convert_layout.hpp"
+#include "ngraph/runtime/cpu/op/deconv.hpp"
+#include "ngraph/runtime/cpu/op/dropout.hpp"
+#include "ngraph/runtime/cpu/op/group_conv_bias.hpp"
+#include "ngraph/runtime/cpu/op/leaky_relu.hpp"
+#include "ngraph/runtime/cpu/op/loop_kernel.hpp"
+#include "ngraph/runtime/cpu/op/lstm.hpp"
+#include "ngraph/runtime/cpu/op/matmul_bias.hpp"
+#include "ngraph/runtime/cpu/op/max_pool_with_indices.hpp"
+#include "ngraph/runtime/cpu/op/quantized_matmul.hpp"
+#include "ngraph/runtime/cpu/op/rnn.hpp"
+#include "ngraph/runtime/cpu/op/sigmoid_mul.hpp"
+#include "ngraph/runtime/cpu/op/update_slice.hpp"
+#include "ngraph/serializer.hpp"
+
+using namespace ngraph;
+using namespace std;
+using json = nlohmann::json;
+
+using attributes_writer_t = function<void(const Node& node, json& attributes)>;
+using attributes_reader_t =
+    function<shared_ptr<Node>(const OutputVector& args, const json& attributes)>;
+
+static void add_op_serializer(const NodeTypeInfo& type_info,
+                              attributes_writer_t writer,
+                              attributes_reader_t reader)
+{
+    register_op_serializer(type_info.name,
+                           [writer](const Node& node) {
+                               json attributes = json::object();
+                               writer(node, attributes);
+                               return attributes.dump();
+                           },
+                           [reader](const OutputVector& args, const string& attributes) {
+                               return reader(args, json::parse(attributes));
+                           });
+}
+
+static Shape read_shape(const json& js)
+{
+    return Shape(js.get<vector<size_t>>());
+}
+
+static Strides read_strides(const json& js)
+{
+    return Strides(js.get<vector<size_t>>());
+}
+
+static CoordinateDiff read_coordinate_diff(const json& js)
+{
+    return CoordinateDiff(js.get<vector<ptrdiff_t>>());
+}
+
+template <typename T>
+static void write_convolution(const T& op, json& js)
+{
+    js["window_movement_strides"] = op.get_window_movement_strides();
+    js["window_dilation_strides"] = op.get_window_dilation_strides();
+    js["padding_below"] = op.get_padding_below();
+    js["padding_above"] = op.get_padding_above();
+    js["data_dilation_strides"] = op.get_data_dilation_strides();
+}
+
+template <typename T>
+static void write_max_pool(const T& op, json& js)
+{
+    js["window_shape"] = op.get_window_shape();
+    js["window_movement_strides"] = op.get_window_movement_strides();
+    js["padding_below"] = op.get_padding_below();
+    js["padding_above"] = op.get_padding_above();
+}
+
+template <typename T>
+static void write_rnn(const T& op, json& js)
+{
+    js["rnn_type"] = static_cast<int>(op.get_rnn_type());
+}
+
+void runtime::cpu::register_op_serializers()
+{
+    add_op_serializer(ngraph::op::BatchMatMulTranspose::type_info,
+                      [](const Node& node, json& js) {
+                          auto& op = static_cast<const ngraph::op::BatchMatMulTranspose&>(node);
+                          js["transpose_0"] = op.get_transpose_arg0();
+                          js["transpose_1"] = op.get_transpose_arg1();
+                      },
+                      [](const OutputVector& args, const json& js) {
+                          return make_shared<ngraph::op::BatchMatMulTranspose>(
+                              args.at(0),
+                              args.at(1),
+                              js.at("transpose_0").get<bool>(),
+                              js.at("transpose_1").get<bool>());
+                      });
+
+    add_op_serializer(ngraph::op::BatchNormInferenceRelu::type_info,
+                      [](const Node& node, json& js) {
+                          auto& op = static_cast<const ngraph::op::BatchNormInferenceRelu&>(node);
+                          js["eps"] = op.get_eps_value();
+                      },
+                      [](const OutputVector& args, const json& js) {
+                          return make_shared<ngraph::op::BatchNormInferenceRelu>(
+                              js.at("eps").get<double>(),
+                              args.at(0),
+                              args.at(1),
+                              args.at(2),
+                              args.at(3),
+                              args.at(4));
+                      });
+
+    add_op_serializer(ngraph::op::BatchNormTrainingRelu::type_info,
+                      [](const Node& node, json& js) {
+                          auto& op = static_cast<const ngraph::op::BatchNormTrainingRelu&>(node);
+                          js["eps"] = op.get_eps_value();
+                      },
+                      [](const OutputVector& args, const json& js) {
+                          return make_shared<ngraph::op::BatchNormTrainingRelu>(
+                              js.at("eps").get<double>(), args.at(0), args.at(1), args.at(2));
+                      });
+
+    add_op_serializer(
+        ngraph::op::BoundedRelu::type_info,
+        [](const Node& node, json& js) {
+            js["alpha"] = static_cast<const ngraph::op::BoundedRelu&>(node).get_alpha();
+        },
+        [](const OutputVector& args, const json& js) {
+            return make_shared<ngraph::op::BoundedRelu>(args.at(0), js.at("alpha").get<float>());
+        });
+
+    add_op_serializer(ngraph::op::ConvolutionAdd::type_info,
+                      [](const Node& node, json& js) {
+                          auto& op = static_cast<const ngraph::op::ConvolutionAdd&>(node);
+                          write_convolution(op, js);
+                          js["with_relu"] = op.with_relu();
+                      },
+                      [](const OutputVector& args, const json& js) {
+                          return make_shared<ngraph::op::ConvolutionAdd>(
+                              args.at(0),
+                              args.at(1),
+                              args.at(2),
+                              read_strides(js.at("window_movement_strides")),
+                              read_strides(js.at("window_dilation_strides")),
+                              read_coordinate_diff(js.at("padding_below")),
+                              read_coordinate_diff(js.at("padding_above")),
+                              read_strides(js.at("data_dilation_strides")),
+                              js.at("with_relu").get<bool>());
+                      });
+
+    add_op_serializer(ngraph::op::ConvolutionRelu::type_info,
+                      [](const Node& node, json& js) {
+                          auto& op = static_cast<const ngraph::op::ConvolutionRelu&>(node);
+                          write_convolution(op, js);
+                      },
+                      [](const OutputVector& args, const json& js) {
+                          return make_shared<ngraph::op::ConvolutionRelu>(
+                              args.at(0),
+                              args.at(1),
+                              read_strides(js.at("window_movement_strides")),
+                              read_strides(js.at("window_dilation_strides")),
+                              read_coordinate_diff(js.at("padding_below")),
+                              read_coordinate_diff(js.at("padding_above")),
+                              read_strides(js.at("data_dilation_strides")));
+                      });
+
+    // The output layout is the only attribute
+    add_op_serializer(
+        runtime::cpu::op::ConvertLayout::type_info,
+        [](const Node& node, json& js) {
+            auto layout = static_pointer_cast<runtime::cpu::LayoutDescriptor>(
+                node.get_output_tensor(0).get_tensor_layout());
+            if (layout->is_mkldnn_layout())
+            {
+                js["mkldnn_md"] = mkldnn_utils::mkldnn_md_to_string(layout->get_mkldnn_md());
+            }
+        },
+        [](const OutputVector& args, const json& js) {
+            auto layout = make_shared<runtime::cpu::LayoutDescriptor>(args.at(0).get_tensor());
+            if (js.count("mkldnn_md"))
+            {
+                layout->set_mkldnn_md(
+                    mkldnn_utils::mkldnn_md_from_string(js.at("mkldnn_md").get<string>()));
+            }
+            return make_shared<runtime::cpu::op::ConvertLayout>(
+                args.at(0), args.at(0).get_index(), layout);
+        });
+
+    add_op_serializer(ngraph::op::DeconvolutionBias::type_info,
+                      [](const Node& node, json& js) {
+                          auto& op = static_cast<const ngraph::op::DeconvolutionBias&>(node);
+                          js["data_batch_shape"] = op.get_data_batch_shape();
+                          js["window_movement_strides_forward"] =
+                              op.get_window_movement_strides_forward();
+                          js["window_dilation_strides_forward"] =
+                              op.get_window_dilation_strides_forward();
+                          js["padding_below_forward"] = op.get_padding_below_forward();
+                          js["padding_above_forward"] = op.get_padding_above_forward();
+                          js["data_dilation_strides_forward"] =
+                              op.get_data_dilation_strides_forward();
+                          js["with_relu"] = op.with_relu();
+                      },
+                      [](const OutputVector& args, const json& js) {
+                          return make_shared<ngraph::op::DeconvolutionBias>(
+                              read_shape(js.at("data_batch_shape")),
+                              args.at(0),
+                              args.at(1),
+                              args.at(2),
+                              read_strides(js.at("window_movement_strides_forward")),
+                              read_strides(js.at("window_dilation_strides_forward")),
+                              read_coordinate_diff(js.at("padding_below_forward")),
+                              read_coordinate_diff(js.at("padding_above_forward")),
+                              read_strides(js.at("data_dilation_strides_forward")),
+                              js.at("with_relu").get<bool>());
+                      });
+
+    // The seed and keep probability are inputs
+    add_op_serializer(ngraph::op::Dropout::type_info,
+                      [](const Node&, json&) {},
+                      [](const OutputVector& args, const json&) {
+                          return make_shared<ngraph::op::Dropout>(
+                              args.at(0), args.at(1), args.at(2), args.at(3), args.at(4));
+                      });
+
+    add_op_serializer(ngraph::op::GroupConvolutionBias::type_info,
+                      [](const Node& node, json& js) {
+                          auto& op = static_cast<const ngraph::op::GroupConvolutionBias&>(node);
+                          write_convolution(op, js);
+                          js["groups"] = op.get_groups();
+                          js["output_shape"] = op.get_output_shape(0);
+                          js["with_relu"] = op.with_relu();
+                          js["alpha"] = op.get_alpha();
+                      },
+                      [](const OutputVector& args, const json& js) {
+                          return make_shared<ngraph::op::GroupConvolutionBias>(
+                              args.at(0),
+                              args.at(1),
+                              args.at(2),
+                              read_strides(js.at("window_movement_strides")),
+                              read_strides(js.at("window_dilation_strides")),
+                              read_coordinate_diff(js.at("padding_below")),
+                              read_coordinate_diff(js.at("padding_above")),
+                              read_strides(js.at("data_dilation_strides")),
+                              js.at("groups").get<size_t>(),
+                              read_shape(js.at("output_shape")),
+                              js.at("with_relu").get<bool>(),
+                              js.at("alpha").get<float>());
+                      });
+
+    add_op_serializer(
+        ngraph::op::CPULeakyRelu::type_info,
+        [](const Node& node, json& js) {
+            js["alpha"] = static_cast<const ngraph::op::CPULeakyRelu&>(node).get_alpha();
+        },
+        [](const OutputVector& args, const json& js) {
+            return make_shared<ngraph::op::CPULeakyRelu>(args.at(0), js.at("alpha").get<float>());
+        });
+
+    // The fused body only references the kernel parameters, so it is saved as a function of
+    // them. The body is cloned first: a Function made of the kernel's own nodes would add
+    // Result users to nodes that the copies of the kernel share.
+    add_op_serializer(
+        runtime::cpu::op::LoopKernel::type_info,
+        [](const Node& node, json& js) {
+            auto& op = static_cast<const runtime::cpu::op::LoopKernel&>(node);
+            list<shared_ptr<Node>> roots(op.get_kernel_outputs().begin(),
+                                         op.get_kernel_outputs().end());
+            roots.insert(
+                roots.end(), op.get_kernel_parameters().begin(), op.get_kernel_parameters().end());
+            NodeMap node_map;
+            clone_nodes(roots, node_map);
+            NodeVector outputs;
+            for (auto& output : op.get_kernel_outputs())
+            {
+                outputs.push_back(node_map.at(output.get()));
+            }
+            ParameterVector parameters;
+            for (auto& parameter : op.get_kernel_parameters())
+            {
+                parameters.push_back(
+                    static_pointer_cast<ngraph::op::Parameter>(node_map.at(parameter.get())));
+            }
+            js["body"] = json::parse(serialize(make_shared<Function>(outputs, parameters)));
+        },
+        [](const OutputVector& args, const json& js) {
+            shared_ptr<Function> body = deserialize(js.at("body").dump());
+            NodeVector node_list;
+            for (auto& node : body->get_ordered_ops())
+            {
+                if (!node->is_parameter() && !node->is_output())
+                {
+                    node_list.push_back(node);
+                }
+            }
+            NodeVector outputs;
+            for (auto& result : body->get_results())
+            {
+                outputs.push_back(result->get_argument(0));
+            }
+            return make_shared<runtime::cpu::op::LoopKernel>(
+                node_list, outputs, body->get_parameters(), args);
+        });
+
+    add_op_serializer(ngraph::op::Lstm::type_info,
+                      [](const Node& node, json& js) {
+                          write_rnn(static_cast<const ngraph::op::Lstm&>(node), js);
+                      },
+                      [](const OutputVector& args, const json& js) {
+                          auto rnn_type = static_cast<runtime::cpu::rnn_utils::rnntype>(
+                              js.at("rnn_type").get<int>());
+#if MKLDNN_VERSION_MAJOR < 1
+                          return make_shared<ngraph::op::Lstm>(
+                              args.at(0), args.at(1), args.at(2), args.at(3), args.at(4), rnn_type);
+#else
+                          return make_shared<ngraph::op::Lstm>(args.at(0),
+                                                               args.at(1),
+                                                               args.at(2),
+                                                               args.at(3),
+                                                               args.at(4),
+                                                               args.at(5),
+                                                               rnn_type);
+#endif
+                      });
+
+    add_op_serializer(ngraph::op::MatmulBias::type_info,
+                      [](const Node& node, json& js) {
+                          auto& op = static_cast<const ngraph::op::MatmulBias&>(node);
+                          js["shape_w"] = op.get_a_shape();
+                          js["shape_x"] = op.get_b_shape();
+                          js["transpose_w"] = op.get_is_a_transposed();
+                          js["transpose_x"] = op.get_is_b_transposed();
+                          js["broadcast_axes"] = op.get_broadcast_axes();
+                      },
+                      [](const OutputVector& args, const json& js) {
+                          return make_shared<ngraph::op::MatmulBias>(
+                              args.at(0),
+                              args.at(1),
+                              args.size() == 3 ? args.at(2) : Output<Node>(),
+                              read_shape(js.at("shape_w")),
+                              read_shape(js.at("shape_x")),
+                              js.at("transpose_w").get<bool>(),
+                              js.at("transpose_x").get<bool>(),
+                              AxisSet(js.at("broadcast_axes").get<set<size_t>>()));
+                      });
+
+    add_op_serializer(ngraph::op::MaxPoolWithIndices::type_info,
+                      [](const Node& node, json& js) {
+                          auto& op = static_cast<const ngraph::op::MaxPoolWithIndices&>(node);
+                          write_max_pool(op, js);
+                      },
+                      [](const OutputVector& args, const json& js) {
+                          return make_shared<ngraph::op::MaxPoolWithIndices>(
+                              args.at(0),
+                              read_shape(js.at("window_shape")),
+                              read_strides(js.at("window_movement_strides")),
+                              read_shape(js.at("padding_below")),
+                              read_shape(js.at("padding_above")));
+                      });
+
+    add_op_serializer(ngraph::op::MaxPoolWithIndicesBackprop::type_info,
+                      [](const Node& node, json& js) {
+                          auto& op =
+                              static_cast<const ngraph::op::MaxPoolWithIndicesBackprop&>(node);
+                          write_max_pool(op, js);
+                      },
+                      [](const OutputVector& args, const json& js) {
+                          return make_shared<ngraph::op::MaxPoolWithIndicesBackprop>(
+                              args.at(0),
+                              args.at(1),
+                              args.at(2),
+                              read_shape(js.at("window_shape")),
+                              read_strides(js.at("window_movement_strides")),
+                              read_shape(js.at("padding_below")),
+                              read_shape(js.at("padding_above")));
+                      });
+
+    add_op_serializer(ngraph::op::QuantizedMatmul::type_info,
+                      [](const Node& node, json& js) {
+                          auto& op = static_cast<const ngraph::op::QuantizedMatmul&>(node);
+                          element::Type_t output_type = op.get_output_type();
+                          js["output_type"] = static_cast<int>(output_type);
+                      },
+                      [](const OutputVector& args, const json& js) {
+                          element::Type output_type(
+                              static_cast<element::Type_t>(js.at("output_type").get<int>()));
+                          return make_shared<ngraph::op::QuantizedMatmul>(
+                              args.at(0), args.at(1), args.at(2), output_type);
+                      });
+
+    add_op_serializer(ngraph::op::Rnn::type_info,
+                      [](const Node& node, json& js) {
+                          auto& op = static_cast<const ngraph::op::Rnn&>(node);
+                          write_rnn(op, js);
+                          js["num_timesteps"] = op.get_num_timesteps();
+                          js["num_gates_per_cell"] = op.get_gates_per_cell();
+                          js["src_sequence_length"] = op.get_src_sequence_length();
+                          js["num_cell_states"] = op.get_num_cell_states();
+                          js["direction"] = op.get_direction();
+                          js["num_fused_layers"] = op.get_num_fused_layers();
+                      },
+                      [](const OutputVector& args, const json& js) {
+                          auto rnn_type = static_cast<runtime::cpu::rnn_utils::rnntype>(
+                              js.at("rnn_type").get<int>());
+                          size_t num_timesteps = js.at("num_timesteps").get<size_t>();
+                          size_t num_gates_per_cell = js.at("num_gates_per_cell").get<size_t>();
+                          size_t src_sequence_length = js.at("src_sequence_length").get<size_t>();
+                          size_t num_cell_states = js.at("num_cell_states").get<size_t>();
+                          size_t direction = js.at("direction").get<size_t>();
+                          size_t num_fused_layers = js.at("num_fused_layers").get<size_t>();
+#if MKLDNN_VERSION_MAJOR < 1
+                          return make_shared<ngraph::op::Rnn>(args.at(0),
+                                                              args.at(1),
+                                                              args.at(2),
+                                                              args.at(3),
+                                                              args.at(4),
+                                                              num_timesteps,
+                                                              num_gates_per_cell,
+                                                              src_sequence_length,
+                                                              num_cell_states,
+                                                              direction,
+                                                              num_fused_layers,
+                                                              rnn_type);
+#else
+                          return make_shared<ngraph::op::Rnn>(args.at(0),
+                                                              args.at(1),
+                                                              args.at(2),
+                                                              args.at(3),
+                                                              args.at(4),
+                                                              args.at(5),
+                                                              num_timesteps,
+                                                              num_gates_per_cell,
+                                                              src_sequence_length,
+                                                              num_cell_states,
+                                                              direction,
+                                                              num_fused_layers,
+                                                              rnn_type);
+#endif
+                      });
+
+    add_op_serializer(
+        ngraph::op::SigmoidMultiply::type_info,
+        [](const Node& node, json& js) {
+            auto& op = static_cast<const ngraph::op::SigmoidMultiply&>(node);
+            js["input_types"] = {static_cast<int>(op.get_input_func_type(0)),
+                                 static_cast<int>(op.get_input_func_type(1))};
+        },
+        [](const OutputVector& args, const json& js) {
+            using FunctionType = ngraph::op::SigmoidMultiply::FunctionType;
+            auto types = js.at("input_types").get<vector<int>>();
+            return make_shared<ngraph::op::SigmoidMultiply>(args.at(0),
+                                                            args.at(1),
+                                                            static_cast<FunctionType>(types.at(0)),
+                                                            static_cast<FunctionType>(types.at(1)));
+        });
+
+    add_op_serializer(
+        ngraph::op::SigmoidMultiplyBackprop::type_info,
+        [](const Node& node, json& js) {
+            auto& op = static_cast<const ngraph::op::SigmoidMultiplyBackprop&>(node);
+            js["input_types"] = {static_cast<int>(op.get_input_func_type(0)),
+                                 static_cast<int>(op.get_input_func_type(1))};
+        },
+        [](const OutputVector& args, const json& js) {
+            using FunctionType = ngraph::op::SigmoidMultiply::FunctionType;
+            auto types = js.at("input_types").get<vector<int>>();
+            array<FunctionType, 2> input_types{{static_cast<FunctionType>(types.at(0)),
+                                                static_cast<FunctionType>(types.at(1))}};
+            return make_shared<ngraph::op::SigmoidMultiplyBackprop>(
+                args.at(0), args.at(1), args.at(2), input_types);
+        });
+
+    add_op_serializer(ngraph::op::UpdateSlice::type_info,
+                      [](const Node& node, json& js) {
+                          auto& op = static_cast<const ngraph::op::UpdateSlice&>(node);
+                          js["lower_bounds"] = op.get_lower_bounds();
+                          js["upper_bounds"] = op.get_upper_bounds();
+                          js["strides"] = op.get_strides();
+                      },
+                      [](const OutputVector& args, const json& js) {
+                          return make_shared<ngraph::op::UpdateSlice>(
+                              args.at(0),
+                              args.at(1),
+                              Coordinate(js.at("lower_bounds").get<vector<size_t>>()),
+                              Coordinate(js.at("upper_bounds").get<vector<size_t>>()),
+                              read_strides(js.at("strides")));
+                      });
+}
+#else
+void ngraph::runtime::cpu::register_op_serializers()
+{
+    // Nothing is serialized, so there is nothing to register
+}
+#endif
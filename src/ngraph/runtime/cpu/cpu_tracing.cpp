@@ -14,79 +14,56 @@
 // limitations under the License.
 //*****************************************************************************
 
-#include <fstream>
 #include <map>
 
 #include "cpu_tracing.hpp"
-
+#include "ngraph/runtime/chrome_trace.hpp"
 #ifndef NGRAPH_JSON_DISABLE
-void ngraph::runtime::cpu::to_json(nlohmann::json& json, const TraceEvent& event)
+#include "nlohmann/json.hpp"
+#endif
+
+using namespace std;
+using namespace ngraph;
+
+runtime::cpu::TimelineRecorder::TimelineRecorder(const vector<OpAttributes>& op_attrs,
+                                                 const string& file_name)
+    : m_category(event::Manager::intern("Op"))
 {
-    std::map<std::string, std::string> args;
-    for (size_t i = 0; i < event.Inputs.size(); i++)
-    {
-        args["Input" + std::to_string(i + 1)] = event.Inputs[i];
-    }
-    for (size_t i = 0; i < event.Outputs.size(); i++)
+    m_file = event::Manager::open_file(file_name);
+    for (const OpAttributes& op : op_attrs)
     {
-        args["Output" + std::to_string(i + 1)] = event.Outputs[i];
+        m_names.push_back(event::Manager::intern(op.Description));
+#ifndef NGRAPH_JSON_DISABLE
+        map<string, string> args;
+        for (size_t i = 0; i < op.Inputs.size(); i++)
+        {
+            args["Input" + to_string(i + 1)] = op.Inputs[i];
+        }
+        for (size_t i = 0; i < op.Outputs.size(); i++)
+        {
+            args["Output" + to_string(i + 1)] = op.Outputs[i];
+        }
+        m_args.push_back(event::Manager::intern(nlohmann::json(args).dump()));
+#else
+        m_args.push_back(0);
+#endif
     }
-
-    json = nlohmann::json{{"ph", event.Phase},
-                          {"cat", event.Category},
-                          {"name", event.Name},
-                          {"pid", event.PID},
-                          {"tid", event.TID},
-                          {"ts", event.Timestamp},
-                          {"dur", event.Duration},
-                          {"args", args}};
 }
 
-void ngraph::runtime::cpu::GenerateTimeline(const std::vector<OpAttributes>& op_attrs,
-                                            int64_t* op_durations,
-                                            const std::string& file_name)
+void runtime::cpu::TimelineRecorder::record(uint64_t start_nanoseconds,
+                                            const int64_t* op_durations) const
 {
-    nlohmann::json timeline;
-    std::list<TraceEvent> trace;
-    std::ofstream out(file_name);
-
-    int64_t ts = 0;
-    for (size_t i = 0; i < op_attrs.size(); i++)
+    uint64_t ts = start_nanoseconds;
+    for (size_t i = 0; i < m_names.size(); i++)
     {
-        trace.emplace_back("X",
-                           "Op",
-                           op_attrs[i].Description,
-                           0,
-                           0,
-                           ts,
-                           op_durations[i],
-                           op_attrs[i].Outputs,
-                           op_attrs[i].Inputs);
-        ts += op_durations[i];
+        uint64_t duration = op_durations[i] * 1000;
+        event::Manager::record_duration(m_names[i], m_category, m_args[i], ts, duration, m_file);
+        ts += duration;
     }
-
-    timeline["traceEvents"] = trace;
-    out << timeline;
-    out.close();
-
-    return;
 }
 
-bool ngraph::runtime::cpu::IsTracingEnabled()
+bool runtime::cpu::IsTracingEnabled()
 {
     static bool enabled = (std::getenv("NGRAPH_CPU_TRACING") != nullptr);
     return enabled;
 }
-#else
-void ngraph::runtime::cpu::GenerateTimeline(const std::vector<OpAttributes>& op_attrs,
-                                            int64_t* op_durations,
-                                            const std::string& file_name)
-{
-    return;
-}
-
-bool ngraph::runtime::cpu::IsTracingEnabled()
-{
-    return false;
-}
-#endif
@@ -21,9 +21,6 @@
 #include <vector>
 
 #include "ngraph/runtime/cpu/cpu_external_function.hpp"
-#ifndef NGRAPH_JSON_DISABLE
-#include "nlohmann/json.hpp"
-#endif
 
 namespace ngraph
 {
@@ -31,49 +28,31 @@ namespace ngraph
     {
         namespace cpu
         {
-            struct TraceEvent
+            /// \brief Records the op durations of each call as Chrome trace events through
+            ///        runtime::event::Manager into a trace file of its own. The names of the
+            ///        ops are interned and their arguments formatted once, so a call costs a
+            ///        few ring buffer writes per op.
+            class TimelineRecorder
             {
-                // This should be a single character
-                // but the JSON encoder nlohmann::json
-                // is broken and doesn't handle character fields
-                std::string Phase;
-                std::string Category;
-                const std::string& Name;
-                unsigned int PID;
-                unsigned int TID;
-                int64_t Timestamp;
-                int64_t Duration;
-                const std::vector<std::string>& Outputs;
-                const std::vector<std::string>& Inputs;
+            public:
+                /// \param file_name The trace file, shared with other recorders of that name
+                TimelineRecorder(const std::vector<OpAttributes>& op_attrs,
+                                 const std::string& file_name);
 
-                TraceEvent(const std::string& ph,
-                           const std::string& cat,
-                           const std::string& name,
-                           unsigned int pid,
-                           unsigned int tid,
-                           int64_t ts,
-                           int64_t dur,
-                           const std::vector<std::string>& outputs,
-                           const std::vector<std::string>& inputs)
-                    : Phase(ph)
-                    , Category(cat)
-                    , Name(name)
-                    , PID(pid)
-                    , TID(tid)
-                    , Timestamp(ts)
-                    , Duration(dur)
-                    , Outputs(outputs)
-                    , Inputs(inputs)
-                {
-                }
+                /// \brief Records the ops of a call back to back from its start
+                /// \param start_nanoseconds When the call started, from
+                ///        runtime::event::Manager::get_current_nanoseconds()
+                /// \param op_durations The duration of each op in microseconds
+                void record(uint64_t start_nanoseconds, const int64_t* op_durations) const;
+
+            private:
+                uint32_t m_file;
+                uint32_t m_category;
+                std::vector<uint32_t> m_names;
+                // The inputs and outputs of each op, interned once since they never change
+                std::vector<uint32_t> m_args;
             };
-#ifndef NGRAPH_JSON_DISABLE
-            void to_json(nlohmann::json& json, const TraceEvent& event);
-#endif
 
-            void GenerateTimeline(const std::vector<OpAttributes>& op_attrs,
-                                  int64_t* op_durations,
-                                  const std::string& file_name);
             bool IsTracingEnabled();
         }
     }
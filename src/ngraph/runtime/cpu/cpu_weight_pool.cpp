@@ -0,0 +1,123 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "ngraph/runtime/cpu/cpu_weight_pool.hpp"
+
+using namespace ngraph;
+using namespace std;
+
+// 64-bit FNV-1a of the data, seeded with its size
+static size_t hash_data(const void* data, size_t size)
+{
+    const uint64_t prime = 0x100000001b3ULL;
+    uint64_t h = 0xcbf29ce484222325ULL ^ size;
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; i++)
+    {
+        h = (h ^ p[i]) * prime;
+    }
+    return static_cast<size_t>(h);
+}
+
+shared_ptr<runtime::AlignedBuffer>
+    runtime::cpu::CPUWeightPool::intern(const shared_ptr<AlignedBuffer>& data, size_t size)
+{
+    if (!data || size == 0)
+    {
+        return data;
+    }
+
+    size_t key = hash_data(data->get_ptr(), size);
+    lock_guard<mutex> lock(m_mutex);
+    vector<Entry>& entries = m_entries[key];
+    for (auto it = entries.begin(); it != entries.end();)
+    {
+        shared_ptr<AlignedBuffer> buffer = it->buffer.lock();
+        if (!buffer)
+        {
+            it = entries.erase(it);
+            m_entry_count--;
+            continue;
+        }
+        // Compare the contents, both to rule out hash collisions and because the sole owner
+        // of a buffer may have modified it since it was pooled
+        if (it->size == size &&
+            (buffer == data || memcmp(buffer->get_ptr(), data->get_ptr(), size) == 0))
+        {
+            if (buffer != data)
+            {
+                m_deduplicated_bytes += size;
+            }
+            return buffer;
+        }
+        ++it;
+    }
+    entries.push_back({data, size});
+    if (++m_entry_count >= m_sweep_count)
+    {
+        sweep();
+        m_sweep_count = max<size_t>(64, 2 * m_entry_count);
+    }
+    return data;
+}
+
+void runtime::cpu::CPUWeightPool::sweep()
+{
+    for (auto bucket = m_entries.begin(); bucket != m_entries.end();)
+    {
+        vector<Entry>& entries = bucket->second;
+        auto live_end = remove_if(entries.begin(), entries.end(), [](const Entry& entry) {
+            return entry.buffer.expired();
+        });
+        m_entry_count -= entries.end() - live_end;
+        entries.erase(live_end, entries.end());
+        if (entries.empty())
+        {
+            bucket = m_entries.erase(bucket);
+        }
+        else
+        {
+            ++bucket;
+        }
+    }
+}
+
+size_t runtime::cpu::CPUWeightPool::get_deduplicated_bytes() const
+{
+    lock_guard<mutex> lock(m_mutex);
+    return m_deduplicated_bytes;
+}
+
+size_t runtime::cpu::CPUWeightPool::get_pooled_bytes() const
+{
+    lock_guard<mutex> lock(m_mutex);
+    size_t bytes = 0;
+    for (auto& bucket : m_entries)
+    {
+        for (const Entry& entry : bucket.second)
+        {
+            if (!entry.buffer.expired())
+            {
+                bytes += entry.size;
+            }
+        }
+    }
+    return bytes;
+}
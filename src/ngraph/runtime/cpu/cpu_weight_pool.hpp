@@ -0,0 +1,73 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "ngraph/runtime/aligned_buffer.hpp"
+#include "ngraph/runtime/cpu/cpu_backend_visibility.h"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            /// \brief Content-addressed store of the constant data of the executables compiled
+            ///        by a backend. Constants with the same bytes share one read-only buffer.
+            ///
+            /// The pool only holds weak references, so a buffer leaves the pool once no
+            /// constant uses it.
+            class CPU_BACKEND_API CPUWeightPool
+            {
+            public:
+                /// \brief Returns a pooled buffer whose first size bytes equal those of data.
+                ///        data is added to the pool if no such buffer is pooled yet.
+                std::shared_ptr<AlignedBuffer> intern(const std::shared_ptr<AlignedBuffer>& data,
+                                                      size_t size);
+
+                /// \brief Bytes that were not stored because the same data was already pooled
+                size_t get_deduplicated_bytes() const;
+                /// \brief Bytes held by the buffers currently in the pool
+                size_t get_pooled_bytes() const;
+
+            private:
+                // Removes the entries of released buffers and the buckets left empty
+                void sweep();
+
+                struct Entry
+                {
+                    std::weak_ptr<AlignedBuffer> buffer;
+                    size_t size;
+                };
+
+                mutable std::mutex m_mutex;
+                // Entries keyed by a hash of their size and contents
+                std::unordered_map<size_t, std::vector<Entry>> m_entries;
+                size_t m_entry_count = 0;
+                // Entries of released buffers in other buckets are swept once the entry count
+                // reaches this, which is then set to twice the live entries
+                size_t m_sweep_count = 64;
+                size_t m_deduplicated_bytes = 0;
+            };
+        }
+    }
+}
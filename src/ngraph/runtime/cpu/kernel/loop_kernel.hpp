@@ -0,0 +1,243 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#define EIGEN_USE_THREADS
+#include <unsupported/Eigen/CXX11/Tensor>
+
+#include "ngraph/runtime/cpu/cpu_executor.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            namespace kernel
+            {
+                namespace loop
+                {
+                    enum class Opcode
+                    {
+                        Abs,
+                        Add,
+                        Divide,
+                        Exp,
+                        Log,
+                        Maximum,
+                        Minimum,
+                        Multiply,
+                        Negative,
+                        Relu,
+                        Sigmoid,
+                        Sqrt,
+                        Subtract,
+                        Tanh
+                    };
+
+                    /// \brief How an input of the loop is read
+                    enum class Access
+                    {
+                        /// Element i of the input
+                        Direct,
+                        /// Element 0 of the input
+                        Scalar,
+                        /// Element i % size of the input
+                        Tile,
+                        /// Element i / size of the input
+                        Repeat
+                    };
+
+                    struct Input
+                    {
+                        size_t arg;
+                        Access access;
+                        size_t size;
+                    };
+
+                    /// \brief Computes value dst from values src0 and src1. Values are numbered
+                    ///        with the loop inputs first, then the instruction results.
+                    struct Instruction
+                    {
+                        Opcode opcode;
+                        size_t dst;
+                        size_t src0;
+                        size_t src1;
+                    };
+
+                    /// \brief A fused elementwise computation over count elements
+                    struct Program
+                    {
+                        std::vector<Input> inputs;
+                        std::vector<Instruction> instructions;
+                        /// Value written to each output
+                        std::vector<size_t> outputs;
+                        size_t count;
+                    };
+
+                    /// Elements per block. One block of every live value stays in cache while
+                    /// the whole program runs over it.
+                    constexpr size_t block_size = 1024;
+
+                    template <typename T>
+                    void execute(Opcode opcode, T* dst, const T* src0, const T* src1, size_t n)
+                    {
+                        using Array = Eigen::Array<T, Eigen::Dynamic, 1>;
+                        Eigen::Map<Array> out(dst, n);
+                        Eigen::Map<const Array> in0(src0, n);
+                        switch (opcode)
+                        {
+                        case Opcode::Abs: out = in0.abs(); break;
+                        case Opcode::Exp: out = in0.exp(); break;
+                        case Opcode::Log: out = in0.log(); break;
+                        case Opcode::Negative: out = -in0; break;
+                        case Opcode::Relu: out = in0.max(T(0)); break;
+                        case Opcode::Sigmoid: out = (T(1) + (-in0).exp()).inverse(); break;
+                        case Opcode::Sqrt: out = in0.sqrt(); break;
+                        case Opcode::Tanh: out = in0.tanh(); break;
+                        default:
+                        {
+                            Eigen::Map<const Array> in1(src1, n);
+                            switch (opcode)
+                            {
+                            case Opcode::Add: out = in0 + in1; break;
+                            case Opcode::Divide: out = in0 / in1; break;
+                            case Opcode::Maximum: out = in0.max(in1); break;
+                            case Opcode::Minimum: out = in0.min(in1); break;
+                            case Opcode::Multiply: out = in0 * in1; break;
+                            case Opcode::Subtract: out = in0 - in1; break;
+                            default: break;
+                            }
+                        }
+                        }
+                    }
+
+                    /// \brief Run program over blocks [first, last). Results that are not
+                    ///        outputs live in a per-thread scratch block.
+                    template <typename T>
+                    void execute_blocks(const Program& program,
+                                        const std::vector<T*>& args,
+                                        const std::vector<T*>& outs,
+                                        size_t first,
+                                        size_t last)
+                    {
+                        size_t num_inputs = program.inputs.size();
+                        size_t num_values = num_inputs + program.instructions.size();
+                        std::vector<int> output_of(num_values, -1);
+                        for (size_t i = 0; i < program.outputs.size(); i++)
+                        {
+                            output_of[program.outputs[i]] = static_cast<int>(i);
+                        }
+
+                        // Scratch blocks for gathered inputs and intermediate results
+                        std::vector<size_t> scratch_of(num_values, 0);
+                        size_t num_scratch = 0;
+                        for (size_t i = 0; i < num_values; i++)
+                        {
+                            bool direct = i < num_inputs &&
+                                          program.inputs[i].access == Access::Direct;
+                            if (!direct && output_of[i] < 0)
+                            {
+                                scratch_of[i] = num_scratch++;
+                            }
+                        }
+                        std::vector<T> scratch(num_scratch * block_size);
+                        std::vector<T*> values(num_values);
+
+                        for (size_t i = 0; i < num_inputs; i++)
+                        {
+                            const Input& input = program.inputs[i];
+                            if (input.access == Access::Scalar)
+                            {
+                                // Constant across blocks
+                                T* block = &scratch[scratch_of[i] * block_size];
+                                std::fill(block, block + block_size, args[input.arg][0]);
+                                values[i] = block;
+                            }
+                        }
+
+                        for (size_t b = first; b < last; b++)
+                        {
+                            size_t offset = b * block_size;
+                            size_t n = std::min(block_size, program.count - offset);
+                            for (size_t i = 0; i < num_inputs; i++)
+                            {
+                                const Input& input = program.inputs[i];
+                                const T* arg = args[input.arg];
+                                T* block = &scratch[scratch_of[i] * block_size];
+                                switch (input.access)
+                                {
+                                case Access::Direct:
+                                    values[i] = const_cast<T*>(arg) + offset;
+                                    break;
+                                case Access::Scalar: break;
+                                case Access::Tile:
+                                    for (size_t j = 0; j < n; j++)
+                                    {
+                                        block[j] = arg[(offset + j) % input.size];
+                                    }
+                                    values[i] = block;
+                                    break;
+                                case Access::Repeat:
+                                    for (size_t j = 0; j < n; j++)
+                                    {
+                                        block[j] = arg[(offset + j) / input.size];
+                                    }
+                                    values[i] = block;
+                                    break;
+                                }
+                            }
+                            for (const Instruction& instruction : program.instructions)
+                            {
+                                size_t dst = instruction.dst;
+                                values[dst] = output_of[dst] >= 0
+                                                  ? outs[output_of[dst]] + offset
+                                                  : &scratch[scratch_of[dst] * block_size];
+                                execute<T>(instruction.opcode,
+                                           values[dst],
+                                           values[instruction.src0],
+                                           values[instruction.src1],
+                                           n);
+                            }
+                        }
+                    }
+                }
+
+                template <typename ElementType>
+                void loop_kernel(const loop::Program& program,
+                                 const std::vector<ElementType*>& args,
+                                 const std::vector<ElementType*>& outs,
+                                 int arena)
+                {
+                    size_t num_blocks = (program.count + loop::block_size - 1) / loop::block_size;
+                    double block_bytes =
+                        static_cast<double>(loop::block_size * sizeof(ElementType));
+                    Eigen::TensorOpCost cost(block_bytes * program.inputs.size(),
+                                             block_bytes * program.outputs.size(),
+                                             loop::block_size * program.instructions.size());
+                    ngraph::runtime::cpu::executor::GetCPUExecutor().get_device(arena).parallelFor(
+                        num_blocks, cost, [&](Eigen::Index first, Eigen::Index last) {
+                            loop::execute_blocks<ElementType>(program, args, outs, first, last);
+                        });
+                }
+            }
+        }
+    }
+}
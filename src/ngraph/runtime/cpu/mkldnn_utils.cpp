@@ -264,6 +264,47 @@ bool runtime::cpu::mkldnn_utils::can_use_mkldnn_batchnorm_bprop(const ngraph::No
     }
 }
 
+string runtime::cpu::mkldnn_utils::mkldnn_md_to_string(const mkldnn::memory::desc& md)
+{
+    static const char* digits = "0123456789abcdef";
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(&md.data);
+    string str;
+    str.reserve(2 * sizeof(md.data));
+    for (size_t i = 0; i < sizeof(md.data); i++)
+    {
+        str.push_back(digits[p[i] >> 4]);
+        str.push_back(digits[p[i] & 0xf]);
+    }
+    return str;
+}
+
+mkldnn::memory::desc runtime::cpu::mkldnn_utils::mkldnn_md_from_string(const string& str)
+{
+    mkldnn_memory_desc_t data;
+    if (str.size() != 2 * sizeof(data))
+    {
+        throw ngraph_error("Memory descriptor was saved by a different MKLDNN version");
+    }
+    auto nibble = [&str](size_t i) -> uint8_t {
+        char c = str[i];
+        if (c >= '0' && c <= '9')
+        {
+            return static_cast<uint8_t>(c - '0');
+        }
+        if (c >= 'a' && c <= 'f')
+        {
+            return static_cast<uint8_t>(c - 'a' + 10);
+        }
+        throw ngraph_error("Malformed memory descriptor string");
+    };
+    uint8_t* p = reinterpret_cast<uint8_t*>(&data);
+    for (size_t i = 0; i < sizeof(data); i++)
+    {
+        p[i] = static_cast<uint8_t>((nibble(2 * i) << 4) | nibble(2 * i + 1));
+    }
+    return mkldnn::memory::desc(data);
+}
+
 #if MKLDNN_VERSION_MAJOR < 1
 std::map<element::Type, const mkldnn::memory::data_type>&
     runtime::cpu::mkldnn_utils::get_mkldnn_data_type_map()
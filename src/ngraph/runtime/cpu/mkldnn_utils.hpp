@@ -141,6 +141,11 @@ namespace ngraph
                 bool compare_mkldnn_formats(mkldnn::memory::FORMAT lhs, mkldnn::memory::FORMAT rhs);
                 bool compare_mkldnn_mds(const mkldnn::memory::desc& lhs,
                                         const mkldnn::memory::desc& rhs);
+                /// \brief Hex encoding of the raw descriptor, used to save compiled layouts
+                std::string mkldnn_md_to_string(const mkldnn::memory::desc& md);
+                /// \brief Inverse of mkldnn_md_to_string. Throws if str was not produced by
+                ///        the same MKLDNN version.
+                mkldnn::memory::desc mkldnn_md_from_string(const std::string& str);
                 bool is_mkldnn_padded_layout(const mkldnn::memory::desc& in,
                                              const AxisVector& axis_list);
                 bool is_mkldnn_filter_format(mkldnn::memory::FORMAT fmt);
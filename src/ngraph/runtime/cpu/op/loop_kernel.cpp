@@ -0,0 +1,99 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include "ngraph/runtime/cpu/op/loop_kernel.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+constexpr NodeTypeInfo runtime::cpu::op::LoopKernel::type_info;
+
+runtime::cpu::op::LoopKernel::LoopKernel(const NodeVector& node_list,
+                                         const NodeVector& outputs,
+                                         const ParameterVector& parameters,
+                                         const OutputVector& args)
+    : Op(args)
+    , m_node_list(node_list)
+    , m_output_nodes(outputs)
+    , m_parameters(parameters)
+{
+    constructor_validate_and_infer_types();
+}
+
+void runtime::cpu::op::LoopKernel::validate_and_infer_types()
+{
+    NODE_VALIDATION_CHECK(this,
+                          m_parameters.size() == get_input_size(),
+                          "Number of kernel parameters (",
+                          m_parameters.size(),
+                          ") does not match the number of arguments (",
+                          get_input_size(),
+                          ")");
+    for (size_t i = 0; i < m_parameters.size(); i++)
+    {
+        NODE_VALIDATION_CHECK(this,
+                              m_parameters[i]->get_element_type() == get_input_element_type(i) &&
+                                  m_parameters[i]->get_shape() == get_input_shape(i),
+                              "Kernel parameter ",
+                              i,
+                              " does not match its argument");
+    }
+
+    set_output_size(m_output_nodes.size());
+    for (size_t i = 0; i < m_output_nodes.size(); i++)
+    {
+        set_output_type(i, m_output_nodes[i]->get_element_type(), m_output_nodes[i]->get_shape());
+    }
+}
+
+shared_ptr<Node>
+    runtime::cpu::op::LoopKernel::copy_with_new_args(const NodeVector& new_args) const
+{
+    // The fused nodes only reference the kernel parameters, so they are shared with the copy
+    return make_shared<LoopKernel>(
+        m_node_list, m_output_nodes, m_parameters, as_output_vector(new_args));
+}
+
+runtime::cpu::op::LoopKernel::BroadcastKind
+    runtime::cpu::op::LoopKernel::get_broadcast_kind(const ngraph::op::Broadcast& broadcast)
+{
+    const Shape& in_shape = broadcast.get_input_shape(0);
+    const Shape& out_shape = broadcast.get_output_shape(0);
+    const AxisSet& axes = broadcast.get_broadcast_axes();
+    if (shape_size(in_shape) == 1)
+    {
+        return BroadcastKind::Scalar;
+    }
+
+    // Tile: axes are 0..n-1, Repeat: axes are rank-n..rank-1
+    size_t rank = out_shape.size();
+    bool leading = true;
+    bool trailing = true;
+    for (size_t axis : axes)
+    {
+        leading = leading && axis < axes.size();
+        trailing = trailing && axis >= rank - axes.size();
+    }
+    if (leading)
+    {
+        return BroadcastKind::Tile;
+    }
+    if (trailing)
+    {
+        return BroadcastKind::Repeat;
+    }
+    return BroadcastKind::Unsupported;
+}
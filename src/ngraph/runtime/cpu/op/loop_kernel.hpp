@@ -0,0 +1,87 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include "ngraph/op/broadcast.hpp"
+#include "ngraph/op/op.hpp"
+#include "ngraph/op/parameter.hpp"
+#include "ngraph/runtime/cpu/cpu_backend_visibility.h"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            namespace op
+            {
+                /// \brief A connected subgraph of elementwise ops over one shape, executed as a
+                ///        single loop over the output elements.
+                ///
+                /// The fused nodes form a self contained graph: their inputs are either other
+                /// fused nodes or the Parameters returned by get_kernel_parameters(), where
+                /// parameter i is bound to input i of the LoopKernel. Output i of the LoopKernel
+                /// is the value of get_kernel_outputs()[i].
+                class LoopKernel : public ngraph::op::Op
+                {
+                public:
+                    CPU_BACKEND_API
+                    static constexpr NodeTypeInfo type_info{"LoopKernel", 0};
+                    const NodeTypeInfo& get_type_info() const override { return type_info; }
+                    /// \brief How a Broadcast in the kernel maps an output element to an input
+                    ///        element.
+                    enum class BroadcastKind
+                    {
+                        /// Not expressible in the loop
+                        Unsupported,
+                        /// The input has a single element
+                        Scalar,
+                        /// Leading axes are broadcast; input index is the output index modulo
+                        /// the input size
+                        Tile,
+                        /// Trailing axes are broadcast; input index is the output index divided
+                        /// by the number of broadcast elements
+                        Repeat
+                    };
+
+                    CPU_BACKEND_API LoopKernel(const NodeVector& node_list,
+                                               const NodeVector& outputs,
+                                               const ParameterVector& parameters,
+                                               const OutputVector& args);
+
+                    virtual void validate_and_infer_types() override;
+
+                    virtual std::shared_ptr<Node>
+                        copy_with_new_args(const NodeVector& new_args) const override;
+
+                    /// \brief The fused nodes in topological order
+                    const NodeVector& get_node_list() const { return m_node_list; }
+                    const NodeVector& get_kernel_outputs() const { return m_output_nodes; }
+                    const ParameterVector& get_kernel_parameters() const { return m_parameters; }
+                    /// \brief Classify a Broadcast for use inside a LoopKernel
+                    static CPU_BACKEND_API BroadcastKind
+                        get_broadcast_kind(const ngraph::op::Broadcast& broadcast);
+
+                private:
+                    NodeVector m_node_list;
+                    NodeVector m_output_nodes;
+                    ParameterVector m_parameters;
+                };
+            }
+        }
+    }
+}
@@ -0,0 +1,298 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <algorithm>
+#include <list>
+#include <map>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "ngraph/log.hpp"
+#include "ngraph/op/abs.hpp"
+#include "ngraph/op/add.hpp"
+#include "ngraph/op/broadcast.hpp"
+#include "ngraph/op/divide.hpp"
+#include "ngraph/op/exp.hpp"
+#include "ngraph/op/get_output_element.hpp"
+#include "ngraph/op/log.hpp"
+#include "ngraph/op/maximum.hpp"
+#include "ngraph/op/minimum.hpp"
+#include "ngraph/op/multiply.hpp"
+#include "ngraph/op/negative.hpp"
+#include "ngraph/op/parameter.hpp"
+#include "ngraph/op/relu.hpp"
+#include "ngraph/op/sigmoid.hpp"
+#include "ngraph/op/sqrt.hpp"
+#include "ngraph/op/subtract.hpp"
+#include "ngraph/op/tanh.hpp"
+#include "ngraph/runtime/cpu/mkldnn_utils.hpp"
+#include "ngraph/runtime/cpu/op/loop_kernel.hpp"
+#include "ngraph/runtime/cpu/pass/cpu_loop_kernel_fusion.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+#define TI(x) type_index(typeid(x))
+
+static const unordered_set<type_index> s_elementwise_ops{TI(op::Abs),
+                                                         TI(op::Add),
+                                                         TI(op::Divide),
+                                                         TI(op::Exp),
+                                                         TI(op::Log),
+                                                         TI(op::Maximum),
+                                                         TI(op::Minimum),
+                                                         TI(op::Multiply),
+                                                         TI(op::Negative),
+                                                         TI(op::Relu),
+                                                         TI(op::Sigmoid),
+                                                         TI(op::Sqrt),
+                                                         TI(op::Subtract),
+                                                         TI(op::Tanh)};
+
+static bool is_fusible_type(const element::Type& type)
+{
+    return type == element::f32 || type == element::f64;
+}
+
+static bool is_fusible_broadcast(const Node& node)
+{
+    if (TI(node) != TI(op::Broadcast) || !is_fusible_type(node.get_element_type()))
+    {
+        return false;
+    }
+    return runtime::cpu::op::LoopKernel::get_broadcast_kind(
+               static_cast<const op::Broadcast&>(node)) !=
+           runtime::cpu::op::LoopKernel::BroadcastKind::Unsupported;
+}
+
+static bool is_fusible_elementwise(Node& node)
+{
+    if (s_elementwise_ops.count(TI(node)) == 0 || node.get_output_size() != 1 ||
+        !is_fusible_type(node.get_element_type()) || shape_size(node.get_shape()) == 0 ||
+        runtime::cpu::mkldnn_utils::use_mkldnn_kernel(&node))
+    {
+        return false;
+    }
+    // Implicit broadcasts have been made explicit by now, but do not rely on it
+    for (const auto& input : node.inputs())
+    {
+        if (input.get_shape() != node.get_shape() ||
+            input.get_element_type() != node.get_element_type())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+namespace
+{
+    struct FusionGroup
+    {
+        // Position of the first elementwise member in topological order. Every input of the
+        // group that is not a leaf comes from before this position, so collapsing the group
+        // into one op cannot create a cycle.
+        size_t first;
+        Shape shape;
+        element::Type type;
+        vector<shared_ptr<Node>> nodes;
+        size_t elementwise_count = 0;
+    };
+}
+
+bool runtime::cpu::pass::CPULoopKernelFusion::run_on_function(shared_ptr<Function> function)
+{
+    list<shared_ptr<Node>> ordered_ops = function->get_ordered_ops();
+    unordered_map<const Node*, size_t> position;
+    size_t next_position = 0;
+    for (const auto& node : ordered_ops)
+    {
+        position[node.get()] = next_position++;
+    }
+
+    vector<FusionGroup> groups;
+    unordered_map<const Node*, size_t> group_of;
+    unordered_set<const Node*> broadcasts;
+
+    auto is_independent_of = [&](const Node* source, const FusionGroup& group) {
+        return source->get_input_size() == 0 || position.at(source) < group.first;
+    };
+    // A Broadcast used only by node is read directly by the kernel instead of materialized
+    auto is_absorbable = [&](const Node* source, const FusionGroup& group) {
+        return broadcasts.count(source) != 0 && group_of.count(source) == 0 &&
+               source->get_users().size() == 1 &&
+               source->get_shape() == group.shape &&
+               is_independent_of(source->input_value(0).get_node(), group);
+    };
+
+    for (const auto& node : ordered_ops)
+    {
+        if (!node->get_control_dependencies().empty() || !node->get_control_dependents().empty())
+        {
+            continue;
+        }
+        if (is_fusible_broadcast(*node))
+        {
+            broadcasts.insert(node.get());
+            continue;
+        }
+        if (!is_fusible_elementwise(*node))
+        {
+            continue;
+        }
+
+        // Join the group of the first producer that keeps the fused graph acyclic
+        size_t target = groups.size();
+        for (const auto& source : node->input_values())
+        {
+            auto it = group_of.find(source.get_node());
+            if (it == group_of.end())
+            {
+                continue;
+            }
+            FusionGroup& group = groups[it->second];
+            if (group.shape != node->get_shape() || group.type != node->get_element_type() ||
+                group.nodes.size() >= m_max_kernel_size)
+            {
+                continue;
+            }
+            bool can_join = true;
+            for (const auto& other : node->input_values())
+            {
+                const Node* other_node = other.get_node();
+                auto other_group = group_of.find(other_node);
+                bool in_group = other_group != group_of.end() && other_group->second == it->second;
+                can_join = can_join &&
+                           (in_group || is_independent_of(other_node, group) ||
+                            is_absorbable(other_node, group));
+            }
+            if (can_join)
+            {
+                target = it->second;
+                break;
+            }
+        }
+        if (target == groups.size())
+        {
+            FusionGroup group;
+            group.first = position.at(node.get());
+            group.shape = node->get_shape();
+            group.type = node->get_element_type();
+            groups.push_back(group);
+        }
+
+        FusionGroup& group = groups[target];
+        for (const auto& source : node->input_values())
+        {
+            const Node* source_node = source.get_node();
+            if (is_absorbable(source_node, group))
+            {
+                group.nodes.push_back(source.get_node_shared_ptr());
+                group_of[source_node] = target;
+            }
+        }
+        group.nodes.push_back(node);
+        group.elementwise_count++;
+        group_of[node.get()] = target;
+    }
+
+    bool replaced = false;
+    for (FusionGroup& group : groups)
+    {
+        if (group.nodes.size() < 2)
+        {
+            continue;
+        }
+        sort(group.nodes.begin(),
+             group.nodes.end(),
+             [&](const shared_ptr<Node>& a, const shared_ptr<Node>& b) {
+                 return position.at(a.get()) < position.at(b.get());
+             });
+        unordered_set<const Node*> members;
+        for (const auto& node : group.nodes)
+        {
+            members.insert(node.get());
+        }
+
+        // Clone the group onto kernel parameters so the fused nodes do not reference the
+        // enclosing graph
+        NodeVector node_list;
+        ParameterVector parameters;
+        OutputVector args;
+        map<Output<Node>, shared_ptr<ngraph::op::Parameter>> parameter_for;
+        unordered_map<const Node*, shared_ptr<Node>> clone_of;
+        NodeVector outputs;
+        NodeVector kernel_outputs;
+        for (const auto& node : group.nodes)
+        {
+            OutputVector new_args;
+            for (const auto& source : node->input_values())
+            {
+                if (members.count(source.get_node()) != 0)
+                {
+                    new_args.push_back(clone_of.at(source.get_node())->output(0));
+                    continue;
+                }
+                auto it = parameter_for.find(source);
+                if (it == parameter_for.end())
+                {
+                    auto parameter = make_shared<ngraph::op::Parameter>(source.get_element_type(),
+                                                                        source.get_shape());
+                    it = parameter_for.insert({source, parameter}).first;
+                    parameters.push_back(parameter);
+                    args.push_back(source);
+                }
+                new_args.push_back(it->second->output(0));
+            }
+            auto clone = node->copy_with_new_inputs(new_args);
+            clone_of[node.get()] = clone;
+            node_list.push_back(clone);
+
+            for (const auto& target : node->output(0).get_target_inputs())
+            {
+                if (members.count(target.get_node()) == 0)
+                {
+                    outputs.push_back(node);
+                    kernel_outputs.push_back(clone);
+                    break;
+                }
+            }
+        }
+
+        auto loop_kernel =
+            make_shared<runtime::cpu::op::LoopKernel>(node_list, kernel_outputs, parameters, args);
+        for (size_t i = 0; i < outputs.size(); i++)
+        {
+            shared_ptr<Node> replacement = loop_kernel;
+            if (outputs.size() > 1)
+            {
+                replacement = make_shared<ngraph::op::GetOutputElement>(loop_kernel, i);
+            }
+            for (const auto& target : outputs[i]->output(0).get_target_inputs())
+            {
+                if (members.count(target.get_node()) == 0)
+                {
+                    target.replace_source_output(replacement->output(0));
+                }
+            }
+        }
+        NGRAPH_DEBUG << "Fused " << group.nodes.size() << " ops into " << loop_kernel->get_name();
+        replaced = true;
+    }
+    return replaced;
+}
@@ -0,0 +1,48 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include "ngraph/pass/pass.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            namespace pass
+            {
+                /// \brief Collapses connected elementwise ops that share an output shape, and
+                ///        the Broadcasts feeding them, into LoopKernel ops that compute the
+                ///        whole subgraph in a single pass over memory.
+                class CPULoopKernelFusion : public ngraph::pass::FunctionPass
+                {
+                public:
+                    /// \param max_kernel_size Maximum number of ops fused into one kernel
+                    CPULoopKernelFusion(size_t max_kernel_size = 32)
+                        : m_max_kernel_size(max_kernel_size)
+                    {
+                    }
+                    bool run_on_function(std::shared_ptr<ngraph::Function> function) override;
+
+                private:
+                    size_t m_max_kernel_size;
+                };
+            }
+        }
+    }
+}
@@ -17,14 +17,18 @@
 #include <exception>
 #include <sstream>
 
+#include "ngraph/descriptor/layout/tensor_layout.hpp"
 #include "ngraph/log.hpp"
 #include "ngraph/log.hpp"
 #include "ngraph/op/concat.hpp"
 #include "ngraph/op/constant.hpp"
 #include "ngraph/op/slice.hpp"
+#include "ngraph/op/util/binary_elementwise_arithmetic.hpp"
+#include "ngraph/op/util/unary_elementwise_arithmetic.hpp"
 #include "ngraph/pass/manager.hpp"
 #include "ngraph/pass/memory_layout.hpp"
 #include "ngraph/runtime/cpu/cpu_op_annotations.hpp"
+#include "ngraph/runtime/cpu/mkldnn_utils.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_memory_assignment.hpp"
 #include "ngraph/util.hpp"
 
@@ -36,9 +40,11 @@ runtime::cpu::pass::CPUMemoryAssignment::CPUMemoryAssignment(
         bufferID_to_tensorSets,
     unordered_map<descriptor::Tensor*, size_t>& tensor_to_bufferID,
     size_t alignment,
-    bool disable_memory_sharing)
+    bool disable_memory_sharing,
+    bool in_place_elementwise)
     : m_alignment(alignment)
     , m_disable_memory_sharing(disable_memory_sharing)
+    , m_in_place_elementwise(in_place_elementwise)
     , m_bufferID_to_tensorSets(bufferID_to_tensorSets)
     , m_tensor_to_bufferID(tensor_to_bufferID)
 {
@@ -574,6 +580,79 @@ void runtime::cpu::pass::CPUMemoryAssignment::build_buffer_sets_maps(list<shared
     }
 }
 
+void runtime::cpu::pass::CPUMemoryAssignment::annotate_in_place_elementwise(
+    std::list<std::shared_ptr<Node>>& ops)
+{
+    for (const shared_ptr<Node>& node : ops)
+    {
+        bool unary =
+            dynamic_pointer_cast<ngraph::op::util::UnaryElementwiseArithmetic>(node) != nullptr;
+        bool binary =
+            dynamic_pointer_cast<ngraph::op::util::BinaryElementwiseArithmetic>(node) != nullptr;
+        if (!(unary || binary) || node->get_output_size() != 1)
+        {
+            continue;
+        }
+        auto op = static_pointer_cast<ngraph::op::Op>(node);
+        auto op_annotations = op->get_op_annotations();
+        // keep the in-place choices made by CPUAssignment
+        if (!op_annotations || op_annotations->get_in_place_oi_pairs().size() > 0)
+        {
+            continue;
+        }
+        // MKLDNN eltwise primitives run in place, binary primitives only for the inputs chosen
+        // by CPUAssignment
+        if (binary && mkldnn_utils::use_mkldnn_kernel(node.get()))
+        {
+            continue;
+        }
+
+        auto output_tensor = &node->get_output_tensor(0);
+        auto output_layout = output_tensor->get_tensor_layout();
+        if (!output_layout || output_tensor->size() == 0)
+        {
+            continue;
+        }
+        for (size_t i = 0; i < node->get_input_size(); i++)
+        {
+            auto input_tensor = &node->get_inputs().at(i).get_tensor();
+            // the input buffer must not be read after this op
+            if (node->liveness_free_list.count(input_tensor) == 0)
+            {
+                continue;
+            }
+            auto input_layout = input_tensor->get_tensor_layout();
+            if (input_tensor->get_element_type() != output_tensor->get_element_type() ||
+                input_tensor->get_shape() != output_tensor->get_shape() || !input_layout ||
+                *input_layout != *output_layout)
+            {
+                continue;
+            }
+            auto input_buffer_it = m_bufferID_to_tensorSets.find(get_bufferID(input_tensor));
+            NGRAPH_CHECK(input_buffer_it != m_bufferID_to_tensorSets.end());
+            if (input_buffer_it->second.first != TensorRole::INTERMEDIATE)
+            {
+                continue;
+            }
+            // every tensor in the buffer must cover all of it, so the kernel reads and writes
+            // each element at the same address. This rules out buffers holding in-place slices
+            // and concat arguments.
+            bool whole_buffer = true;
+            for (auto tensor : input_buffer_it->second.second)
+            {
+                whole_buffer = whole_buffer && tensor->size() == output_tensor->size();
+            }
+            if (whole_buffer)
+            {
+                NGRAPH_DEBUG << "cpu_memory_assignment: " << node->get_name()
+                             << " may overwrite input " << i;
+                op_annotations->add_in_place_oi_pair({0, i, true});
+                break;
+            }
+        }
+    }
+}
+
 void runtime::cpu::pass::CPUMemoryAssignment::liveness_analysis(
     std::list<std::shared_ptr<Node>>& ops)
 {
@@ -654,6 +733,10 @@ bool runtime::cpu::pass::CPUMemoryAssignment::run_on_function(shared_ptr<ngraph:
 
     build_buffer_sets_maps(ops);
     liveness_analysis(ops);
+    if (m_in_place_elementwise)
+    {
+        annotate_in_place_elementwise(ops);
+    }
 
     // memory assignment using liveness analysis result
 
@@ -661,6 +744,14 @@ bool runtime::cpu::pass::CPUMemoryAssignment::run_on_function(shared_ptr<ngraph:
     ngraph::pass::MemoryManager mm(m_alignment, m_disable_memory_sharing);
     // memory manager for cacheable ops, memory allocation will never be freed
     ngraph::pass::MemoryManager mm_caching(m_alignment, true);
+    // When memory is reused, non-cacheable buffers are only recorded with their lifetimes while
+    // walking the ops, and are placed all at once afterwards. Tensors sharing a planned buffer
+    // through destructive in-place ops get the same offset.
+    bool plan_offline = !m_disable_memory_sharing;
+    ngraph::pass::MemoryPlanner planner(m_alignment);
+    unordered_map<size_t, size_t> planned_buffers;
+    vector<vector<descriptor::Tensor*>> planned_tensors;
+    size_t step = 0;
 
     // reuse memory
     if (!m_disable_memory_sharing)
@@ -694,6 +785,7 @@ bool runtime::cpu::pass::CPUMemoryAssignment::run_on_function(shared_ptr<ngraph:
         {
             continue;
         }
+        step++;
         // handle destructive oi pair
         unordered_set<descriptor::Tensor*> no_free;
         unordered_set<descriptor::Tensor*> no_new;
@@ -788,6 +880,16 @@ bool runtime::cpu::pass::CPUMemoryAssignment::run_on_function(shared_ptr<ngraph:
                         no_free.insert(input_tensor);
                         no_new.insert(output_tensor);
 
+                        auto planned_it = planned_buffers.find(input_bufferID);
+                        if (planned_it != planned_buffers.end())
+                        {
+                            planned_buffers[output_bufferID] = planned_it->second;
+                            auto& tensors = planned_tensors[planned_it->second];
+                            tensors.insert(tensors.end(), output_set.begin(), output_set.end());
+                            output_buffer_it->second.first = input_buffer_it->second.first;
+                            continue;
+                        }
+
                         // set the tensor offset for tensors in the set containing the output tensor
                         // to the starting offset
                         // of the set of input tensor.
@@ -826,6 +928,12 @@ bool runtime::cpu::pass::CPUMemoryAssignment::run_on_function(shared_ptr<ngraph:
             {
                 offset = mm_caching.allocate(size);
             }
+            else if (plan_offline)
+            {
+                planned_buffers[bufferID] = planner.add_buffer(size, step);
+                planned_tensors.emplace_back(tensor_set.begin(), tensor_set.end());
+                continue;
+            }
             else
             {
                 offset = mm.allocate(size);
@@ -849,12 +957,39 @@ bool runtime::cpu::pass::CPUMemoryAssignment::run_on_function(shared_ptr<ngraph:
                 if (m_tensor_caching.empty() ||
                     (!m_tensor_caching.empty() && m_tensor_caching.count(tensor) == 0))
                 {
-                    mm.free(tensor->get_pool_offset());
+                    auto planned_it = planned_buffers.find(get_bufferID(tensor));
+                    if (planned_it != planned_buffers.end())
+                    {
+                        planner.set_last_use(planned_it->second, step);
+                    }
+                    else if (!plan_offline)
+                    {
+                        mm.free(tensor->get_pool_offset());
+                    }
                 }
             }
         }
     }
 
+    size_t max_allocated = mm.max_allocated();
+    if (plan_offline)
+    {
+        planner.plan();
+        for (size_t id = 0; id < planned_tensors.size(); id++)
+        {
+            for (auto tensor : planned_tensors[id])
+            {
+                tensor->set_pool_offset(planner.get_offset(id));
+            }
+        }
+        max_allocated = planner.max_allocated();
+        m_planned_size = max_allocated;
+        m_lower_bound = planner.get_lower_bound();
+        NGRAPH_DEBUG << "cpu_memory_assignment: planned " << planner.get_buffer_count()
+                     << " buffers into " << max_allocated << " bytes, lower bound "
+                     << m_lower_bound << " bytes";
+    }
+
     // update offsets in concat and slice tensors set.
     // In place concatenation optimization
     process_in_place_concat(ops);
@@ -863,7 +998,7 @@ bool runtime::cpu::pass::CPUMemoryAssignment::run_on_function(shared_ptr<ngraph:
     process_in_place_slice(ops);
 
     // update the offset for intermediate tensors in tensor_caching
-    auto start = mm.max_allocated();
+    auto start = max_allocated;
     for (auto item : m_tensor_caching)
     {
         auto bufferID = get_bufferID(item);
@@ -877,13 +1012,13 @@ bool runtime::cpu::pass::CPUMemoryAssignment::run_on_function(shared_ptr<ngraph:
         }
     }
 
-    NGRAPH_DEBUG << "cpu_memory_assignemnt: max allocated for mm is " << mm.max_allocated();
+    NGRAPH_DEBUG << "cpu_memory_assignemnt: max allocated for mm is " << max_allocated;
     NGRAPH_DEBUG << "cpu_memory_assignment: max allocated for mm_caching is "
                  << mm_caching.max_allocated();
     NGRAPH_DEBUG << "cpu_memory_assignment: max allocated in total is "
-                 << mm.max_allocated() + mm_caching.max_allocated();
+                 << max_allocated + mm_caching.max_allocated();
 
-    function->set_temporary_pool_size(mm.max_allocated() + mm_caching.max_allocated());
+    function->set_temporary_pool_size(max_allocated + mm_caching.max_allocated());
 
     return false;
 }
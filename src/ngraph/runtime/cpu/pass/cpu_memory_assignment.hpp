@@ -45,9 +45,17 @@ public:
         std::unordered_map<size_t, std::pair<TensorRole, std::unordered_set<descriptor::Tensor*>>>&,
         std::unordered_map<descriptor::Tensor*, size_t>&,
         size_t alignment = 1,
-        bool disable_memory_sharing = false);
+        bool disable_memory_sharing = false,
+        bool in_place_elementwise = true);
     bool run_on_function(std::shared_ptr<ngraph::Function>) override;
 
+    /// \brief The size of the arena of the reusable buffers placed by the last run, or 0 if
+    ///        memory is not reused
+    size_t get_planned_size() const { return m_planned_size; }
+    /// \brief The largest number of bytes of reusable buffers live at one step in the last
+    ///        run. No placement of those buffers fits in less.
+    size_t get_lower_bound() const { return m_lower_bound; }
+
 private:
     // Find in-place concat ops and set appropriate memory pool offset for its arguments
     void process_in_place_concat(std::list<std::shared_ptr<Node>> nodes);
@@ -67,13 +75,20 @@ private:
     // liveness analysis to build new and free list for each node
     void liveness_analysis(std::list<std::shared_ptr<Node>>& ops);
 
+    // Let elementwise ops overwrite an input buffer of the same size and layout that is not
+    // read after them
+    void annotate_in_place_elementwise(std::list<std::shared_ptr<Node>>& ops);
+
     size_t get_bufferID(descriptor::Tensor* tensor);
 
     size_t m_alignment;
     bool m_disable_memory_sharing;
+    bool m_in_place_elementwise;
     std::set<descriptor::Tensor*> m_tensor_caching;
     std::unordered_map<size_t,
                        std::pair<ngraph::TensorRole, std::unordered_set<descriptor::Tensor*>>>&
         m_bufferID_to_tensorSets;
     std::unordered_map<descriptor::Tensor*, size_t>& m_tensor_to_bufferID;
+    size_t m_planned_size = 0;
+    size_t m_lower_bound = 0;
 };
@@ -317,7 +317,8 @@ static shared_ptr<ngraph::op::Constant> fold_constant_convertlayout_helper(
             mkldnn::memory::format::goihw);
     }
 
-    // build mkldnn primitive and execute
+    // build mkldnn primitive and execute. mkldnn::memory takes a non-const handle, but the
+    // reorder only reads the input, whose data may be shared with other constants.
     mkldnn::memory in{{input_desc, runtime::cpu::executor::global_cpu_engine},
                       const_cast<void*>(input->get_data_ptr())};
     mkldnn::memory out{{result_desc, runtime::cpu::executor::global_cpu_engine}, result_vec.data()};
@@ -376,7 +377,7 @@ static shared_ptr<ngraph::op::Constant> fold_constant_convertlayout_helper(
             mkldnn::memory::format_tag::goihw);
     }
 
-    // build mkldnn primitive and execute
+    // build mkldnn primitive and execute. The reorder only reads the shared constant data.
     mkldnn::memory in{input_desc,
                       runtime::cpu::executor::global_cpu_engine,
                       const_cast<void*>(input->get_data_ptr())};
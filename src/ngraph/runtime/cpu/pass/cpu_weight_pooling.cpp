@@ -0,0 +1,66 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include "ngraph/runtime/cpu/pass/cpu_weight_pooling.hpp"
+#include "ngraph/graph_util.hpp"
+#include "ngraph/log.hpp"
+#include "ngraph/op/constant.hpp"
+#include "ngraph/runtime/cpu/cpu_layout_descriptor.hpp"
+
+using namespace ngraph;
+using namespace std;
+
+bool runtime::cpu::pass::CPUWeightPooling::run_on_function(shared_ptr<Function> function)
+{
+    bool replaced = false;
+    size_t pooled_bytes = 0;
+    for (auto& node : function->get_ordered_ops())
+    {
+        auto constant = as_type_ptr<ngraph::op::Constant>(node);
+        if (!constant)
+        {
+            continue;
+        }
+        auto& data = constant->get_data_buffer();
+        size_t size = shape_size(constant->get_shape()) * constant->get_element_type().size();
+        auto pooled = m_weight_pool->intern(data, size);
+        if (pooled == data)
+        {
+            continue;
+        }
+
+        auto replacement = make_shared<ngraph::op::Constant>(
+            constant->get_element_type(), constant->get_shape(), pooled);
+        // Keep the layout assigned by CPULayout, which may be an MKLDNN weight layout
+        auto tv = constant->get_output_tensor_ptr(0);
+        if (auto layout = dynamic_pointer_cast<LayoutDescriptor>(tv->get_tensor_layout()))
+        {
+            auto new_tv = replacement->get_output_tensor_ptr(0);
+            auto new_layout = make_shared<LayoutDescriptor>(*new_tv);
+            if (layout->is_mkldnn_layout())
+            {
+                new_layout->set_mkldnn_md(layout->get_mkldnn_md());
+            }
+            new_tv->set_tensor_layout(new_layout);
+        }
+        replace_node(constant, replacement);
+        pooled_bytes += size;
+        replaced = true;
+    }
+    NGRAPH_DEBUG << "CPUWeightPooling: " << pooled_bytes << " bytes of constants of "
+                 << function->get_name() << " shared with other executables";
+    return replaced;
+}
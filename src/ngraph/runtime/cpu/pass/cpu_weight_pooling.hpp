@@ -0,0 +1,51 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <memory>
+
+#include "ngraph/pass/pass.hpp"
+#include "ngraph/runtime/cpu/cpu_backend_visibility.h"
+#include "ngraph/runtime/cpu/cpu_weight_pool.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            namespace pass
+            {
+                /// \brief Replaces the data of every constant, including the weights reordered
+                ///        by CPUConvertLayoutConstantFolding, with the matching buffer of a
+                ///        CPUWeightPool so identical weights are stored once per backend.
+                class CPU_BACKEND_API CPUWeightPooling : public ngraph::pass::FunctionPass
+                {
+                public:
+                    CPUWeightPooling(const std::shared_ptr<CPUWeightPool>& weight_pool)
+                        : m_weight_pool(weight_pool)
+                    {
+                    }
+                    bool run_on_function(std::shared_ptr<ngraph::Function> function) override;
+
+                private:
+                    std::shared_ptr<CPUWeightPool> m_weight_pool;
+                };
+            }
+        }
+    }
+}
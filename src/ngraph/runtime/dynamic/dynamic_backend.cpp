@@ -14,6 +14,9 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <cstdlib>
+#include <cstring>
+
 #include "ngraph/runtime/dynamic/dynamic_backend.hpp"
 #include "ngraph/graph_util.hpp"
 #include "ngraph/op/experimental/dyn_broadcast.hpp"
@@ -64,12 +67,26 @@ shared_ptr<runtime::Executable>
         function, m_wrapped_backend, enable_performance_collection);
 }
 
+static size_t default_cache_capacity()
+{
+    size_t capacity = 64;
+    if (const char* env = std::getenv("NGRAPH_DYNAMIC_CACHE_SIZE"))
+    {
+        capacity = std::strtoul(env, nullptr, 10);
+    }
+    return capacity;
+}
+
 runtime::dynamic::DynamicExecutable::DynamicExecutable(shared_ptr<Function> wrapped_function,
                                                        shared_ptr<runtime::Backend> wrapped_backend,
                                                        bool enable_performance_collection)
     : m_wrapped_function(wrapped_function)
     , m_wrapped_backend(wrapped_backend)
     , m_enable_performance_collection(enable_performance_collection)
+    , m_cache_capacity(default_cache_capacity())
+    , m_cache_hits(0)
+    , m_cache_misses(0)
+    , m_cache_evictions(0)
 {
     pass::Manager passes;
     passes.register_pass<pass::ShapeRelevance>();
@@ -98,22 +115,178 @@ static size_t count_dyn_nodes(const shared_ptr<ngraph::Function>& f)
     return count;
 }
 
+// Appends one argument's contribution to the executable cache key. The key covers the element
+// type, the concrete shape, and (for shape-relevant arguments only) the raw bytes of the value.
+static void append_cache_key(std::string& key,
+                             const element::Type& element_type,
+                             const Shape& shape,
+                             const void* value,
+                             size_t value_size)
+{
+    std::ostringstream ss;
+    ss << element_type.c_type_string() << shape;
+    key += ss.str();
+    if (value != nullptr)
+    {
+        key += '=';
+        key.append(static_cast<const char*>(value), value_size);
+    }
+    key += ';';
+}
+
+size_t runtime::dynamic::ShapeBucket::get_bucket_size(size_t extent) const
+{
+    if (sizes.empty())
+    {
+        NGRAPH_CHECK(multiple_of > 0, "Shape bucket multiple must be positive");
+        return ((extent + multiple_of - 1) / multiple_of) * multiple_of;
+    }
+
+    size_t bucket_size = std::numeric_limits<size_t>::max();
+    for (size_t size : sizes)
+    {
+        if (size >= extent && size < bucket_size)
+        {
+            bucket_size = size;
+        }
+    }
+
+    // Extents larger than every bucket run unpadded.
+    return bucket_size == std::numeric_limits<size_t>::max() ? extent : bucket_size;
+}
+
+// Copies the leading `block`-shaped corner of the row-major buffer `src` (of shape `src_shape`)
+// into the leading corner of the row-major buffer `dst` (of shape `dst_shape`). Used both to pad
+// inputs up to a bucket shape and to slice outputs back down.
+static void copy_corner(const char* src,
+                        const Shape& src_shape,
+                        char* dst,
+                        const Shape& dst_shape,
+                        const Shape& block,
+                        size_t element_size)
+{
+    if (shape_size(block) == 0)
+    {
+        return;
+    }
+
+    size_t rank = block.size();
+    if (rank == 0)
+    {
+        memcpy(dst, src, element_size);
+        return;
+    }
+
+    Strides src_strides = row_major_strides(src_shape);
+    Strides dst_strides = row_major_strides(dst_shape);
+    size_t run_bytes = block[rank - 1] * element_size;
+    size_t outer_count = shape_size(block) / block[rank - 1];
+    Coordinate coord(rank - 1, 0);
+
+    for (size_t n = 0; n < outer_count; n++)
+    {
+        size_t src_offset = 0;
+        size_t dst_offset = 0;
+        for (size_t axis = 0; axis < rank - 1; axis++)
+        {
+            src_offset += coord[axis] * src_strides[axis];
+            dst_offset += coord[axis] * dst_strides[axis];
+        }
+        memcpy(dst + dst_offset * element_size, src + src_offset * element_size, run_bytes);
+
+        for (size_t axis = rank - 1; axis-- > 0;)
+        {
+            if (++coord[axis] < block[axis])
+            {
+                break;
+            }
+            coord[axis] = 0;
+        }
+    }
+}
+
+// Returns a new tensor on `backend` holding `input` zero-padded up to `padded_shape`.
+static shared_ptr<runtime::Tensor> pad_tensor(const shared_ptr<runtime::Backend>& backend,
+                                              const shared_ptr<runtime::Tensor>& input,
+                                              const Shape& padded_shape)
+{
+    const element::Type& et = input->get_element_type();
+    std::vector<char> src(input->get_size_in_bytes());
+    input->read(src.data(), src.size());
+
+    std::vector<char> dst(shape_size(padded_shape) * et.size(), 0);
+    copy_corner(src.data(),
+                input->get_shape(),
+                dst.data(),
+                padded_shape,
+                input->get_shape(),
+                et.size());
+
+    auto padded = backend->create_tensor(et, padded_shape);
+    padded->write(dst.data(), dst.size());
+    return padded;
+}
+
+// Copies the leading corner of `padded` into `output`, whose shape must already be set.
+static void slice_tensor(const shared_ptr<runtime::Tensor>& padded,
+                         const shared_ptr<runtime::Tensor>& output)
+{
+    const element::Type& et = padded->get_element_type();
+    std::vector<char> src(padded->get_size_in_bytes());
+    padded->read(src.data(), src.size());
+
+    std::vector<char> dst(output->get_size_in_bytes());
+    copy_corner(src.data(),
+                padded->get_shape(),
+                dst.data(),
+                output->get_shape(),
+                output->get_shape(),
+                et.size());
+    output->write(dst.data(), dst.size());
+}
+
+void runtime::dynamic::DynamicExecutable::add_shape_bucket(const ShapeBucket& bucket)
+{
+    NGRAPH_CHECK(!bucket.input_axes.empty(), "Shape bucket must name at least one input axis");
+    for (auto& input_axis : bucket.input_axes)
+    {
+        NGRAPH_CHECK(input_axis.first < m_wrapped_function->get_parameters().size(),
+                     "Shape bucket refers to nonexistent input ",
+                     input_axis.first);
+        NGRAPH_CHECK(
+            !m_wrapped_function->get_parameters()[input_axis.first]->is_relevant_to_shapes(),
+            "Shape bucket refers to input ",
+            input_axis.first,
+            ", which is relevant to shapes and cannot be padded");
+    }
+    for (auto& output_axis : bucket.output_axes)
+    {
+        NGRAPH_CHECK(output_axis.first < m_wrapped_function->get_output_size(),
+                     "Shape bucket refers to nonexistent output ",
+                     output_axis.first);
+    }
+    m_shape_buckets.push_back(bucket);
+}
+
+void runtime::dynamic::DynamicExecutable::clear_shape_buckets()
+{
+    m_shape_buckets.clear();
+}
+
 bool runtime::dynamic::DynamicExecutable::call(
     const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
     const std::vector<std::shared_ptr<runtime::Tensor>>& inputs)
 {
-    // TODO: Get cached executable out if it exists.
-    // We will cache on:
-    // (1) all shapes;
-    // (2) all values of shape-relevant input tensors.
-
     NGRAPH_CHECK(m_wrapped_function->get_parameters().size() == inputs.size());
 
     std::vector<std::shared_ptr<runtime::Tensor>> wrapped_inputs;
     std::vector<element::Type> arg_element_types;
     std::vector<PartialShape> arg_shapes;
 
-    std::shared_ptr<Function> clone;
+    // Actual extent of each registered shape bucket for this call.
+    std::vector<size_t> bucket_extents(m_shape_buckets.size());
+
+    std::shared_ptr<runtime::Executable> compiled_executable;
     {
         // We'll use AlignedBuffers to back the base pointers, storing them in this vector for RAII
         // purposes.
@@ -165,10 +338,147 @@ bool runtime::dynamic::DynamicExecutable::call(
             i++;
         }
 
-        clone = specialize_function(
-            m_wrapped_function, arg_element_types, arg_shapes, arg_value_base_pointers);
+        // Pad bucketed inputs up to their bucket shapes. Only inputs that are not relevant to
+        // shapes can be bucketed (see add_shape_bucket), so arg_value_base_pointers is unaffected.
+        if (!m_shape_buckets.empty())
+        {
+            std::vector<Shape> padded_shapes(arg_shapes.size());
+            for (size_t j = 0; j < arg_shapes.size(); j++)
+            {
+                padded_shapes[j] = arg_shapes[j].to_shape();
+            }
+
+            for (size_t b = 0; b < m_shape_buckets.size(); b++)
+            {
+                const ShapeBucket& bucket = m_shape_buckets[b];
+                bool first = true;
+                for (auto& input_axis : bucket.input_axes)
+                {
+                    const Shape& shape = padded_shapes[input_axis.first];
+                    NGRAPH_CHECK(input_axis.second < shape.size(),
+                                 "Shape bucket axis ",
+                                 input_axis.second,
+                                 " is out of range for input ",
+                                 input_axis.first,
+                                 " with shape ",
+                                 shape);
+                    NGRAPH_CHECK(first || bucket_extents[b] == shape[input_axis.second],
+                                 "Inputs disagree on the extent of a bucketed dimension");
+                    bucket_extents[b] = shape[input_axis.second];
+                    first = false;
+                }
+
+                size_t bucket_size = bucket.get_bucket_size(bucket_extents[b]);
+                for (auto& input_axis : bucket.input_axes)
+                {
+                    padded_shapes[input_axis.first][input_axis.second] = bucket_size;
+                }
+            }
+
+            for (size_t j = 0; j < arg_shapes.size(); j++)
+            {
+                if (padded_shapes[j] != arg_shapes[j].to_shape())
+                {
+                    wrapped_inputs[j] =
+                        pad_tensor(m_wrapped_backend, wrapped_inputs[j], padded_shapes[j]);
+                    arg_shapes[j] = padded_shapes[j];
+                }
+            }
+        }
+
+        std::string cache_key;
+        for (size_t j = 0; j < arg_shapes.size(); j++)
+        {
+            append_cache_key(cache_key,
+                             arg_element_types[j],
+                             arg_shapes[j].to_shape(),
+                             arg_value_base_pointers[j],
+                             wrapped_inputs[j]->get_size_in_bytes());
+        }
+
+        compiled_executable = cache_lookup(cache_key);
+        if (compiled_executable == nullptr)
+        {
+            compiled_executable =
+                specialize_and_compile(arg_element_types, arg_shapes, arg_value_base_pointers);
+            cache_insert(cache_key, compiled_executable);
+        }
     }
 
+    std::vector<std::shared_ptr<runtime::Tensor>> wrapped_outputs;
+
+    const ResultVector& results = compiled_executable->get_results();
+    NGRAPH_CHECK(results.size() == outputs.size());
+
+    // Shapes of the outputs with bucketed axes sliced back to their actual extents.
+    std::vector<Shape> output_shapes(outputs.size());
+    for (size_t i = 0; i < outputs.size(); i++)
+    {
+        output_shapes[i] = results[i]->get_output_shape(0);
+    }
+    for (size_t b = 0; b < m_shape_buckets.size(); b++)
+    {
+        for (auto& output_axis : m_shape_buckets[b].output_axes)
+        {
+            Shape& shape = output_shapes[output_axis.first];
+            NGRAPH_CHECK(output_axis.second < shape.size(),
+                         "Shape bucket axis ",
+                         output_axis.second,
+                         " is out of range for output ",
+                         output_axis.first,
+                         " with shape ",
+                         shape);
+            shape[output_axis.second] = bucket_extents[b];
+        }
+    }
+
+    // Bucketed outputs are computed into padded temporaries and sliced afterwards.
+    std::vector<std::pair<std::shared_ptr<runtime::Tensor>, std::shared_ptr<runtime::Tensor>>>
+        padded_outputs;
+
+    for (size_t i = 0; i < outputs.size(); i++)
+    {
+        std::shared_ptr<runtime::Tensor> wrapped_output;
+        if (auto dynamic_tensor =
+                std::dynamic_pointer_cast<runtime::dynamic::DynamicTensor>(outputs[i]))
+        {
+            dynamic_tensor->make_storage(results[i]->get_output_element_type(0),
+                                         output_shapes[i]);
+            wrapped_output = dynamic_tensor->get_wrapped_tensor();
+        }
+        else
+        {
+            wrapped_output = outputs[i];
+        }
+
+        if (output_shapes[i] != results[i]->get_output_shape(0))
+        {
+            auto padded = m_wrapped_backend->create_tensor(results[i]->get_output_element_type(0),
+                                                           results[i]->get_output_shape(0));
+            padded_outputs.emplace_back(padded, wrapped_output);
+            wrapped_output = padded;
+        }
+        wrapped_outputs.push_back(wrapped_output);
+    }
+
+    bool rc = compiled_executable->call(wrapped_outputs, wrapped_inputs);
+
+    for (auto& padded_output : padded_outputs)
+    {
+        slice_tensor(padded_output.first, padded_output.second);
+    }
+
+    return rc;
+}
+
+shared_ptr<runtime::Executable> runtime::dynamic::DynamicExecutable::specialize_and_compile(
+    const std::vector<element::Type>& arg_element_types,
+    const std::vector<PartialShape>& arg_shapes,
+    const std::vector<void*>& arg_value_base_pointers)
+{
+    std::shared_ptr<Function> clone = specialize_function(
+        m_wrapped_function, arg_element_types, arg_shapes, arg_value_base_pointers);
+
     pass::Manager passes;
     passes.register_pass<pass::ConstantFolding>();
     passes.register_pass<pass::DynElimination>();
@@ -199,37 +509,104 @@ bool runtime::dynamic::DynamicExecutable::call(
     pass_val.register_pass<pass::Validate>();
     pass_val.run_passes(clone);
 
-    std::vector<std::shared_ptr<runtime::Tensor>> wrapped_outputs;
-
-    const ResultVector& results = clone->get_results();
-    for (auto& result : results)
+    for (auto& result : clone->get_results())
     {
         NGRAPH_CHECK(result->get_output_partial_shape(0).is_static(),
                      "Shape staticization failed for result node ",
                      *result);
     }
-    NGRAPH_CHECK(results.size() == outputs.size());
 
-    for (size_t i = 0; i < outputs.size(); i++)
+    return m_wrapped_backend->compile(clone, m_enable_performance_collection);
+}
+
+shared_ptr<runtime::Executable>
+    runtime::dynamic::DynamicExecutable::cache_lookup(const std::string& key)
+{
+    std::lock_guard<std::mutex> lock(m_cache_mutex);
+    auto it = m_cache_map.find(key);
+    if (it == m_cache_map.end())
     {
-        if (auto dynamic_tensor =
-                std::dynamic_pointer_cast<runtime::dynamic::DynamicTensor>(outputs[i]))
-        {
-            dynamic_tensor->make_storage(results[i]->get_output_element_type(0),
-                                         results[i]->get_output_shape(0));
-            wrapped_outputs.push_back(dynamic_tensor->get_wrapped_tensor());
-        }
-        else
-        {
-            wrapped_outputs.push_back(outputs[i]);
-        }
+        m_cache_misses++;
+        return nullptr;
     }
+    m_cache_hits++;
+    m_cache_entries.splice(m_cache_entries.begin(), m_cache_entries, it->second);
+    return it->second->second;
+}
 
-    // TODO: Put compiled executable in the cache.
-    auto compiled_executable = m_wrapped_backend->compile(clone, m_enable_performance_collection);
-    auto result = compiled_executable->call(wrapped_outputs, wrapped_inputs);
+void runtime::dynamic::DynamicExecutable::cache_insert(
+    const std::string& key, const std::shared_ptr<runtime::Executable>& executable)
+{
+    std::lock_guard<std::mutex> lock(m_cache_mutex);
+    if (m_cache_capacity == 0)
+    {
+        return;
+    }
+    auto it = m_cache_map.find(key);
+    if (it != m_cache_map.end())
+    {
+        // Another thread compiled the same specialization concurrently; keep the newer one.
+        m_cache_entries.erase(it->second);
+        m_cache_map.erase(it);
+    }
+    m_cache_entries.emplace_front(key, executable);
+    m_cache_map[key] = m_cache_entries.begin();
+    evict_to_capacity();
+}
 
-    return result;
+// Must be called with m_cache_mutex held.
+void runtime::dynamic::DynamicExecutable::evict_to_capacity()
+{
+    while (m_cache_entries.size() > m_cache_capacity)
+    {
+        m_cache_map.erase(m_cache_entries.back().first);
+        m_cache_entries.pop_back();
+        m_cache_evictions++;
+    }
+}
+
+void runtime::dynamic::DynamicExecutable::set_cache_capacity(size_t capacity)
+{
+    std::lock_guard<std::mutex> lock(m_cache_mutex);
+    m_cache_capacity = capacity;
+    evict_to_capacity();
+}
+
+size_t runtime::dynamic::DynamicExecutable::get_cache_capacity() const
+{
+    std::lock_guard<std::mutex> lock(m_cache_mutex);
+    return m_cache_capacity;
+}
+
+size_t runtime::dynamic::DynamicExecutable::get_cache_size() const
+{
+    std::lock_guard<std::mutex> lock(m_cache_mutex);
+    return m_cache_entries.size();
+}
+
+size_t runtime::dynamic::DynamicExecutable::get_cache_hit_count() const
+{
+    std::lock_guard<std::mutex> lock(m_cache_mutex);
+    return m_cache_hits;
+}
+
+size_t runtime::dynamic::DynamicExecutable::get_cache_miss_count() const
+{
+    std::lock_guard<std::mutex> lock(m_cache_mutex);
+    return m_cache_misses;
+}
+
+size_t runtime::dynamic::DynamicExecutable::get_cache_eviction_count() const
+{
+    std::lock_guard<std::mutex> lock(m_cache_mutex);
+    return m_cache_evictions;
+}
+
+void runtime::dynamic::DynamicExecutable::clear_cache()
+{
+    std::lock_guard<std::mutex> lock(m_cache_mutex);
+    m_cache_entries.clear();
+    m_cache_map.clear();
 }
 
 runtime::dynamic::DynamicTensor::DynamicTensor(
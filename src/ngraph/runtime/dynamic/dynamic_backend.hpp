@@ -16,9 +16,12 @@
 
 #pragma once
 
+#include <list>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "ngraph/runtime/backend.hpp"
@@ -34,6 +37,7 @@ namespace ngraph
             class DynamicBackend;
             class DynamicExecutable;
             class DynamicTensor;
+            struct ShapeBucket;
         }
     }
 }
@@ -74,6 +78,36 @@ private:
     std::shared_ptr<ngraph::runtime::Backend> m_wrapped_backend;
 };
 
+///
+/// \brief Describes one bucketed dimension for `DynamicExecutable::add_shape_bucket`.
+///
+/// A bucketed dimension is a single runtime extent (e.g. "batch" or "sequence length") that
+/// appears on one or more input axes and one or more output axes. Before execution the inputs
+/// are zero-padded along `input_axes` up to the selected bucket size, and after execution the
+/// outputs are sliced back along `output_axes` to the actual extent.
+///
+/// The bucket size is the smallest entry of `sizes` that is not less than the actual extent, or,
+/// if `sizes` is empty, the actual extent rounded up to a multiple of `multiple_of`. If the actual
+/// extent exceeds every entry of `sizes`, the extent is used unpadded.
+///
+/// Zero-padding is only correct for computations in which the padded elements do not affect the
+/// unpadded part of the outputs (e.g. elementwise ops, or batch-independent per-sample
+/// computation); it is the caller's responsibility to register buckets only for such axes.
+///
+struct ngraph::runtime::dynamic::ShapeBucket
+{
+    /// (input index, axis) pairs that carry this dimension.
+    std::vector<std::pair<size_t, size_t>> input_axes;
+    /// (output index, axis) pairs that carry this dimension.
+    std::vector<std::pair<size_t, size_t>> output_axes;
+    /// Allowed padded extents, in any order.
+    std::vector<size_t> sizes;
+    /// Used when `sizes` is empty: pad the extent up to a multiple of this value.
+    size_t multiple_of = 1;
+
+    size_t get_bucket_size(size_t extent) const;
+};
+
 ///
 /// \brief Wrapper class used to provide an Executable that supports dynamic
 ///        tensors on top of a backend that does not support dynamic tensors
@@ -81,11 +115,22 @@ private:
 ///
 /// This class intercepts `call` and:
 ///
-/// 1. creates a clone of the stored function with shapes tailored to the
-///    actual runtime inputs;
-/// 2. compiles the clone using the wrapped backend;
+/// 1. looks up a previously compiled clone in an LRU cache keyed on the
+///    input element types, the input shapes, and the values of all
+///    shape-relevant inputs;
+/// 2. on a cache miss, creates a clone of the stored function with shapes
+///    tailored to the actual runtime inputs, compiles the clone using the
+///    wrapped backend, and adds it to the cache;
 /// 3. fowards the input tensors to the clone executable for actual execution.
 ///
+/// The cache capacity defaults to the value of the environment variable
+/// `NGRAPH_DYNAMIC_CACHE_SIZE` (or 64 if that is not set), and can be changed
+/// with `set_cache_capacity()`. A capacity of zero disables caching.
+///
+/// Optionally, shape buckets can be registered with `add_shape_bucket()`. Inputs are then padded
+/// to the nearest bucket before the cache lookup, so that the number of compiled executables is
+/// bounded by the number of bucket combinations rather than the number of distinct shapes seen.
+///
 /// `DynamicExecutable` objects are produced by `DynamicBackend::compile()`.
 ///
 class ngraph::runtime::dynamic::DynamicExecutable : public ngraph::runtime::Executable
@@ -97,10 +142,53 @@ public:
     virtual bool call(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
                       const std::vector<std::shared_ptr<runtime::Tensor>>& inputs) override;
 
+    /// \brief Set the maximum number of specialized executables kept in the cache. If the
+    ///        cache currently holds more entries, the least recently used ones are evicted.
+    void set_cache_capacity(size_t capacity);
+    size_t get_cache_capacity() const;
+    /// \returns The number of specialized executables currently held in the cache.
+    size_t get_cache_size() const;
+    /// \returns The number of calls that were served from the cache.
+    size_t get_cache_hit_count() const;
+    /// \returns The number of calls that required specializing and compiling a clone.
+    size_t get_cache_miss_count() const;
+    /// \returns The number of executables dropped from the cache to respect its capacity.
+    size_t get_cache_eviction_count() const;
+    /// \brief Drop all cached executables. The hit/miss/eviction counters are not reset.
+    void clear_cache();
+
+    /// \brief Register a bucketed dimension. See `ShapeBucket` for the padding semantics.
+    ///        Inputs that are relevant to shapes cannot be bucketed.
+    void add_shape_bucket(const ShapeBucket& bucket);
+    /// \brief Remove all registered shape buckets.
+    void clear_shape_buckets();
+
 private:
+    std::shared_ptr<ngraph::runtime::Executable>
+        specialize_and_compile(const std::vector<element::Type>& arg_element_types,
+                               const std::vector<PartialShape>& arg_shapes,
+                               const std::vector<void*>& arg_value_base_pointers);
+    std::shared_ptr<ngraph::runtime::Executable> cache_lookup(const std::string& key);
+    void cache_insert(const std::string& key,
+                      const std::shared_ptr<ngraph::runtime::Executable>& executable);
+    void evict_to_capacity();
+
+    using CacheEntry = std::pair<std::string, std::shared_ptr<ngraph::runtime::Executable>>;
+
     std::shared_ptr<ngraph::Function> m_wrapped_function;
     std::shared_ptr<ngraph::runtime::Backend> m_wrapped_backend;
     bool m_enable_performance_collection;
+
+    mutable std::mutex m_cache_mutex;
+    size_t m_cache_capacity;
+    // Most recently used entries are at the front of m_cache_entries.
+    std::list<CacheEntry> m_cache_entries;
+    std::unordered_map<std::string, std::list<CacheEntry>::iterator> m_cache_map;
+    size_t m_cache_hits;
+    size_t m_cache_misses;
+    size_t m_cache_evictions;
+
+    std::vector<ShapeBucket> m_shape_buckets;
 };
 
 ///
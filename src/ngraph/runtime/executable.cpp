@@ -14,11 +14,14 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <algorithm>
 #include <sstream>
+#include <thread>
 
 #include "ngraph/file_util.hpp"
 #include "ngraph/runtime/executable.hpp"
 #include "ngraph/runtime/tensor.hpp"
+#include "ngraph/runtime/thread_pool.hpp"
 #include "ngraph/util.hpp"
 
 using namespace std;
@@ -39,6 +42,50 @@ bool runtime::Executable::call_with_validate(const vector<shared_ptr<runtime::Te
     return call(outputs, inputs);
 }
 
+// Calls started by the default begin_call run on these threads
+static runtime::ThreadPool& get_call_pool()
+{
+    static runtime::ThreadPool pool(max(thread::hardware_concurrency(), 1u) + 1);
+    return pool;
+}
+
+future<bool> runtime::Executable::begin_call(const vector<shared_ptr<runtime::Tensor>>& outputs,
+                                             const vector<shared_ptr<runtime::Tensor>>& inputs,
+                                             CallCallback callback)
+{
+    // Unlike a future from std::async, the future of a packaged_task does not wait for the
+    // task when it is destroyed, so callers may discard it
+    auto task = make_shared<packaged_task<bool()>>(make_call_task(
+        [this, outputs, inputs]() { return call(outputs, inputs); }, callback));
+    future<bool> result = task->get_future();
+    get_call_pool().post([task]() { (*task)(); });
+    return result;
+}
+
+function<bool()> runtime::Executable::make_call_task(function<bool()> run_call, CallCallback callback)
+{
+    return [run_call, callback]() {
+        bool rc;
+        try
+        {
+            rc = run_call();
+        }
+        catch (...)
+        {
+            if (callback)
+            {
+                callback(current_exception());
+            }
+            throw;
+        }
+        if (callback)
+        {
+            callback(nullptr);
+        }
+        return rc;
+    };
+}
+
 void runtime::Executable::validate(const vector<std::shared_ptr<runtime::Tensor>>& outputs,
                                    const vector<std::shared_ptr<runtime::Tensor>>& inputs)
 {
@@ -16,6 +16,9 @@
 
 #pragma once
 
+#include <exception>
+#include <functional>
+#include <future>
 #include <memory>
 
 #include "ngraph/function.hpp"
@@ -44,6 +47,24 @@ public:
     virtual bool call(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
                       const std::vector<std::shared_ptr<runtime::Tensor>>& inputs) = 0;
 
+    /// \brief Called when a call started with begin_call completes. The argument is null if
+    ///        the call succeeded, otherwise it holds the exception raised by the call.
+    using CallCallback = std::function<void(std::exception_ptr)>;
+
+    /// \brief Starts a single iteration of a Function and returns without waiting for it.
+    ///        The tensors must not be accessed until the call completes. The Executable and
+    ///        the tensors must stay alive until then; the handle does not own them. The
+    ///        returned future may be discarded without waiting: the call still runs, and the
+    ///        callback reports its completion.
+    /// \param outputs vector of runtime::Tensor used as outputs
+    /// \param inputs vector of runtime::Tensor used as inputs
+    /// \param callback Optional function called on the executing thread when the call completes
+    /// \returns A future holding the result of call(), or the exception it raised
+    virtual std::future<bool>
+        begin_call(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
+                   const std::vector<std::shared_ptr<runtime::Tensor>>& inputs,
+                   CallCallback callback = nullptr);
+
     /// \brief Executes a single iteration of a Function.
     /// \param outputs vector of runtime::Tensor used as outputs
     /// \param inputs vector of runtime::Tensor used as inputs
@@ -109,6 +130,11 @@ protected:
     /// \param func The function with Results fully resolved.
     void set_parameters_and_results(const Function& func);
 
+    /// \brief Wraps a call for begin_call implementations. The task runs run_call, then the
+    ///        callback, and rethrows any exception so that it reaches the future.
+    static std::function<bool()> make_call_task(std::function<bool()> run_call,
+                                                CallCallback callback);
+
 private:
     ngraph::ParameterVector m_parameters;
     ngraph::ResultVector m_results;
@@ -16,6 +16,8 @@
 
 #include "ngraph/runtime/generic_cpu/gcpu_backend_visibility.hpp"
 
+#include <cstdlib>
+
 #include "ngraph/except.hpp"
 #include "ngraph/runtime/backend_manager.hpp"
 #include "ngraph/runtime/generic_cpu/gcpu_backend.hpp"
@@ -26,6 +28,17 @@
 using namespace std;
 using namespace ngraph;
 
+static shared_ptr<runtime::ThreadPool> make_thread_pool(size_t thread_count)
+{
+    return thread_count > 1 ? make_shared<runtime::ThreadPool>(thread_count) : nullptr;
+}
+
+static size_t get_default_thread_count()
+{
+    const char* env_threads = getenv("NGRAPH_GCPU_THREADS");
+    return env_threads == nullptr ? 1 : strtoul(env_threads, nullptr, 10);
+}
+
 extern "C" GCPU_BACKEND_API void ngraph_register_gcpu_backend()
 {
     runtime::BackendManager::register_backend("GCPU", [](const std::string& config) {
@@ -34,11 +47,13 @@ extern "C" GCPU_BACKEND_API void ngraph_register_gcpu_backend()
 }
 
 runtime::gcpu::GCPUBackend::GCPUBackend()
+    : m_thread_pool{make_thread_pool(get_default_thread_count())}
 {
 }
 
 runtime::gcpu::GCPUBackend::GCPUBackend(const vector<string>& unsupported_op_name_list)
     : m_unsupported_op_name_list{unsupported_op_name_list.begin(), unsupported_op_name_list.end()}
+    , m_thread_pool{make_thread_pool(get_default_thread_count())}
 {
 }
 
@@ -59,10 +74,31 @@ shared_ptr<runtime::Executable>
     runtime::gcpu::GCPUBackend::compile(shared_ptr<Function> function,
                                         bool enable_performance_collection)
 {
-    return make_shared<GCPUExecutable>(function, enable_performance_collection);
+    auto exec = make_shared<GCPUExecutable>(function, enable_performance_collection);
+    exec->m_thread_pool = m_thread_pool;
+    return exec;
 }
 
 bool runtime::gcpu::GCPUBackend::is_supported(const Node& node) const
 {
     return m_unsupported_op_name_list.find(node.description()) == m_unsupported_op_name_list.end();
 }
+
+bool runtime::gcpu::GCPUBackend::set_config(const map<string, string>& config, string& error)
+{
+    error = "";
+    auto it = config.find("num_threads");
+    if (it == config.end())
+    {
+        return false;
+    }
+    char* end = nullptr;
+    size_t thread_count = strtoul(it->second.c_str(), &end, 10);
+    if (it->second.empty() || *end != '\0' || thread_count == 0)
+    {
+        error = "num_threads must be a positive integer, got '" + it->second + "'";
+        return false;
+    }
+    m_thread_pool = make_thread_pool(thread_count);
+    return true;
+}
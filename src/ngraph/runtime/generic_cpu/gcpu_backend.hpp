@@ -24,6 +24,7 @@
 
 #include "ngraph/runtime/reference/allreduce.hpp"
 #include "ngraph/runtime/tensor.hpp"
+#include "ngraph/runtime/thread_pool.hpp"
 
 namespace ngraph
 {
@@ -56,6 +57,12 @@ public:
 
     bool is_supported(const Node& node) const override;
 
+    /// \brief Accepts "num_threads", the number of threads that run the reference kernels of
+    ///        executables compiled afterwards. The default is 1, or the value of the
+    ///        NGRAPH_GCPU_THREADS environment variable.
+    bool set_config(const std::map<std::string, std::string>& config, std::string& error) override;
+
 private:
     std::set<std::string> m_unsupported_op_name_list;
+    std::shared_ptr<ThreadPool> m_thread_pool;
 };
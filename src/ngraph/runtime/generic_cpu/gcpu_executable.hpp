@@ -72,6 +72,7 @@
 #include "ngraph/runtime/aligned_buffer.hpp"
 #include "ngraph/runtime/backend.hpp"
 #include "ngraph/runtime/generic_cpu/kernel/broadcast.hpp"
+#include "ngraph/runtime/generic_cpu/kernel/convolution.hpp"
 #include "ngraph/runtime/generic_cpu/kernel/dot.hpp"
 #include "ngraph/runtime/generic_cpu/kernel/reshape.hpp"
 #include "ngraph/runtime/generic_cpu/node_wrapper.hpp"
@@ -158,6 +159,7 @@
 #include "ngraph/runtime/reference/topk.hpp"
 #include "ngraph/runtime/reference/xor.hpp"
 #include "ngraph/runtime/tensor.hpp"
+#include "ngraph/runtime/thread_pool.hpp"
 #include "ngraph/state/bernoulli_rng_state.hpp"
 
 namespace ngraph
@@ -201,6 +203,7 @@ private:
     std::vector<NodeWrapper> m_wrapped_nodes;
     std::unordered_map<const Node*, std::shared_ptr<ngraph::State>> m_states;
     std::set<std::string> m_unsupported_op_name_list;
+    std::shared_ptr<ThreadPool> m_thread_pool;
 
     static void perform_nan_check(const std::vector<std::shared_ptr<HostTensor>>&,
                                   const Node* op = nullptr);
@@ -626,54 +629,48 @@ private:
         case OP_TYPEID::Convolution:
         {
             const op::Convolution* c = static_cast<const op::Convolution*>(&node);
-            reference::convolution<T>(args[0]->get_data_ptr<const T>(),
-                                      args[1]->get_data_ptr<const T>(),
-                                      out[0]->get_data_ptr<T>(),
-                                      node.get_input_shape(0),
-                                      node.get_input_shape(1),
-                                      node.get_output_shape(0),
-                                      c->get_window_movement_strides(),
-                                      c->get_window_dilation_strides(),
-                                      c->get_padding_below(),
-                                      c->get_padding_above(),
-                                      c->get_data_dilation_strides());
-
+            kernel::convolution<T>(args[0]->get_data_ptr<const T>(),
+                                   args[1]->get_data_ptr<const T>(),
+                                   out[0]->get_data_ptr<T>(),
+                                   node.get_input_shape(0),
+                                   node.get_input_shape(1),
+                                   node.get_output_shape(0),
+                                   c->get_window_movement_strides(),
+                                   c->get_window_dilation_strides(),
+                                   c->get_padding_below(),
+                                   c->get_data_dilation_strides());
             break;
         }
         case OP_TYPEID::ConvolutionBackpropFilters:
         {
             const op::ConvolutionBackpropFilters* c =
                 static_cast<const op::ConvolutionBackpropFilters*>(&node);
-            reference::convolution_backprop_filter<T>(
-                args[0]->get_data_ptr<const T>(), // input
-                args[1]->get_data_ptr<const T>(), // delta_convolution_output
-                out[0]->get_data_ptr<T>(),        // delta_filter
-                c->get_input_shape(0),            // input_shape
-                c->get_input_shape(1),            // convolution_output_shape
-                c->get_filters_shape(),           // filter_shape
-                c->get_window_dilation_strides_forward(),
-                c->get_window_movement_strides_forward(),
-                c->get_padding_below_forward(),
-                c->compute_backward_in_pad_above(),
-                c->get_data_dilation_strides_forward());
+            kernel::convolution_backprop_filter<T>(args[0]->get_data_ptr<const T>(),
+                                                   args[1]->get_data_ptr<const T>(),
+                                                   out[0]->get_data_ptr<T>(),
+                                                   c->get_input_shape(0),
+                                                   c->get_filters_shape(),
+                                                   c->get_input_shape(1),
+                                                   c->get_window_movement_strides_forward(),
+                                                   c->get_window_dilation_strides_forward(),
+                                                   c->get_padding_below_forward(),
+                                                   c->get_data_dilation_strides_forward());
             break;
         }
         case OP_TYPEID::ConvolutionBackpropData:
         {
-            // Note that args[1] and args[0] are switched here from the usual order.
             const op::ConvolutionBackpropData* c =
                 static_cast<const op::ConvolutionBackpropData*>(&node);
-            reference::convolution_backprop_in<T>(args[1]->get_data_ptr<const T>(),
-                                                  args[0]->get_data_ptr<const T>(),
-                                                  out[0]->get_data_ptr<T>(),
-                                                  c->get_input_shape(1),
-                                                  c->get_input_shape(0),
-                                                  c->get_data_batch_shape(),
-                                                  c->get_data_dilation_strides_forward(),
-                                                  c->get_window_dilation_strides_forward(),
-                                                  c->compute_backward_delta_out_pad_below(),
-                                                  c->compute_backward_delta_out_pad_above(),
-                                                  c->get_window_movement_strides_forward());
+            kernel::convolution_backprop_data<T>(args[0]->get_data_ptr<const T>(),
+                                                 args[1]->get_data_ptr<const T>(),
+                                                 out[0]->get_data_ptr<T>(),
+                                                 c->get_data_batch_shape(),
+                                                 c->get_input_shape(0),
+                                                 c->get_input_shape(1),
+                                                 c->get_window_movement_strides_forward(),
+                                                 c->get_window_dilation_strides_forward(),
+                                                 c->get_padding_below_forward(),
+                                                 c->get_data_dilation_strides_forward());
             break;
         }
         case OP_TYPEID::Cos:
@@ -0,0 +1,409 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "ngraph/coordinate.hpp"
+#include "ngraph/coordinate_diff.hpp"
+#include "ngraph/runtime/generic_cpu/kernel/dot.hpp"
+#include "ngraph/runtime/reference/parallel_for.hpp"
+#include "ngraph/shape.hpp"
+#include "ngraph/strides.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace gcpu
+        {
+            namespace kernel
+            {
+                /// \brief The spatial axes of a forward convolution of NC... data with OI...
+                ///        filters into NC... output. The backprop kernels use the geometry of
+                ///        the forward convolution they differentiate.
+                class ConvolutionGeometry
+                {
+                public:
+                    ConvolutionGeometry(const Shape& data_shape,
+                                        const Shape& filter_shape,
+                                        const Shape& out_shape,
+                                        const Strides& stride,
+                                        const Strides& filter_dilation,
+                                        const CoordinateDiff& pad_below,
+                                        const Strides& data_dilation)
+                        : m_data_shape(data_shape.begin() + 2, data_shape.end())
+                        , m_filter_shape(filter_shape.begin() + 2, filter_shape.end())
+                        , m_out_shape(out_shape.begin() + 2, out_shape.end())
+                        , m_stride(stride)
+                        , m_filter_dilation(filter_dilation)
+                        , m_pad_below(pad_below)
+                        , m_data_dilation(data_dilation)
+                    {
+                    }
+
+                    /// \brief The number of elements in one channel of the data
+                    size_t get_data_size() const { return shape_size(m_data_shape); }
+                    /// \brief The number of elements in one channel of a filter
+                    size_t get_window_size() const { return shape_size(m_filter_shape); }
+                    /// \brief The number of elements in one channel of the output
+                    size_t get_out_size() const { return shape_size(m_out_shape); }
+                    /// \brief Sets offsets[i] to the offset in a data channel of the element
+                    ///        that filter element window_index multiplies for output position
+                    ///        begin + i, or to -1 where it multiplies padding or a data dilation
+                    ///        hole.
+                    void get_source_offsets(size_t window_index,
+                                            size_t begin,
+                                            size_t end,
+                                            std::ptrdiff_t* offsets) const
+                    {
+                        size_t rank = m_out_shape.size();
+                        Coordinate window_coord(rank);
+                        Coordinate out_coord(rank);
+                        size_t out_index = begin;
+                        for (size_t axis = rank; axis-- > 0;)
+                        {
+                            window_coord[axis] = window_index % m_filter_shape[axis];
+                            window_index /= m_filter_shape[axis];
+                            out_coord[axis] = out_index % m_out_shape[axis];
+                            out_index /= m_out_shape[axis];
+                        }
+
+                        // The offset contributed by each position along each output axis
+                        std::vector<std::vector<std::ptrdiff_t>> axis_offsets(rank);
+                        std::ptrdiff_t data_stride = 1;
+                        for (size_t axis = rank; axis-- > 0;)
+                        {
+                            std::ptrdiff_t dilation = m_data_dilation[axis];
+                            std::ptrdiff_t data_extent = m_data_shape[axis];
+                            axis_offsets[axis].resize(m_out_shape[axis]);
+                            for (size_t i = 0; i < m_out_shape[axis]; i++)
+                            {
+                                std::ptrdiff_t position =
+                                    static_cast<std::ptrdiff_t>(
+                                        i * m_stride[axis] +
+                                        window_coord[axis] * m_filter_dilation[axis]) -
+                                    m_pad_below[axis];
+                                bool in_data = position >= 0 && position % dilation == 0 &&
+                                               position / dilation < data_extent;
+                                axis_offsets[axis][i] =
+                                    in_data ? position / dilation * data_stride : -1;
+                            }
+                            data_stride *= data_extent;
+                        }
+
+                        for (size_t i = 0; i < end - begin; i++)
+                        {
+                            std::ptrdiff_t offset = 0;
+                            for (size_t axis = 0; axis < rank && offset >= 0; axis++)
+                            {
+                                std::ptrdiff_t axis_offset = axis_offsets[axis][out_coord[axis]];
+                                offset = axis_offset < 0 ? -1 : offset + axis_offset;
+                            }
+                            offsets[i] = offset;
+                            for (size_t axis = rank; axis-- > 0;)
+                            {
+                                if (++out_coord[axis] < m_out_shape[axis])
+                                {
+                                    break;
+                                }
+                                out_coord[axis] = 0;
+                            }
+                        }
+                    }
+
+                private:
+                    Shape m_data_shape;
+                    Shape m_filter_shape;
+                    Shape m_out_shape;
+                    Strides m_stride;
+                    Strides m_filter_dilation;
+                    CoordinateDiff m_pad_below;
+                    Strides m_data_dilation;
+                };
+
+                /// \brief Copies the elements that the filters multiply for output positions
+                ///        [begin, end) of one data item into col. Row c * window size + w of col
+                ///        holds the elements that element w of channel c of a filter multiplies,
+                ///        so the output block is the filter matrix times col.
+                template <typename T>
+                void im2col(const T* data,
+                            size_t channel_count,
+                            const ConvolutionGeometry& geometry,
+                            size_t begin,
+                            size_t end,
+                            T* col)
+                {
+                    size_t width = end - begin;
+                    size_t window_size = geometry.get_window_size();
+                    size_t data_size = geometry.get_data_size();
+                    std::vector<std::ptrdiff_t> offsets(width);
+                    for (size_t w = 0; w < window_size; w++)
+                    {
+                        geometry.get_source_offsets(w, begin, end, offsets.data());
+                        for (size_t c = 0; c < channel_count; c++)
+                        {
+                            const T* channel = data + c * data_size;
+                            T* row = col + (c * window_size + w) * width;
+                            for (size_t i = 0; i < width; i++)
+                            {
+                                row[i] = offsets[i] < 0 ? T(0) : channel[offsets[i]];
+                            }
+                        }
+                    }
+                }
+
+                /// \brief The adjoint of im2col, adds each element of col to the data element
+                ///        that im2col copies there
+                template <typename T>
+                void col2im(const T* col,
+                            size_t channel_count,
+                            const ConvolutionGeometry& geometry,
+                            size_t begin,
+                            size_t end,
+                            T* data)
+                {
+                    size_t width = end - begin;
+                    size_t window_size = geometry.get_window_size();
+                    size_t data_size = geometry.get_data_size();
+                    std::vector<std::ptrdiff_t> offsets(width);
+                    for (size_t w = 0; w < window_size; w++)
+                    {
+                        geometry.get_source_offsets(w, begin, end, offsets.data());
+                        for (size_t c = 0; c < channel_count; c++)
+                        {
+                            T* channel = data + c * data_size;
+                            const T* row = col + (c * window_size + w) * width;
+                            for (size_t i = 0; i < width; i++)
+                            {
+                                if (offsets[i] >= 0)
+                                {
+                                    channel[offsets[i]] += row[i];
+                                }
+                            }
+                        }
+                    }
+                }
+
+                /// \brief The number of output positions to handle at a time so that an im2col
+                ///        block with rows rows stays in cache while it is multiplied
+                inline size_t get_column_block(size_t rows, size_t out_size)
+                {
+                    size_t block = (1 << 16) / std::max<size_t>(1, rows);
+                    return std::max<size_t>(1, std::min(out_size, std::max<size_t>(16, block)));
+                }
+
+                template <typename T>
+                void convolution(const T* data,
+                                 const T* filter,
+                                 T* out,
+                                 const Shape& data_shape,
+                                 const Shape& filter_shape,
+                                 const Shape& out_shape,
+                                 const Strides& stride,
+                                 const Strides& filter_dilation,
+                                 const CoordinateDiff& pad_below,
+                                 const Strides& data_dilation)
+                {
+                    ConvolutionGeometry geometry(data_shape,
+                                                 filter_shape,
+                                                 out_shape,
+                                                 stride,
+                                                 filter_dilation,
+                                                 pad_below,
+                                                 data_dilation);
+                    size_t in_channels = data_shape[1];
+                    size_t out_channels = out_shape[1];
+                    size_t data_size = geometry.get_data_size();
+                    size_t out_size = geometry.get_out_size();
+                    size_t rows = in_channels * geometry.get_window_size();
+                    size_t block = get_column_block(rows, out_size);
+                    size_t block_count = (out_size + block - 1) / block;
+
+                    ConstMatrixMap<T> filter_matrix(
+                        filter, out_channels, rows, Eigen::OuterStride<>(rows));
+                    // Each task computes all output channels for a block of positions of one
+                    // data item
+                    auto compute_blocks = [&](size_t first, size_t last) {
+                        std::vector<T> col(rows * block);
+                        for (size_t task = first; task < last; task++)
+                        {
+                            size_t n = task / block_count;
+                            size_t begin = task % block_count * block;
+                            size_t end = std::min(out_size, begin + block);
+                            im2col(data + n * in_channels * data_size,
+                                   in_channels,
+                                   geometry,
+                                   begin,
+                                   end,
+                                   col.data());
+                            ConstMatrixMap<T> col_matrix(
+                                col.data(), rows, end - begin, Eigen::OuterStride<>(end - begin));
+                            MatrixMap<T> out_matrix(out + n * out_channels * out_size + begin,
+                                                    out_channels,
+                                                    end - begin,
+                                                    Eigen::OuterStride<>(out_size));
+                            out_matrix.noalias() = filter_matrix * col_matrix;
+                        }
+                    };
+                    reference::parallel_for(
+                        data_shape[0] * block_count, out_channels * rows * block, compute_blocks);
+                }
+
+                template <typename T>
+                void convolution_backprop_data(const T* filter,
+                                               const T* delta,
+                                               T* data_delta,
+                                               const Shape& data_shape,
+                                               const Shape& filter_shape,
+                                               const Shape& delta_shape,
+                                               const Strides& stride,
+                                               const Strides& filter_dilation,
+                                               const CoordinateDiff& pad_below,
+                                               const Strides& data_dilation)
+                {
+                    ConvolutionGeometry geometry(data_shape,
+                                                 filter_shape,
+                                                 delta_shape,
+                                                 stride,
+                                                 filter_dilation,
+                                                 pad_below,
+                                                 data_dilation);
+                    size_t in_channels = data_shape[1];
+                    size_t out_channels = delta_shape[1];
+                    size_t data_size = geometry.get_data_size();
+                    size_t out_size = geometry.get_out_size();
+                    size_t window_size = geometry.get_window_size();
+                    size_t block =
+                        get_column_block(std::max(window_size, out_channels), out_size);
+
+                    std::fill(data_delta, data_delta + shape_size(data_shape), T(0));
+                    size_t filter_columns = in_channels * window_size;
+                    ConstMatrixMap<T> filter_matrix(
+                        filter, out_channels, filter_columns, Eigen::OuterStride<>(filter_columns));
+                    // Each task computes one channel of one data item, so tasks add to
+                    // disjoint outputs
+                    auto compute_channels = [&](size_t first, size_t last) {
+                        std::vector<T> col(window_size * block);
+                        for (size_t task = first; task < last; task++)
+                        {
+                            size_t n = task / in_channels;
+                            size_t c = task % in_channels;
+                            auto channel_filter =
+                                filter_matrix.middleCols(c * window_size, window_size);
+                            for (size_t begin = 0; begin < out_size; begin += block)
+                            {
+                                size_t end = std::min(out_size, begin + block);
+                                ConstMatrixMap<T> delta_matrix(delta + n * out_channels * out_size +
+                                                                   begin,
+                                                               out_channels,
+                                                               end - begin,
+                                                               Eigen::OuterStride<>(out_size));
+                                MatrixMap<T> col_matrix(col.data(),
+                                                        window_size,
+                                                        end - begin,
+                                                        Eigen::OuterStride<>(end - begin));
+                                col_matrix.noalias() = channel_filter.transpose() * delta_matrix;
+                                col2im(col.data(),
+                                       1,
+                                       geometry,
+                                       begin,
+                                       end,
+                                       data_delta + (n * in_channels + c) * data_size);
+                            }
+                        }
+                    };
+                    reference::parallel_for(data_shape[0] * in_channels,
+                                            out_channels * window_size * out_size,
+                                            compute_channels);
+                }
+
+                template <typename T>
+                void convolution_backprop_filter(const T* data,
+                                                 const T* delta,
+                                                 T* filter_delta,
+                                                 const Shape& data_shape,
+                                                 const Shape& filter_shape,
+                                                 const Shape& delta_shape,
+                                                 const Strides& stride,
+                                                 const Strides& filter_dilation,
+                                                 const CoordinateDiff& pad_below,
+                                                 const Strides& data_dilation)
+                {
+                    ConvolutionGeometry geometry(data_shape,
+                                                 filter_shape,
+                                                 delta_shape,
+                                                 stride,
+                                                 filter_dilation,
+                                                 pad_below,
+                                                 data_dilation);
+                    size_t batch_size = data_shape[0];
+                    size_t in_channels = data_shape[1];
+                    size_t out_channels = delta_shape[1];
+                    size_t data_size = geometry.get_data_size();
+                    size_t out_size = geometry.get_out_size();
+                    size_t window_size = geometry.get_window_size();
+                    size_t block = get_column_block(window_size, out_size);
+
+                    // Each task computes the filter elements of one input channel. It only
+                    // needs the im2col rows of that channel, so no rows are built twice.
+                    auto compute_channels = [&](size_t first, size_t last) {
+                        std::vector<T> col(window_size * block);
+                        for (size_t c = first; c < last; c++)
+                        {
+                            MatrixMap<T> channel_delta(filter_delta + c * window_size,
+                                                       out_channels,
+                                                       window_size,
+                                                       Eigen::OuterStride<>(in_channels *
+                                                                            window_size));
+                            channel_delta.setZero();
+                            for (size_t n = 0; n < batch_size; n++)
+                            {
+                                for (size_t begin = 0; begin < out_size; begin += block)
+                                {
+                                    size_t end = std::min(out_size, begin + block);
+                                    im2col(data + (n * in_channels + c) * data_size,
+                                           1,
+                                           geometry,
+                                           begin,
+                                           end,
+                                           col.data());
+                                    ConstMatrixMap<T> delta_matrix(
+                                        delta + n * out_channels * out_size + begin,
+                                        out_channels,
+                                        end - begin,
+                                        Eigen::OuterStride<>(out_size));
+                                    ConstMatrixMap<T> col_matrix(col.data(),
+                                                                 window_size,
+                                                                 end - begin,
+                                                                 Eigen::OuterStride<>(end - begin));
+                                    channel_delta.noalias() +=
+                                        delta_matrix * col_matrix.transpose();
+                                }
+                            }
+                        }
+                    };
+                    reference::parallel_for(in_channels,
+                                            batch_size * out_channels * window_size * out_size,
+                                            compute_channels);
+                }
+            }
+        }
+    }
+}
@@ -775,6 +775,7 @@ shared_ptr<runtime::Executable>
             arguments_check(op, 0, 1);
 
             const shared_ptr<op::Constant> constant_inst = static_pointer_cast<op::Constant>(op);
+            // cldnn only reads attached data, which may be shared with other constants
             void* memory_pointer = const_cast<void*>(constant_inst->get_data_ptr());
 
             const cldnn::layout layout = IntelGPULayout::create_cldnn_layout(
@@ -16,6 +16,8 @@
 
 #include "ngraph/runtime/interpreter/int_backend_visibility.hpp"
 
+#include <cstdlib>
+
 #include "ngraph/component_manager.hpp"
 #include "ngraph/cpio.hpp"
 #include "ngraph/except.hpp"
@@ -29,6 +31,17 @@
 using namespace std;
 using namespace ngraph;
 
+static shared_ptr<runtime::ThreadPool> make_thread_pool(size_t thread_count)
+{
+    return thread_count > 1 ? make_shared<runtime::ThreadPool>(thread_count) : nullptr;
+}
+
+static size_t get_default_thread_count()
+{
+    const char* env_threads = getenv("NGRAPH_INTERPRETER_THREADS");
+    return env_threads == nullptr ? 1 : strtoul(env_threads, nullptr, 10);
+}
+
 extern "C" INTERPRETER_BACKEND_API void ngraph_register_interpreter_backend()
 {
     runtime::BackendManager::register_backend("INTERPRETER", [](const std::string& /* config */) {
@@ -37,11 +50,13 @@ extern "C" INTERPRETER_BACKEND_API void ngraph_register_interpreter_backend()
 }
 
 runtime::interpreter::INTBackend::INTBackend()
+    : m_thread_pool{make_thread_pool(get_default_thread_count())}
 {
 }
 
 runtime::interpreter::INTBackend::INTBackend(const vector<string>& unsupported_op_name_list)
     : m_unsupported_op_name_list{unsupported_op_name_list.begin(), unsupported_op_name_list.end()}
+    , m_thread_pool{make_thread_pool(get_default_thread_count())}
 {
 }
 
@@ -61,7 +76,9 @@ shared_ptr<runtime::Executable>
     runtime::interpreter::INTBackend::compile(shared_ptr<Function> function,
                                               bool enable_performance_collection)
 {
-    return make_shared<INTExecutable>(function, enable_performance_collection);
+    auto exec = make_shared<INTExecutable>(function, enable_performance_collection);
+    exec->m_thread_pool = m_thread_pool;
+    return exec;
 }
 
 bool runtime::interpreter::INTBackend::is_supported(const Node& node) const
@@ -92,7 +109,9 @@ std::shared_ptr<runtime::Executable> runtime::interpreter::INTBackend::load(istr
             {
                 vector<char> buffer = reader.read(info);
                 string model_string = string(buffer.data(), buffer.size());
-                exec = shared_ptr<INTExecutable>(new INTExecutable(model_string));
+                auto int_exec = shared_ptr<INTExecutable>(new INTExecutable(model_string));
+                int_exec->m_thread_pool = m_thread_pool;
+                exec = int_exec;
                 break;
             }
         }
@@ -110,5 +129,18 @@ bool runtime::interpreter::INTBackend::set_config(const map<string, string>& con
         error = it->second;
         rc = true;
     }
+    it = config.find("num_threads");
+    if (it != config.end())
+    {
+        char* end = nullptr;
+        size_t thread_count = strtoul(it->second.c_str(), &end, 10);
+        if (it->second.empty() || *end != '\0' || thread_count == 0)
+        {
+            error = "num_threads must be a positive integer, got '" + it->second + "'";
+            return false;
+        }
+        m_thread_pool = make_thread_pool(thread_count);
+        rc = true;
+    }
     return rc;
 }
@@ -26,6 +26,7 @@
 
 #include "ngraph/runtime/backend_manager.hpp"
 #include "ngraph/runtime/tensor.hpp"
+#include "ngraph/runtime/thread_pool.hpp"
 
 namespace ngraph
 {
@@ -60,8 +61,12 @@ public:
 
     bool is_supported(const Node& node) const override;
 
+    /// \brief Besides "test_echo", accepts "num_threads", the number of threads that run the
+    ///        kernels of executables compiled afterwards. The default is 1, or the value of the
+    ///        NGRAPH_INTERPRETER_THREADS environment variable.
     bool set_config(const std::map<std::string, std::string>& config, std::string& error) override;
 
 private:
     std::set<std::string> m_unsupported_op_name_list;
+    std::shared_ptr<ThreadPool> m_thread_pool;
 };
@@ -51,10 +51,7 @@ runtime::interpreter::INTExecutable::INTExecutable(const shared_ptr<Function>& f
     pass_manager.register_pass<pass::Liveness>();
     pass_manager.run_passes(m_function);
 
-    for (const shared_ptr<Node>& node : m_function->get_ordered_ops())
-    {
-        m_wrapped_nodes.emplace_back(node);
-    }
+    build_plan();
     set_parameters_and_results(*m_function);
 }
 
@@ -63,105 +60,150 @@ runtime::interpreter::INTExecutable::INTExecutable(const std::string& model_stri
     , m_performance_counters_enabled{false}
 {
     m_function = deserialize(model_string);
-    for (const shared_ptr<Node>& node : m_function->get_ordered_ops())
-    {
-        m_wrapped_nodes.emplace_back(node);
-    }
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::Liveness>();
+    pass_manager.run_passes(m_function);
+
+    build_plan();
     set_parameters_and_results(*m_function);
 }
 
-bool runtime::interpreter::INTExecutable::call(const vector<shared_ptr<runtime::Tensor>>& outputs,
-                                               const vector<shared_ptr<runtime::Tensor>>& inputs)
+runtime::interpreter::INTExecutable::~INTExecutable()
 {
-    runtime::event::Duration d1("call", "Interpreter");
-
-    // convert inputs to HostTensor
-    vector<shared_ptr<HostTensor>> func_inputs;
-    for (auto tensor : inputs)
     {
-        auto host_tensor = static_pointer_cast<runtime::HostTensor>(tensor);
-        func_inputs.push_back(host_tensor);
+        lock_guard<mutex> lock(m_call_mutex);
+        m_call_thread_stop = true;
     }
-    if (m_nan_check_enabled)
+    m_call_condition.notify_all();
+    if (m_call_thread.joinable())
     {
-        perform_nan_check(func_inputs);
+        // Queued calls are drained before the thread exits
+        m_call_thread.join();
     }
+}
 
-    // convert outputs to HostTensor
-    vector<shared_ptr<HostTensor>> func_outputs;
-    for (auto tensor : outputs)
+future<bool>
+    runtime::interpreter::INTExecutable::begin_call(const vector<shared_ptr<Tensor>>& outputs,
+                                                    const vector<shared_ptr<Tensor>>& inputs,
+                                                    CallCallback callback)
+{
+    auto task = make_shared<packaged_task<bool()>>(make_call_task(
+        [this, outputs, inputs]() { return call(outputs, inputs); }, callback));
+    future<bool> result = task->get_future();
     {
-        auto host_tensor = static_pointer_cast<runtime::HostTensor>(tensor);
-        func_outputs.push_back(host_tensor);
+        lock_guard<mutex> lock(m_call_mutex);
+        if (!m_call_thread.joinable())
+        {
+            m_call_thread = thread(&INTExecutable::run_call_thread, this);
+        }
+        m_call_queue.push_back([task]() { (*task)(); });
     }
+    m_call_condition.notify_one();
+    return result;
+}
 
-    // map function params -> HostTensor
-    unordered_map<descriptor::Tensor*, shared_ptr<HostTensor>> tensor_map;
-    size_t input_count = 0;
-    for (auto param : get_parameters())
+void runtime::interpreter::INTExecutable::run_call_thread()
+{
+    while (true)
     {
-        for (size_t i = 0; i < param->get_output_size(); ++i)
+        function<void()> task;
         {
-            descriptor::Tensor* tensor = &param->output(i).get_tensor();
-            tensor_map.insert({tensor, func_inputs[input_count++]});
+            unique_lock<mutex> lock(m_call_mutex);
+            m_call_condition.wait(lock,
+                                  [this]() { return m_call_thread_stop || !m_call_queue.empty(); });
+            if (m_call_queue.empty())
+            {
+                return;
+            }
+            task = move(m_call_queue.front());
+            m_call_queue.pop_front();
         }
+        task();
     }
+}
 
-    // map function outputs -> HostTensor
-    for (size_t output_count = 0; output_count < get_results().size(); ++output_count)
+void runtime::interpreter::INTExecutable::build_plan()
+{
+    if (m_function->is_dynamic())
     {
-        auto output = get_results()[output_count];
-        if (!is_type<op::Result>(output))
+        // Nothing can be laid out; call() reports the error
+        return;
+    }
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::MemoryLayout>(get_alignment());
+    pass_manager.run_passes(m_function);
+    m_arena_size = m_function->get_temporary_pool_size();
+
+    unordered_map<descriptor::Tensor*, size_t> slot_map;
+    auto add_tensor = [&](const Output<Node>& output) {
+        descriptor::Tensor* tensor = &output.get_tensor();
+        PlanTensor plan_tensor;
+        plan_tensor.type = output.get_element_type();
+        plan_tensor.shape = output.get_shape();
+        plan_tensor.name = tensor->get_name();
+        plan_tensor.offset = tensor->get_pool_offset();
+        m_plan_tensors.push_back(plan_tensor);
+        slot_map.insert({tensor, m_plan_tensors.size() - 1});
+        return &m_plan_tensors.back();
+    };
+
+    size_t external_index = 0;
+    for (auto param : m_function->get_parameters())
+    {
+        for (size_t i = 0; i < param->get_output_size(); ++i)
         {
-            throw ngraph_error("One of function's outputs isn't op::Result");
+            PlanTensor* plan_tensor = add_tensor(param->output(i));
+            plan_tensor->is_external = true;
+            plan_tensor->external_index = external_index++;
         }
-        descriptor::Tensor* tensor = &output->output(0).get_tensor();
-        tensor_map.insert({tensor, func_outputs[output_count]});
+    }
+    for (auto result : m_function->get_results())
+    {
+        PlanTensor* plan_tensor = add_tensor(result->output(0));
+        plan_tensor->is_external = true;
+        plan_tensor->external_index = external_index++;
     }
 
-    // for each ordered op in the graph
-    for (const NodeWrapper& wrapped : m_wrapped_nodes)
+    for (const shared_ptr<Node>& node : m_function->get_ordered_ops())
     {
-        auto op = wrapped.get_node();
-        runtime::event::Duration d2(op->description(), "Interpreter");
-        auto type_id = wrapped.get_typeid();
+        NodeWrapper wrapped(node);
+        OP_TYPEID type_id = wrapped.get_typeid();
         if (type_id == OP_TYPEID::Parameter)
         {
             continue;
         }
-
-        // get op inputs from map
-        vector<shared_ptr<HostTensor>> op_inputs;
-        for (auto input : op->inputs())
+        if (auto constant = as_type_ptr<op::Constant>(node))
         {
-            descriptor::Tensor* tensor = &input.get_tensor();
-            op_inputs.push_back(tensor_map.at(tensor));
+            // Constants are not executed, kernels read the Constant's data directly
+            PlanTensor* plan_tensor = add_tensor(constant->output(0));
+            // Wraps the constant data, which other Constants may share, without copying it.
+            // The kernels only read their inputs, so it is never written.
+            plan_tensor->constant = make_shared<runtime::HostTensor>(
+                plan_tensor->type,
+                plan_tensor->shape,
+                const_cast<void*>(constant->get_data_ptr()),
+                plan_tensor->name);
+            plan_tensor->constant_node = node.get();
+            continue;
         }
 
-        // get op outputs from map or create
-        vector<shared_ptr<HostTensor>> op_outputs;
-        for (size_t i = 0; i < op->get_output_size(); ++i)
+        PlanStep step(wrapped);
+        step.description = node->description();
+        for (auto input : node->inputs())
         {
-            descriptor::Tensor* tensor = &op->output(i).get_tensor();
-            shared_ptr<HostTensor> host_tensor;
-            auto it = tensor_map.find(tensor);
-            if (it == tensor_map.end())
-            {
-                const Shape& shape = op->get_output_shape(i);
-                const element::Type& type = op->get_output_element_type(i);
-                string name = op->output(i).get_tensor().get_name();
-                host_tensor = make_shared<runtime::HostTensor>(type, shape, name);
-                tensor_map.insert({tensor, host_tensor});
-            }
-            else
+            step.input_slots.push_back(slot_map.at(&input.get_tensor()));
+        }
+        for (size_t i = 0; i < node->get_output_size(); ++i)
+        {
+            descriptor::Tensor* tensor = &node->output(i).get_tensor();
+            if (slot_map.find(tensor) == slot_map.end())
             {
-                host_tensor = it->second;
+                add_tensor(node->output(i));
             }
-            op_outputs.push_back(host_tensor);
+            step.output_slots.push_back(slot_map.at(tensor));
         }
 
         // get op type
-        element::Type type;
 #if defined(__GNUC__) && !(__GNUC__ == 4 && __GNUC_MINOR__ == 8)
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wswitch-enum"
@@ -172,7 +214,7 @@ bool runtime::interpreter::INTExecutable::call(const vector<shared_ptr<runtime::
         case OP_TYPEID::Quantize:
         case OP_TYPEID::Dequantize:
         case OP_TYPEID::ArgMin:
-        case OP_TYPEID::ArgMax: type = op->get_input_element_type(0); break;
+        case OP_TYPEID::ArgMax: step.type = node->get_input_element_type(0); break;
         case OP_TYPEID::Equal:
         case OP_TYPEID::Greater:
         case OP_TYPEID::GreaterEq:
@@ -182,58 +224,231 @@ bool runtime::interpreter::INTExecutable::call(const vector<shared_ptr<runtime::
             // Get the type of the second input, not the first
             // All BinaryElementwiseComparision ops have the same type for inputs
             // Select has bool for first input and the type we are interested in for the second
-            type = op->get_input_element_type(1);
+            step.type = node->get_input_element_type(1);
             break;
-        case OP_TYPEID::TopK: type = op->get_output_element_type(1); break;
-        default: type = op->get_output_element_type(0); break;
+        case OP_TYPEID::TopK: step.type = node->get_output_element_type(1); break;
+        default: step.type = node->get_output_element_type(0); break;
         }
 #if defined(__GNUC__) && !(__GNUC__ == 4 && __GNUC_MINOR__ == 8)
 #pragma GCC diagnostic pop
 #endif
+        step.kernel = get_kernel(step.type);
+        m_plan.push_back(step);
+    }
 
-        if (m_performance_counters_enabled)
-        {
-            m_timer_map[op].start();
-        }
-        generate_calls(type, wrapped, op_outputs, op_inputs);
-        if (m_performance_counters_enabled)
+    for (size_t i = 0; i < m_plan.size(); ++i)
+    {
+        const PlanStep& step = m_plan[i];
+        for (size_t j = 0; j < step.input_slots.size(); ++j)
         {
-            m_timer_map[op].stop();
+            const PlanTensor& plan_tensor = m_plan_tensors[step.input_slots[j]];
+            if (plan_tensor.is_external)
+            {
+                m_external_uses.push_back({i, j, false, plan_tensor.external_index});
+            }
         }
-        if (m_nan_check_enabled)
+        for (size_t j = 0; j < step.output_slots.size(); ++j)
         {
-            perform_nan_check(op_outputs, op.get());
+            const PlanTensor& plan_tensor = m_plan_tensors[step.output_slots[j]];
+            if (plan_tensor.is_external)
+            {
+                m_external_uses.push_back({i, j, true, plan_tensor.external_index});
+            }
         }
     }
-
-    return true;
 }
 
-void runtime::interpreter::INTExecutable::generate_calls(const element::Type& type,
-                                                         const NodeWrapper& op,
-                                                         const vector<shared_ptr<HostTensor>>& out,
-                                                         const vector<shared_ptr<HostTensor>>& in)
+runtime::interpreter::INTExecutable::kernel_t
+    runtime::interpreter::INTExecutable::get_kernel(const element::Type& type)
 {
-    stringstream ss;
+    kernel_t kernel = nullptr;
     switch (type)
     {
-    case element::Type_t::boolean: op_engine<char>(op, out, in); break;
-    case element::Type_t::f32: op_engine<float>(op, out, in); break;
-    case element::Type_t::f64: op_engine<double>(op, out, in); break;
-    case element::Type_t::i8: op_engine<int8_t>(op, out, in); break;
-    case element::Type_t::i16: op_engine<int16_t>(op, out, in); break;
-    case element::Type_t::i32: op_engine<int32_t>(op, out, in); break;
-    case element::Type_t::i64: op_engine<int64_t>(op, out, in); break;
-    case element::Type_t::u8: op_engine<uint8_t>(op, out, in); break;
-    case element::Type_t::u16: op_engine<uint16_t>(op, out, in); break;
-    case element::Type_t::u32: op_engine<uint32_t>(op, out, in); break;
-    case element::Type_t::u64: op_engine<uint64_t>(op, out, in); break;
+    case element::Type_t::boolean: kernel = &INTExecutable::op_engine<char>; break;
+    case element::Type_t::f32: kernel = &INTExecutable::op_engine<float>; break;
+    case element::Type_t::f64: kernel = &INTExecutable::op_engine<double>; break;
+    case element::Type_t::i8: kernel = &INTExecutable::op_engine<int8_t>; break;
+    case element::Type_t::i16: kernel = &INTExecutable::op_engine<int16_t>; break;
+    case element::Type_t::i32: kernel = &INTExecutable::op_engine<int32_t>; break;
+    case element::Type_t::i64: kernel = &INTExecutable::op_engine<int64_t>; break;
+    case element::Type_t::u8: kernel = &INTExecutable::op_engine<uint8_t>; break;
+    case element::Type_t::u16: kernel = &INTExecutable::op_engine<uint16_t>; break;
+    case element::Type_t::u32: kernel = &INTExecutable::op_engine<uint32_t>; break;
+    case element::Type_t::u64: kernel = &INTExecutable::op_engine<uint64_t>; break;
     case element::Type_t::undefined:
     case element::Type_t::dynamic:
     case element::Type_t::bf16:
-    case element::Type_t::f16:
-        ss << "unsupported element type " << type << " op " << op.get_node()->get_name();
-        throw ngraph_error(ss.str());
+    case element::Type_t::f16: break;
+    }
+    return kernel;
+}
+
+unique_ptr<runtime::interpreter::INTExecutable::CallFrame>
+    runtime::interpreter::INTExecutable::acquire_frame()
+{
+    {
+        lock_guard<mutex> lock(m_frame_mutex);
+        if (!m_free_frames.empty())
+        {
+            unique_ptr<CallFrame> frame = move(m_free_frames.back());
+            m_free_frames.pop_back();
+            return frame;
+        }
+    }
+
+    unique_ptr<CallFrame> frame(new CallFrame());
+    frame->arena.reset(new AlignedBuffer(m_arena_size, get_alignment()));
+    vector<shared_ptr<HostTensor>> tensors;
+    for (const PlanTensor& plan_tensor : m_plan_tensors)
+    {
+        shared_ptr<HostTensor> tensor;
+        if (plan_tensor.constant)
+        {
+            tensor = plan_tensor.constant;
+        }
+        else if (!plan_tensor.is_external)
+        {
+            tensor = make_shared<runtime::HostTensor>(plan_tensor.type,
+                                                      plan_tensor.shape,
+                                                      frame->arena->get_ptr(plan_tensor.offset),
+                                                      plan_tensor.name);
+        }
+        tensors.push_back(tensor);
+    }
+    for (const PlanStep& step : m_plan)
+    {
+        frame->inputs.emplace_back();
+        for (size_t slot : step.input_slots)
+        {
+            frame->inputs.back().push_back(tensors[slot]);
+        }
+        frame->outputs.emplace_back();
+        for (size_t slot : step.output_slots)
+        {
+            frame->outputs.back().push_back(tensors[slot]);
+        }
+    }
+    return frame;
+}
+
+void runtime::interpreter::INTExecutable::release_frame(unique_ptr<CallFrame> frame)
+{
+    // Drop the references to the caller's tensors
+    for (const ExternalUse& use : m_external_uses)
+    {
+        auto& tensors = use.is_output ? frame->outputs[use.step] : frame->inputs[use.step];
+        tensors[use.position] = nullptr;
+    }
+    lock_guard<mutex> lock(m_frame_mutex);
+    m_free_frames.push_back(move(frame));
+}
+
+bool runtime::interpreter::INTExecutable::call(const vector<shared_ptr<runtime::Tensor>>& outputs,
+                                               const vector<shared_ptr<runtime::Tensor>>& inputs)
+{
+    runtime::event::Duration d1("call", "Interpreter");
+
+    if (m_function->is_dynamic())
+    {
+        throw ngraph_error("INTERPRETER cannot execute a function with dynamic shapes");
+    }
+
+    // convert inputs to HostTensor
+    vector<shared_ptr<HostTensor>> func_inputs;
+    for (auto tensor : inputs)
+    {
+        auto host_tensor = static_pointer_cast<runtime::HostTensor>(tensor);
+        func_inputs.push_back(host_tensor);
+    }
+    if (m_nan_check_enabled)
+    {
+        perform_nan_check(func_inputs);
+        for (const PlanTensor& plan_tensor : m_plan_tensors)
+        {
+            if (plan_tensor.constant)
+            {
+                perform_nan_check({plan_tensor.constant}, plan_tensor.constant_node);
+            }
+        }
+    }
+
+    // convert outputs to HostTensor
+    vector<shared_ptr<HostTensor>> func_outputs;
+    for (auto tensor : outputs)
+    {
+        auto host_tensor = static_pointer_cast<runtime::HostTensor>(tensor);
+        func_outputs.push_back(host_tensor);
+    }
+
+    unique_ptr<CallFrame> frame = acquire_frame();
+    try
+    {
+        run_plan(*frame, func_inputs, func_outputs);
+    }
+    catch (...)
+    {
+        release_frame(move(frame));
+        throw;
+    }
+    release_frame(move(frame));
+
+    return true;
+}
+
+void runtime::interpreter::INTExecutable::run_plan(
+    CallFrame& frame,
+    const vector<shared_ptr<HostTensor>>& func_inputs,
+    const vector<shared_ptr<HostTensor>>& func_outputs)
+{
+    for (const ExternalUse& use : m_external_uses)
+    {
+        auto& tensors = use.is_output ? frame.outputs[use.step] : frame.inputs[use.step];
+        tensors[use.position] = use.external_index < func_inputs.size()
+                                    ? func_inputs[use.external_index]
+                                    : func_outputs.at(use.external_index - func_inputs.size());
+    }
+
+    ThreadPool::Scope thread_pool_scope(m_thread_pool.get());
+    // Op times of this call, merged into m_timer_map once the call completes
+    vector<chrono::nanoseconds> op_times(m_performance_counters_enabled ? m_plan.size() : 0);
+    for (size_t i = 0; i < m_plan.size(); ++i)
+    {
+        const PlanStep& step = m_plan[i];
+        const shared_ptr<const Node>& op = step.wrapped.get_node();
+        runtime::event::Duration d2(step.description, "Interpreter");
+        if (!step.kernel)
+        {
+            stringstream ss;
+            ss << "unsupported element type " << step.type << " op " << op->get_name();
+            throw ngraph_error(ss.str());
+        }
+
+        stopwatch timer;
+        if (m_performance_counters_enabled)
+        {
+            timer.start();
+        }
+        (this->*step.kernel)(step.wrapped, frame.outputs[i], frame.inputs[i]);
+        if (m_performance_counters_enabled)
+        {
+            timer.stop();
+            op_times[i] = timer.get_timer_value();
+        }
+        if (m_nan_check_enabled)
+        {
+            perform_nan_check(frame.outputs[i], op.get());
+        }
+    }
+
+    if (m_performance_counters_enabled)
+    {
+        lock_guard<mutex> lock(m_timer_mutex);
+        for (size_t i = 0; i < m_plan.size(); ++i)
+        {
+            OpTime& op_time = m_timer_map[m_plan[i].wrapped.get_node()];
+            op_time.total += op_times[i];
+            op_time.call_count++;
+        }
     }
 }
 
@@ -246,9 +461,12 @@ vector<runtime::PerformanceCounter>
     runtime::interpreter::INTExecutable::get_performance_data() const
 {
     vector<runtime::PerformanceCounter> rc;
-    for (const pair<shared_ptr<const Node>, stopwatch> p : m_timer_map)
+    lock_guard<mutex> lock(m_timer_mutex);
+    for (const auto& p : m_timer_map)
     {
-        rc.emplace_back(p.first, p.second.get_total_microseconds(), p.second.get_call_count());
+        rc.emplace_back(p.first,
+                        chrono::duration_cast<chrono::microseconds>(p.second.total).count(),
+                        p.second.call_count);
     }
     return rc;
 }
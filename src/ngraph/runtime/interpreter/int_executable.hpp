@@ -16,11 +16,17 @@
 
 #pragma once
 
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <initializer_list>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "ngraph/op/add.hpp"
@@ -174,6 +180,7 @@
 #include "ngraph/runtime/reference/topk.hpp"
 #include "ngraph/runtime/reference/xor.hpp"
 #include "ngraph/runtime/tensor.hpp"
+#include "ngraph/runtime/thread_pool.hpp"
 #include "ngraph/state/bernoulli_rng_state.hpp"
 #include "ngraph/state/uniform_rng_state.hpp"
 
@@ -196,10 +203,17 @@ class ngraph::runtime::interpreter::INTExecutable : public Executable
 public:
     INTExecutable(const std::shared_ptr<Function>& function,
                   bool enable_performance_collection = false);
+    ~INTExecutable() override;
 
     bool call(const std::vector<std::shared_ptr<Tensor>>& outputs,
               const std::vector<std::shared_ptr<Tensor>>& inputs) override;
 
+    /// \brief Queue a call on the executable's call thread. Calls started with begin_call
+    /// complete in the order they were started.
+    std::future<bool> begin_call(const std::vector<std::shared_ptr<Tensor>>& outputs,
+                                 const std::vector<std::shared_ptr<Tensor>>& inputs,
+                                 CallCallback callback = nullptr) override;
+
     virtual void save(std::ostream& output_stream) override;
 
     void set_nan_check(bool enable);
@@ -219,6 +233,58 @@ public:
 private:
     INTExecutable(const std::string& model_string);
 
+    using kernel_t = void (INTExecutable::*)(const NodeWrapper&,
+                                             const std::vector<std::shared_ptr<HostTensor>>&,
+                                             const std::vector<std::shared_ptr<HostTensor>>&);
+
+    /// \brief A tensor of the execution plan. Function inputs and outputs are bound on each
+    /// call, constants use the Constant's data and all other tensors live in the call arena
+    /// at the offset assigned by pass::MemoryLayout.
+    struct PlanTensor
+    {
+        element::Type type;
+        Shape shape;
+        std::string name;
+        size_t offset = 0;
+        bool is_external = false;
+        size_t external_index = 0;
+        std::shared_ptr<HostTensor> constant;
+        const Node* constant_node = nullptr;
+    };
+
+    /// \brief One op of the execution plan with its kernel resolved for its element type
+    struct PlanStep
+    {
+        PlanStep(const NodeWrapper& node_wrapper)
+            : wrapped(node_wrapper)
+        {
+        }
+        NodeWrapper wrapped;
+        std::string description;
+        element::Type type;
+        kernel_t kernel = nullptr;
+        std::vector<size_t> input_slots;
+        std::vector<size_t> output_slots;
+    };
+
+    /// \brief A use of a function input or output by a plan step
+    struct ExternalUse
+    {
+        size_t step;
+        size_t position;
+        bool is_output;
+        size_t external_index;
+    };
+
+    /// \brief The tensors used by one call. Frames are reused so a call does not allocate;
+    /// concurrent calls each take their own frame.
+    struct CallFrame
+    {
+        std::unique_ptr<AlignedBuffer> arena;
+        std::vector<std::vector<std::shared_ptr<HostTensor>>> inputs;
+        std::vector<std::vector<std::shared_ptr<HostTensor>>> outputs;
+    };
+
     std::shared_ptr<ngraph::op::Parameter> get_parameter(size_t index) const;
     std::shared_ptr<ngraph::op::Result> get_result(size_t index) const;
     int get_alignment() const { return 64; }
@@ -226,18 +292,44 @@ private:
     bool m_nan_check_enabled = false;
     bool m_performance_counters_enabled = false;
     std::shared_ptr<Function> m_function;
-    std::unordered_map<std::shared_ptr<const Node>, stopwatch> m_timer_map;
-    std::vector<NodeWrapper> m_wrapped_nodes;
+    struct OpTime
+    {
+        std::chrono::nanoseconds total{0};
+        size_t call_count = 0;
+    };
+    // Accumulated across calls, which may run concurrently, under m_timer_mutex
+    mutable std::mutex m_timer_mutex;
+    std::unordered_map<std::shared_ptr<const Node>, OpTime> m_timer_map;
+    // RNG states advance on every call; m_state_mutex serializes the ops that use them
+    std::mutex m_state_mutex;
     std::unordered_map<const Node*, std::shared_ptr<State>> m_states;
     std::set<std::string> m_unsupported_op_name_list;
+    std::shared_ptr<ThreadPool> m_thread_pool;
+
+    std::vector<PlanTensor> m_plan_tensors;
+    std::vector<PlanStep> m_plan;
+    std::vector<ExternalUse> m_external_uses;
+    size_t m_arena_size = 0;
+    std::mutex m_frame_mutex;
+    std::vector<std::unique_ptr<CallFrame>> m_free_frames;
+
+    std::thread m_call_thread;
+    std::mutex m_call_mutex;
+    std::condition_variable m_call_condition;
+    std::deque<std::function<void()>> m_call_queue;
+    bool m_call_thread_stop = false;
 
     static void perform_nan_check(const std::vector<std::shared_ptr<HostTensor>>&,
                                   const Node* op = nullptr);
 
-    void generate_calls(const element::Type& type,
-                        const NodeWrapper& op,
-                        const std::vector<std::shared_ptr<HostTensor>>& outputs,
-                        const std::vector<std::shared_ptr<HostTensor>>& inputs);
+    void build_plan();
+    void run_call_thread();
+    std::unique_ptr<CallFrame> acquire_frame();
+    void release_frame(std::unique_ptr<CallFrame> frame);
+    void run_plan(CallFrame& frame,
+                  const std::vector<std::shared_ptr<HostTensor>>& func_inputs,
+                  const std::vector<std::shared_ptr<HostTensor>>& func_outputs);
+    static kernel_t get_kernel(const element::Type& type);
 
     template <typename T>
     void op_engine(const NodeWrapper& node_wrapper,
@@ -418,6 +510,7 @@ private:
         case OP_TYPEID::GenerateMask:
         {
             bool use_seed = static_cast<bool>(args[2]->get_data_ptr<const int32_t>()[0]);
+            std::lock_guard<std::mutex> lock(m_state_mutex);
             if (m_states.count(&node) == 0)
             {
                 const op::GenerateMask* gm = static_cast<const op::GenerateMask*>(&node);
@@ -1462,6 +1555,7 @@ private:
             // static output shapes anyway.
             bool use_fixed_seed = static_cast<bool>(args[3]->get_data_ptr<const char>()[0]);
 
+            std::lock_guard<std::mutex> lock(m_state_mutex);
             if (m_states.count(&node) == 0)
             {
                 m_states[&node] = std::unique_ptr<UniformRNGState>(new UniformRNGState());
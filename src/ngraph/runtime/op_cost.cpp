@@ -0,0 +1,245 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <string>
+#include <unordered_map>
+
+#include "ngraph/op/avg_pool.hpp"
+#include "ngraph/op/dot.hpp"
+#include "ngraph/op/max_pool.hpp"
+#include "ngraph/op/quantized_dot.hpp"
+#include "ngraph/op/util/arithmetic_reduction.hpp"
+#include "ngraph/op/util/index_reduction.hpp"
+#include "ngraph/op/util/logical_reduction.hpp"
+#include "ngraph/runtime/op_cost.hpp"
+#include "ngraph/shape_util.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+namespace
+{
+    // Ops whose cost follows from their shapes alone, by type name so that the fused ops of the
+    // backends are covered without core depending on them
+    enum class CostKind
+    {
+        // Filters are input 1 and the forward output is output 0
+        Convolution,
+        // Filters are input 0 and the forward output is the delta, input 1
+        ConvolutionBackpropData,
+        // Filters are output 0 and the forward output is the delta, input 1
+        ConvolutionBackpropFilters,
+        // A product of matrices, possibly batched, with the rows of input 0 in the output
+        MatMul,
+        // Normalizes output 0 with known statistics
+        BatchNormInference,
+        // Computes the statistics of output 0 and normalizes it
+        BatchNormTraining,
+        Softmax,
+        // Fused elementwise ops that do not derive from the elementwise base classes
+        Elementwise
+    };
+
+    const unordered_map<string, CostKind>& get_cost_kinds()
+    {
+        static const unordered_map<string, CostKind> cost_kinds{
+            {"Convolution", CostKind::Convolution},
+            {"ConvolutionAdd", CostKind::Convolution},
+            {"ConvolutionBias", CostKind::Convolution},
+            {"ConvolutionBiasAdd", CostKind::Convolution},
+            {"ConvolutionRelu", CostKind::Convolution},
+            {"GroupConvolution", CostKind::Convolution},
+            {"GroupConvolutionBias", CostKind::Convolution},
+            {"QuantizedConvolution", CostKind::Convolution},
+            {"QuantizedConvolutionBias", CostKind::Convolution},
+            {"QuantizedConvolutionBiasAdd", CostKind::Convolution},
+            {"QuantizedConvolutionBiasSignedAdd", CostKind::Convolution},
+            {"QuantizedConvolutionRelu", CostKind::Convolution},
+            {"ConvolutionBackpropData", CostKind::ConvolutionBackpropData},
+            {"DeconvolutionBias", CostKind::ConvolutionBackpropData},
+            {"ConvolutionBackpropFilters", CostKind::ConvolutionBackpropFilters},
+            {"ConvolutionBiasBackpropFiltersBias", CostKind::ConvolutionBackpropFilters},
+            {"BatchMatMul", CostKind::MatMul},
+            {"BatchMatMulTranspose", CostKind::MatMul},
+            {"Gemm", CostKind::MatMul},
+            {"MatMul", CostKind::MatMul},
+            {"MatmulBias", CostKind::MatMul},
+            {"QuantizedMatmul", CostKind::MatMul},
+            {"BatchNormInference", CostKind::BatchNormInference},
+            {"BatchNormInferenceRelu", CostKind::BatchNormInference},
+            {"BatchNormTraining", CostKind::BatchNormTraining},
+            {"BatchNormTrainingRelu", CostKind::BatchNormTraining},
+            {"Softmax", CostKind::Softmax},
+            {"BoundedRelu", CostKind::Elementwise},
+            {"Clamp", CostKind::Elementwise},
+            {"CPULeakyRelu", CostKind::Elementwise},
+            {"Elu", CostKind::Elementwise},
+            {"Gelu", CostKind::Elementwise},
+            {"HardSigmoid", CostKind::Elementwise},
+            {"Not", CostKind::Elementwise},
+            {"PRelu", CostKind::Elementwise},
+            {"ScaleShift", CostKind::Elementwise},
+            {"Select", CostKind::Elementwise},
+            {"SigmoidMultiply", CostKind::Elementwise},
+            {"SigmoidMultiplyBackprop", CostKind::Elementwise},
+            {"SquaredDifference", CostKind::Elementwise}};
+        return cost_kinds;
+    }
+
+    template <typename T>
+    size_t tensor_bytes(const T& value)
+    {
+        return value.get_element_type().size() * shape_size(value.get_shape());
+    }
+
+    // Every element of the forward output is a dot product over one input channel group and
+    // window, which is the filter divided over the output channels
+    size_t convolution_flops(const Shape& forward_out_shape, const Shape& filter_shape)
+    {
+        if (forward_out_shape.size() < 2 || forward_out_shape[1] == 0)
+        {
+            return 0;
+        }
+        return 2 * shape_size(forward_out_shape) * shape_size(filter_shape) /
+               forward_out_shape[1];
+    }
+
+    size_t matmul_flops(const Shape& arg0_shape, const Shape& out_shape)
+    {
+        if (out_shape.empty() || shape_size(out_shape) == 0)
+        {
+            return 0;
+        }
+        // arg0 holds every row of the output, each with dot_size elements
+        size_t rows = shape_size(out_shape) / out_shape.back();
+        size_t dot_size = shape_size(arg0_shape) / rows;
+        return 2 * shape_size(out_shape) * dot_size;
+    }
+
+    size_t dot_flops(const Node& node, size_t reduction_axes_count)
+    {
+        const Shape& arg1_shape = node.get_input_shape(1);
+        size_t dot_size = 1;
+        for (size_t i = 0; i < reduction_axes_count && i < arg1_shape.size(); i++)
+        {
+            dot_size *= arg1_shape[i];
+        }
+        return 2 * shape_size(node.get_output_shape(0)) * dot_size;
+    }
+
+    size_t pool_flops(const Shape& forward_out_shape, const Shape& window_shape)
+    {
+        return shape_size(forward_out_shape) * shape_size(window_shape);
+    }
+
+    size_t estimate_flops(const Node& node)
+    {
+        if (node.is_unary_elementwise_arithmetic() || node.is_binary_elementwise_arithmetic() ||
+            node.is_binary_elementwise_comparison() || node.is_binary_elementwise_logical())
+        {
+            return shape_size(node.get_output_shape(0));
+        }
+        if (dynamic_cast<const op::util::ArithmeticReduction*>(&node) ||
+            dynamic_cast<const op::util::LogicalReduction*>(&node) ||
+            dynamic_cast<const op::util::IndexReduction*>(&node))
+        {
+            return shape_size(node.get_input_shape(0));
+        }
+        if (auto dot = as_type<const op::Dot>(&node))
+        {
+            return dot_flops(node, dot->get_reduction_axes_count());
+        }
+        if (auto dot = as_type<const op::QuantizedDot>(&node))
+        {
+            return dot_flops(node, dot->get_reduction_axes_count());
+        }
+        if (auto pool = as_type<const op::v0::MaxPool>(&node))
+        {
+            return pool_flops(node.get_output_shape(0), pool->get_window_shape());
+        }
+        if (auto pool = as_type<const op::v1::MaxPool>(&node))
+        {
+            return pool_flops(node.get_output_shape(0), pool->get_kernel());
+        }
+        if (auto pool = as_type<const op::v0::AvgPool>(&node))
+        {
+            return pool_flops(node.get_output_shape(0), pool->get_window_shape());
+        }
+        if (auto pool = as_type<const op::v1::AvgPool>(&node))
+        {
+            return pool_flops(node.get_output_shape(0), pool->get_kernel());
+        }
+        if (auto pool = as_type<const op::v0::MaxPoolBackprop>(&node))
+        {
+            return pool_flops(node.get_input_shape(1), pool->get_window_shape());
+        }
+        if (auto pool = as_type<const op::v1::MaxPoolBackprop>(&node))
+        {
+            return pool_flops(node.get_input_shape(1), pool->get_kernel());
+        }
+        if (auto pool = as_type<const op::v0::AvgPoolBackprop>(&node))
+        {
+            return pool_flops(node.get_input_shape(0), pool->get_window_shape());
+        }
+        if (auto pool = as_type<const op::v1::AvgPoolBackprop>(&node))
+        {
+            return pool_flops(node.get_input_shape(0), pool->get_kernel());
+        }
+
+        auto it = get_cost_kinds().find(node.description());
+        if (it == get_cost_kinds().end() || node.get_output_size() == 0)
+        {
+            return 0;
+        }
+        switch (it->second)
+        {
+        case CostKind::Convolution:
+            return convolution_flops(node.get_output_shape(0), node.get_input_shape(1));
+        case CostKind::ConvolutionBackpropData:
+            return convolution_flops(node.get_input_shape(1), node.get_input_shape(0));
+        case CostKind::ConvolutionBackpropFilters:
+            return convolution_flops(node.get_input_shape(1), node.get_output_shape(0));
+        case CostKind::MatMul:
+            return matmul_flops(node.get_input_shape(0), node.get_output_shape(0));
+        case CostKind::BatchNormInference: return 2 * shape_size(node.get_output_shape(0));
+        // Mean and variance take a pass each, then the normalization
+        case CostKind::BatchNormTraining: return 5 * shape_size(node.get_output_shape(0));
+        // Max, exp and subtract, sum, divide
+        case CostKind::Softmax: return 4 * shape_size(node.get_output_shape(0));
+        case CostKind::Elementwise: return shape_size(node.get_output_shape(0));
+        }
+        return 0;
+    }
+}
+
+runtime::OpCost runtime::estimate_op_cost(const Node& node)
+{
+    OpCost cost;
+    if (node.is_parameter() || node.is_constant())
+    {
+        return cost;
+    }
+    for (const Input<const Node>& input : node.inputs())
+    {
+        cost.bytes_read += tensor_bytes(input);
+    }
+    for (const Output<const Node>& output : node.outputs())
+    {
+        cost.bytes_written += tensor_bytes(output);
+    }
+    cost.flops = estimate_flops(node);
+    return cost;
+}
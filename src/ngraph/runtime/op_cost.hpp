@@ -0,0 +1,43 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <cstddef>
+
+#include "ngraph/node.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        /// \brief The work one execution of an op does, estimated from its shapes and types
+        struct OpCost
+        {
+            /// Arithmetic operations, counting a multiply-add as two
+            size_t flops = 0;
+            size_t bytes_read = 0;
+            size_t bytes_written = 0;
+        };
+
+        /// \brief Estimates the cost of one execution of node.
+        ///
+        /// Bytes are the sizes of the input and output tensors, so they are a lower bound on the
+        /// memory traffic of kernels that read their inputs more than once. Ops that only move
+        /// data, and ops with no estimate, have zero flops.
+        OpCost estimate_op_cost(const Node& node);
+    }
+}
@@ -20,6 +20,7 @@
 #include <string>
 
 #include "ngraph/node.hpp"
+#include "ngraph/runtime/op_cost.hpp"
 
 namespace ngraph
 {
@@ -32,6 +33,7 @@ namespace ngraph
                 : m_node(n)
                 , m_total_microseconds(us)
                 , m_call_count(calls)
+                , m_cost(n ? estimate_op_cost(*n) : OpCost())
             {
             }
             std::shared_ptr<const Node> get_node() const { return m_node; }
@@ -41,9 +43,29 @@ namespace ngraph
                 return m_call_count == 0 ? 0 : m_total_microseconds / m_call_count;
             }
             size_t call_count() const { return m_call_count; }
+            /// \brief The estimated work of one call of the node
+            const OpCost& get_cost() const { return m_cost; }
+            /// \brief The achieved rate over all calls, or 0 when no time was recorded
+            double gflops_per_second() const { return per_nanosecond(m_cost.flops); }
+            /// \brief The achieved bandwidth over all calls, reads and writes together
+            double gbytes_per_second() const
+            {
+                return per_nanosecond(m_cost.bytes_read + m_cost.bytes_written);
+            }
             std::shared_ptr<const Node> m_node;
             size_t m_total_microseconds;
             size_t m_call_count;
+
+        private:
+            double per_nanosecond(size_t count_per_call) const
+            {
+                return m_total_microseconds == 0
+                           ? 0
+                           : static_cast<double>(count_per_call) * m_call_count /
+                                 (m_total_microseconds * 1000.0);
+            }
+
+            OpCost m_cost;
         };
     }
 }
@@ -20,6 +20,7 @@
 
 #include "ngraph/coordinate_transform.hpp"
 #include "ngraph/op/util/attr_types.hpp"
+#include "ngraph/runtime/reference/parallel_for.hpp"
 #include "ngraph/shape_util.hpp"
 
 namespace ngraph
@@ -57,10 +58,12 @@ namespace ngraph
                 switch (broadcast_spec.m_type)
                 {
                 case op::AutoBroadcastType::NONE:
-                    for (size_t i = 0; i < shape_size(arg0_shape); i++)
-                    {
-                        out[i] = elementwise_functor(arg0[i], arg1[i]);
-                    }
+                    parallel_for(shape_size(arg0_shape), 1, [&](size_t begin, size_t end) {
+                        for (size_t i = begin; i < end; i++)
+                        {
+                            out[i] = elementwise_functor(arg0[i], arg1[i]);
+                        }
+                    });
                     break;
                 case op::AutoBroadcastType::NUMPY:
                     // We'll be using CoordinateTransform to handle the broadcasting. The general
@@ -129,18 +132,29 @@ namespace ngraph
                                                        : arg0_padded_shape[i]);
                         }
 
-                        CoordinateTransform arg0_transform(arg0_squeezed_shape);
-                        CoordinateTransform arg1_transform(arg1_squeezed_shape);
-                        CoordinateTransform output_transform(output_shape);
-
-                        for (const Coordinate& output_coord : output_transform)
-                        {
-                            Coordinate arg0_coord = reduce(output_coord, arg0_squeezed_axes);
-                            Coordinate arg1_coord = reduce(output_coord, arg1_squeezed_axes);
-                            out[output_transform.index(output_coord)] =
-                                elementwise_functor(arg0[arg0_transform.index(arg0_coord)],
-                                                    arg1[arg1_transform.index(arg1_coord)]);
-                        }
+                        parallel_walk(
+                            output_shape,
+                            {row_major_strides(output_shape),
+                             CoordinateWalker::expanded_strides(arg0_squeezed_shape,
+                                                                arg0_squeezed_axes),
+                             CoordinateWalker::expanded_strides(arg1_squeezed_shape,
+                                                                arg1_squeezed_axes)},
+                            [&](CoordinateWalker& walker) {
+                                for (; !walker.is_done(); walker.next_run())
+                                {
+                                    U* out_run = out + walker.get_index(0);
+                                    const T* arg0_run = arg0 + walker.get_index(1);
+                                    const T* arg1_run = arg1 + walker.get_index(2);
+                                    size_t out_stride = walker.get_run_stride(0);
+                                    size_t arg0_stride = walker.get_run_stride(1);
+                                    size_t arg1_stride = walker.get_run_stride(2);
+                                    for (size_t i = 0; i < walker.get_run_length(); i++)
+                                    {
+                                        out_run[i * out_stride] = elementwise_functor(
+                                            arg0_run[i * arg0_stride], arg1_run[i * arg1_stride]);
+                                    }
+                                }
+                            });
                     }
                     break;
                 case op::AutoBroadcastType::PDPD:
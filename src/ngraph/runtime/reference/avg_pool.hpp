@@ -24,6 +24,7 @@
 
 #include "ngraph/axis_vector.hpp"
 #include "ngraph/coordinate_transform.hpp"
+#include "ngraph/runtime/reference/parallel_for.hpp"
 #include "ngraph/shape.hpp"
 
 namespace ngraph
@@ -134,11 +135,11 @@ namespace ngraph
             {
                 auto old_mode = std::fegetround();
                 std::fesetround(FE_TONEAREST);
-                // At the outermost level we will walk over every output coordinate O.
+                // At the outermost level we will walk over every output coordinate O. Each O
+                // only writes its own output, so the batch and channel planes run in parallel.
                 CoordinateTransform output_transform(out_shape);
 
-                for (const Coordinate& out_coord : output_transform)
-                {
+                auto compute_output = [&](const Coordinate& out_coord) {
                     // Our output coordinate O will have the form:
                     //
                     //   (N,chan,i_1,...,i_n)
@@ -244,8 +245,10 @@ namespace ngraph
                     {
                         out[output_transform.index(out_coord)] = result / n_elements;
                     }
-                    std::fesetround(old_mode);
-                }
+                };
+                parallel_for_each_coordinate(
+                    out_shape, 0, 1, shape_size(window_shape), compute_output);
+                std::fesetround(old_mode);
             }
         }
     }
@@ -19,6 +19,7 @@
 #include <cmath>
 
 #include "ngraph/coordinate_transform.hpp"
+#include "ngraph/runtime/reference/parallel_for.hpp"
 #include "ngraph/shape_util.hpp"
 
 namespace ngraph
@@ -34,16 +35,23 @@ namespace ngraph
                            const Shape& out_shape,
                            const AxisSet& broadcast_axes)
             {
-                CoordinateTransform input_transform(in_shape);
-                CoordinateTransform output_transform(out_shape);
-
-                for (const Coordinate& output_coord : output_transform)
-                {
-                    Coordinate input_coord = reduce(output_coord, broadcast_axes);
-
-                    out[output_transform.index(output_coord)] =
-                        arg[input_transform.index(input_coord)];
-                }
+                parallel_walk(
+                    out_shape,
+                    {row_major_strides(out_shape),
+                     CoordinateWalker::expanded_strides(in_shape, broadcast_axes)},
+                    [&](CoordinateWalker& walker) {
+                        for (; !walker.is_done(); walker.next_run())
+                        {
+                            T* out_run = out + walker.get_index(0);
+                            const T* arg_run = arg + walker.get_index(1);
+                            size_t out_stride = walker.get_run_stride(0);
+                            size_t arg_stride = walker.get_run_stride(1);
+                            for (size_t i = 0; i < walker.get_run_length(); i++)
+                            {
+                                out_run[i * out_stride] = arg_run[i * arg_stride];
+                            }
+                        }
+                    });
             }
         }
     }
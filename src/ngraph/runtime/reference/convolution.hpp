@@ -22,6 +22,7 @@
 
 #include "ngraph/axis_vector.hpp"
 #include "ngraph/coordinate_transform.hpp"
+#include "ngraph/runtime/reference/parallel_for.hpp"
 #include "ngraph/runtime/reference/reverse.hpp"
 #include "ngraph/util.hpp"
 
@@ -96,11 +97,19 @@ namespace ngraph
                 // * out channel axes for filter is 0
                 // * out channel axis for out is 1
 
-                // At the outermost level we will walk over every out coordinate O.
+                // At the outermost level we will walk over every out coordinate O. Each O only
+                // writes its own output, so the batch and channel planes run in parallel.
                 CoordinateTransform out_transform(out_shape);
-
-                for (const Coordinate& out_coord : out_transform)
+                size_t filter_size_per_out_channel = 1;
+                for (size_t i = 0; i < filter_shape.size(); i++)
                 {
+                    if (i != filter_out_channel_axis)
+                    {
+                        filter_size_per_out_channel *= filter_shape[i];
+                    }
+                }
+
+                auto compute_output = [&](const Coordinate& out_coord) {
                     // Our out coordinate O will have the form:
                     //
                     //   (N,chan_out,i_1,...,i_n)
@@ -260,7 +269,12 @@ namespace ngraph
                     {
                         out[out_transform.index(out_coord)] = result;
                     }
-                }
+                };
+                parallel_for_each_coordinate(out_shape,
+                                             out_batch_axis,
+                                             out_channel_axis,
+                                             filter_size_per_out_channel,
+                                             compute_output);
                 std::fesetround(old_mode);
             }
 
@@ -20,6 +20,7 @@
 
 #include "ngraph/axis_set.hpp"
 #include "ngraph/coordinate_transform.hpp"
+#include "ngraph/runtime/reference/parallel_for.hpp"
 #include "ngraph/shape_util.hpp"
 
 namespace ngraph
@@ -37,19 +38,38 @@ namespace ngraph
                             const Shape& scale_zero_point_shape,
                             const AxisSet& axes)
             {
-                CoordinateTransform input_transform(input_shape);
-                CoordinateTransform scale_zero_point_transform(scale_zero_point_shape);
-
-                for (const Coordinate& input_coord : input_transform)
+                // The scale and zero point only vary along axes
+                AxisSet broadcast_axes;
+                for (size_t i = 0; i < input_shape.size(); i++)
                 {
-                    Coordinate scale_zero_point_coord = project(input_coord, axes);
-
-                    output[input_transform.index(input_coord)] =
-                        static_cast<REAL>((
-                            input[input_transform.index(input_coord)] -
-                            zero_point[scale_zero_point_transform.index(scale_zero_point_coord)])) *
-                        scale[scale_zero_point_transform.index(scale_zero_point_coord)];
+                    if (axes.count(i) == 0)
+                    {
+                        broadcast_axes.insert(i);
+                    }
                 }
+
+                parallel_walk(
+                    input_shape,
+                    {row_major_strides(input_shape),
+                     CoordinateWalker::expanded_strides(scale_zero_point_shape, broadcast_axes)},
+                    [&](CoordinateWalker& walker) {
+                        for (; !walker.is_done(); walker.next_run())
+                        {
+                            const QUANT* input_run = input + walker.get_index(0);
+                            REAL* output_run = output + walker.get_index(0);
+                            const REAL* scale_run = scale + walker.get_index(1);
+                            const QUANT* zero_point_run = zero_point + walker.get_index(1);
+                            size_t input_stride = walker.get_run_stride(0);
+                            size_t scale_stride = walker.get_run_stride(1);
+                            for (size_t i = 0; i < walker.get_run_length(); i++)
+                            {
+                                output_run[i * input_stride] =
+                                    static_cast<REAL>((input_run[i * input_stride] -
+                                                       zero_point_run[i * scale_stride])) *
+                                    scale_run[i * scale_stride];
+                            }
+                        }
+                    });
             }
         }
     }
@@ -16,13 +16,16 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 #include <utility>
+#include <vector>
 
 #include <cfenv>
 #include <functional>
 #include "convolution.hpp"
 #include "ngraph/coordinate_transform.hpp"
+#include "ngraph/runtime/reference/parallel_for.hpp"
 #include "ngraph/shape_util.hpp"
 
 namespace ngraph
@@ -58,112 +61,88 @@ namespace ngraph
 
                 auto old_mode = std::fegetround();
                 std::fesetround(FE_TONEAREST);
-                // Get the sizes of the dot axes. It's easiest to pull them from arg1 because
-                // they're right up front.
-                Shape dot_axis_sizes(reduction_axes_count);
-                std::copy(arg1_shape.begin(),
-                          arg1_shape.begin() + reduction_axes_count,
-                          dot_axis_sizes.begin());
 
-                CoordinateTransform arg0_transform(arg0_shape);
-                CoordinateTransform arg1_transform(arg1_shape);
-                CoordinateTransform output_transform(out_shape);
-
-                // Create coordinate transforms for arg0 and arg1 that throw away the dotted axes.
+                // arg0 has shape (arg0 projected axes, dot axes) and arg1 has shape (dot axes,
+                // arg1 projected axes), so each side flattens to a matrix and the output is their
+                // row-major product
                 size_t arg0_projected_rank = arg0_shape.size() - reduction_axes_count;
-                size_t arg1_projected_rank = arg1_shape.size() - reduction_axes_count;
-
-                Shape arg0_projected_shape(arg0_projected_rank);
-                std::copy(arg0_shape.begin(),
-                          arg0_shape.begin() + arg0_projected_rank,
-                          arg0_projected_shape.begin());
-
-                Shape arg1_projected_shape(arg1_projected_rank);
-                std::copy(arg1_shape.begin() + reduction_axes_count,
-                          arg1_shape.end(),
-                          arg1_projected_shape.begin());
-
-                CoordinateTransform arg0_projected_transform(arg0_projected_shape);
-                CoordinateTransform arg1_projected_transform(arg1_projected_shape);
-
-                // Create a coordinate transform that allows us to iterate over all possible values
-                // for the dotted axes.
-                CoordinateTransform dot_axes_transform(dot_axis_sizes);
-
-                for (const Coordinate& arg0_projected_coord : arg0_projected_transform)
+                size_t arg0_projected_size = 1;
+                for (size_t i = 0; i < arg0_projected_rank; i++)
                 {
-                    for (const Coordinate& arg1_projected_coord : arg1_projected_transform)
-                    {
-                        // The output coordinate is just the concatenation of the projected
-                        // coordinates.
-                        Coordinate out_coord(arg0_projected_coord.size() +
-                                             arg1_projected_coord.size());
-
-                        auto out_coord_it = std::copy(arg0_projected_coord.begin(),
-                                                      arg0_projected_coord.end(),
-                                                      out_coord.begin());
-                        std::copy(
-                            arg1_projected_coord.begin(), arg1_projected_coord.end(), out_coord_it);
-
-                        // Zero out to start the sum.
-                        ACCUMULATION sum = 0;
-
-                        size_t out_index = output_transform.index(out_coord);
-
-                        // Walk along the dotted axes.
-                        Coordinate arg0_coord(arg0_shape.size());
-                        Coordinate arg1_coord(arg1_shape.size());
-                        auto arg0_it = std::copy(arg0_projected_coord.begin(),
-                                                 arg0_projected_coord.end(),
-                                                 arg0_coord.begin());
-                        for (const Coordinate& dot_axis_positions : dot_axes_transform)
+                    arg0_projected_size *= arg0_shape[i];
+                }
+                size_t dot_size = 1;
+                for (size_t i = 0; i < reduction_axes_count; i++)
+                {
+                    dot_size *= arg1_shape[i];
+                }
+                size_t arg1_projected_size = 1;
+                for (size_t i = reduction_axes_count; i < arg1_shape.size(); i++)
+                {
+                    arg1_projected_size *= arg1_shape[i];
+                }
+                NGRAPH_CHECK(shape_size(out_shape) == arg0_projected_size * arg1_projected_size);
+
+                // Accumulate a whole output row at a time so that arg1 is read along its rows.
+                // Each output element still sums its products in order along the dot axes.
+                // Rows are independent, so blocks of rows run in parallel.
+                parallel_for(
+                    arg0_projected_size,
+                    dot_size * arg1_projected_size,
+                    [&](size_t begin, size_t end) {
+                        std::vector<ACCUMULATION> sums(arg1_projected_size);
+                        for (size_t i = begin; i < end; i++)
                         {
-                            // In order to find the points to multiply together, we need to inject
-                            // our current positions along the dotted axes back into the projected
-                            // arg0 and arg1 coordinates.
-                            std::copy(
-                                dot_axis_positions.begin(), dot_axis_positions.end(), arg0_it);
-
-                            auto arg1_it = std::copy(dot_axis_positions.begin(),
-                                                     dot_axis_positions.end(),
-                                                     arg1_coord.begin());
-                            std::copy(
-                                arg1_projected_coord.begin(), arg1_projected_coord.end(), arg1_it);
+                            std::fill(sums.begin(), sums.end(), ACCUMULATION(0));
+                            const INPUT0* arg0_row = arg0 + i * dot_size;
+                            for (size_t k = 0; k < dot_size; k++)
+                            {
+                                const INPUT1* arg1_row = arg1 + k * arg1_projected_size;
+                                if (is_quantized)
+                                {
+                                    ACCUMULATION x =
+                                        static_cast<ACCUMULATION>(arg0_row[k]) -
+                                        static_cast<ACCUMULATION>(*input0_zero_point);
+                                    ACCUMULATION y_offset =
+                                        static_cast<ACCUMULATION>(*input1_zero_point);
+                                    for (size_t j = 0; j < arg1_projected_size; j++)
+                                    {
+                                        sums[j] +=
+                                            x * (static_cast<ACCUMULATION>(arg1_row[j]) - y_offset);
+                                    }
+                                }
+                                else
+                                {
+                                    ACCUMULATION x = static_cast<ACCUMULATION>(arg0_row[k]);
+                                    for (size_t j = 0; j < arg1_projected_size; j++)
+                                    {
+                                        sums[j] += x * static_cast<ACCUMULATION>(arg1_row[j]);
+                                    }
+                                }
+                            }
 
-                            // Multiply and add to the sum.
+                            OUTPUT* out_row = out + i * arg1_projected_size;
                             if (is_quantized)
                             {
-                                sum += (static_cast<ACCUMULATION>(
-                                            arg0[arg0_transform.index(arg0_coord)]) -
-                                        static_cast<ACCUMULATION>(*input0_zero_point)) *
-                                       (static_cast<ACCUMULATION>(
-                                            arg1[arg1_transform.index(arg1_coord)]) -
-                                        static_cast<ACCUMULATION>(*input1_zero_point));
+                                float scale = *input0_scale * *input1_scale / *output_scale;
+                                for (size_t j = 0; j < arg1_projected_size; j++)
+                                {
+                                    out_row[j] =
+                                        static_cast<OUTPUT>(
+                                            std::round(static_cast<float>(sums[j]) * scale)) +
+                                        *output_zero_point;
+                                }
                             }
                             else
                             {
-                                sum += static_cast<ACCUMULATION>(
-                                           arg0[arg0_transform.index(arg0_coord)]) *
-                                       static_cast<ACCUMULATION>(
-                                           arg1[arg1_transform.index(arg1_coord)]);
+                                for (size_t j = 0; j < arg1_projected_size; j++)
+                                {
+                                    out_row[j] = sums[j];
+                                }
                             }
                         }
-
-                        if (is_quantized)
-                        {
-                            float scale = *input0_scale * *input1_scale / *output_scale;
-                            // Write the sum back.
-                            out[out_index] =
-                                static_cast<OUTPUT>(std::round(static_cast<float>(sum) * scale)) +
-                                *output_zero_point;
-                        }
-                        else
-                        {
-                            out[out_index] = sum;
-                        }
-                    }
-                    std::fesetround(old_mode);
-                }
+                    });
+                std::fesetround(old_mode);
             }
         }
     }
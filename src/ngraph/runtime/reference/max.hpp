@@ -16,10 +16,12 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 
 #include "ngraph/coordinate_transform.hpp"
+#include "ngraph/runtime/reference/parallel_for.hpp"
 #include "ngraph/shape_util.hpp"
 
 namespace ngraph
@@ -39,26 +41,26 @@ namespace ngraph
                                ? T(-std::numeric_limits<T>::infinity())
                                : std::numeric_limits<T>::min();
 
-                CoordinateTransform output_transform(out_shape);
+                std::fill(out, out + shape_size(out_shape), minval);
 
-                for (const Coordinate& output_coord : output_transform)
-                {
-                    out[output_transform.index(output_coord)] = minval;
-                }
-
-                CoordinateTransform input_transform(in_shape);
-
-                for (const Coordinate& input_coord : input_transform)
-                {
-                    Coordinate output_coord = reduce(input_coord, reduction_axes);
-
-                    T x = arg[input_transform.index(input_coord)];
-                    T max = out[output_transform.index(output_coord)];
-                    if (x > max)
-                    {
-                        out[output_transform.index(output_coord)] = x;
-                    }
-                }
+                parallel_reduction_walk(
+                    in_shape, out_shape, reduction_axes, [&](CoordinateWalker& walker) {
+                        for (; !walker.is_done(); walker.next_run())
+                        {
+                            size_t arg_index = walker.get_index(0);
+                            size_t out_index = walker.get_index(1);
+                            for (size_t i = 0; i < walker.get_run_length(); i++)
+                            {
+                                T x = arg[arg_index];
+                                if (x > out[out_index])
+                                {
+                                    out[out_index] = x;
+                                }
+                                arg_index += walker.get_run_stride(0);
+                                out_index += walker.get_run_stride(1);
+                            }
+                        }
+                    });
             }
         }
     }
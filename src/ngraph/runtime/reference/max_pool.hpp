@@ -20,6 +20,7 @@
 #include <numeric>
 
 #include "ngraph/coordinate_transform.hpp"
+#include "ngraph/runtime/reference/parallel_for.hpp"
 
 namespace ngraph
 {
@@ -131,11 +132,11 @@ namespace ngraph
                           const Shape& padding_below,
                           const Shape& padding_above)
             {
-                // At the outermost level we will walk over every output coordinate O.
+                // At the outermost level we will walk over every output coordinate O. Each O
+                // only writes its own output, so the batch and channel planes run in parallel.
                 CoordinateTransform output_transform(out_shape);
 
-                for (const Coordinate& out_coord : output_transform)
-                {
+                auto compute_output = [&](const Coordinate& out_coord) {
                     // Our output coordinate O will have the form:
                     //
                     //   (N,chan,i_1,...,i_n)
@@ -218,7 +219,9 @@ namespace ngraph
                     }
 
                     out[output_transform.index(out_coord)] = result;
-                }
+                };
+                parallel_for_each_coordinate(
+                    out_shape, 0, 1, shape_size(window_shape), compute_output);
             }
         }
     }
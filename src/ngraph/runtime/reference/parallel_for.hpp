@@ -0,0 +1,174 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "ngraph/coordinate_transform.hpp"
+#include "ngraph/runtime/thread_pool.hpp"
+#include "ngraph/shape_util.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace reference
+        {
+            /// \brief The pool to split a loop of count iterations over, or nullptr if the loop
+            ///        should run sequentially. Loops with less than about 32K element operations
+            ///        in total cost more to hand out than they gain.
+            inline ThreadPool* get_parallel_pool(size_t count, size_t cost_per_iteration)
+            {
+                ThreadPool* pool = ThreadPool::get_current();
+                if (pool == nullptr || pool->get_thread_count() < 2 || count < 2 ||
+                    count * cost_per_iteration < (1 << 15))
+                {
+                    return nullptr;
+                }
+                return pool;
+            }
+
+            /// \brief Calls f(begin, end) on ranges covering [0, count), in parallel on the
+            ///        current thread pool when there is one and the loop is large enough.
+            /// \param cost_per_iteration A rough count of the element operations in one
+            ///        iteration
+            template <typename F>
+            void parallel_for(size_t count, size_t cost_per_iteration, F f)
+            {
+                if (ThreadPool* pool = get_parallel_pool(count, cost_per_iteration))
+                {
+                    pool->parallel_for(count, f);
+                }
+                else if (count > 0)
+                {
+                    f(0, count);
+                }
+            }
+
+            /// \brief Calls f(coordinate) for every coordinate of shape. The planes spanned by
+            ///        axis0 and axis1, such as the batch and channel axes of an NC... tensor, are
+            ///        handed out to the threads, so f must only write outputs of its coordinate.
+            template <typename F>
+            void parallel_for_each_coordinate(const Shape& shape,
+                                              size_t axis0,
+                                              size_t axis1,
+                                              size_t cost_per_coordinate,
+                                              F f)
+            {
+                Shape plane_shape = shape;
+                plane_shape[axis0] = 1;
+                plane_shape[axis1] = 1;
+                size_t plane_count = shape[axis0] * shape[axis1];
+                parallel_for(plane_count,
+                             shape_size(plane_shape) * cost_per_coordinate,
+                             [&](size_t begin, size_t end) {
+                                 CoordinateTransform plane_transform(plane_shape);
+                                 for (size_t plane = begin; plane < end; plane++)
+                                 {
+                                     for (Coordinate coordinate : plane_transform)
+                                     {
+                                         coordinate[axis0] = plane / shape[axis1];
+                                         coordinate[axis1] = plane % shape[axis1];
+                                         f(static_cast<const Coordinate&>(coordinate));
+                                     }
+                                 }
+                             });
+            }
+
+            /// \brief Calls f(walker) with CoordinateWalkers over buffers with the given strides
+            ///        that together walk all of shape. The walk is split along the outermost axis
+            ///        with more than one element, so f must only write elements that its walker
+            ///        visits and that no other coordinate maps to, such as those of a dense output.
+            template <typename F>
+            void parallel_walk(const Shape& shape, const std::vector<Strides>& strides, F f)
+            {
+                size_t split_axis = 0;
+                while (split_axis < shape.size() && shape[split_axis] < 2)
+                {
+                    split_axis++;
+                }
+                if (split_axis == shape.size() ||
+                    !get_parallel_pool(shape[split_axis],
+                                       shape_size(shape) / shape[split_axis]))
+                {
+                    CoordinateWalker walker(shape, strides);
+                    f(walker);
+                    return;
+                }
+
+                parallel_for(shape[split_axis],
+                             shape_size(shape) / shape[split_axis],
+                             [&](size_t begin, size_t end) {
+                                 Shape block_shape = shape;
+                                 block_shape[split_axis] = end - begin;
+                                 std::vector<size_t> offsets;
+                                 for (const Strides& buffer_strides : strides)
+                                 {
+                                     offsets.push_back(begin * buffer_strides[split_axis]);
+                                 }
+                                 CoordinateWalker walker(block_shape, strides, offsets);
+                                 f(walker);
+                             });
+            }
+
+            /// \brief Calls f(walker) with CoordinateWalkers over the input and output of a
+            ///        reduction that together walk all of in_shape. Buffer 0 of a walker is the
+            ///        input and buffer 1 the output.
+            ///
+            /// The walk is split along the outermost axis that is not reduced, so every output
+            /// element is reduced by one walker in the same order as a sequential walk, and
+            /// concurrent walkers write disjoint outputs.
+            template <typename F>
+            void parallel_reduction_walk(const Shape& in_shape,
+                                         const Shape& out_shape,
+                                         const AxisSet& reduction_axes,
+                                         F f)
+            {
+                Strides in_strides = row_major_strides(in_shape);
+                Strides out_strides = CoordinateWalker::expanded_strides(out_shape, reduction_axes);
+
+                size_t split_axis = 0;
+                while (split_axis < in_shape.size() &&
+                       (reduction_axes.count(split_axis) != 0 || in_shape[split_axis] < 2))
+                {
+                    split_axis++;
+                }
+                if (split_axis == in_shape.size() ||
+                    !get_parallel_pool(in_shape[split_axis],
+                                       shape_size(in_shape) / in_shape[split_axis]))
+                {
+                    CoordinateWalker walker(in_shape, {in_strides, out_strides});
+                    f(walker);
+                    return;
+                }
+
+                parallel_for(in_shape[split_axis],
+                             shape_size(in_shape) / in_shape[split_axis],
+                             [&](size_t begin, size_t end) {
+                                 Shape block_shape = in_shape;
+                                 block_shape[split_axis] = end - begin;
+                                 CoordinateWalker walker(block_shape,
+                                                         {in_strides, out_strides},
+                                                         {begin * in_strides[split_axis],
+                                                          begin * out_strides[split_axis]});
+                                 f(walker);
+                             });
+            }
+        }
+    }
+}
@@ -16,9 +16,11 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 
 #include "ngraph/coordinate_transform.hpp"
+#include "ngraph/runtime/reference/parallel_for.hpp"
 #include "ngraph/shape_util.hpp"
 
 namespace ngraph
@@ -34,23 +36,22 @@ namespace ngraph
                          const Shape& out_shape,
                          const AxisSet& reduction_axes)
             {
-                CoordinateTransform output_transform(out_shape);
-
-                for (const Coordinate& output_coord : output_transform)
-                {
-                    out[output_transform.index(output_coord)] = 1;
-                }
-
-                CoordinateTransform input_transform(in_shape);
-
-                for (const Coordinate& input_coord : input_transform)
-                {
-                    Coordinate output_coord = reduce(input_coord, reduction_axes);
-
-                    size_t output_index = output_transform.index(output_coord);
-
-                    out[output_index] = out[output_index] * arg[input_transform.index(input_coord)];
-                }
+                std::fill(out, out + shape_size(out_shape), T(1));
+
+                parallel_reduction_walk(
+                    in_shape, out_shape, reduction_axes, [&](CoordinateWalker& walker) {
+                        for (; !walker.is_done(); walker.next_run())
+                        {
+                            size_t arg_index = walker.get_index(0);
+                            size_t out_index = walker.get_index(1);
+                            for (size_t i = 0; i < walker.get_run_length(); i++)
+                            {
+                                out[out_index] = out[out_index] * arg[arg_index];
+                                arg_index += walker.get_run_stride(0);
+                                out_index += walker.get_run_stride(1);
+                            }
+                        }
+                    });
             }
         }
     }
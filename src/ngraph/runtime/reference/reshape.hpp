@@ -21,6 +21,7 @@
 #include "ngraph/axis_vector.hpp"
 #include "ngraph/check.hpp"
 #include "ngraph/coordinate_transform.hpp"
+#include "ngraph/runtime/reference/parallel_for.hpp"
 
 namespace ngraph
 {
@@ -43,22 +44,26 @@ namespace ngraph
 
                 CoordinateTransform input_transform(
                     in_shape, in_start_corner, in_shape, in_strides, in_axis_order);
-                CoordinateTransform output_transform(out_shape);
+                const Shape& target_shape = input_transform.get_target_shape();
 
-                NGRAPH_CHECK(shape_size(input_transform.get_target_shape()) ==
-                             shape_size(output_transform.get_target_shape()));
+                NGRAPH_CHECK(shape_size(target_shape) == shape_size(out_shape));
 
-                CoordinateTransform::Iterator output_it = output_transform.begin();
-
-                for (const Coordinate& input_coord : input_transform)
-                {
-                    const Coordinate& output_coord = *output_it;
-
-                    out[output_transform.index(output_coord)] =
-                        arg[input_transform.index(input_coord)];
-
-                    ++output_it;
-                }
+                // The output is written in the order the input is read
+                parallel_walk(target_shape,
+                              {row_major_strides(target_shape),
+                               input_transform.get_source_index_strides()},
+                              [&](CoordinateWalker& walker) {
+                                  for (; !walker.is_done(); walker.next_run())
+                                  {
+                                      T* out_run = out + walker.get_index(0);
+                                      const T* arg_run = arg + walker.get_index(1);
+                                      size_t arg_stride = walker.get_run_stride(1);
+                                      for (size_t i = 0; i < walker.get_run_length(); i++)
+                                      {
+                                          out_run[i] = arg_run[i * arg_stride];
+                                      }
+                                  }
+                              });
             }
         }
     }
@@ -37,20 +37,25 @@ namespace ngraph
                        const Shape& out_shape)
             {
                 CoordinateTransform input_transform(arg_shape, lower_bounds, upper_bounds, strides);
-                CoordinateTransform output_transform(out_shape);
+                const Shape& target_shape = input_transform.get_target_shape();
 
-                CoordinateTransform::Iterator output_it = output_transform.begin();
+                NGRAPH_CHECK(shape_size(target_shape) == shape_size(out_shape));
 
-                NGRAPH_CHECK(shape_size(input_transform.get_target_shape()) ==
-                             shape_size(output_transform.get_target_shape()));
-
-                for (const Coordinate& in_coord : input_transform)
+                // The output is written in the order the input is read
+                for (CoordinateWalker walker(target_shape,
+                                             {row_major_strides(target_shape),
+                                              input_transform.get_source_index_strides()},
+                                             {0, input_transform.get_source_start_index()});
+                     !walker.is_done();
+                     walker.next_run())
                 {
-                    const Coordinate& out_coord = *output_it;
-
-                    out[output_transform.index(out_coord)] = arg[input_transform.index(in_coord)];
-
-                    ++output_it;
+                    T* out_run = out + walker.get_index(0);
+                    const T* arg_run = arg + walker.get_index(1);
+                    size_t arg_stride = walker.get_run_stride(1);
+                    for (size_t i = 0; i < walker.get_run_length(); i++)
+                    {
+                        out_run[i] = arg_run[i * arg_stride];
+                    }
                 }
             }
         }
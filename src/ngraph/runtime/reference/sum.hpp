@@ -16,9 +16,11 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 
 #include "ngraph/coordinate_transform.hpp"
+#include "ngraph/runtime/reference/parallel_for.hpp"
 #include "ngraph/shape_util.hpp"
 #include "ngraph/type/bfloat16.hpp"
 #include "ngraph/type/float16.hpp"
@@ -59,36 +61,36 @@ namespace ngraph
                      const Shape& out_shape,
                      const AxisSet& reduction_axes)
             {
-                CoordinateTransform output_transform(out_shape);
-                std::vector<T> cs(shape_size(out_shape));
+                std::vector<T> cs(shape_size(out_shape), 0);
+                std::fill(out, out + cs.size(), T(0));
 
-                for (const Coordinate& output_coord : output_transform)
-                {
-                    out[output_transform.index(output_coord)] = 0;
-                    cs[output_transform.index(output_coord)] = 0;
-                }
+                parallel_reduction_walk(
+                    in_shape, out_shape, reduction_axes, [&](CoordinateWalker& walker) {
+                        for (; !walker.is_done(); walker.next_run())
+                        {
+                            size_t arg_index = walker.get_index(0);
+                            size_t out_index = walker.get_index(1);
+                            for (size_t i = 0; i < walker.get_run_length(); i++)
+                            {
+                                T x = arg[arg_index];
+                                T& z = out[out_index];
 
-                CoordinateTransform input_transform(in_shape);
-
-                for (const Coordinate& input_coord : input_transform)
-                {
-                    Coordinate output_coord = reduce(input_coord, reduction_axes);
-
-                    T x = arg[input_transform.index(input_coord)];
-                    T& z = out[output_transform.index(output_coord)];
-
-                    if (is_finite(x) && is_finite(z))
-                    {
-                        T& c = cs[output_transform.index(output_coord)];
-                        T t = z + (x - c);
-                        c = (t - z) - (x - c);
-                        z = t;
-                    }
-                    else
-                    {
-                        z = z + x;
-                    }
-                }
+                                if (is_finite(x) && is_finite(z))
+                                {
+                                    T& c = cs[out_index];
+                                    T t = z + (x - c);
+                                    c = (t - z) - (x - c);
+                                    z = t;
+                                }
+                                else
+                                {
+                                    z = z + x;
+                                }
+                                arg_index += walker.get_run_stride(0);
+                                out_index += walker.get_run_stride(1);
+                            }
+                        }
+                    });
             }
         }
     }
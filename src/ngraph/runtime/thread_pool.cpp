@@ -0,0 +1,235 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <algorithm>
+#include <atomic>
+#include <cfenv>
+#include <exception>
+
+#include "ngraph/runtime/thread_pool.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+namespace
+{
+    // Set while a thread runs part of a loop, so that loops nested in it run sequentially
+    thread_local bool s_in_parallel_for = false;
+    thread_local runtime::ThreadPool* s_current_pool = nullptr;
+}
+
+// The state of one parallel_for. Workers that pick up the job after its caller returned only
+// find that every chunk is claimed, so they never call body after parallel_for returns.
+struct runtime::ThreadPool::Job
+{
+    Job(size_t count,
+        size_t chunk_size,
+        size_t chunk_count,
+        const function<void(size_t, size_t)>& body,
+        int rounding_mode)
+        : m_body(&body)
+        , m_count(count)
+        , m_chunk_size(chunk_size)
+        , m_chunk_count(chunk_count)
+        , m_rounding_mode(rounding_mode)
+        , m_next_chunk(0)
+        , m_finished_chunks(0)
+        , m_failed(false)
+    {
+    }
+
+    bool is_claimed() const { return m_next_chunk >= m_chunk_count; }
+    void run()
+    {
+        size_t chunk;
+        while ((chunk = m_next_chunk++) < m_chunk_count)
+        {
+            if (!m_failed)
+            {
+                size_t begin = chunk * m_chunk_size;
+                try
+                {
+                    (*m_body)(begin, min(m_count, begin + m_chunk_size));
+                }
+                catch (...)
+                {
+                    lock_guard<mutex> lock(m_job_mutex);
+                    if (!m_error)
+                    {
+                        m_error = current_exception();
+                    }
+                    m_failed = true;
+                }
+            }
+            if (++m_finished_chunks == m_chunk_count)
+            {
+                lock_guard<mutex> lock(m_job_mutex);
+                m_done.notify_all();
+            }
+        }
+    }
+
+    const function<void(size_t, size_t)>* m_body;
+    size_t m_count;
+    size_t m_chunk_size;
+    size_t m_chunk_count;
+    int m_rounding_mode;
+    atomic<size_t> m_next_chunk;
+    atomic<size_t> m_finished_chunks;
+    atomic<bool> m_failed;
+    exception_ptr m_error;
+    mutex m_job_mutex;
+    condition_variable m_done;
+};
+
+runtime::ThreadPool::ThreadPool(size_t thread_count)
+{
+    for (size_t i = 1; i < thread_count; i++)
+    {
+        m_threads.emplace_back(&ThreadPool::run_worker, this);
+    }
+}
+
+runtime::ThreadPool::~ThreadPool()
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_condition.notify_all();
+    for (thread& t : m_threads)
+    {
+        t.join();
+    }
+}
+
+void runtime::ThreadPool::parallel_for(size_t count, const function<void(size_t, size_t)>& body)
+{
+    if (count == 0)
+    {
+        return;
+    }
+    if (m_threads.empty() || count == 1 || s_in_parallel_for)
+    {
+        body(0, count);
+        return;
+    }
+
+    // A few chunks per thread even out chunks that take different times
+    size_t chunk_count = min(count, get_thread_count() * 4);
+    size_t chunk_size = (count + chunk_count - 1) / chunk_count;
+    chunk_count = (count + chunk_size - 1) / chunk_size;
+    auto job = make_shared<Job>(count, chunk_size, chunk_count, body, fegetround());
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_jobs.push_back(job);
+    }
+    m_condition.notify_all();
+
+    s_in_parallel_for = true;
+    job->run();
+    s_in_parallel_for = false;
+    {
+        unique_lock<mutex> lock(job->m_job_mutex);
+        job->m_done.wait(lock, [&job]() { return job->m_finished_chunks == job->m_chunk_count; });
+    }
+    if (job->m_error)
+    {
+        rethrow_exception(job->m_error);
+    }
+}
+
+void runtime::ThreadPool::post(function<void()> task)
+{
+    if (m_threads.empty())
+    {
+        task();
+        return;
+    }
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_tasks.push_back(move(task));
+    }
+    m_condition.notify_one();
+}
+
+void runtime::ThreadPool::run_worker()
+{
+    s_in_parallel_for = true;
+    while (true)
+    {
+        shared_ptr<Job> job;
+        function<void()> task;
+        {
+            unique_lock<mutex> lock(m_mutex);
+            while (!job && !task)
+            {
+                // Jobs with every chunk claimed are only waiting for the threads running them
+                while (!m_jobs.empty() && m_jobs.front()->is_claimed())
+                {
+                    m_jobs.pop_front();
+                }
+                if (!m_jobs.empty())
+                {
+                    job = m_jobs.front();
+                }
+                else if (!m_tasks.empty())
+                {
+                    task = move(m_tasks.front());
+                    m_tasks.pop_front();
+                }
+                else if (m_stop)
+                {
+                    return;
+                }
+                else
+                {
+                    m_condition.wait(lock);
+                }
+            }
+        }
+        if (job)
+        {
+            int old_mode = fegetround();
+            fesetround(job->m_rounding_mode);
+            job->run();
+            fesetround(old_mode);
+        }
+        else
+        {
+            // A task is not part of a loop, so the loops it runs may be parallel
+            s_in_parallel_for = false;
+            task();
+            s_in_parallel_for = true;
+        }
+    }
+}
+
+runtime::ThreadPool* runtime::ThreadPool::get_current()
+{
+    return s_current_pool;
+}
+
+runtime::ThreadPool::Scope::Scope(ThreadPool* pool)
+    : m_previous(s_current_pool)
+{
+    s_current_pool = pool;
+}
+
+runtime::ThreadPool::Scope::~Scope()
+{
+    s_current_pool = m_previous;
+}
@@ -0,0 +1,94 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        class ThreadPool;
+    }
+}
+
+/// \brief A fixed set of threads that run data-parallel loops for the reference kernels, and
+///        independent tasks posted to it.
+///
+/// The thread calling parallel_for runs chunks of its own loop, so a pool of n threads uses
+/// n - 1 worker threads. Kernels find the pool to use through get_current(), which a backend
+/// sets for the duration of a call with a Scope.
+class ngraph::runtime::ThreadPool
+{
+public:
+    /// \param thread_count The number of threads that run a loop, including the caller
+    explicit ThreadPool(size_t thread_count);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t get_thread_count() const { return m_threads.size() + 1; }
+    /// \brief Calls body(begin, end) on disjoint ranges that together cover [0, count) and
+    ///        returns when all of them are done. Ranges run with the caller's floating point
+    ///        rounding mode. The first exception thrown by body is rethrown here.
+    ///
+    /// A parallel_for called from inside body runs sequentially on the calling thread.
+    void parallel_for(size_t count, const std::function<void(size_t, size_t)>& body);
+
+    /// \brief Runs task on a worker thread and returns without waiting for it. Loop chunks
+    ///        are picked up before tasks. A pool without worker threads runs task on the
+    ///        caller. Tasks must not throw; queued tasks are run before the pool is destroyed.
+    void post(std::function<void()> task);
+
+    /// \brief The pool installed on this thread by the innermost Scope, or nullptr
+    static ThreadPool* get_current();
+
+    /// \brief Makes a pool the current pool of this thread while the Scope exists. A null
+    ///        pool makes the kernels run sequentially.
+    class Scope
+    {
+    public:
+        Scope(ThreadPool* pool);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        ThreadPool* m_previous;
+    };
+
+private:
+    struct Job;
+
+    void run_worker();
+
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<std::shared_ptr<Job>> m_jobs;
+    std::deque<std::function<void()>> m_tasks;
+    bool m_stop = false;
+};
@@ -16,10 +16,22 @@
 
 #include <fstream>
 #include <functional>
+#include <iomanip>
+#include <iterator>
+#include <limits>
+#include <mutex>
 #include <queue>
 #include <stack>
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include "ngraph/cpio.hpp"
+#include "ngraph/except.hpp"
 #include "ngraph/file_util.hpp"
 #include "ngraph/graph_util.hpp"
 #include "ngraph/op/abs.hpp"
@@ -151,6 +163,7 @@
 #include "ngraph/op/util/attr_types.hpp"
 #include "ngraph/op/xor.hpp"
 #include "ngraph/provenance.hpp"
+#include "ngraph/runtime/shared_buffer.hpp"
 #include "ngraph/serializer.hpp"
 #include "ngraph/util.hpp"
 #include "nlohmann/json.hpp"
@@ -158,8 +171,62 @@
 using namespace ngraph;
 using namespace std;
 using json = nlohmann::json;
+// Constant records in cpio files are aligned so that they can be used in place when the file is
+// memory mapped
+static const size_t s_cpio_constant_alignment = 64;
+
+// Binary graph format
+//
+// header:   magic, uint32 format version
+// op table: uint32 count followed by the description of every op type used in the function
+// function: string name, uint64 node count and one record per node in topological order
+// node:     uint32 op table index and the node's attributes as a MessagePack blob. A Constant
+//           record is followed by its uint64 data size, zero padding to a multiple of
+//           s_cpio_constant_alignment from the start of the file and the raw data
+// trailer:  the function's parameters and results as a MessagePack blob
+//
+// Strings are a uint32 length followed by the characters, blobs are a uint32 size followed by
+// the bytes. Integers are in native byte order.
+static const char s_binary_magic[8] = {'N', 'G', 'R', 'A', 'P', 'H', 'B', 'G'};
+static const uint32_t s_binary_version = 1;
+
 using const_data_callback_t = shared_ptr<Node>(const string&, const element::Type&, const Shape&);
 
+struct OpSerializer
+{
+    op_attributes_writer_t writer;
+    op_attributes_reader_t reader;
+};
+
+static mutex s_op_serializers_mutex;
+
+static unordered_map<string, OpSerializer>& get_op_serializers()
+{
+    static unordered_map<string, OpSerializer> op_serializers;
+    return op_serializers;
+}
+
+void ngraph::register_op_serializer(const string& op_name,
+                                    op_attributes_writer_t writer,
+                                    op_attributes_reader_t reader)
+{
+    lock_guard<mutex> lock(s_op_serializers_mutex);
+    get_op_serializers()[op_name] = {writer, reader};
+}
+
+// Returns false if no serializer is registered for op_name
+static bool find_op_serializer(const string& op_name, OpSerializer& op_serializer)
+{
+    lock_guard<mutex> lock(s_op_serializers_mutex);
+    auto it = get_op_serializers().find(op_name);
+    if (it == get_op_serializers().end())
+    {
+        return false;
+    }
+    op_serializer = it->second;
+    return true;
+}
+
 static bool s_serialize_output_shapes_enabled =
     (std::getenv("NGRAPH_SERIALIZER_OUTPUT_SHAPES") != nullptr);
 
@@ -227,6 +294,17 @@ public:
         m_binary_constant_data = binary_constant_data;
     }
 
+    // Replace node, tensor and function names with ordinals and constant values with digests.
+    // Used to compute structural hashes.
+    void set_anonymous(bool anonymous) { m_anonymous = anonymous; }
+
+    // Throw on ops that are not in the op tables and have no registered serializer, rather
+    // than writing them without attributes. Used by the formats that are meant to be loaded.
+    void set_require_op_serializers(bool require_op_serializers)
+    {
+        m_require_op_serializers = require_op_serializers;
+    }
+
     json serialize_function(const Function& function);
     json serialize_output(const Output<Node>& output);
     json serialize_parameter_vector(const ParameterVector& parameters);
@@ -236,9 +314,14 @@ public:
     json serialize_axis_set(const AxisSet& axis_set);
 
 protected:
+    json node_name(const Node& n);
+
     size_t m_indent{0};
     bool m_serialize_output_shapes{false};
     bool m_binary_constant_data{false};
+    bool m_anonymous{false};
+    bool m_require_op_serializers{false};
+    map<const Node*, size_t> m_node_ids;
     json m_json_nodes;
     set<const Node*> m_nodes_serialized;
     queue<const Node*> m_nodes_to_serialize;
@@ -268,6 +351,8 @@ protected:
 
 static string
     serialize(shared_ptr<ngraph::Function> func, size_t indent, bool binary_constant_data);
+static bool is_binary_graph(istream& in);
+static shared_ptr<Function> deserialize_binary(istream& in);
 
 static json write_dimension(Dimension d)
 {
@@ -420,31 +505,49 @@ void ngraph::serialize(ostream& out, shared_ptr<ngraph::Function> func, size_t i
     out << ::serialize(func, indent, false);
 }
 
-#if defined ENABLE_CPIO_FILE
-static void serialize_to_cpio(ostream& out, shared_ptr<ngraph::Function> func, size_t indent)
+void ngraph::serialize_cpio(const string& path, shared_ptr<ngraph::Function> func, size_t indent)
+{
+    ofstream out(path, ios_base::binary | ios_base::out);
+    serialize_cpio(out, func, indent);
+}
+
+// cpio records store their size in 32 bits
+static uint32_t cpio_record_size(const string& name, size_t size)
+{
+    if (size > numeric_limits<uint32_t>::max())
+    {
+        throw ngraph_error("cannot serialize " + name + " of " + to_string(size) +
+                           " bytes to cpio, which is limited to 4 GB per record");
+    }
+    return static_cast<uint32_t>(size);
+}
+
+void ngraph::serialize_cpio(ostream& out, shared_ptr<ngraph::Function> func, size_t indent)
 {
     string j = ::serialize(func, indent, true);
     cpio::Writer writer(out);
-    writer.write(func->get_name(), j.c_str(), static_cast<uint32_t>(j.size()));
+    writer.write(func->get_name(), j.c_str(), cpio_record_size(func->get_name(), j.size()));
 
     traverse_nodes(const_cast<Function*>(func.get()),
                    [&](shared_ptr<Node> node) {
-                       if (auto c = node->as_type<op::Constant>())
+                       if (auto c = as_type_ptr<op::Constant>(node))
                        {
-                           uint32_t size =
-                               static_cast<uint32_t>(shape_size(c->get_output_shape(0)) *
-                                                     c->get_output_element_type(0).size());
-                           writer.write(c->get_name(), c->get_data_ptr(), size);
+                           size_t size = shape_size(c->get_output_shape(0)) *
+                                         c->get_output_element_type(0).size();
+                           writer.write(c->get_name(),
+                                        c->get_data_ptr(),
+                                        cpio_record_size(c->get_name(), size),
+                                        s_cpio_constant_alignment);
                        }
                    },
                    true);
 }
-#endif
 
 static string serialize(shared_ptr<Function> func, size_t indent, bool binary_constant_data)
 {
     JSONSerializer serializer;
     serializer.set_binary_constant_data(binary_constant_data);
+    serializer.set_require_op_serializers(binary_constant_data);
     serializer.set_indent(indent);
     serializer.set_serialize_output_shapes(s_serialize_output_shapes_enabled);
 
@@ -468,36 +571,75 @@ std::string ngraph::serialize(std::shared_ptr<ngraph::Function> func, size_t ind
     return ::serialize(func, indent, false);
 }
 
+// Two 64-bit FNV-1a hashes over differently seeded streams, formatted as 32 hex digits. This
+// is not a 128-bit hash function, so equal digests do not prove equal data.
+static string digest(const void* data, size_t size)
+{
+    const uint64_t prime = 0x100000001b3ULL;
+    uint64_t h1 = 0xcbf29ce484222325ULL;
+    uint64_t h2 = 0x84222325cbf29ce4ULL;
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; i++)
+    {
+        h1 = (h1 ^ p[i]) * prime;
+        h2 = (h2 ^ static_cast<uint8_t>(p[i] + i)) * prime;
+    }
+    stringstream ss;
+    ss << hex << setfill('0') << setw(16) << h1 << setw(16) << h2;
+    return ss.str();
+}
+
+std::string ngraph::serialize_structure(std::shared_ptr<ngraph::Function> func)
+{
+    JSONSerializer serializer;
+    serializer.set_anonymous(true);
+    serializer.set_require_op_serializers(true);
+    return serializer.serialize_function(*func).dump();
+}
+
+std::string ngraph::hash_function(std::shared_ptr<ngraph::Function> func)
+{
+    string structure = serialize_structure(func);
+    return digest(structure.data(), structure.size());
+}
+
 shared_ptr<ngraph::Function> ngraph::deserialize(istream& in)
 {
     shared_ptr<Function> rc;
-    if (cpio::is_cpio(in))
+    if (is_binary_graph(in))
+    {
+        rc = deserialize_binary(in);
+    }
+    else if (cpio::is_cpio(in))
     {
         cpio::Reader reader(in);
         vector<cpio::FileInfo> file_info = reader.get_file_info();
         if (file_info.size() > 0)
         {
             // The first file is the model
-            uint32_t size = static_cast<uint32_t>(file_info[0].get_size());
+            size_t size = file_info[0].get_size();
             char* data = new char[size];
-            reader.read(file_info[0].get_name(), data, size);
+            reader.read(file_info[0], data, size);
             string jstr(data, size);
             delete[] data;
             json js = json::parse(jstr);
+            unordered_map<string, const cpio::FileInfo*> const_info;
+            for (const cpio::FileInfo& info : file_info)
+            {
+                const_info[info.get_name()] = &info;
+            }
             JSONDeserializer deserializer;
             deserializer.set_const_data_callback(
                 [&](const string& const_name, const element::Type& et, const Shape& shape) {
                     shared_ptr<Node> const_node;
-                    for (const cpio::FileInfo& info : file_info)
+                    auto it = const_info.find(const_name);
+                    if (it != const_info.end())
                     {
-                        if (info.get_name() == const_name)
-                        {
-                            void* const_data = ngraph_malloc(info.get_size());
-                            reader.read(const_name, const_data, info.get_size());
-                            const_node = make_shared<op::Constant>(et, shape, const_data);
-                            ngraph_free(const_data);
-                            break;
-                        }
+                        // Read straight into the buffer the Constant will own
+                        size_t size = it->second->get_size();
+                        auto buffer = make_shared<runtime::AlignedBuffer>(size, 64);
+                        reader.read(*it->second, buffer->get_ptr(), size);
+                        const_node = make_shared<op::Constant>(et, shape, buffer);
                     }
                     return const_node;
                 });
@@ -517,10 +659,451 @@ shared_ptr<ngraph::Function> ngraph::deserialize(istream& in)
     return rc;
 }
 
+namespace
+{
+    // A whole file mapped into memory. The mapping is private and copy-on-write, so constants
+    // can refer to it directly and passes that modify constant data do not touch the file.
+    // Where mmap is unavailable the file is read into memory instead.
+    class MappedFile
+    {
+    public:
+        MappedFile(const string& path)
+        {
+#ifndef _WIN32
+            int fd = open(path.c_str(), O_RDONLY);
+            if (fd >= 0)
+            {
+                struct stat sb;
+                if (fstat(fd, &sb) == 0 && sb.st_size > 0)
+                {
+                    void* p = mmap(nullptr,
+                                   static_cast<size_t>(sb.st_size),
+                                   PROT_READ | PROT_WRITE,
+                                   MAP_PRIVATE,
+                                   fd,
+                                   0);
+                    if (p != MAP_FAILED)
+                    {
+                        m_data = static_cast<char*>(p);
+                        m_size = static_cast<size_t>(sb.st_size);
+                        m_mapped = true;
+                    }
+                }
+                close(fd);
+            }
+#endif
+            if (!m_mapped)
+            {
+                ifstream in(path, ios_base::binary | ios_base::in);
+                m_buffer.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+                m_data = m_buffer.data();
+                m_size = m_buffer.size();
+            }
+        }
+
+        ~MappedFile()
+        {
+#ifndef _WIN32
+            if (m_mapped)
+            {
+                munmap(m_data, m_size);
+            }
+#endif
+        }
+
+        char* data() const { return m_data; }
+        size_t size() const { return m_size; }
+    private:
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        char* m_data{nullptr};
+        size_t m_size{0};
+        bool m_mapped{false};
+        vector<char> m_buffer;
+    };
+}
+
+// Deserialize a cpio file written by serialize_cpio. Constant data that is suitably aligned in
+// the file is used in place, without copying.
+static shared_ptr<Function> deserialize_mapped_cpio(const string& path)
+{
+    shared_ptr<Function> rc;
+    vector<cpio::FileInfo> file_info;
+    {
+        // Only the record headers are read here
+        cpio::Reader reader(path);
+        file_info = reader.get_file_info();
+    }
+    if (file_info.empty())
+    {
+        return rc;
+    }
+
+    auto file = make_shared<MappedFile>(path);
+    for (const cpio::FileInfo& info : file_info)
+    {
+        if (info.get_offset() + info.get_size() > file->size())
+        {
+            throw ngraph_error("Truncated cpio file " + path);
+        }
+    }
+
+    // The first file is the model
+    const char* model = file->data() + file_info[0].get_offset();
+    json js = json::parse(model, model + file_info[0].get_size());
+
+    unordered_map<string, const cpio::FileInfo*> const_info;
+    for (const cpio::FileInfo& info : file_info)
+    {
+        const_info[info.get_name()] = &info;
+    }
+    JSONDeserializer deserializer;
+    deserializer.set_const_data_callback(
+        [&](const string& const_name, const element::Type& et, const Shape& shape) {
+            shared_ptr<Node> const_node;
+            auto it = const_info.find(const_name);
+            if (it != const_info.end())
+            {
+                char* data = file->data() + it->second->get_offset();
+                size_t size = it->second->get_size();
+                if (reinterpret_cast<size_t>(data) % s_cpio_constant_alignment == 0)
+                {
+                    auto buffer =
+                        make_shared<runtime::SharedBuffer<shared_ptr<MappedFile>>>(data, size, file);
+                    const_node = make_shared<op::Constant>(et, shape, buffer);
+                }
+                else
+                {
+                    const_node = make_shared<op::Constant>(et, shape, data);
+                }
+            }
+            return const_node;
+        });
+    for (json func : js)
+    {
+        rc = deserializer.deserialize_function(func);
+    }
+    return rc;
+}
+
+namespace
+{
+    class BinaryWriter
+    {
+    public:
+        BinaryWriter(ostream& out)
+            : m_out(out)
+        {
+        }
+
+        void write(const void* data, size_t size)
+        {
+            m_out.write(static_cast<const char*>(data), size);
+            m_offset += size;
+        }
+
+        template <typename T>
+        void write_value(T value)
+        {
+            write(&value, sizeof(value));
+        }
+
+        void write_string(const string& s)
+        {
+            write_value(static_cast<uint32_t>(s.size()));
+            write(s.data(), s.size());
+        }
+
+        void write_json(const json& j)
+        {
+            vector<uint8_t> blob = json::to_msgpack(j);
+            write_value(static_cast<uint32_t>(blob.size()));
+            write(blob.data(), blob.size());
+        }
+
+        // Pad with zeros so that the next write starts at a multiple of alignment
+        void align(size_t alignment)
+        {
+            static const char zeros[s_cpio_constant_alignment] = {};
+            NGRAPH_CHECK(alignment <= s_cpio_constant_alignment, "Unsupported alignment");
+            write(zeros, (alignment - m_offset % alignment) % alignment);
+        }
+
+    private:
+        ostream& m_out;
+        size_t m_offset{0};
+    };
+
+    // Reads the binary graph format either from a stream or from a mapped file. Offsets are
+    // counted from the start of the graph so padding is skipped the same way in both cases.
+    class BinaryReader
+    {
+    public:
+        BinaryReader(istream& in)
+            : m_in(&in)
+        {
+        }
+
+        BinaryReader(const shared_ptr<MappedFile>& file)
+            : m_file(file)
+        {
+        }
+
+        void read(void* data, size_t size)
+        {
+            if (m_file)
+            {
+                check_available(size);
+                memcpy(data, m_file->data() + m_offset, size);
+            }
+            else
+            {
+                m_in->read(static_cast<char*>(data), size);
+                if (static_cast<size_t>(m_in->gcount()) != size)
+                {
+                    throw ngraph_error("Truncated binary graph");
+                }
+            }
+            m_offset += size;
+        }
+
+        template <typename T>
+        T read_value()
+        {
+            T value;
+            read(&value, sizeof(value));
+            return value;
+        }
+
+        string read_string()
+        {
+            string s(read_value<uint32_t>(), '\0');
+            read(&s[0], s.size());
+            return s;
+        }
+
+        json read_json()
+        {
+            size_t size = read_value<uint32_t>();
+            if (m_file)
+            {
+                check_available(size);
+                const uint8_t* data = reinterpret_cast<const uint8_t*>(m_file->data() + m_offset);
+                m_offset += size;
+                return json::from_msgpack(data, data + size);
+            }
+            m_blob.resize(size);
+            read(m_blob.data(), size);
+            return json::from_msgpack(m_blob);
+        }
+
+        void align(size_t alignment)
+        {
+            char pad[s_cpio_constant_alignment];
+            read(pad, (alignment - m_offset % alignment) % alignment);
+        }
+
+        // Mapped data is used in place, stream data is read straight into an aligned buffer
+        shared_ptr<runtime::AlignedBuffer> read_buffer(size_t size)
+        {
+            shared_ptr<runtime::AlignedBuffer> buffer;
+            if (m_file)
+            {
+                check_available(size);
+                char* data = m_file->data() + m_offset;
+                if (reinterpret_cast<size_t>(data) % s_cpio_constant_alignment == 0)
+                {
+                    buffer = make_shared<runtime::SharedBuffer<shared_ptr<MappedFile>>>(
+                        data, size, m_file);
+                    m_offset += size;
+                    return buffer;
+                }
+            }
+            buffer = make_shared<runtime::AlignedBuffer>(size, s_cpio_constant_alignment);
+            read(buffer->get_ptr(), size);
+            return buffer;
+        }
+
+    private:
+        void check_available(size_t size) const
+        {
+            if (m_offset + size > m_file->size())
+            {
+                throw ngraph_error("Truncated binary graph");
+            }
+        }
+
+        istream* m_in{nullptr};
+        shared_ptr<MappedFile> m_file;
+        size_t m_offset{0};
+        vector<uint8_t> m_blob;
+    };
+}
+
+// Node attributes are produced and consumed by the json serializer one node at a time, so no
+// document for the whole graph is ever built
+static void serialize_binary(BinaryWriter& writer, shared_ptr<Function> func)
+{
+    JSONSerializer serializer;
+    serializer.set_binary_constant_data(true);
+    serializer.set_require_op_serializers(true);
+    serializer.set_serialize_output_shapes(s_serialize_output_shapes_enabled);
+
+    auto ops = func->get_ordered_ops();
+    vector<string> op_table;
+    unordered_map<string, uint32_t> op_index;
+    for (auto& node : ops)
+    {
+        if (op_index.insert({node->description(), static_cast<uint32_t>(op_table.size())}).second)
+        {
+            op_table.push_back(node->description());
+        }
+    }
+
+    writer.write(s_binary_magic, sizeof(s_binary_magic));
+    writer.write_value(s_binary_version);
+    writer.write_value(static_cast<uint32_t>(op_table.size()));
+    for (const string& op : op_table)
+    {
+        writer.write_string(op);
+    }
+
+    writer.write_string(func->get_name());
+    writer.write_value(static_cast<uint64_t>(ops.size()));
+    for (auto& node : ops)
+    {
+        // Inputs precede node in topological order so serialize_node only references them
+        json node_js = serializer.serialize_node(*node);
+        node_js.erase("op");
+        writer.write_value(op_index.at(node->description()));
+        writer.write_json(node_js);
+        if (auto c = as_type_ptr<op::Constant>(node))
+        {
+            size_t size = shape_size(c->get_shape()) * c->get_element_type().size();
+            writer.write_value(static_cast<uint64_t>(size));
+            writer.align(s_cpio_constant_alignment);
+            writer.write(c->get_data_ptr(), size);
+        }
+    }
+
+    json func_js;
+    func_js["parameters"] = serializer.serialize_parameter_vector(func->get_parameters());
+    func_js["result"] = json::array();
+    for (size_t i = 0; i < func->get_output_size(); ++i)
+    {
+        func_js["result"].push_back(serializer.serialize_node_reference(*func->get_output_op(i)));
+    }
+    writer.write_json(func_js);
+}
+
+static shared_ptr<Function> deserialize_binary(BinaryReader& reader)
+{
+    char magic[sizeof(s_binary_magic)];
+    reader.read(magic, sizeof(magic));
+    if (memcmp(magic, s_binary_magic, sizeof(magic)) != 0)
+    {
+        throw ngraph_error("Not a binary graph");
+    }
+    uint32_t version = reader.read_value<uint32_t>();
+    if (version != s_binary_version)
+    {
+        throw ngraph_error("Unsupported binary graph version " + to_string(version));
+    }
+
+    vector<string> op_table(reader.read_value<uint32_t>());
+    for (string& op : op_table)
+    {
+        op = reader.read_string();
+    }
+
+    shared_ptr<runtime::AlignedBuffer> constant_data;
+    JSONDeserializer deserializer;
+    deserializer.set_const_data_callback(
+        [&](const string& const_name, const element::Type& et, const Shape& shape) {
+            shared_ptr<Node> const_node;
+            if (constant_data)
+            {
+                const_node = make_shared<op::Constant>(et, shape, constant_data);
+                constant_data.reset();
+            }
+            return const_node;
+        });
+
+    string name = reader.read_string();
+    uint64_t node_count = reader.read_value<uint64_t>();
+    for (uint64_t i = 0; i < node_count; ++i)
+    {
+        uint32_t index = reader.read_value<uint32_t>();
+        if (index >= op_table.size())
+        {
+            throw ngraph_error("Invalid op table index in binary graph");
+        }
+        json node_js = reader.read_json();
+        node_js["op"] = op_table[index];
+        if (op_table[index] == "Constant")
+        {
+            size_t size = reader.read_value<uint64_t>();
+            reader.align(s_cpio_constant_alignment);
+            constant_data = reader.read_buffer(size);
+        }
+        deserializer.deserialize_node(node_js);
+    }
+
+    json func_js = reader.read_json();
+    func_js["name"] = name;
+    func_js["ops"] = json::array();
+    return deserializer.deserialize_function(func_js);
+}
+
+static bool is_binary_graph(istream& in)
+{
+    char magic[sizeof(s_binary_magic)];
+    auto offset = in.tellg();
+    in.read(magic, sizeof(magic));
+    bool rc = (in.gcount() == sizeof(magic) && memcmp(magic, s_binary_magic, sizeof(magic)) == 0);
+    in.clear();
+    in.seekg(offset);
+    return rc;
+}
+
+static bool is_binary_graph(const string& path)
+{
+    ifstream in(path, ios_base::binary | ios_base::in);
+    return is_binary_graph(in);
+}
+
+static shared_ptr<Function> deserialize_binary(istream& in)
+{
+    BinaryReader reader(in);
+    return deserialize_binary(reader);
+}
+
+void ngraph::serialize_binary(const string& path, shared_ptr<ngraph::Function> func)
+{
+    ofstream out(path, ios_base::binary | ios_base::out);
+    serialize_binary(out, func);
+}
+
+void ngraph::serialize_binary(ostream& out, shared_ptr<ngraph::Function> func)
+{
+    BinaryWriter writer(out);
+    ::serialize_binary(writer, func);
+}
+
 shared_ptr<ngraph::Function> ngraph::deserialize(const string& s)
 {
     shared_ptr<Function> rc;
-    if (file_util::exists(s))
+    if (file_util::exists(s) && is_binary_graph(s))
+    {
+        BinaryReader reader(make_shared<MappedFile>(s));
+        rc = deserialize_binary(reader);
+    }
+    else if (file_util::exists(s) && cpio::is_cpio(s))
+    {
+        rc = deserialize_mapped_cpio(s);
+    }
+    else if (file_util::exists(s))
     {
         // s is a file and not a json string
         ifstream in(s, ios_base::binary | ios_base::in);
@@ -551,7 +1134,10 @@ json JSONSerializer::serialize_parameter_vector(const ParameterVector& parameter
 json JSONSerializer::serialize_function(const Function& f)
 {
     json function;
-    function["name"] = f.get_name();
+    if (!m_anonymous)
+    {
+        function["name"] = f.get_name();
+    }
     function["parameters"] = serialize_parameter_vector(f.get_parameters());
 
     // TODO Functions can return multiple results
@@ -953,8 +1539,19 @@ shared_ptr<Node> JSONDeserializer::deserialize_node(json node_js)
                 has_key(node_js, "element_type") ? node_js : node_js.at("value_type");
             auto element_type = read_element_type(type_node_js.at("element_type"));
             auto shape = type_node_js.at("shape");
-            auto value = node_js.at("value").get<vector<string>>();
-            node = make_shared<op::Constant>(element_type, shape, value);
+            if (!has_key(node_js, "value") && m_const_data_callback)
+            {
+                node = m_const_data_callback(node_name, element_type, shape);
+                if (!node)
+                {
+                    throw ngraph_error("Missing data for constant " + node_name);
+                }
+            }
+            else
+            {
+                auto value = node_js.at("value").get<vector<string>>();
+                node = make_shared<op::Constant>(element_type, shape, value);
+            }
             break;
         }
         case OP_TYPEID::Convert:
@@ -1806,7 +2403,9 @@ shared_ptr<Node> JSONDeserializer::deserialize_node(json node_js)
         {
             if (op_version == 0)
             {
-                auto reduction_axes = deserialize_axis_set(node_js.at("reduction_axes"));
+                // Graphs written by serialize() carry the axes as a Constant input
+                auto reduction_axes = deserialize_axis_set(
+                    get_or_default<json>(node_js, "reduction_axes", json::array()));
                 if (reduction_axes.empty())
                     node = make_shared<op::v0::Product>(args[0], args[1]);
                 else
@@ -2116,7 +2715,9 @@ shared_ptr<Node> JSONDeserializer::deserialize_node(json node_js)
         {
             if (op_version == 0)
             {
-                auto reduction_axes = deserialize_axis_set(node_js.at("reduction_axes"));
+                // Graphs written by serialize() carry the axes as a Constant input
+                auto reduction_axes = deserialize_axis_set(
+                    get_or_default<json>(node_js, "reduction_axes", json::array()));
                 if (reduction_axes.empty())
                     node = make_shared<op::v0::Sum>(args[0], args[1]);
                 else
@@ -2189,9 +2790,16 @@ shared_ptr<Node> JSONDeserializer::deserialize_node(json node_js)
         }
         case OP_TYPEID::UnknownOp:
         {
-            stringstream ss;
-            ss << "unsupported op " << node_op;
-            throw runtime_error(ss.str());
+            OpSerializer op_serializer;
+            if (!find_op_serializer(node_op, op_serializer))
+            {
+                stringstream ss;
+                ss << "unsupported op " << node_op;
+                throw runtime_error(ss.str());
+            }
+            node = op_serializer.reader(
+                args, get_or_default<json>(node_js, "attributes", json::object()).dump());
+            break;
         }
         }
 #if defined(__GNUC__) && !(__GNUC__ == 4 && __GNUC_MINOR__ == 8)
@@ -2260,6 +2868,20 @@ json JSONSerializer::serialize_node_reference(const Node& n)
             }
         }
     }
+    return node_name(n);
+}
+
+json JSONSerializer::node_name(const Node& n)
+{
+    if (m_anonymous)
+    {
+        auto it = m_node_ids.find(&n);
+        if (it == m_node_ids.end())
+        {
+            it = m_node_ids.insert({&n, m_node_ids.size()}).first;
+        }
+        return it->second;
+    }
     return n.get_name();
 }
 
@@ -2294,11 +2916,11 @@ json JSONSerializer::serialize_node(const Node& n)
 {
     m_nodes_serialized.insert(&n);
     json node;
-    node["name"] = n.get_name();
+    node["name"] = node_name(n);
     auto op_version = n.get_version();
     node["op_version"] = op_version;
 
-    if (n.get_name() != n.get_friendly_name())
+    if (!m_anonymous && n.get_name() != n.get_friendly_name())
     {
         node["friendly_name"] = n.get_friendly_name();
     }
@@ -2316,9 +2938,12 @@ json JSONSerializer::serialize_node(const Node& n)
     {
         control_deps.push_back(serialize_node_reference(*cdep));
     }
-    for (auto& output : n.outputs())
+    if (!m_anonymous)
     {
-        outputs.push_back(output.get_tensor().get_name());
+        for (auto& output : n.outputs())
+        {
+            outputs.push_back(output.get_tensor().get_name());
+        }
     }
 
     if (!inputs.empty())
@@ -2343,7 +2968,7 @@ json JSONSerializer::serialize_node(const Node& n)
         }
         node["output_shapes"] = output_shapes;
     }
-    if (ngraph::get_provenance_enabled())
+    if (!m_anonymous && ngraph::get_provenance_enabled())
     {
         json provenance_tags = json::array();
         for (auto prov_tag : n.get_provenance_tags())
@@ -2524,7 +3149,17 @@ json JSONSerializer::serialize_node(const Node& n)
     case OP_TYPEID::Constant:
     {
         auto tmp = dynamic_cast<const op::Constant*>(&n);
-        if (tmp->are_all_data_elements_bitwise_identical() && shape_size(tmp->get_shape()) > 0)
+        if (m_anonymous)
+        {
+            node["value"] = digest(tmp->get_data_ptr(),
+                                   shape_size(tmp->get_shape()) * tmp->get_element_type().size());
+        }
+        else if (m_binary_constant_data)
+        {
+            // The data is written as a separate cpio record named after the node
+        }
+        else if (tmp->are_all_data_elements_bitwise_identical() &&
+                 shape_size(tmp->get_shape()) > 0)
         {
             vector<string> vs;
             vs.push_back(tmp->convert_value_to_string(0));
@@ -3370,7 +4005,24 @@ json JSONSerializer::serialize_node(const Node& n)
         }
         break;
     }
-    case OP_TYPEID::UnknownOp: { break;
+    case OP_TYPEID::UnknownOp:
+    {
+        OpSerializer op_serializer;
+        if (find_op_serializer(node_op, op_serializer))
+        {
+            string attributes = op_serializer.writer(n);
+            if (!attributes.empty())
+            {
+                node["attributes"] = json::parse(attributes);
+            }
+        }
+        else if (m_require_op_serializers)
+        {
+            // The attributes of the op are unknown, so it could be neither hashed safely nor
+            // created again when loading
+            throw unsupported_op("no serializer is registered for op " + node_op);
+        }
+        break;
     }
     }
 #if !(defined(__GNUC__) && (__GNUC__ == 4 && __GNUC_MINOR__ == 8))
@@ -16,7 +16,9 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
+#include <string>
 
 #include "ngraph/function.hpp"
 #include "ngraph/node.hpp"
@@ -48,14 +50,91 @@ namespace ngraph
     ///    indent level specified.
     void serialize(std::ostream& out, std::shared_ptr<ngraph::Function> func, size_t indent = 0);
 
+    /// \brief Serialize a Function to a cpio archive
+    ///
+    /// The first record holds the json graph and every Constant's data is stored as a separate
+    /// binary record, aligned so that `deserialize(path)` can memory map the file and use the
+    /// data in place.
+    /// \param path The path to the output file
+    /// \param func The Function to serialize
+    /// \param indent Indentation of the json record, as for `serialize`
+    /// \throws unsupported_op if func contains an op that is not in the op tables and has no
+    ///    serializer registered with register_op_serializer
+    void serialize_cpio(const std::string& path,
+                        std::shared_ptr<ngraph::Function> func,
+                        size_t indent = 0);
+
+    /// \brief Serialize a Function to a cpio archive written to a stream
+    /// \param out The output stream to which the data is serialized.
+    /// \param func The Function to serialize
+    /// \param indent Indentation of the json record, as for `serialize`
+    /// \throws unsupported_op if func contains an op that is not in the op tables and has no
+    ///    serializer registered with register_op_serializer
+    void serialize_cpio(std::ostream& out,
+                        std::shared_ptr<ngraph::Function> func,
+                        size_t indent = 0);
+
+    /// \brief Serialize a Function to a binary file
+    ///
+    /// The binary format is written and read one node at a time without building a json
+    /// document for the whole graph, and Constant data is stored aligned so that
+    /// `deserialize(path)` can memory map the file and use the data in place.
+    /// \param path The path to the output file
+    /// \param func The Function to serialize
+    /// \throws unsupported_op if func contains an op that is not in the op tables and has no
+    ///    serializer registered with register_op_serializer
+    void serialize_binary(const std::string& path, std::shared_ptr<ngraph::Function> func);
+
+    /// \brief Serialize a Function in the binary format to a stream
+    /// \param out The output stream to which the data is serialized.
+    /// \param func The Function to serialize
+    /// \throws unsupported_op if func contains an op that is not in the op tables and has no
+    ///    serializer registered with register_op_serializer
+    void serialize_binary(std::ostream& out, std::shared_ptr<ngraph::Function> func);
+
     /// \brief Deserialize a Function
     /// \param in An isteam to the input data
     std::shared_ptr<ngraph::Function> deserialize(std::istream& in);
 
     /// \brief Deserialize a Function
-    /// \param str The json formatted string to deseriailze.
+    /// \param str The json formatted string to deseriailze, or the path of a json, cpio or binary
+    ///    file. cpio and binary files are memory mapped and Constant data is used in place
+    ///    rather than copied.
     std::shared_ptr<ngraph::Function> deserialize(const std::string& str);
 
+    /// \brief Serialize the structure of a Function
+    /// \param func The Function to serialize
+    /// \returns A json string of the op types, op versions, attributes, element types,
+    ///    parameter shapes and graph connectivity of func, with a 128 bit digest in place of
+    ///    the data of each Constant. Node, tensor and function names are left out. Functions
+    ///    that differ only in names have equal structures, but equal structures do not prove
+    ///    equal constant data; compare the Constants themselves when that matters.
+    /// \throws unsupported_op if func contains an op whose attributes cannot be serialized
+    std::string serialize_structure(std::shared_ptr<ngraph::Function> func);
+
+    /// \brief Compute a content hash of a Function
+    /// \param func The Function to hash
+    /// \returns A 32 digit hex digest of serialize_structure(func). Structurally identical
+    ///    Functions hash equal, but equal hashes are not proof of identical structure.
+    /// \throws unsupported_op if func contains an op whose attributes cannot be serialized
+    std::string hash_function(std::shared_ptr<ngraph::Function> func);
+
+    /// \brief Returns the attributes of a node as json text
+    using op_attributes_writer_t = std::function<std::string(const Node& node)>;
+    /// \brief Creates a node from its arguments and the json text written by the matching
+    ///        op_attributes_writer_t
+    using op_attributes_reader_t = std::function<std::shared_ptr<Node>(
+        const OutputVector& args, const std::string& attributes)>;
+
+    /// \brief Registers how to serialize an op that is not in the core op tables, such as an op
+    ///        added by a backend, so that graphs containing it can be saved, loaded and hashed.
+    /// \param op_name The description() of the op
+    /// \param writer Writes the attributes of a node of the op
+    /// \param reader Creates a node of the op
+    void register_op_serializer(const std::string& op_name,
+                                op_attributes_writer_t writer,
+                                op_attributes_reader_t reader);
+
     /// \brief If enabled adds output shapes to the serialized graph
     /// \param enable Set to true to enable or false otherwise
     ///
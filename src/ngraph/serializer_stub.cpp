@@ -33,6 +33,30 @@ void ngraph::serialize(std::ostream& out, std::shared_ptr<ngraph::Function> func
     throw std::runtime_error("serializer disabled in build");
 }
 
+void ngraph::serialize_cpio(const std::string& path,
+                            std::shared_ptr<ngraph::Function> func,
+                            size_t indent)
+{
+    throw std::runtime_error("serializer disabled in build");
+}
+
+void ngraph::serialize_cpio(std::ostream& out,
+                            std::shared_ptr<ngraph::Function> func,
+                            size_t indent)
+{
+    throw std::runtime_error("serializer disabled in build");
+}
+
+void ngraph::serialize_binary(const std::string& path, std::shared_ptr<ngraph::Function> func)
+{
+    throw std::runtime_error("serializer disabled in build");
+}
+
+void ngraph::serialize_binary(std::ostream& out, std::shared_ptr<ngraph::Function> func)
+{
+    throw std::runtime_error("serializer disabled in build");
+}
+
 std::shared_ptr<ngraph::Function> ngraph::deserialize(std::istream& in)
 {
     throw std::runtime_error("serializer disabled in build");
@@ -43,6 +67,23 @@ std::shared_ptr<ngraph::Function> ngraph::deserialize(const std::string& str)
     throw std::runtime_error("serializer disabled in build");
 }
 
+std::string ngraph::serialize_structure(std::shared_ptr<ngraph::Function> func)
+{
+    throw std::runtime_error("serializer disabled in build");
+}
+
+std::string ngraph::hash_function(std::shared_ptr<ngraph::Function> func)
+{
+    throw std::runtime_error("serializer disabled in build");
+}
+
+void ngraph::register_op_serializer(const std::string& op_name,
+                                    op_attributes_writer_t writer,
+                                    op_attributes_reader_t reader)
+{
+    // Nothing is serialized, so there is nothing to register
+}
+
 void ngraph::set_serialize_output_shapes(bool enable)
 {
     throw std::runtime_error("serializer disabled in build");
@@ -227,7 +227,8 @@ namespace ngraph
     FpropCache cache_fprop(std::shared_ptr<Function> fprop, std::shared_ptr<Function> bprop);
 
     // NodeExecutors are used in compiler optimization passes like ConstantFolding to execute a node
-    // using the supplied input and output memory locations.
+    // using the supplied input and output memory locations. The inputs are often the data of
+    // Constants, which may be shared with other Constants, so a NodeExecutor must only read them.
     // A BuildNodeExecutor returns a backend-specific NodeExecutor for a given Node type
     using NodeExecutorTy =
         std::function<void(const std::vector<void*>& inputs, std::vector<void*>& outputs)>;
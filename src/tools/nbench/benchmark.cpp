@@ -14,7 +14,10 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <chrono>
+
 #include "benchmark.hpp"
+#include "benchmark_sweep.hpp"
 #include "benchmark_utils.hpp"
 #include "ngraph/file_util.hpp"
 #include "ngraph/runtime/backend.hpp"
@@ -78,12 +81,14 @@ vector<runtime::PerformanceCounter> run_benchmark(shared_ptr<Function> f,
     }
 
     stopwatch t1;
+    vector<double> latencies_ms;
     for (size_t i = 0; i < iterations + warmup_iterations; i++)
     {
         if (i == warmup_iterations)
         {
             t1.start();
         }
+        auto call_start = chrono::steady_clock::now();
         if (copy_data)
         {
             for (size_t arg_index = 0; arg_index < args.size(); arg_index++)
@@ -108,10 +113,17 @@ vector<runtime::PerformanceCounter> run_benchmark(shared_ptr<Function> f,
                              data->get_element_count() * data->get_element_type().size());
             }
         }
+        if (i >= warmup_iterations)
+        {
+            latencies_ms.push_back(
+                chrono::duration<double, milli>(chrono::steady_clock::now() - call_start)
+                    .count());
+        }
     }
     t1.stop();
     float time = t1.get_milliseconds();
     cout << time / iterations << "ms per iteration" << endl;
+    print_latency_stats(get_latency_stats(latencies_ms, time));
 
     vector<runtime::PerformanceCounter> perf_data = exec->get_performance_data();
     return perf_data;
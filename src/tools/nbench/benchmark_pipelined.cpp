@@ -15,9 +15,7 @@
 //*****************************************************************************
 
 #include <array>
-#include <condition_variable>
-#include <mutex>
-#include <thread>
+#include <future>
 
 #include "benchmark.hpp"
 #include "benchmark_utils.hpp"
@@ -43,67 +41,33 @@ public:
 private:
 };
 
-static mutex s_mutex;
-static condition_variable s_condition;
-static size_t current_iteration = 0;
-static size_t s_iterations;
-static size_t s_warmup_iterations;
-static stopwatch s_timer;
-
-static void
-    thread_entry(runtime::Executable* exec, const TensorCollection& tensors, size_t pipeline_stage)
+static void write_inputs(const TensorCollection& tensors)
 {
-    bool data_written = false;
     const vector<shared_ptr<runtime::Tensor>>& args = tensors.input_tensors;
-    const vector<shared_ptr<runtime::Tensor>>& results = tensors.output_tensors;
-    while (current_iteration < s_iterations + s_warmup_iterations)
+    for (size_t arg_index = 0; arg_index < args.size(); arg_index++)
     {
-        if (!data_written)
-        {
-            for (size_t arg_index = 0; arg_index < args.size(); arg_index++)
-            {
-                const shared_ptr<runtime::Tensor>& arg = args[arg_index];
-                if (arg->get_stale())
-                {
-                    const shared_ptr<runtime::HostTensor>& data = tensors.parameter_data[arg_index];
-                    arg->write(data->get_data_ptr(),
-                               data->get_element_count() * data->get_element_type().size());
-                }
-            }
-            data_written = true;
-        }
-        unique_lock<mutex> lock(s_mutex);
-        if ((current_iteration & 1) != pipeline_stage)
-        {
-            s_condition.wait(lock);
-        }
-        else
+        const shared_ptr<runtime::Tensor>& arg = args[arg_index];
+        if (arg->get_stale())
         {
-            if (current_iteration == s_warmup_iterations)
-            {
-                s_timer.start();
-            }
-            // our turn to run
-            exec->call(results, args);
-            current_iteration++;
-            data_written = false;
-            s_condition.notify_all();
-            lock.unlock();
-            for (size_t result_index = 0; result_index < results.size(); result_index++)
-            {
-                const shared_ptr<runtime::HostTensor>& data = tensors.result_data[result_index];
-                const shared_ptr<runtime::Tensor>& result = results[result_index];
-                result->read(data->get_data_ptr(),
-                             data->get_element_count() * data->get_element_type().size());
-            }
-            if (current_iteration == (s_iterations + s_warmup_iterations - 1))
-            {
-                s_timer.stop();
-            }
+            const shared_ptr<runtime::HostTensor>& data = tensors.parameter_data[arg_index];
+            arg->write(data->get_data_ptr(),
+                       data->get_element_count() * data->get_element_type().size());
         }
     }
 }
 
+static void read_outputs(const TensorCollection& tensors)
+{
+    const vector<shared_ptr<runtime::Tensor>>& results = tensors.output_tensors;
+    for (size_t result_index = 0; result_index < results.size(); result_index++)
+    {
+        const shared_ptr<runtime::HostTensor>& data = tensors.result_data[result_index];
+        const shared_ptr<runtime::Tensor>& result = results[result_index];
+        result->read(data->get_data_ptr(),
+                     data->get_element_count() * data->get_element_type().size());
+    }
+}
+
 vector<runtime::PerformanceCounter> run_benchmark_pipelined(shared_ptr<Function> f,
                                                             const string& backend_name,
                                                             size_t iterations,
@@ -112,8 +76,6 @@ vector<runtime::PerformanceCounter> run_benchmark_pipelined(shared_ptr<Function>
                                                             bool /* copy_data */)
 {
     constexpr size_t pipeline_depth = 2;
-    s_iterations = iterations;
-    s_warmup_iterations = warmup_iterations;
     array<TensorCollection, pipeline_depth> tensor_collections;
     stopwatch timer;
     timer.start();
@@ -148,7 +110,6 @@ vector<runtime::PerformanceCounter> run_benchmark_pipelined(shared_ptr<Function>
     }
 
     // Create input tensors for all Parameters
-    array<vector<shared_ptr<runtime::Tensor>>, pipeline_depth> input_tensors_array;
     size_t input_index = 0;
     for (shared_ptr<op::Parameter> param : f->get_parameters())
     {
@@ -160,7 +121,6 @@ vector<runtime::PerformanceCounter> run_benchmark_pipelined(shared_ptr<Function>
     }
 
     // Create output tensors for all Results
-    array<vector<shared_ptr<runtime::Tensor>>, pipeline_depth> output_tensors_array;
     size_t output_index = 0;
     for (shared_ptr<Node> result : f->get_results())
     {
@@ -171,17 +131,38 @@ vector<runtime::PerformanceCounter> run_benchmark_pipelined(shared_ptr<Function>
         }
     }
 
-    thread threads[pipeline_depth];
-    for (size_t i = 0; i < pipeline_depth; i++)
+    // Each pipeline stage owns one set of tensors. While the call for one stage runs, the
+    // host reads the results of the previous call on the next stage and stages its inputs.
+    array<future<bool>, pipeline_depth> in_flight;
+    stopwatch run_timer;
+    size_t total_iterations = iterations + warmup_iterations;
+    for (size_t iteration = 0; iteration < total_iterations; iteration++)
     {
-        threads[i] = thread(thread_entry, exec.get(), tensor_collections[i], i);
+        size_t stage = iteration % pipeline_depth;
+        TensorCollection& tensors = tensor_collections[stage];
+        if (in_flight[stage].valid())
+        {
+            in_flight[stage].get();
+            read_outputs(tensors);
+        }
+        if (iteration == static_cast<size_t>(warmup_iterations))
+        {
+            run_timer.start();
+        }
+        write_inputs(tensors);
+        in_flight[stage] = exec->begin_call(tensors.output_tensors, tensors.input_tensors);
     }
-
     for (size_t i = 0; i < pipeline_depth; i++)
     {
-        threads[i].join();
+        size_t stage = (total_iterations + i) % pipeline_depth;
+        if (in_flight[stage].valid())
+        {
+            in_flight[stage].get();
+            read_outputs(tensor_collections[stage]);
+        }
     }
-    float time = s_timer.get_milliseconds();
+    run_timer.stop();
+    float time = run_timer.get_milliseconds();
     cout << time / iterations << "ms per iteration" << endl;
 
     vector<runtime::PerformanceCounter> perf_data = exec->get_performance_data();
@@ -0,0 +1,351 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+#include "benchmark_sweep.hpp"
+#include "benchmark_utils.hpp"
+#include "ngraph/except.hpp"
+#include "ngraph/graph_util.hpp"
+#include "ngraph/runtime/backend.hpp"
+#include "ngraph/runtime/host_tensor.hpp"
+#include "ngraph/specialize_function.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+namespace
+{
+    // The tensors of one calling thread
+    struct CallerTensors
+    {
+        vector<shared_ptr<runtime::HostTensor>> arg_data;
+        vector<shared_ptr<runtime::Tensor>> args;
+        vector<shared_ptr<runtime::HostTensor>> result_data;
+        vector<shared_ptr<runtime::Tensor>> results;
+    };
+
+    CallerTensors make_caller_tensors(runtime::Backend& backend, const Function& f)
+    {
+        CallerTensors tensors;
+        for (const shared_ptr<op::Parameter>& param : f.get_parameters())
+        {
+            auto tensor = backend.create_tensor(param->get_element_type(), param->get_shape());
+            auto data =
+                make_shared<runtime::HostTensor>(param->get_element_type(), param->get_shape());
+            random_init(data);
+            tensor->write(data->get_data_ptr(),
+                          data->get_element_count() * data->get_element_type().size());
+            tensors.args.push_back(tensor);
+            tensors.arg_data.push_back(data);
+        }
+        for (const shared_ptr<op::Result>& result : f.get_results())
+        {
+            tensors.results.push_back(
+                backend.create_tensor(result->get_element_type(), result->get_shape()));
+            tensors.result_data.push_back(make_shared<runtime::HostTensor>(
+                result->get_element_type(), result->get_shape()));
+        }
+        return tensors;
+    }
+
+    void call(runtime::Executable& exec, CallerTensors& tensors, bool copy_data)
+    {
+        if (copy_data)
+        {
+            for (size_t i = 0; i < tensors.args.size(); i++)
+            {
+                if (tensors.args[i]->get_stale())
+                {
+                    const shared_ptr<runtime::HostTensor>& data = tensors.arg_data[i];
+                    tensors.args[i]->write(data->get_data_ptr(),
+                                           data->get_element_count() *
+                                               data->get_element_type().size());
+                }
+            }
+        }
+        exec.call(tensors.results, tensors.args);
+        if (copy_data)
+        {
+            for (size_t i = 0; i < tensors.results.size(); i++)
+            {
+                const shared_ptr<runtime::HostTensor>& data = tensors.result_data[i];
+                tensors.results[i]->read(data->get_data_ptr(),
+                                         data->get_element_count() *
+                                             data->get_element_type().size());
+            }
+        }
+    }
+
+    // Runs iterations calls on each of threads threads at once
+    LatencyStats run_concurrent(runtime::Executable& exec,
+                                vector<CallerTensors>& callers,
+                                size_t iterations,
+                                bool copy_data)
+    {
+        size_t thread_count = callers.size();
+        vector<vector<double>> latencies(thread_count);
+        atomic<size_t> ready{0};
+        atomic<bool> go{false};
+        vector<thread> threads;
+        for (size_t t = 0; t < thread_count; t++)
+        {
+            threads.emplace_back([&, t]() {
+                // The denormal mode is per thread
+                set_denormals_flush_to_zero();
+                latencies[t].reserve(iterations);
+                ready++;
+                while (!go)
+                {
+                    this_thread::yield();
+                }
+                for (size_t i = 0; i < iterations; i++)
+                {
+                    auto start = chrono::steady_clock::now();
+                    call(exec, callers[t], copy_data);
+                    latencies[t].push_back(
+                        chrono::duration<double, milli>(chrono::steady_clock::now() - start)
+                            .count());
+                }
+            });
+        }
+        while (ready < thread_count)
+        {
+            this_thread::yield();
+        }
+        auto start = chrono::steady_clock::now();
+        go = true;
+        for (thread& t : threads)
+        {
+            t.join();
+        }
+        double wall_ms =
+            chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        vector<double> all_latencies;
+        for (const vector<double>& thread_latencies : latencies)
+        {
+            all_latencies.insert(
+                all_latencies.end(), thread_latencies.begin(), thread_latencies.end());
+        }
+        return get_latency_stats(all_latencies, wall_ms);
+    }
+
+    string batch_size_name(size_t batch_size)
+    {
+        return batch_size == 0 ? "model" : to_string(batch_size);
+    }
+}
+
+LatencyStats get_latency_stats(vector<double> latencies_ms, double wall_ms)
+{
+    LatencyStats stats;
+    stats.calls = latencies_ms.size();
+    if (latencies_ms.empty())
+    {
+        return stats;
+    }
+    sort(latencies_ms.begin(), latencies_ms.end());
+    // Nearest rank, so a percentile is always a latency that was measured
+    auto percentile = [&](double p) {
+        size_t rank = static_cast<size_t>(ceil(p / 100 * latencies_ms.size()));
+        return latencies_ms[max<size_t>(rank, 1) - 1];
+    };
+    double total_ms = 0;
+    for (double latency : latencies_ms)
+    {
+        total_ms += latency;
+    }
+    stats.calls_per_second = wall_ms > 0 ? stats.calls * 1000 / wall_ms : 0;
+    stats.mean_ms = total_ms / stats.calls;
+    stats.p50_ms = percentile(50);
+    stats.p90_ms = percentile(90);
+    stats.p99_ms = percentile(99);
+    stats.p999_ms = percentile(99.9);
+    stats.max_ms = latencies_ms.back();
+    return stats;
+}
+
+void print_latency_stats(const LatencyStats& stats)
+{
+    cout << fixed << setprecision(3) << "latency ms: mean " << stats.mean_ms << ", p50 "
+         << stats.p50_ms << ", p90 " << stats.p90_ms << ", p99 " << stats.p99_ms << ", p99.9 "
+         << stats.p999_ms << ", max " << stats.max_ms << endl;
+    cout.unsetf(ios_base::floatfield);
+}
+
+shared_ptr<Function> set_batch_size(shared_ptr<Function> f, size_t batch_size)
+{
+    const ParameterVector& params = f->get_parameters();
+    if (params.empty() || params[0]->get_shape().empty())
+    {
+        throw ngraph_error("The first parameter of the model has no batch axis");
+    }
+    size_t model_batch_size = params[0]->get_shape()[0];
+
+    // specialize_function can only refine shapes, so relax the batch axis of a clone first
+    shared_ptr<Function> relaxed = clone_function(*f);
+    vector<element::Type> types;
+    vector<PartialShape> shapes;
+    for (const shared_ptr<op::Parameter>& param : relaxed->get_parameters())
+    {
+        Shape shape = param->get_shape();
+        types.push_back(param->get_element_type());
+        if (!shape.empty() && shape[0] == model_batch_size)
+        {
+            PartialShape relaxed_shape(shape);
+            relaxed_shape[0] = Dimension::dynamic();
+            param->set_partial_shape(relaxed_shape);
+            shape[0] = batch_size;
+        }
+        shapes.push_back(shape);
+    }
+    relaxed->validate_nodes_and_infer_types();
+    return specialize_function(relaxed, types, shapes, vector<void*>(params.size(), nullptr));
+}
+
+vector<SweepResult> run_benchmark_sweep(const string& model,
+                                        shared_ptr<Function> f,
+                                        const string& backend_name,
+                                        size_t iterations,
+                                        size_t warmup_iterations,
+                                        const vector<size_t>& batch_sizes,
+                                        size_t max_threads,
+                                        bool copy_data)
+{
+    auto backend = runtime::Backend::create(backend_name);
+    vector<SweepResult> results;
+    cout << setw(8) << "batch" << setw(9) << "threads" << setw(12) << "calls/s" << setw(11)
+         << "mean ms" << setw(11) << "p50" << setw(11) << "p90" << setw(11) << "p99"
+         << setw(11) << "p99.9" << setw(11) << "max" << endl;
+    for (size_t batch_size : batch_sizes)
+    {
+        shared_ptr<runtime::Executable> exec;
+        shared_ptr<Function> batched;
+        try
+        {
+            batched = (batch_size == 0 ? f : set_batch_size(f, batch_size));
+            exec = backend->compile(batched);
+        }
+        catch (const exception& e)
+        {
+            cout << "Batch size " << batch_size << " skipped: " << e.what() << endl;
+            continue;
+        }
+
+        for (size_t threads = 1; threads <= max_threads; threads++)
+        {
+            vector<CallerTensors> callers;
+            for (size_t t = 0; t < threads; t++)
+            {
+                callers.push_back(make_caller_tensors(*backend, *batched));
+                for (size_t i = 0; i < warmup_iterations; i++)
+                {
+                    call(*exec, callers.back(), copy_data);
+                }
+            }
+
+            SweepResult result{model,
+                               batch_size,
+                               threads,
+                               run_concurrent(*exec, callers, iterations, copy_data)};
+            const LatencyStats& s = result.latency;
+            cout << fixed << setprecision(3) << setw(8) << batch_size_name(batch_size)
+                 << setw(9) << threads << setw(12) << setprecision(1) << s.calls_per_second
+                 << setprecision(3) << setw(11) << s.mean_ms << setw(11) << s.p50_ms
+                 << setw(11) << s.p90_ms << setw(11) << s.p99_ms << setw(11) << s.p999_ms
+                 << setw(11) << s.max_ms << endl;
+            cout.unsetf(ios_base::floatfield);
+            results.push_back(result);
+        }
+    }
+    return results;
+}
+
+// The model is a path, which may hold quotes, backslashes or control characters
+static string json_quote(const string& str)
+{
+    ostringstream out;
+    out << '"';
+    for (char c : str)
+    {
+        if (c == '"' || c == '\\')
+        {
+            out << '\\' << c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20)
+        {
+            out << "\\u" << hex << setw(4) << setfill('0') << static_cast<int>(c);
+        }
+        else
+        {
+            out << c;
+        }
+    }
+    out << '"';
+    return out.str();
+}
+
+static string csv_quote(const string& str)
+{
+    string quoted = "\"";
+    for (char c : str)
+    {
+        if (c == '"')
+        {
+            quoted += '"';
+        }
+        quoted += c;
+    }
+    quoted += '"';
+    return quoted;
+}
+
+void write_sweep_json(ostream& out, const vector<SweepResult>& results)
+{
+    out << "[";
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const SweepResult& r = results[i];
+        const LatencyStats& s = r.latency;
+        out << (i == 0 ? "\n" : ",\n") << R"(  {"model": )" << json_quote(r.model)
+            << R"(, "batch_size": )" << r.batch_size << R"(, "threads": )" << r.threads
+            << R"(, "calls": )" << s.calls << R"(, "calls_per_second": )" << s.calls_per_second
+            << R"(, "mean_ms": )" << s.mean_ms << R"(, "p50_ms": )" << s.p50_ms
+            << R"(, "p90_ms": )" << s.p90_ms << R"(, "p99_ms": )" << s.p99_ms
+            << R"(, "p99.9_ms": )" << s.p999_ms << R"(, "max_ms": )" << s.max_ms << "}";
+    }
+    out << "\n]\n";
+}
+
+void write_sweep_csv(ostream& out, const vector<SweepResult>& results)
+{
+    out << "model,batch_size,threads,calls,calls_per_second,mean_ms,p50_ms,p90_ms,p99_ms,"
+           "p99.9_ms,max_ms\n";
+    for (const SweepResult& r : results)
+    {
+        const LatencyStats& s = r.latency;
+        out << csv_quote(r.model) << "," << r.batch_size << "," << r.threads << "," << s.calls
+            << "," << s.calls_per_second << "," << s.mean_ms << "," << s.p50_ms << ","
+            << s.p90_ms << "," << s.p99_ms << "," << s.p999_ms << "," << s.max_ms << "\n";
+    }
+}
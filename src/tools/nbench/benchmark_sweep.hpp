@@ -0,0 +1,73 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ngraph/function.hpp"
+
+/// \brief The latency distribution and throughput of a set of calls
+struct LatencyStats
+{
+    size_t calls = 0;
+    double calls_per_second = 0;
+    double mean_ms = 0;
+    double p50_ms = 0;
+    double p90_ms = 0;
+    double p99_ms = 0;
+    double p999_ms = 0;
+    double max_ms = 0;
+};
+
+/// \param latencies_ms The latency of each call
+/// \param wall_ms The time from the first call starting to the last call finishing
+LatencyStats get_latency_stats(std::vector<double> latencies_ms, double wall_ms);
+
+void print_latency_stats(const LatencyStats& stats);
+
+struct SweepResult
+{
+    std::string model;
+    /// 0 when the model was run with its own batch size
+    size_t batch_size;
+    size_t threads;
+    LatencyStats latency;
+};
+
+/// \brief A clone of f with axis 0 of its batched parameters set to batch_size. Parameters are
+///        batched when their axis 0 has the same size as that of the first parameter.
+/// \throws ngraph_error if the ops of f do not accept the new batch size
+std::shared_ptr<ngraph::Function> set_batch_size(std::shared_ptr<ngraph::Function> f,
+                                                 size_t batch_size);
+
+/// \brief Runs f with every combination of the batch sizes and 1..max_threads threads that
+///        call it concurrently, each with its own tensors and each making iterations calls.
+/// \param batch_sizes Batch sizes to specialize f to, with 0 running f as it is
+std::vector<SweepResult> run_benchmark_sweep(const std::string& model,
+                                             std::shared_ptr<ngraph::Function> f,
+                                             const std::string& backend_name,
+                                             size_t iterations,
+                                             size_t warmup_iterations,
+                                             const std::vector<size_t>& batch_sizes,
+                                             size_t max_threads,
+                                             bool copy_data);
+
+void write_sweep_json(std::ostream& out, const std::vector<SweepResult>& results);
+void write_sweep_csv(std::ostream& out, const std::vector<SweepResult>& results);
@@ -27,9 +27,11 @@
 
 #include <fstream>
 #include <iomanip>
+#include <sstream>
 
 #include "benchmark.hpp"
 #include "benchmark_pipelined.hpp"
+#include "benchmark_sweep.hpp"
 #include "ngraph/distributed.hpp"
 #include "ngraph/except.hpp"
 #include "ngraph/file_util.hpp"
@@ -143,6 +145,72 @@ void print_times(const multimap<size_t, string>& timing)
     }
 }
 
+struct Throughput
+{
+    size_t microseconds = 0;
+    size_t flops = 0;
+    size_t bytes = 0;
+};
+
+void print_throughput_row(const string& name, int name_width, const Throughput& t)
+{
+    // Rates are per nanosecond to give GFLOP/s and GB/s
+    double ns = t.microseconds * 1000.0;
+    cout << setw(name_width + 2) << left << name << right << setw(14) << t.microseconds
+         << setw(12) << (ns == 0 ? 0 : t.flops / ns) << setw(12) << (ns == 0 ? 0 : t.bytes / ns)
+         << setw(12) << (t.bytes == 0 ? 0 : static_cast<double>(t.flops) / t.bytes) << "\n";
+}
+
+void print_throughput_header(int name_width)
+{
+    cout << setw(name_width + 2) << left << "" << right << setw(14) << "us/iteration"
+         << setw(12) << "GFLOP/s" << setw(12) << "GB/s" << setw(12) << "FLOP/byte"
+         << "\n";
+}
+
+// Achieved rates from the analytic cost of each op, to tell kernels that are far from the
+// compute or bandwidth roof of the machine. perf_data is sorted by time.
+void print_throughput(const vector<PerfShape>& perf_data)
+{
+    map<string, Throughput> op_types;
+    vector<pair<string, Throughput>> ops;
+    for (const PerfShape& p : perf_data)
+    {
+        auto node = p.get_node();
+        Throughput t;
+        t.microseconds = p.microseconds();
+        t.flops = p.get_cost().flops;
+        t.bytes = p.get_cost().bytes_read + p.get_cost().bytes_written;
+        ops.push_back({node->get_name() + " " + node->description() + " {" + join(p.shape) + "}",
+                       t});
+
+        Throughput& op_type = op_types[node->description()];
+        op_type.microseconds += t.microseconds;
+        op_type.flops += t.flops;
+        op_type.bytes += t.bytes;
+    }
+
+    int name_width = 0;
+    for (auto& op : ops)
+    {
+        name_width = max(name_width, static_cast<int>(op.first.size()));
+    }
+    cout << fixed << setprecision(2);
+    cout << "\n---- Achieved throughput per op type ----\n";
+    print_throughput_header(name_width);
+    for (auto& op_type : op_types)
+    {
+        print_throughput_row(op_type.first, name_width, op_type.second);
+    }
+    cout << "\n---- Achieved throughput per op ----\n";
+    print_throughput_header(name_width);
+    for (auto& op : ops)
+    {
+        print_throughput_row(op.first, name_width, op.second);
+    }
+    cout.unsetf(ios_base::floatfield);
+}
+
 void print_results(vector<PerfShape> perf_data, bool timing_detail)
 {
     sort(perf_data.begin(), perf_data.end(), [](const PerfShape& p1, const PerfShape& p2) {
@@ -158,9 +226,41 @@ void print_results(vector<PerfShape> perf_data, bool timing_detail)
 
         cout << "\n---- Aggregate times per op type/shape/count ----\n";
         print_times(timing_details);
+
+        print_throughput(perf_data);
     }
 }
 
+// Times compiling a model against loading the executable saved from that compile. Each runs on
+// a new backend, so the load does not hit a compile cache.
+void print_startup_times(const string& model, const string& backend_name)
+{
+    shared_ptr<Function> f = deserialize(model);
+    stopwatch timer;
+    timer.start();
+    shared_ptr<runtime::Executable> exec = runtime::Backend::create(backend_name)->compile(f);
+    timer.stop();
+    size_t compile_ms = timer.get_milliseconds();
+
+    stringstream saved;
+    timer.start();
+    exec->save(saved);
+    timer.stop();
+    size_t save_ms = timer.get_milliseconds();
+    size_t saved_bytes = saved.str().size();
+    exec = nullptr;
+
+    // The load includes reading the graph, which the compile time above does not
+    timer.start();
+    exec = runtime::Backend::create(backend_name)->load(saved);
+    timer.stop();
+    size_t load_ms = timer.get_milliseconds();
+
+    cout << "compile: " << compile_ms << " ms\n";
+    cout << "save:    " << save_ms << " ms, " << locale_string(saved_bytes) << " bytes\n";
+    cout << "load:    " << load_ms << " ms\n";
+}
+
 element::Type get_op_element_type(const Node& op)
 {
     element::Type type;
@@ -198,6 +298,11 @@ int main(int argc, char** argv)
     bool copy_data = true;
     bool dot_file = false;
     bool double_buffer = false;
+    bool startup = false;
+    size_t max_threads = 0;
+    vector<size_t> batch_sizes;
+    string json_file;
+    string csv_file;
 
     configure_static_backends();
     for (int i = 1; i < argc; i++)
@@ -251,6 +356,45 @@ int main(int argc, char** argv)
         {
             double_buffer = true;
         }
+        else if (arg == "--startup")
+        {
+            startup = true;
+        }
+        else if (arg == "--threads")
+        {
+            try
+            {
+                max_threads = stoul(argv[++i]);
+            }
+            catch (...)
+            {
+                cout << "Invalid Argument\n";
+                failed = true;
+            }
+        }
+        else if (arg == "--batch_sizes")
+        {
+            try
+            {
+                for (const string& batch_size : split(argv[++i], ','))
+                {
+                    batch_sizes.push_back(stoul(batch_size));
+                }
+            }
+            catch (...)
+            {
+                cout << "Invalid Argument\n";
+                failed = true;
+            }
+        }
+        else if (arg == "--json")
+        {
+            json_file = argv[++i];
+        }
+        else if (arg == "--csv")
+        {
+            csv_file = argv[++i];
+        }
         else if (arg == "-w" || arg == "--warmup_iterations")
         {
             try
@@ -301,11 +445,17 @@ OPTIONS
         -i|--iterations           Iterations (default: 10)
         -s|--statistics           Display op statistics
         -v|--visualize            Visualize a model (WARNING: requires Graphviz installed)
-        --timing_detail           Gather detailed timing
+        --timing_detail           Gather detailed timing and achieved GFLOP/s and GB/s per op
         -w|--warmup_iterations    Number of warm-up iterations
         --no_copy_data            Disable copy of input/result data every iteration
         --dot                     Generate Graphviz dot file
         --double_buffer           Double buffer inputs and outputs
+        --startup                 Time compiling the model against loading it after a save
+        --threads <n>             Sweep 1 to n threads calling the model concurrently and report
+                                  the latency distribution and throughput of each
+        --batch_sizes <n,...>     Sweep the batch sizes, set on axis 0 of the parameters
+        --json <file>             Write the sweep results as JSON
+        --csv <file>              Write the sweep results as CSV
 )###";
         return 1;
     }
@@ -329,7 +479,16 @@ OPTIONS
         models.push_back(model_arg);
     }
 
+    bool sweep = max_threads > 0 || !batch_sizes.empty() || !json_file.empty() ||
+                 !csv_file.empty();
+    if (batch_sizes.empty())
+    {
+        batch_sizes.push_back(0);
+    }
+    max_threads = max<size_t>(max_threads, 1);
+
     vector<PerfShape> aggregate_perf_data;
+    vector<SweepResult> sweep_results;
     int rc = 0;
     for (const string& model : models)
     {
@@ -439,7 +598,27 @@ OPTIONS
                 }
             }
 
-            if (!backend.empty())
+            if (!backend.empty() && startup)
+            {
+                cout << "\n---- Startup ----\n";
+                print_startup_times(model, backend);
+            }
+
+            if (!backend.empty() && sweep)
+            {
+                cout << "\n---- Benchmark sweep ----\n";
+                shared_ptr<Function> f = deserialize(model);
+                vector<SweepResult> results = run_benchmark_sweep(model,
+                                                                  f,
+                                                                  backend,
+                                                                  iterations,
+                                                                  warmup_iterations,
+                                                                  batch_sizes,
+                                                                  max_threads,
+                                                                  copy_data);
+                sweep_results.insert(sweep_results.end(), results.begin(), results.end());
+            }
+            else if (!backend.empty())
             {
                 cout << "\n---- Benchmark ----\n";
                 shared_ptr<Function> f = deserialize(model);
@@ -472,7 +651,18 @@ OPTIONS
         }
     }
 
-    if (models.size() > 1)
+    if (!json_file.empty())
+    {
+        ofstream out(json_file);
+        write_sweep_json(out, sweep_results);
+    }
+    if (!csv_file.empty())
+    {
+        ofstream out(csv_file);
+        write_sweep_csv(out, sweep_results);
+    }
+
+    if (models.size() > 1 && !sweep)
     {
         cout << "\n";
         cout << "============================================================================\n";
@@ -16,6 +16,7 @@
 
 #include "gtest/gtest.h"
 #include "ngraph/ngraph.hpp"
+#include "ngraph/runtime/dynamic/dynamic_backend.hpp"
 #include "util/all_close_f.hpp"
 #include "util/test_control.hpp"
 #include "util/test_tools.hpp"
@@ -292,3 +293,103 @@ NGRAPH_TEST(${BACKEND_NAME}, dynamic_reverse_shape)
                         Shape{8, 2, 8, 2},
                         Shape{2, 3, 4, 5, 2}});
 }
+
+NGRAPH_TEST(${BACKEND_NAME}, dynamic_executable_cache)
+{
+    auto a = make_shared<op::Parameter>(element::f32, PartialShape{Dimension::dynamic(), 3});
+    auto b = make_shared<op::Parameter>(element::f32, PartialShape{Dimension::dynamic(), 3});
+    auto f = make_shared<Function>(NodeVector{a + b}, ParameterVector{a, b});
+
+    auto backend = runtime::Backend::create("${BACKEND_NAME}", true);
+    auto ex = backend->compile(f);
+    auto dyn_ex = dynamic_pointer_cast<runtime::dynamic::DynamicExecutable>(ex);
+    ASSERT_NE(dyn_ex, nullptr);
+    dyn_ex->set_cache_capacity(2);
+
+    auto t_r = backend->create_dynamic_tensor(element::f32, PartialShape{Dimension::dynamic(), 3});
+
+    // Calls with batch sizes 1, 2, 1, 3, 1: the second call with batch 1 hits the cache, batch 3
+    // evicts the least recently used entry (batch 2), and the last call still hits batch 1.
+    for (size_t batch : vector<size_t>{1, 2, 1, 3, 1})
+    {
+        vector<float> inputs(batch * 3);
+        iota(inputs.begin(), inputs.end(), 0);
+
+        auto t_a = backend->create_tensor(element::f32, Shape{batch, 3});
+        auto t_b = backend->create_tensor(element::f32, Shape{batch, 3});
+        copy_data(t_a, inputs);
+        copy_data(t_b, inputs);
+
+        ex->call_with_validate({t_r}, {t_a, t_b});
+
+        ASSERT_EQ(t_r->get_shape(), (Shape{batch, 3}));
+        vector<float> expected(batch * 3);
+        for (size_t i = 0; i < expected.size(); i++)
+        {
+            expected[i] = 2 * inputs[i];
+        }
+        EXPECT_TRUE(test::all_close_f(read_vector<float>(t_r), expected));
+    }
+
+    EXPECT_EQ(dyn_ex->get_cache_hit_count(), 2);
+    EXPECT_EQ(dyn_ex->get_cache_miss_count(), 3);
+    EXPECT_EQ(dyn_ex->get_cache_eviction_count(), 1);
+    EXPECT_EQ(dyn_ex->get_cache_size(), 2);
+
+    dyn_ex->set_cache_capacity(0);
+    EXPECT_EQ(dyn_ex->get_cache_size(), 0);
+    EXPECT_EQ(dyn_ex->get_cache_eviction_count(), 3);
+}
+
+NGRAPH_TEST(${BACKEND_NAME}, dynamic_executable_shape_buckets)
+{
+    auto a = make_shared<op::Parameter>(element::f32, PartialShape{Dimension::dynamic(), 2});
+    auto b = make_shared<op::Parameter>(element::f32, PartialShape{Dimension::dynamic(), 2});
+    auto f = make_shared<Function>(NodeVector{(a + b) * a}, ParameterVector{a, b});
+
+    auto backend = runtime::Backend::create("${BACKEND_NAME}", true);
+    auto ex = backend->compile(f);
+    auto dyn_ex = dynamic_pointer_cast<runtime::dynamic::DynamicExecutable>(ex);
+    ASSERT_NE(dyn_ex, nullptr);
+
+    runtime::dynamic::ShapeBucket batch;
+    batch.input_axes = {{0, 0}, {1, 0}};
+    batch.output_axes = {{0, 0}};
+    batch.sizes = {1, 2, 4, 8};
+    dyn_ex->add_shape_bucket(batch);
+
+    auto t_r = backend->create_dynamic_tensor(element::f32, PartialShape{Dimension::dynamic(), 2});
+
+    // Batch sizes 3 and 4 share the 4 bucket, 5..8 share the 8 bucket, and 9 exceeds every
+    // bucket so it runs unpadded.
+    for (size_t n : vector<size_t>{3, 4, 5, 7, 8, 9})
+    {
+        vector<float> inputs(n * 2);
+        iota(inputs.begin(), inputs.end(), 1);
+
+        auto t_a = backend->create_tensor(element::f32, Shape{n, 2});
+        auto t_b = backend->create_tensor(element::f32, Shape{n, 2});
+        copy_data(t_a, inputs);
+        copy_data(t_b, inputs);
+
+        ex->call_with_validate({t_r}, {t_a, t_b});
+
+        ASSERT_EQ(t_r->get_shape(), (Shape{n, 2}));
+        vector<float> expected(n * 2);
+        for (size_t i = 0; i < expected.size(); i++)
+        {
+            expected[i] = 2 * inputs[i] * inputs[i];
+        }
+        EXPECT_TRUE(test::all_close_f(read_vector<float>(t_r), expected));
+    }
+
+    EXPECT_EQ(dyn_ex->get_cache_miss_count(), 3);
+    EXPECT_EQ(dyn_ex->get_cache_hit_count(), 3);
+
+    runtime::dynamic::ShapeBucket rounded;
+    rounded.multiple_of = 32;
+    EXPECT_EQ(rounded.get_bucket_size(0), 0);
+    EXPECT_EQ(rounded.get_bucket_size(1), 32);
+    EXPECT_EQ(rounded.get_bucket_size(32), 32);
+    EXPECT_EQ(rounded.get_bucket_size(33), 64);
+}
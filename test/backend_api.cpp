@@ -49,6 +49,66 @@ TEST(backend_api, config)
     EXPECT_STREQ(error.c_str(), "");
 }
 
+TEST(backend_api, config_num_threads)
+{
+    auto backend = runtime::Backend::create("INTERPRETER");
+    string error;
+    EXPECT_FALSE(backend->set_config({{"num_threads", "many"}}, error));
+    EXPECT_FALSE(error == "");
+
+    // Every kernel is large enough to be split over the threads
+    auto make_function = []() {
+        auto data = make_shared<op::Parameter>(element::f32, Shape{4, 8, 16, 16});
+        auto filter = make_shared<op::Parameter>(element::f32, Shape{8, 8, 3, 3});
+        auto conv = make_shared<op::Convolution>(data, filter);
+        auto max_pool = make_shared<op::MaxPool>(conv, Shape{2, 2});
+        auto avg_pool = make_shared<op::AvgPool>(conv, Shape{3, 3});
+        auto sum = make_shared<op::Sum>(conv, AxisSet{1, 3});
+        auto max = make_shared<op::Max>(conv, AxisSet{0});
+        auto matrix = make_shared<op::Reshape>(conv, AxisVector{0, 1, 2, 3}, Shape{32, 196});
+        auto transposed = make_shared<op::Reshape>(matrix, AxisVector{1, 0}, Shape{196, 32});
+        auto dot = make_shared<op::Dot>(matrix, transposed);
+        return make_shared<Function>(NodeVector{max_pool, avg_pool, sum, max, dot},
+                                     ParameterVector{data, filter});
+    };
+
+    vector<float> data(4 * 8 * 16 * 16);
+    vector<float> filter(8 * 8 * 3 * 3);
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = sin(static_cast<float>(i));
+    }
+    for (size_t i = 0; i < filter.size(); i++)
+    {
+        filter[i] = cos(static_cast<float>(i));
+    }
+
+    auto run = [&](const string& num_threads) {
+        EXPECT_TRUE(backend->set_config({{"num_threads", num_threads}}, error));
+        auto f = make_function();
+        auto exec = backend->compile(f);
+        auto a = backend->create_tensor(element::f32, f->get_parameters()[0]->get_shape());
+        auto b = backend->create_tensor(element::f32, f->get_parameters()[1]->get_shape());
+        copy_data(a, data);
+        copy_data(b, filter);
+        vector<shared_ptr<runtime::Tensor>> results;
+        for (auto result : f->get_results())
+        {
+            results.push_back(backend->create_tensor(element::f32, result->get_shape()));
+        }
+        exec->call_with_validate(results, {a, b});
+        vector<vector<float>> values;
+        for (auto result : results)
+        {
+            values.push_back(read_vector<float>(result));
+        }
+        return values;
+    };
+
+    // The threads reduce every output in the sequential order
+    EXPECT_EQ(run("1"), run("4"));
+}
+
 TEST(backend_api, config_unsupported)
 {
     auto backend = runtime::Backend::create("NOP");
@@ -102,3 +162,46 @@ TEST(backend_api, executable_can_create_tensor)
     EXPECT_FALSE(cpu->executable_can_create_tensors());
 }
 #endif
+
+#if defined(NGRAPH_INTERPRETER_ENABLE)
+TEST(backend_api, performance_counter_cost)
+{
+    auto A = make_shared<op::Parameter>(element::f32, Shape{2, 3});
+    auto B = make_shared<op::Parameter>(element::f32, Shape{3, 4});
+    auto dot = make_shared<op::Dot>(A, B);
+    auto sum = make_shared<op::Sum>(make_shared<op::Tanh>(dot), AxisSet{1});
+    auto data = make_shared<op::Parameter>(element::f32, Shape{1, 2, 5, 5});
+    auto filter = make_shared<op::Parameter>(element::f32, Shape{3, 2, 3, 3});
+    auto conv = make_shared<op::Convolution>(data, filter);
+    auto pool = make_shared<op::MaxPool>(conv, Shape{2, 2});
+    auto f = make_shared<Function>(NodeVector{sum, pool}, ParameterVector{A, B, data, filter});
+
+    auto backend = runtime::Backend::create("INTERPRETER");
+    vector<shared_ptr<runtime::Tensor>> args;
+    for (auto& param : f->get_parameters())
+    {
+        args.push_back(backend->create_tensor(element::f32, param->get_shape()));
+    }
+    auto sum_result = backend->create_tensor(element::f32, sum->get_shape());
+    auto pool_result = backend->create_tensor(element::f32, pool->get_shape());
+    auto handle = backend->compile(f, true);
+    handle->call_with_validate({sum_result, pool_result}, args);
+
+    map<string, runtime::PerformanceCounter> counters;
+    for (const runtime::PerformanceCounter& counter : handle->get_performance_data())
+    {
+        counters.insert({counter.get_node()->description(), counter});
+    }
+
+    // 8 outputs of 3 multiply-adds each, from 6 + 12 floats to 8 floats
+    EXPECT_EQ(counters.at("Dot").get_cost().flops, 48);
+    EXPECT_EQ(counters.at("Dot").get_cost().bytes_read, 72);
+    EXPECT_EQ(counters.at("Dot").get_cost().bytes_written, 32);
+    EXPECT_EQ(counters.at("Tanh").get_cost().flops, 8);
+    EXPECT_EQ(counters.at("Sum").get_cost().flops, 8);
+    // 27 outputs of 2 channels by 3x3 multiply-adds
+    EXPECT_EQ(counters.at("Convolution").get_cost().flops, 972);
+    EXPECT_EQ(counters.at("MaxPool").get_cost().flops, 48);
+    EXPECT_GE(counters.at("Convolution").gflops_per_second(), 0);
+}
+#endif
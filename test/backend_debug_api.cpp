@@ -14,9 +14,14 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <atomic>
+#include <condition_variable>
+#include <future>
+#include <mutex>
 #include <random>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -74,3 +79,135 @@ TEST(INTERPRETER, nan_check_output)
     ihandle->set_nan_check(true);
     EXPECT_ANY_THROW(handle->call_with_validate({result}, {a, b}));
 }
+
+TEST(INTERPRETER, repeated_and_concurrent_calls)
+{
+    Shape shape{4};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto C = op::Constant::create(element::f32, shape, {1, 1, 1, 1});
+    auto f = make_shared<Function>(NodeVector{(A + B) * (A - C), A}, ParameterVector{A, B});
+
+    shared_ptr<runtime::Backend> backend = runtime::Backend::create("INTERPRETER");
+    shared_ptr<runtime::Executable> handle = backend->compile(f);
+
+    auto run = [&](float scale) {
+        vector<float> a_values{1 * scale, 2 * scale, 3 * scale, 4 * scale};
+        vector<float> b_values{4, 3, 2, 1};
+        vector<float> expected;
+        for (size_t i = 0; i < a_values.size(); i++)
+        {
+            expected.push_back((a_values[i] + b_values[i]) * (a_values[i] - 1));
+        }
+
+        auto a = backend->create_tensor(element::f32, shape);
+        copy_data(a, a_values);
+        auto b = backend->create_tensor(element::f32, shape);
+        copy_data(b, b_values);
+        auto result = backend->create_tensor(element::f32, shape);
+        auto pass_through = backend->create_tensor(element::f32, shape);
+        for (size_t i = 0; i < 10; i++)
+        {
+            handle->call_with_validate({result, pass_through}, {a, b});
+            EXPECT_EQ(expected, read_vector<float>(result));
+            EXPECT_EQ(a_values, read_vector<float>(pass_through));
+        }
+    };
+
+    run(1);
+    run(2);
+    thread t1(run, 3.0f);
+    thread t2(run, 4.0f);
+    t1.join();
+    t2.join();
+}
+
+TEST(INTERPRETER, begin_call)
+{
+    Shape shape{4};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto f = make_shared<Function>(A * A, ParameterVector{A});
+
+    shared_ptr<runtime::Backend> backend = runtime::Backend::create("INTERPRETER");
+    shared_ptr<runtime::Executable> handle = backend->compile(f);
+
+    vector<shared_ptr<runtime::Tensor>> results;
+    vector<future<bool>> calls;
+    vector<size_t> completed;
+    auto a = backend->create_tensor(element::f32, shape);
+    copy_data(a, vector<float>{1, 2, 3, 4});
+    for (size_t i = 0; i < 4; i++)
+    {
+        results.push_back(backend->create_tensor(element::f32, shape));
+        // Callbacks run on the call thread, in submission order
+        calls.push_back(handle->begin_call({results.back()}, {a}, [&completed, i](exception_ptr e) {
+            EXPECT_EQ(e, nullptr);
+            completed.push_back(i);
+        }));
+    }
+    for (size_t i = 0; i < calls.size(); i++)
+    {
+        EXPECT_TRUE(calls[i].get());
+        EXPECT_EQ((vector<float>{1, 4, 9, 16}), read_vector<float>(results[i]));
+    }
+    EXPECT_EQ((vector<size_t>{0, 1, 2, 3}), completed);
+
+    // Errors are reported to the callback and rethrown by the future
+    static_pointer_cast<runtime::interpreter::INTExecutable>(handle)->set_nan_check(true);
+    copy_data(a, vector<float>{1, NAN, 3, 4});
+    bool failed = false;
+    auto call = handle->begin_call(
+        {results[0]}, {a}, [&failed](exception_ptr e) { failed = (e != nullptr); });
+    EXPECT_ANY_THROW(call.get());
+    EXPECT_TRUE(failed);
+}
+
+namespace
+{
+    // An executable whose calls block until released
+    class BlockingExecutable : public runtime::Executable
+    {
+    public:
+        bool call(const vector<shared_ptr<runtime::Tensor>>& outputs,
+                  const vector<shared_ptr<runtime::Tensor>>& inputs) override
+        {
+            unique_lock<mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() { return m_released; });
+            return true;
+        }
+
+        void release()
+        {
+            {
+                lock_guard<mutex> lock(m_mutex);
+                m_released = true;
+            }
+            m_condition.notify_all();
+        }
+
+    private:
+        mutex m_mutex;
+        condition_variable m_condition;
+        bool m_released = false;
+    };
+}
+
+TEST(executable, begin_call_discarded_future)
+{
+    auto exec = make_shared<BlockingExecutable>();
+    atomic<size_t> completed{0};
+    for (size_t i = 0; i < 2; i++)
+    {
+        // Discarding the future must not wait for the blocked call
+        exec->begin_call({}, {}, [&completed](exception_ptr e) {
+            EXPECT_EQ(e, nullptr);
+            completed++;
+        });
+    }
+    EXPECT_EQ(completed, 0);
+    exec->release();
+    while (completed < 2)
+    {
+        this_thread::yield();
+    }
+}
@@ -1217,3 +1217,43 @@ TEST(constant_folding, pass_property)
     ASSERT_EQ(false, pass->get_property(pass::PassProperty::REQUIRE_STATIC_SHAPE));
     ASSERT_EQ(true, pass->get_property(pass::PassProperty::CHANGE_DYNAMIC_STATE));
 }
+
+TEST(constant_folding, thread_pool)
+{
+    // Large enough for the kernels to split the work over the pool
+    Shape shape{64, 32, 16};
+    vector<float> values(shape_size(shape));
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        values[i] = static_cast<float>(i % 97) - 48.0f;
+    }
+    vector<float> row(16);
+    for (size_t i = 0; i < row.size(); i++)
+    {
+        row[i] = static_cast<float>(i) * 0.5f;
+    }
+
+    auto fold = [&](const shared_ptr<runtime::ThreadPool>& pool) {
+        auto a = make_shared<op::Constant>(element::f32, shape, values);
+        auto b = make_shared<op::Constant>(element::f32, Shape{16}, row);
+        auto add = make_shared<op::Add>(a, b, op::AutoBroadcastType::NUMPY);
+        auto reshape = make_shared<op::Reshape>(add, AxisVector{2, 0, 1}, Shape{16, 64, 32});
+        auto convert = make_shared<op::Convert>(reshape, element::i32);
+        auto f = make_shared<Function>(convert, ParameterVector{});
+
+        pass::ConstantFolding constant_folding;
+        constant_folding.set_thread_pool(pool);
+        constant_folding.run_on_function(f);
+
+        EXPECT_EQ(count_ops_of_type<op::Constant>(f), 1);
+        auto new_const = as_type_ptr<op::Constant>(f->get_results().at(0)->get_argument(0));
+        return new_const->get_vector<int32_t>();
+    };
+
+    auto sequential = fold(nullptr);
+    auto parallel = fold(make_shared<runtime::ThreadPool>(4));
+    ASSERT_EQ(sequential, parallel);
+    // Element (c, a, b) of the result is element (a, b, c) of the sum
+    ASSERT_EQ(sequential.at((5 * 64 + 3) * 32 + 7),
+              static_cast<int32_t>(values.at((3 * 32 + 7) * 16 + 5) + row.at(5)));
+}
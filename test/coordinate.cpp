@@ -335,3 +335,139 @@ TEST(benchmark, coordinate)
     timer.stop();
     cout << "time: " << timer.get_milliseconds() << endl;
 }
+
+// Indices visited by walker in buffer, one per element
+static vector<size_t> walked_indices(CoordinateWalker walker, size_t buffer)
+{
+    vector<size_t> result;
+    for (; !walker.is_done(); walker.next_run())
+    {
+        for (size_t i = 0; i < walker.get_run_length(); i++)
+        {
+            result.push_back(walker.get_index(buffer) + i * walker.get_run_stride(buffer));
+        }
+    }
+    return result;
+}
+
+// Indices of the source coordinates of ct in iteration order
+static vector<size_t> transform_indices(CoordinateTransform& ct)
+{
+    vector<size_t> result;
+    for (const Coordinate& c : ct)
+    {
+        result.push_back(ct.index(c));
+    }
+    return result;
+}
+
+TEST(coordinate_walker, dense)
+{
+    Shape shape{2, 3, 4};
+    CoordinateWalker walker(shape, {row_major_strides(shape)});
+    ASSERT_FALSE(walker.is_done());
+    // All axes merge into one run
+    EXPECT_EQ(walker.get_run_length(), 24);
+    EXPECT_EQ(walker.get_run_stride(0), 1);
+    EXPECT_EQ(walker.get_index(0), 0);
+    walker.next_run();
+    EXPECT_TRUE(walker.is_done());
+}
+
+TEST(coordinate_walker, scalar_and_empty)
+{
+    EXPECT_EQ(walked_indices(CoordinateWalker(Shape{}, {Strides{}}, {5}), 0),
+              vector<size_t>{5});
+    EXPECT_EQ(walked_indices(CoordinateWalker(Shape{1, 1}, {Strides{7, 3}}), 0),
+              vector<size_t>{0});
+    EXPECT_TRUE(CoordinateWalker(Shape{3, 0, 2}, {Strides{0, 2, 1}}).is_done());
+}
+
+TEST(coordinate_walker, broadcast)
+{
+    Shape in_shape{3};
+    Shape out_shape{2, 3};
+    Strides in_strides = CoordinateWalker::expanded_strides(in_shape, AxisSet{0});
+    EXPECT_EQ(in_strides, (Strides{0, 1}));
+
+    CoordinateWalker walker(out_shape, {row_major_strides(out_shape), in_strides});
+    EXPECT_EQ(walker.get_run_length(), 3);
+    EXPECT_EQ(walked_indices(walker, 0), (vector<size_t>{0, 1, 2, 3, 4, 5}));
+    EXPECT_EQ(walked_indices(walker, 1), (vector<size_t>{0, 1, 2, 0, 1, 2}));
+
+    EXPECT_THROW(CoordinateWalker::expanded_strides(in_shape, AxisSet{2}), std::domain_error);
+    EXPECT_THROW(CoordinateWalker(out_shape, {Strides{1}}), std::domain_error);
+}
+
+TEST(coordinate_walker, matches_transform)
+{
+    Shape shape{4, 5, 6};
+    vector<CoordinateTransform> transforms{
+        CoordinateTransform(shape),
+        CoordinateTransform(shape, Coordinate{1, 0, 2}, Coordinate{4, 5, 5}),
+        CoordinateTransform(shape, Coordinate{0, 1, 1}, Coordinate{4, 5, 6}, Strides{2, 3, 2}),
+        CoordinateTransform(
+            shape, Coordinate{0, 0, 0}, Coordinate{4, 5, 6}, Strides{1, 1, 1}, AxisVector{2, 0, 1}),
+        CoordinateTransform(
+            shape, Coordinate{1, 1, 0}, Coordinate{3, 5, 6}, Strides{1, 2, 3}, AxisVector{1, 2, 0})};
+
+    for (CoordinateTransform& ct : transforms)
+    {
+        CoordinateWalker walker(ct.get_target_shape(),
+                                {ct.get_source_index_strides()},
+                                {ct.get_source_start_index()});
+        EXPECT_EQ(walked_indices(walker, 0), transform_indices(ct));
+    }
+
+    CoordinateTransform padded(shape,
+                               Coordinate{0, 0, 0},
+                               Coordinate{4, 5, 6},
+                               Strides{1, 1, 1},
+                               AxisVector{0, 1, 2},
+                               CoordinateDiff{1, 0, 0},
+                               CoordinateDiff{0, 0, 0});
+    EXPECT_THROW(padded.get_source_index_strides(), std::domain_error);
+}
+
+TEST(benchmark, coordinate_walker)
+{
+    // Read a 4-d tensor in transposed order, as Reshape does
+    Shape source_shape{16, 3, 128, 128};
+    AxisVector source_axis_order{0, 2, 3, 1};
+    CoordinateTransform ct(source_shape,
+                           Coordinate(source_shape.size(), 0),
+                           source_shape,
+                           Strides(source_shape.size(), 1),
+                           source_axis_order);
+    size_t element_count = shape_size(source_shape);
+
+    size_t checksum = 0;
+    stopwatch timer;
+    timer.start();
+    for (const Coordinate& c : ct)
+    {
+        checksum += ct.index(c);
+    }
+    timer.stop();
+    double transform_ns = static_cast<double>(timer.get_nanoseconds()) / element_count;
+
+    size_t walker_checksum = 0;
+    timer.start();
+    for (CoordinateWalker walker(ct.get_target_shape(), {ct.get_source_index_strides()});
+         !walker.is_done();
+         walker.next_run())
+    {
+        size_t index = walker.get_index(0);
+        for (size_t i = 0; i < walker.get_run_length(); i++)
+        {
+            walker_checksum += index;
+            index += walker.get_run_stride(0);
+        }
+    }
+    timer.stop();
+    double walker_ns = static_cast<double>(timer.get_nanoseconds()) / element_count;
+
+    EXPECT_EQ(checksum, walker_checksum);
+    cout << "CoordinateTransform: " << transform_ns << " ns/element" << endl;
+    cout << "CoordinateWalker: " << walker_ns << " ns/element" << endl;
+}
@@ -138,6 +138,65 @@ TEST(copy, constant)
     ASSERT_TRUE(node_cast->get_element_type() == et);
 }
 
+TEST(copy, constant_shares_data)
+{
+    Shape shape{2, 2};
+    vector<float> c{1.0f, 2.0f, 3.0f, 4.0f};
+    auto node = op::Constant::create(element::f32, shape, c);
+    auto param = make_shared<op::Parameter>(element::f32, shape);
+    auto f = make_shared<Function>(node + param, ParameterVector{param});
+
+    auto new_node = as_type_ptr<op::Constant>(node->copy_with_new_args(NodeVector{}));
+    ASSERT_EQ(new_node->get_data_ptr(), node->get_data_ptr());
+
+    auto clone = clone_function(*f);
+    for (auto& op : clone->get_ops())
+    {
+        if (auto constant = as_type_ptr<op::Constant>(op))
+        {
+            ASSERT_NE(constant, node);
+            ASSERT_EQ(constant->get_data_ptr(), node->get_data_ptr());
+            ASSERT_EQ(constant->get_vector<float>(), c);
+        }
+    }
+}
+
+namespace
+{
+    // Exposes the protected write_values, through which subclasses such as the Constant
+    // versions of ops fill in their data
+    class WritableConstant : public op::Constant
+    {
+    public:
+        WritableConstant(const Shape& shape, const vector<float>& values)
+            : Constant(element::f32, shape, values)
+        {
+        }
+        void write(const vector<float>& values) { write_values(values); }
+    };
+}
+
+TEST(copy, constant_copy_on_write)
+{
+    Shape shape{2, 2};
+    auto node = make_shared<WritableConstant>(shape, vector<float>{1.0f, 2.0f, 3.0f, 4.0f});
+    auto copy = as_type_ptr<op::Constant>(node->copy_with_new_args(NodeVector{}));
+    ASSERT_EQ(copy->get_data_ptr(), node->get_data_ptr());
+
+    // The shared data is copied before it is written, so the copy keeps the old values
+    node->write({5.0f, 6.0f, 7.0f, 8.0f});
+    EXPECT_NE(copy->get_data_ptr(), node->get_data_ptr());
+    EXPECT_EQ(copy->get_vector<float>(), (vector<float>{1.0f, 2.0f, 3.0f, 4.0f}));
+    EXPECT_EQ(node->get_vector<float>(), (vector<float>{5.0f, 6.0f, 7.0f, 8.0f}));
+
+    // Data that is no longer shared is written in place
+    const void* data = node->get_data_ptr();
+    node->write({9.0f, 10.0f, 11.0f, 12.0f});
+    EXPECT_EQ(node->get_data_ptr(), data);
+    EXPECT_EQ(node->get_vector<float>(), (vector<float>{9.0f, 10.0f, 11.0f, 12.0f}));
+    EXPECT_EQ(copy->get_vector<float>(), (vector<float>{1.0f, 2.0f, 3.0f, 4.0f}));
+}
+
 TEST(copy, convert)
 {
     Shape shape;
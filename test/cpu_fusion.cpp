@@ -57,6 +57,7 @@
 #include "ngraph/pattern/op/label.hpp"
 #include "ngraph/pattern/op/skip.hpp"
 #include "ngraph/runtime/cpu/cpu_layout_descriptor.hpp"
+#include "ngraph/runtime/cpu/cpu_op_serializers.hpp"
 #include "ngraph/runtime/cpu/cpu_tensor_view.hpp"
 #include "ngraph/runtime/cpu/op/batch_mat_mul_transpose.hpp"
 #include "ngraph/runtime/cpu/op/batch_norm_relu.hpp"
@@ -68,6 +69,7 @@
 #include "ngraph/runtime/cpu/op/dropout.hpp"
 #include "ngraph/runtime/cpu/op/group_conv_bias.hpp"
 #include "ngraph/runtime/cpu/op/leaky_relu.hpp"
+#include "ngraph/runtime/cpu/op/loop_kernel.hpp"
 #include "ngraph/runtime/cpu/op/lstm.hpp"
 #include "ngraph/runtime/cpu/op/matmul_bias.hpp"
 #include "ngraph/runtime/cpu/op/rnn.hpp"
@@ -75,6 +77,7 @@
 #include "ngraph/runtime/cpu/op/sigmoid_mul.hpp"
 #include "ngraph/runtime/cpu/op/update_slice.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_fusion.hpp"
+#include "ngraph/runtime/cpu/pass/cpu_loop_kernel_fusion.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_mat_fusion.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_post_layout_optimizations.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_rnn_fusion.hpp"
@@ -3571,7 +3574,92 @@ TEST(cpu_quant_fusion, qconvba_q)
     ASSERT_EQ(count_ops_of_type<op::Quantize>(fuse), 6);
 }
 
+TEST(cpu_fusion, loop_kernel_fusion)
+{
+    auto make_function = []() {
+        Shape shape{4, 300};
+        auto A = make_shared<op::Parameter>(element::f32, shape);
+        auto B = make_shared<op::Parameter>(element::f32, shape);
+        auto bias = make_shared<op::Parameter>(element::f32, Shape{300});
+        auto C = make_shared<op::Parameter>(element::f32, shape);
+        auto scale = make_shared<op::Parameter>(element::f32, Shape{4});
+        auto add = make_shared<op::Add>(make_shared<op::Multiply>(A, B),
+                                        make_shared<op::Broadcast>(bias, shape, AxisSet{0}));
+        auto tanh = make_shared<op::Tanh>(add);
+        auto scaled = make_shared<op::Multiply>(
+            make_shared<op::Relu>(add), make_shared<op::Broadcast>(scale, shape, AxisSet{1}));
+        return make_shared<Function>(NodeVector{make_shared<op::Multiply>(tanh, C), scaled},
+                                     ParameterVector{A, B, bias, C, scale});
+    };
+
+    auto fused = make_function();
+    pass::Manager pass_manager;
+    pass_manager.register_pass<runtime::cpu::pass::CPULoopKernelFusion>();
+    pass_manager.run_passes(fused);
+    ASSERT_EQ(count_ops_of_type<runtime::cpu::op::LoopKernel>(fused), 1);
+    ASSERT_EQ(count_ops_of_type<op::Broadcast>(fused), 0);
+    ASSERT_EQ(count_ops_of_type<op::Multiply>(fused), 0);
+
+    auto cpu_f = make_function();
+    auto int_f = make_function();
+    test::Uniform<float> rng(-1.0f, 1.0f);
+    vector<vector<float>> args;
+    for (shared_ptr<op::Parameter> param : int_f->get_parameters())
+    {
+        vector<float> tensor_val(shape_size(param->get_shape()));
+        rng.initialize(tensor_val);
+        args.push_back(tensor_val);
+    }
+    auto int_results = execute(int_f, args, "INTERPRETER");
+    auto cpu_results = execute(cpu_f, args, "CPU");
+    // The CPU passes must have fused the chain, rather than left it to MKLDNN or the
+    // per-op kernels
+    EXPECT_GE(count_ops_of_type<runtime::cpu::op::LoopKernel>(cpu_f), 1);
+    for (size_t i = 0; i < cpu_results.size(); i++)
+    {
+        EXPECT_TRUE(test::all_close(cpu_results.at(i), int_results.at(i), 1.0e-4f, 1.0e-4f));
+    }
+}
+
 #ifndef NGRAPH_JSON_DISABLE
+TEST(cpu_fusion, loop_kernel_save_leaves_kernel_unchanged)
+{
+    Shape shape{4, 300};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto C = make_shared<op::Parameter>(element::f32, shape);
+    auto f = make_shared<Function>(make_shared<op::Tanh>(A * B + C), ParameterVector{A, B, C});
+    pass::Manager pass_manager;
+    pass_manager.register_pass<runtime::cpu::pass::CPULoopKernelFusion>();
+    pass_manager.run_passes(f);
+    shared_ptr<runtime::cpu::op::LoopKernel> kernel;
+    for (auto& node : f->get_ordered_ops())
+    {
+        if (auto lk = as_type_ptr<runtime::cpu::op::LoopKernel>(node))
+        {
+            kernel = lk;
+        }
+    }
+    ASSERT_NE(kernel, nullptr);
+    vector<size_t> user_counts;
+    for (auto& node : kernel->get_kernel_outputs())
+    {
+        user_counts.push_back(node->get_users().size());
+    }
+
+    runtime::cpu::register_op_serializers();
+    stringstream saved;
+    serialize_cpio(saved, f);
+
+    // Saving must not add users to the kernel nodes, which copies of the kernel share
+    for (size_t i = 0; i < user_counts.size(); i++)
+    {
+        EXPECT_EQ(kernel->get_kernel_outputs().at(i)->get_users().size(), user_counts.at(i));
+    }
+    auto loaded = deserialize(saved);
+    EXPECT_EQ(count_ops_of_type<runtime::cpu::op::LoopKernel>(loaded), 1);
+}
+
 // Tests that rely on deserializing json files
 TEST(cpu_fusion, fuse_conv_bias)
 {
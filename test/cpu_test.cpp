@@ -15,15 +15,18 @@
 //*****************************************************************************
 
 #include <algorithm>
+#include <cmath>
 #include <cstdio>
 #include <iostream>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <thread>
 
 #include "gtest/gtest.h"
 #include "misc.hpp"
 #include "ngraph/autodiff/adjoints.hpp"
+#include "ngraph/cpio.hpp"
 #include "ngraph/file_util.hpp"
 #include "ngraph/graph_util.hpp"
 #include "ngraph/log.hpp"
@@ -36,13 +39,19 @@
 #include "ngraph/op/parameter.hpp"
 #include "ngraph/pass/constant_folding.hpp"
 #include "ngraph/pass/manager.hpp"
+#include "ngraph/pass/propagate_cacheability.hpp"
 #include "ngraph/pass/visualize_tree.hpp"
 #include "ngraph/runtime/cpu/cpu_backend.hpp"
 #include "ngraph/runtime/cpu/cpu_builder.hpp"
+#include "ngraph/runtime/cpu/cpu_call_frame.hpp"
+#include "ngraph/runtime/cpu/cpu_inter_op_scheduler.hpp"
+#include "ngraph/runtime/cpu/cpu_op_annotations.hpp"
 #include "ngraph/runtime/cpu/cpu_tensor_view.hpp"
 #include "ngraph/runtime/cpu/mkldnn_utils.hpp"
+#include "ngraph/runtime/cpu/op/conv_relu.hpp"
 #include "ngraph/runtime/cpu/op/convert_layout.hpp"
 #include "ngraph/runtime/cpu/op/max_pool_with_indices.hpp"
+#include "ngraph/runtime/cpu/pass/cpu_memory_assignment.hpp"
 #include "ngraph/serializer.hpp"
 #include "ngraph/util.hpp"
 #include "util/all_close.hpp"
@@ -831,6 +840,103 @@ TEST(cpu_test, memory_reuse_cacheable_no_destructive_oi_relu)
     EXPECT_TRUE(test::all_close_f(read_vector<float>(result), expected));
 }
 
+TEST(cpu_test, memory_reuse_destructive_oi_elementwise)
+{
+    Shape shape{2, 3};
+    auto make_function = [&shape]() {
+        auto A = make_shared<op::Parameter>(element::f32, shape);
+        auto B = make_shared<op::Parameter>(element::f32, shape);
+        auto add = make_shared<op::Add>(A, B);
+        auto exp = make_shared<op::Exp>(add);
+        // exp is read again after negative, so negative must not overwrite it
+        auto negative = make_shared<op::Negative>(exp);
+        auto multiply = make_shared<op::Multiply>(negative, exp);
+        auto subtract = make_shared<op::Subtract>(multiply, A);
+        return make_shared<Function>(subtract, ParameterVector{A, B});
+    };
+
+    vector<float> a_data{0.5f, -1, 0, 1, -0.25f, 2};
+    vector<float> b_data{-0.5f, 0.5f, 1, -2, 0.75f, -1.5f};
+    vector<float> expected;
+    for (size_t i = 0; i < a_data.size(); i++)
+    {
+        expected.push_back(-std::exp(2 * (a_data[i] + b_data[i])) - a_data[i]);
+    }
+
+    auto backend = runtime::Backend::create("CPU");
+    auto a = backend->create_tensor(element::f32, shape);
+    copy_data(a, a_data);
+    auto b = backend->create_tensor(element::f32, shape);
+    copy_data(b, b_data);
+    auto result = backend->create_tensor(element::f32, shape);
+
+    for (bool reuse_memory : {false, true})
+    {
+        ngraph::pass::PassConfig pass_config;
+        pass_config.set_pass_attribute("CPUMemoryAssignment::ReuseMemory", reuse_memory);
+        shared_ptr<runtime::Executable> handle = backend->compile(make_function(), pass_config);
+        ASSERT_NE(handle, nullptr);
+        handle->call_with_validate({result}, {a, b});
+        EXPECT_TRUE(test::all_close_f(read_vector<float>(result), expected));
+    }
+
+    // Keep the ops separate so that their buffers are assigned one by one
+    auto compile = [&](bool in_place_elementwise) {
+        ngraph::pass::PassConfig pass_config;
+        pass_config.set_pass_enable("CPULoopKernelFusion", false);
+        pass_config.set_pass_attribute("CPUMemoryAssignment::ReuseMemory", true);
+        pass_config.set_pass_attribute("CPUMemoryAssignment::InPlaceElementwise",
+                                       in_place_elementwise);
+        auto f = make_function();
+        auto handle = backend->compile(f, pass_config);
+        handle->call_with_validate({result}, {a, b});
+        EXPECT_TRUE(test::all_close_f(read_vector<float>(result), expected));
+        return f;
+    };
+    auto in_place_f = compile(true);
+    auto separate_f = compile(false);
+
+    // exp is the last reader of add, so it writes over add's buffer
+    for (auto node : in_place_f->get_ordered_ops())
+    {
+        if (as_type_ptr<op::Exp>(node))
+        {
+            EXPECT_EQ(node->get_output_tensor(0).get_pool_offset(),
+                      node->get_inputs().at(0).get_tensor().get_pool_offset());
+        }
+    }
+    EXPECT_EQ(count_ops_of_type<op::Exp>(in_place_f), 1);
+    EXPECT_LT(in_place_f->get_temporary_pool_size(), separate_f->get_temporary_pool_size());
+}
+
+TEST(cpu_test, memory_assignment_lower_bound)
+{
+    Shape shape{16, 16};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    // t1 stays live while t2 and t3 are computed
+    auto t1 = make_shared<op::Add>(A, B);
+    auto t2 = make_shared<op::Multiply>(t1, A);
+    auto t3 = make_shared<op::Subtract>(t2, B);
+    auto t4 = make_shared<op::Multiply>(t3, t1);
+    auto f = make_shared<Function>(make_shared<op::Negative>(t4), ParameterVector{A, B});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::PropagateCacheability>(
+        runtime::cpu::get_annotations_factory());
+    pass_manager.run_passes(f);
+    unordered_map<size_t, pair<TensorRole, unordered_set<descriptor::Tensor*>>>
+        bufferID_to_tensorSets;
+    unordered_map<descriptor::Tensor*, size_t> tensor_to_bufferID;
+    runtime::cpu::pass::CPUMemoryAssignment memory_assignment(
+        bufferID_to_tensorSets, tensor_to_bufferID, 64, false);
+    memory_assignment.run_on_function(f);
+
+    EXPECT_GT(memory_assignment.get_lower_bound(), 0);
+    EXPECT_EQ(memory_assignment.get_planned_size(), memory_assignment.get_lower_bound());
+    EXPECT_GE(f->get_temporary_pool_size(), memory_assignment.get_planned_size());
+}
+
 TEST(cpu_test, memory_reuse_in_place_concat_after_in_place_slice)
 {
     Shape shape_a{4, 4};
@@ -1060,6 +1166,249 @@ TEST(cpu_test, thread_safe_calls_convolution_2d_2items)
     unset_environment("NGRAPH_CPU_CONCURRENCY");
 }
 
+TEST(cpu_test, concurrency_api)
+{
+    if (is_codegen_mode())
+    {
+        // TODO change to skip when there is a new release of gtest
+        NGRAPH_WARN << "This test is skipped for CODEGEN mode.";
+        return;
+    }
+
+    Shape shape{2, 3};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto function = make_shared<Function>((A + B) * A, ParameterVector{A, B});
+
+    auto backend = runtime::Backend::create("CPU");
+    auto handle = static_pointer_cast<runtime::cpu::CPU_Executable>(backend->compile(function));
+    EXPECT_EQ(handle->get_concurrency(), 1);
+    handle->set_concurrency(4);
+    EXPECT_EQ(handle->get_concurrency(), 4);
+
+    auto make_call = [&](float scale) {
+        auto a = backend->create_tensor(element::f32, shape);
+        copy_data(a, vector<float>{1 * scale, 2 * scale, 3 * scale, 4, 5, 6});
+        auto b = backend->create_tensor(element::f32, shape);
+        copy_data(b, vector<float>{1, 1, 1, 1, 1, 1});
+        auto result = backend->create_tensor(element::f32, shape);
+        auto ready = handle->begin_call({result}, {a, b});
+        EXPECT_TRUE(ready.get());
+        EXPECT_TRUE(test::all_close_f(
+            (vector<float>{(1 * scale + 1) * 1 * scale,
+                           (2 * scale + 1) * 2 * scale,
+                           (3 * scale + 1) * 3 * scale,
+                           20,
+                           30,
+                           42}),
+            read_vector<float>(result),
+            MIN_FLOAT_TOLERANCE_BITS));
+    };
+
+    vector<thread> calls;
+    for (size_t i = 0; i < 8; i++)
+    {
+        calls.emplace_back(make_call, static_cast<float>(i));
+    }
+    // Shrinking waits for the calls running on the contexts that are removed
+    handle->set_concurrency(2);
+    for (auto& call : calls)
+    {
+        call.join();
+    }
+    EXPECT_EQ(handle->get_concurrency(), 2);
+
+    auto a = backend->create_tensor(element::f32, shape);
+    copy_data(a, vector<float>{1, 2, 3, 4, 5, 6});
+    auto result = backend->create_tensor(element::f32, shape);
+    EXPECT_TRUE(handle->try_call({result}, {a, a}));
+    EXPECT_TRUE(test::all_close_f((vector<float>{2, 8, 18, 32, 50, 72}),
+                                  read_vector<float>(result),
+                                  MIN_FLOAT_TOLERANCE_BITS));
+    EXPECT_THROW(handle->set_concurrency(0), CheckFailure);
+}
+
+TEST(cpu_test, lazy_call_contexts)
+{
+    if (is_codegen_mode())
+    {
+        // TODO change to skip when there is a new release of gtest
+        NGRAPH_WARN << "This test is skipped for CODEGEN mode.";
+        return;
+    }
+
+    Shape shape{2, 3};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto function = make_shared<Function>(A * A, ParameterVector{A});
+
+    auto backend = runtime::Backend::create("CPU");
+    auto handle = static_pointer_cast<runtime::cpu::CPU_Executable>(backend->compile(function));
+    auto call_frame = handle->get_call_frame();
+    handle->set_concurrency(4);
+    EXPECT_EQ(call_frame->get_context_count(), 1);
+
+    vector<shared_ptr<runtime::Tensor>> results;
+    vector<future<bool>> calls;
+    auto a = backend->create_tensor(element::f32, shape);
+    copy_data(a, vector<float>{1, 2, 3, 4, 5, 6});
+    for (size_t i = 0; i < 8; i++)
+    {
+        results.push_back(backend->create_tensor(element::f32, shape));
+        calls.push_back(handle->begin_call({results.back()}, {a}));
+    }
+    for (size_t i = 0; i < calls.size(); i++)
+    {
+        EXPECT_TRUE(calls[i].get());
+        EXPECT_TRUE(test::all_close_f((vector<float>{1, 4, 9, 16, 25, 36}),
+                                      read_vector<float>(results[i]),
+                                      MIN_FLOAT_TOLERANCE_BITS));
+    }
+    EXPECT_GE(call_frame->get_context_count(), 1);
+    EXPECT_LE(call_frame->get_context_count(), 4);
+
+    // Idle contexts other than the first are released
+    call_frame->set_idle_timeout(chrono::milliseconds(0));
+    call_frame->release_idle_contexts();
+    EXPECT_EQ(call_frame->get_context_count(), 1);
+
+    // Without further calls or polling, the executor releases them once they time out
+    call_frame->set_idle_timeout(chrono::milliseconds(20));
+    calls.clear();
+    for (size_t i = 0; i < 8; i++)
+    {
+        calls.push_back(handle->begin_call({results[i]}, {a}));
+    }
+    for (auto& call : calls)
+    {
+        EXPECT_TRUE(call.get());
+    }
+    auto deadline = chrono::steady_clock::now() + chrono::seconds(10);
+    while (call_frame->get_context_count() > 1 && chrono::steady_clock::now() < deadline)
+    {
+        this_thread::sleep_for(chrono::milliseconds(5));
+    }
+    EXPECT_EQ(call_frame->get_context_count(), 1);
+
+    auto result = backend->create_tensor(element::f32, shape);
+    handle->call_with_validate({result}, {a});
+    EXPECT_TRUE(test::all_close_f((vector<float>{1, 4, 9, 16, 25, 36}),
+                                  read_vector<float>(result),
+                                  MIN_FLOAT_TOLERANCE_BITS));
+}
+
+TEST(cpu_test, inter_op_scheduler_dependencies)
+{
+    using Region = runtime::cpu::InterOpScheduler::Region;
+    runtime::cpu::InterOpScheduler scheduler;
+    // 0 and 1 write a and b, 2 and 3 read a, 4 reads b and reuses part of a, 5 reads the
+    // results of 2 and 3, and 6 has a control dependency on 1
+    scheduler.add_op({}, {Region{1, 0, 64}});
+    scheduler.add_op({}, {Region{1, 64, 128}});
+    scheduler.add_op({Region{1, 0, 64}}, {Region{2, 0, 64}});
+    scheduler.add_op({Region{1, 0, 64}}, {Region{3, 0, 64}});
+    scheduler.add_op({Region{1, 64, 96}}, {Region{1, 0, 32}});
+    scheduler.add_op({Region{2, 0, 64}, Region{3, 0, 64}}, {});
+    scheduler.add_op({}, {}, {1});
+
+    EXPECT_EQ(scheduler.get_op_count(), 7);
+    EXPECT_EQ(scheduler.get_predecessors(0), (vector<size_t>{}));
+    EXPECT_EQ(scheduler.get_predecessors(1), (vector<size_t>{}));
+    EXPECT_EQ(scheduler.get_predecessors(2), (vector<size_t>{0}));
+    EXPECT_EQ(scheduler.get_predecessors(3), (vector<size_t>{0}));
+    // The overwrite of a must wait for its readers
+    EXPECT_EQ(scheduler.get_predecessors(4), (vector<size_t>{0, 1, 2, 3}));
+    EXPECT_EQ(scheduler.get_predecessors(5), (vector<size_t>{2, 3}));
+    EXPECT_EQ(scheduler.get_predecessors(6), (vector<size_t>{1}));
+
+    for (size_t width : {1, 2, 4})
+    {
+        mutex order_mutex;
+        vector<size_t> order;
+        scheduler.run(width, [&](size_t op, size_t worker) {
+            EXPECT_LT(worker, width);
+            lock_guard<mutex> lock(order_mutex);
+            order.push_back(op);
+        });
+        ASSERT_EQ(order.size(), scheduler.get_op_count());
+        for (size_t op = 0; op < scheduler.get_op_count(); op++)
+        {
+            auto position = find(order.begin(), order.end(), op);
+            for (size_t predecessor : scheduler.get_predecessors(op))
+            {
+                EXPECT_LT(find(order.begin(), order.end(), predecessor), position);
+            }
+        }
+    }
+
+    EXPECT_THROW(scheduler.run(4,
+                               [](size_t op, size_t) {
+                                   if (op == 2)
+                                   {
+                                       throw ngraph_error("op failed");
+                                   }
+                               }),
+                 ngraph_error);
+}
+
+TEST(cpu_test, inter_op_parallelism)
+{
+    if (is_codegen_mode())
+    {
+        // TODO change to skip when there is a new release of gtest
+        NGRAPH_WARN << "This test is skipped for CODEGEN mode.";
+        return;
+    }
+
+    // Independent branches joined at the end, like an Inception block
+    auto make_function = []() {
+        Shape shape{8, 64};
+        auto A = make_shared<op::Parameter>(element::f32, shape);
+        auto B = make_shared<op::Parameter>(element::f32, Shape{64, 64});
+        NodeVector branches;
+        for (size_t i = 0; i < 4; i++)
+        {
+            auto dot = make_shared<op::Dot>(make_shared<op::Tanh>(A), B);
+            branches.push_back(make_shared<op::Sum>(dot + A, AxisSet{1}));
+        }
+        auto concat = make_shared<op::Concat>(branches, 0);
+        return make_shared<Function>(concat, ParameterVector{A, B});
+    };
+
+    auto backend = runtime::Backend::create("CPU");
+    auto handle =
+        static_pointer_cast<runtime::cpu::CPU_Executable>(backend->compile(make_function()));
+    handle->set_inter_op_parallelism(4);
+    EXPECT_GE(handle->get_inter_op_parallelism(), 1);
+    EXPECT_LE(handle->get_inter_op_parallelism(), 4);
+
+    test::Uniform<float> rng(-1.0f, 1.0f);
+    vector<vector<float>> args;
+    auto int_f = make_function();
+    for (shared_ptr<op::Parameter> param : int_f->get_parameters())
+    {
+        vector<float> tensor_val(shape_size(param->get_shape()));
+        rng.initialize(tensor_val);
+        args.push_back(tensor_val);
+    }
+    auto int_results = execute(int_f, args, "INTERPRETER");
+
+    vector<shared_ptr<runtime::Tensor>> inputs;
+    for (size_t i = 0; i < args.size(); i++)
+    {
+        inputs.push_back(
+            backend->create_tensor(element::f32, int_f->get_parameters().at(i)->get_shape()));
+        copy_data(inputs.back(), args.at(i));
+    }
+    auto result = backend->create_tensor(element::f32, Shape{32});
+    // The first call always runs sequentially
+    for (size_t i = 0; i < 3; i++)
+    {
+        handle->call_with_validate({result}, inputs);
+        EXPECT_TRUE(
+            test::all_close(int_results.at(0), read_vector<float>(result), 1.0e-4f, 1.0e-4f));
+    }
+}
+
 TEST(cpu_test, constant_convertlayout)
 {
     Shape data_shape{1, 64, 56, 56};
@@ -2250,3 +2599,234 @@ TEST(cpu_test, convolution_simple_bf16)
     EXPECT_TRUE(test::all_close_f(vector<float>{expected_result}, read_vector<float>(c)));
 }
 #endif
+
+#ifndef NGRAPH_JSON_DISABLE
+TEST(cpu_test, save_load)
+{
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto f = make_shared<Function>(make_shared<op::Relu>(A + B), ParameterVector{A, B});
+
+    auto backend = runtime::Backend::create("CPU");
+
+    auto a = backend->create_tensor(element::f32, shape);
+    auto b = backend->create_tensor(element::f32, shape);
+    auto result = backend->create_tensor(element::f32, shape);
+    copy_data<float>(a, {1.f, -2.f, 3.f, -4.f});
+    copy_data<float>(b, {5.f, 6.f, -7.f, 8.f});
+
+    stringstream saved;
+    {
+        auto handle = backend->compile(f);
+        handle->save(saved);
+    }
+    {
+        auto other_backend = runtime::Backend::create("CPU");
+        auto handle = other_backend->load(saved);
+        ASSERT_NE(handle, nullptr);
+        handle->call_with_validate({result}, {a, b});
+        EXPECT_TRUE(test::all_close_f(read_vector<float>(result), {6.f, 4.f, 0.f, 4.f}));
+    }
+}
+
+TEST(cpu_test, compile_shares_structurally_identical_functions)
+{
+    auto make_f = [](float w) {
+        auto A = make_shared<op::Parameter>(element::f32, Shape{2, 2});
+        auto W = op::Constant::create(element::f32, Shape{2, 2}, {w, w, w, w});
+        return make_shared<Function>(make_shared<op::Relu>(A * W), ParameterVector{A});
+    };
+
+    auto backend = runtime::Backend::create("CPU");
+    auto f1 = make_f(2.f);
+    auto f2 = make_f(2.f);
+    auto f3 = make_f(3.f);
+
+    auto ex1 = backend->compile(f1);
+    auto ex2 = backend->compile(f2);
+    auto ex3 = backend->compile(f3);
+    auto cf1 = static_pointer_cast<runtime::cpu::CPU_Executable>(ex1)->get_call_frame();
+    auto cf2 = static_pointer_cast<runtime::cpu::CPU_Executable>(ex2)->get_call_frame();
+    auto cf3 = static_pointer_cast<runtime::cpu::CPU_Executable>(ex3)->get_call_frame();
+    EXPECT_EQ(cf1, cf2);
+    EXPECT_NE(cf1, cf3);
+    // ex2 shares the compiled code of ex1, but is bound to the nodes of f2
+    EXPECT_NE(ex1, ex2);
+    EXPECT_EQ(ex2->get_parameters().at(0), f2->get_parameters().at(0));
+    EXPECT_EQ(ex2->get_results().at(0), f2->get_results().at(0));
+    EXPECT_EQ(backend->compile(f2), ex2);
+
+    auto a = backend->create_tensor(element::f32, Shape{2, 2});
+    auto result = backend->create_tensor(element::f32, Shape{2, 2});
+    copy_data<float>(a, {1.f, -1.f, 2.f, -2.f});
+    ex2->call_with_validate({result}, {a});
+    EXPECT_TRUE(test::all_close_f(read_vector<float>(result), {2.f, 0.f, 4.f, 0.f}));
+    ex3->call_with_validate({result}, {a});
+    EXPECT_TRUE(test::all_close_f(read_vector<float>(result), {3.f, 0.f, 6.f, 0.f}));
+
+    backend->remove_compiled_function(ex1);
+    auto ex4 = backend->compile(make_f(2.f));
+    EXPECT_NE(static_pointer_cast<runtime::cpu::CPU_Executable>(ex4)->get_call_frame(), cf1);
+}
+
+TEST(cpu_test, save_load_compiled_layouts)
+{
+    auto make_function = []() -> std::shared_ptr<Function> {
+        auto A = make_shared<op::Parameter>(element::f32, Shape{2, 3, 6, 6});
+        auto W = make_shared<op::Parameter>(element::f32, Shape{8, 3, 3, 3});
+        auto conv = make_shared<op::Convolution>(A, W, Strides{1, 1});
+        return make_shared<Function>(make_shared<op::Relu>(conv), ParameterVector{A, W});
+    };
+
+    auto cpu_f = make_function();
+    auto int_f = make_function();
+    test::Uniform<float> rng(-1.0f, 1.0f);
+    vector<vector<float>> args;
+    for (shared_ptr<op::Parameter> param : cpu_f->get_parameters())
+    {
+        vector<float> tensor_val(shape_size(param->get_shape()));
+        rng.initialize(tensor_val);
+        args.push_back(tensor_val);
+    }
+    auto int_results = execute(int_f, args, "INTERPRETER");
+
+    stringstream saved;
+    {
+        auto backend = runtime::Backend::create("CPU");
+        backend->compile(cpu_f)->save(saved);
+    }
+    // The saved graph is the compiled one, with the fused op and the layout conversions
+    ASSERT_EQ(count_ops_of_type<op::ConvolutionRelu>(cpu_f), 1);
+    ASSERT_GT(count_ops_of_type<runtime::cpu::op::ConvertLayout>(cpu_f), 0);
+
+    auto backend = runtime::Backend::create("CPU");
+    auto handle = backend->load(saved);
+    vector<shared_ptr<runtime::Tensor>> inputs;
+    for (size_t i = 0; i < args.size(); i++)
+    {
+        auto& param = int_f->get_parameters().at(i);
+        inputs.push_back(backend->create_tensor(element::f32, param->get_shape()));
+        copy_data(inputs.back(), args.at(i));
+    }
+    auto result = backend->create_tensor(element::f32, int_f->get_output_shape(0));
+    handle->call_with_validate({result}, inputs);
+    EXPECT_TRUE(
+        test::all_close(read_vector<float>(result), int_results.at(0), 1.0e-4f, 1.0e-4f));
+}
+
+TEST(cpu_test, load_rejects_bad_input)
+{
+    auto backend = runtime::Backend::create("CPU");
+
+    stringstream not_cpio("not a saved executable");
+    EXPECT_THROW(backend->load(not_cpio), ngraph_error);
+
+    stringstream wrong_version;
+    {
+        cpio::Writer writer(wrong_version);
+        string save_info = "CPU Save File 1.0";
+        writer.write("save_info", save_info.data(), save_info.size());
+    }
+    EXPECT_THROW(backend->load(wrong_version), ngraph_error);
+}
+
+TEST(cpu_test, compile_cache_directory)
+{
+    auto make_function = [](float w) -> std::shared_ptr<Function> {
+        auto A = make_shared<op::Parameter>(element::f32, Shape{2, 3, 6, 6});
+        auto W = op::Constant::create(element::f32, Shape{8, 3, 3, 3}, vector<float>(216, w));
+        auto conv = make_shared<op::Convolution>(A, W, Strides{1, 1});
+        return make_shared<Function>(make_shared<op::Relu>(conv), ParameterVector{A});
+    };
+    auto make_backend = [](const string& dir) {
+        auto backend = runtime::Backend::create("CPU");
+        static_pointer_cast<runtime::cpu::CPU_Backend>(backend)->set_compile_cache_dir(dir);
+        return backend;
+    };
+    string dir = file_util::path_join(file_util::get_temp_directory_path(),
+                                      "cpu_test_compile_cache_directory");
+    file_util::remove_directory(dir);
+
+    vector<float> input(shape_size(Shape{2, 3, 6, 6}));
+    test::Uniform<float> rng(-1.0f, 1.0f);
+    rng.initialize(input);
+    auto check = [&](const shared_ptr<runtime::Backend>& backend,
+                     const shared_ptr<runtime::Executable>& handle,
+                     float w) {
+        auto expected = execute(make_function(w), vector<vector<float>>{input}, "INTERPRETER");
+        auto a = backend->create_tensor(element::f32, Shape{2, 3, 6, 6});
+        copy_data(a, input);
+        auto result = backend->create_tensor(element::f32, Shape{2, 8, 4, 4});
+        handle->call_with_validate({result}, {a});
+        EXPECT_TRUE(
+            test::all_close(read_vector<float>(result), expected.at(0), 1.0e-4f, 1.0e-4f));
+    };
+
+    {
+        auto backend = make_backend(dir);
+        auto f = make_function(0.5f);
+        auto handle = backend->compile(f);
+        // The passes ran and rewrote f
+        EXPECT_EQ(count_ops_of_type<op::ConvolutionRelu>(f), 1);
+        check(backend, handle, 0.5f);
+    }
+    size_t files = 0;
+    file_util::iterate_files(dir, [&](const string&, bool) { files++; });
+    EXPECT_EQ(files, 1);
+
+    {
+        // Loaded from the directory, so the passes did not run on f
+        auto backend = make_backend(dir);
+        auto f = make_function(0.5f);
+        auto handle = backend->compile(f);
+        EXPECT_EQ(count_ops_of_type<op::ConvolutionRelu>(f), 0);
+        EXPECT_EQ(handle->get_parameters().at(0), f->get_parameters().at(0));
+        check(backend, handle, 0.5f);
+
+        // Different constant data is compiled
+        auto g = make_function(-0.25f);
+        auto other = backend->compile(g);
+        EXPECT_EQ(count_ops_of_type<op::ConvolutionRelu>(g), 1);
+        check(backend, other, -0.25f);
+    }
+
+    {
+        // The cache is opt-in
+        auto backend = make_backend("");
+        auto f = make_function(0.5f);
+        backend->compile(f);
+        EXPECT_EQ(count_ops_of_type<op::ConvolutionRelu>(f), 1);
+    }
+    file_util::remove_directory(dir);
+}
+#endif
+
+TEST(cpu_test, weight_pool_shares_constants)
+{
+    // The same model compiled for two batch sizes
+    auto make_f = [](size_t batch) {
+        auto A = make_shared<op::Parameter>(element::f32, Shape{batch, 4});
+        auto W = op::Constant::create(
+            element::f32, Shape{4, 4}, {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16});
+        return make_shared<Function>(make_shared<op::Dot>(A, W), ParameterVector{A});
+    };
+
+    auto backend = runtime::Backend::create("CPU");
+    auto cpu_backend = dynamic_pointer_cast<runtime::cpu::CPU_Backend>(backend);
+    ASSERT_NE(cpu_backend, nullptr);
+    auto weight_pool = cpu_backend->get_weight_pool();
+
+    auto ex1 = backend->compile(make_f(1));
+    EXPECT_EQ(weight_pool->get_deduplicated_bytes(), 0u);
+    EXPECT_EQ(weight_pool->get_pooled_bytes(), 16 * sizeof(float));
+    auto ex2 = backend->compile(make_f(2));
+    EXPECT_EQ(weight_pool->get_deduplicated_bytes(), 16 * sizeof(float));
+    EXPECT_EQ(weight_pool->get_pooled_bytes(), 16 * sizeof(float));
+
+    auto a = backend->create_tensor(element::f32, Shape{2, 4});
+    auto result = backend->create_tensor(element::f32, Shape{2, 4});
+    copy_data<float>(a, {1, 0, 0, 0, 0, 0, 0, 1});
+    ex2->call_with_validate({result}, {a});
+    EXPECT_TRUE(test::all_close_f(read_vector<float>(result), {1, 2, 3, 4, 13, 14, 15, 16}));
+}
@@ -17,6 +17,7 @@
 #include <fstream>
 #include <iostream>
 #include <mutex>
+#include <set>
 #include <stdlib.h>
 #include <vector>
 #include "nlohmann/json.hpp"
@@ -24,6 +25,7 @@
 #include "gtest/gtest.h"
 #include "ngraph/event_tracing.hpp"
 #include "ngraph/file_util.hpp"
+#include "ngraph/runtime/chrome_trace.hpp"
 
 using namespace std;
 
@@ -62,3 +64,100 @@ TEST(event_tracing, event_file)
     // TODO
     ngraph::Event::disable_event_tracing();
 }
+
+TEST(event_tracing, runtime_event_file)
+{
+    const string path = "runtime_event_trace_test.json";
+    ngraph::runtime::event::Manager::open(path);
+    ngraph::runtime::event::Manager::enable_event_tracing();
+    size_t thread_count = 4;
+    size_t event_count = 1000;
+    vector<thread> threads;
+    for (size_t i = 0; i < thread_count; i++)
+    {
+        threads.push_back(thread([&] {
+            for (size_t j = 0; j < event_count; j++)
+            {
+                ngraph::runtime::event::Duration event("Event \"" + to_string(j % 3) + "\"",
+                                                       "Dummy");
+            }
+        }));
+    }
+    for (auto& next : threads)
+    {
+        next.join();
+    }
+    ngraph::runtime::event::Manager::disable_event_tracing();
+    ngraph::runtime::event::Manager::close();
+
+    auto events = nlohmann::json::parse(ngraph::file_util::read_file_to_string(path));
+    ASSERT_EQ(events.size() + ngraph::runtime::event::Manager::get_dropped_count(),
+              thread_count * event_count);
+    set<string> tids;
+    for (auto& event : events)
+    {
+        EXPECT_EQ(event["ph"], "X");
+        EXPECT_EQ(event["cat"], "Dummy");
+        tids.insert(event["tid"].dump());
+    }
+    EXPECT_EQ(tids.size(), thread_count);
+    EXPECT_EQ(events[0]["name"].get<string>().substr(0, 7), "Event \"");
+    ngraph::file_util::remove_file(path);
+}
+
+TEST(event_tracing, runtime_event_files)
+{
+    const string default_path = "runtime_event_trace_default.json";
+    const string own_path = "runtime_event_trace_own.json";
+    ngraph::runtime::event::Manager::open(default_path);
+    uint32_t file = ngraph::runtime::event::Manager::open_file(own_path);
+    EXPECT_NE(file, 0);
+    EXPECT_EQ(ngraph::runtime::event::Manager::open_file(own_path), file);
+
+    uint32_t name = ngraph::runtime::event::Manager::intern("Op");
+    uint32_t category = ngraph::runtime::event::Manager::intern("Dummy");
+    uint32_t args = ngraph::runtime::event::Manager::intern(R"({"Input1":"a"})");
+    ngraph::runtime::event::Manager::record_duration(name, category, args, 1000, 2000, file);
+    ngraph::runtime::event::Manager::record_duration(name, category, 0, 3000, 2000);
+    ngraph::runtime::event::Manager::close();
+
+    // Events after close() are dropped rather than reopening the default file
+    ngraph::runtime::event::Manager::record_duration(name, category, 0, 5000, 2000);
+    ngraph::runtime::event::Manager::flush();
+
+    auto own_events = nlohmann::json::parse(ngraph::file_util::read_file_to_string(own_path));
+    ASSERT_EQ(own_events.size(), 1);
+    EXPECT_EQ(own_events[0]["args"]["Input1"], "a");
+    auto default_events =
+        nlohmann::json::parse(ngraph::file_util::read_file_to_string(default_path));
+    ASSERT_EQ(default_events.size(), 1);
+    EXPECT_EQ(default_events[0].count("args"), 0);
+    ngraph::file_util::remove_file(default_path);
+    ngraph::file_util::remove_file(own_path);
+}
+
+TEST(event_tracing, runtime_event_inline_args)
+{
+    const string path = "runtime_event_trace_inline_args.json";
+    ngraph::runtime::event::Manager::open(path);
+    ngraph::runtime::event::Manager::enable_event_tracing();
+    {
+        ngraph::runtime::event::Duration event("Short", "Dummy", R"({"value":1})");
+    }
+    {
+        string long_args = R"({"value":")" +
+                           string(ngraph::runtime::event::Manager::max_inline_args, 'x') +
+                           R"("})";
+        ngraph::runtime::event::Duration event("Long", "Dummy", long_args);
+    }
+    ngraph::runtime::event::Manager::disable_event_tracing();
+    ngraph::runtime::event::Manager::close();
+
+    auto events = nlohmann::json::parse(ngraph::file_util::read_file_to_string(path));
+    ASSERT_EQ(events.size(), 2);
+    EXPECT_EQ(events[0]["args"]["value"], 1);
+    // Args too long to copy into the event are replaced by a note
+    EXPECT_EQ(events[1]["args"].count("value"), 0);
+    EXPECT_EQ(events[1]["args"].count("note"), 1);
+    ngraph::file_util::remove_file(path);
+}
@@ -0,0 +1,305 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ngraph/ngraph.hpp"
+#include "ngraph/runtime/generic_cpu/kernel/convolution.hpp"
+#include "ngraph/runtime/generic_cpu/kernel/dot.hpp"
+#include "ngraph/runtime/reference/convolution.hpp"
+#include "ngraph/runtime/reference/dot.hpp"
+#include "ngraph/runtime/thread_pool.hpp"
+#include "util/all_close.hpp"
+#include "util/random.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+namespace
+{
+    struct ConvolutionCase
+    {
+        Shape data_shape;
+        Shape filter_shape;
+        Strides stride;
+        Strides filter_dilation;
+        CoordinateDiff pad_below;
+        CoordinateDiff pad_above;
+        Strides data_dilation;
+    };
+
+    vector<ConvolutionCase> get_convolution_cases()
+    {
+        return {
+            // plain
+            {{2, 3, 7, 7}, {4, 3, 3, 3}, {1, 1}, {1, 1}, {0, 0}, {0, 0}, {1, 1}},
+            // padding and stride
+            {{1, 2, 8, 6}, {3, 2, 3, 2}, {2, 3}, {1, 1}, {1, 2}, {2, 0}, {1, 1}},
+            // filter dilation
+            {{3, 1, 9, 9}, {2, 1, 3, 3}, {1, 2}, {2, 3}, {0, 0}, {0, 0}, {1, 1}},
+            // negative padding
+            {{1, 2, 10}, {2, 2, 3}, {1}, {1}, {-1}, {-2}, {1}},
+            // data dilation
+            {{2, 2, 5, 4}, {3, 2, 2, 2}, {1, 1}, {1, 1}, {1, 1}, {1, 1}, {2, 3}},
+            // everything at once
+            {{2, 3, 6, 7}, {2, 3, 2, 3}, {2, 1}, {2, 1}, {2, -1}, {0, 1}, {2, 1}},
+            // three spatial axes, one item and one channel
+            {{1, 1, 4, 5, 3}, {1, 1, 2, 3, 2}, {2, 1, 1}, {1, 1, 1}, {0, 0, 0}, {0, 0, 0}, {1, 1, 1}},
+            // the filter covers the whole data
+            {{1, 8, 3, 3}, {1, 8, 3, 3}, {1, 1}, {1, 1}, {0, 0}, {0, 0}, {1, 1}},
+            // large enough to be split over the threads
+            {{4, 16, 20, 20}, {8, 16, 3, 3}, {1, 1}, {1, 1}, {1, 1}, {1, 1}, {1, 1}},
+        };
+    }
+
+    vector<float> random_vector(const Shape& shape)
+    {
+        static test::Uniform<float> rng(-1.0f, 1.0f);
+        vector<float> values(shape_size(shape));
+        rng.initialize(values);
+        return values;
+    }
+
+    // The generic_cpu kernels must match the reference kernels whether or not they run on a
+    // thread pool
+    template <typename F>
+    void with_and_without_thread_pool(F f)
+    {
+        f();
+        runtime::ThreadPool pool(4);
+        runtime::ThreadPool::Scope scope(&pool);
+        f();
+    }
+}
+
+TEST(gcpu_kernels, convolution)
+{
+    for (const ConvolutionCase& c : get_convolution_cases())
+    {
+        auto data = make_shared<op::Parameter>(element::f32, c.data_shape);
+        auto filter = make_shared<op::Parameter>(element::f32, c.filter_shape);
+        auto conv = make_shared<op::Convolution>(data,
+                                                 filter,
+                                                 c.stride,
+                                                 c.filter_dilation,
+                                                 c.pad_below,
+                                                 c.pad_above,
+                                                 c.data_dilation);
+        Shape out_shape = conv->get_shape();
+        vector<float> data_values = random_vector(c.data_shape);
+        vector<float> filter_values = random_vector(c.filter_shape);
+
+        vector<float> expected(shape_size(out_shape));
+        runtime::reference::convolution<float>(data_values.data(),
+                                               filter_values.data(),
+                                               expected.data(),
+                                               c.data_shape,
+                                               c.filter_shape,
+                                               out_shape,
+                                               c.stride,
+                                               c.filter_dilation,
+                                               c.pad_below,
+                                               c.pad_above,
+                                               c.data_dilation);
+        with_and_without_thread_pool([&]() {
+            vector<float> result(shape_size(out_shape));
+            runtime::gcpu::kernel::convolution<float>(data_values.data(),
+                                                      filter_values.data(),
+                                                      result.data(),
+                                                      c.data_shape,
+                                                      c.filter_shape,
+                                                      out_shape,
+                                                      c.stride,
+                                                      c.filter_dilation,
+                                                      c.pad_below,
+                                                      c.data_dilation);
+            EXPECT_TRUE(test::all_close(expected, result, 1.0e-4f, 1.0e-5f))
+                << "data " << c.data_shape << " filter " << c.filter_shape;
+        });
+    }
+}
+
+TEST(gcpu_kernels, convolution_backprop_data)
+{
+    for (const ConvolutionCase& c : get_convolution_cases())
+    {
+        auto data = make_shared<op::Parameter>(element::f32, c.data_shape);
+        auto filter = make_shared<op::Parameter>(element::f32, c.filter_shape);
+        Shape delta_shape = make_shared<op::Convolution>(data,
+                                                         filter,
+                                                         c.stride,
+                                                         c.filter_dilation,
+                                                         c.pad_below,
+                                                         c.pad_above,
+                                                         c.data_dilation)
+                                ->get_shape();
+        auto delta = make_shared<op::Parameter>(element::f32, delta_shape);
+        auto backprop = make_shared<op::ConvolutionBackpropData>(c.data_shape,
+                                                                 filter,
+                                                                 delta,
+                                                                 c.stride,
+                                                                 c.filter_dilation,
+                                                                 c.pad_below,
+                                                                 c.pad_above,
+                                                                 c.data_dilation);
+        vector<float> filter_values = random_vector(c.filter_shape);
+        vector<float> delta_values = random_vector(delta_shape);
+
+        vector<float> expected(shape_size(c.data_shape));
+        runtime::reference::convolution_backprop_in<float>(
+            delta_values.data(),
+            filter_values.data(),
+            expected.data(),
+            delta_shape,
+            c.filter_shape,
+            c.data_shape,
+            c.data_dilation,
+            c.filter_dilation,
+            backprop->compute_backward_delta_out_pad_below(),
+            backprop->compute_backward_delta_out_pad_above(),
+            c.stride);
+        with_and_without_thread_pool([&]() {
+            vector<float> result(shape_size(c.data_shape));
+            runtime::gcpu::kernel::convolution_backprop_data<float>(filter_values.data(),
+                                                                    delta_values.data(),
+                                                                    result.data(),
+                                                                    c.data_shape,
+                                                                    c.filter_shape,
+                                                                    delta_shape,
+                                                                    c.stride,
+                                                                    c.filter_dilation,
+                                                                    c.pad_below,
+                                                                    c.data_dilation);
+            EXPECT_TRUE(test::all_close(expected, result, 1.0e-4f, 1.0e-5f))
+                << "data " << c.data_shape << " filter " << c.filter_shape;
+        });
+    }
+}
+
+TEST(gcpu_kernels, convolution_backprop_filter)
+{
+    for (const ConvolutionCase& c : get_convolution_cases())
+    {
+        auto data = make_shared<op::Parameter>(element::f32, c.data_shape);
+        auto filter = make_shared<op::Parameter>(element::f32, c.filter_shape);
+        Shape delta_shape = make_shared<op::Convolution>(data,
+                                                         filter,
+                                                         c.stride,
+                                                         c.filter_dilation,
+                                                         c.pad_below,
+                                                         c.pad_above,
+                                                         c.data_dilation)
+                                ->get_shape();
+        auto delta = make_shared<op::Parameter>(element::f32, delta_shape);
+        auto backprop = make_shared<op::ConvolutionBackpropFilters>(data,
+                                                                    c.filter_shape,
+                                                                    delta,
+                                                                    c.stride,
+                                                                    c.filter_dilation,
+                                                                    c.pad_below,
+                                                                    c.pad_above,
+                                                                    c.data_dilation);
+        vector<float> data_values = random_vector(c.data_shape);
+        vector<float> delta_values = random_vector(delta_shape);
+
+        vector<float> expected(shape_size(c.filter_shape));
+        runtime::reference::convolution_backprop_filter<float>(
+            data_values.data(),
+            delta_values.data(),
+            expected.data(),
+            c.data_shape,
+            delta_shape,
+            c.filter_shape,
+            c.filter_dilation,
+            c.stride,
+            c.pad_below,
+            backprop->compute_backward_in_pad_above(),
+            c.data_dilation);
+        with_and_without_thread_pool([&]() {
+            vector<float> result(shape_size(c.filter_shape));
+            runtime::gcpu::kernel::convolution_backprop_filter<float>(data_values.data(),
+                                                                      delta_values.data(),
+                                                                      result.data(),
+                                                                      c.data_shape,
+                                                                      c.filter_shape,
+                                                                      delta_shape,
+                                                                      c.stride,
+                                                                      c.filter_dilation,
+                                                                      c.pad_below,
+                                                                      c.data_dilation);
+            EXPECT_TRUE(test::all_close(expected, result, 1.0e-4f, 1.0e-5f))
+                << "data " << c.data_shape << " filter " << c.filter_shape;
+        });
+    }
+}
+
+TEST(gcpu_kernels, dot)
+{
+    struct DotCase
+    {
+        Shape arg0_shape;
+        Shape arg1_shape;
+        size_t reduction_axes_count;
+    };
+    vector<DotCase> cases{
+        // matrix product
+        {{2, 3}, {3, 4}, 1},
+        // inner product of vectors
+        {{3}, {3}, 1},
+        // vector times matrix, matrix times vector
+        {{5}, {5, 2}, 1},
+        {{2, 3, 4}, {4}, 1},
+        // two reduction axes
+        {{2, 3, 4}, {3, 4, 5}, 2},
+        // outer product
+        {{2, 3}, {4}, 0},
+        // scalar times tensor
+        {{}, {2, 3}, 0},
+        // large enough to be split over the threads
+        {{64, 96}, {96, 80}, 1},
+    };
+    for (const DotCase& c : cases)
+    {
+        auto arg0 = make_shared<op::Parameter>(element::f32, c.arg0_shape);
+        auto arg1 = make_shared<op::Parameter>(element::f32, c.arg1_shape);
+        Shape out_shape = make_shared<op::Dot>(arg0, arg1, c.reduction_axes_count)->get_shape();
+        vector<float> arg0_values = random_vector(c.arg0_shape);
+        vector<float> arg1_values = random_vector(c.arg1_shape);
+
+        vector<float> expected(shape_size(out_shape));
+        runtime::reference::dot<float, float, float>(arg0_values.data(),
+                                                     arg1_values.data(),
+                                                     expected.data(),
+                                                     c.arg0_shape,
+                                                     c.arg1_shape,
+                                                     out_shape,
+                                                     c.reduction_axes_count);
+        with_and_without_thread_pool([&]() {
+            vector<float> result(shape_size(out_shape));
+            runtime::gcpu::kernel::dot<float>(arg0_values.data(),
+                                              arg1_values.data(),
+                                              result.data(),
+                                              c.arg0_shape,
+                                              c.arg1_shape,
+                                              out_shape,
+                                              c.reduction_axes_count);
+            EXPECT_TRUE(test::all_close(expected, result, 1.0e-4f, 1.0e-5f))
+                << "arg0 " << c.arg0_shape << " arg1 " << c.arg1_shape;
+        });
+    }
+}
@@ -204,6 +204,90 @@ TEST(memory_manager, memory_align)
     EXPECT_EQ(128, mm.allocate(4));
 }
 
+TEST(memory_planner, beats_first_fit)
+{
+    // First fit puts c after b because the hole left by a is too small
+    pass::MemoryPlanner planner{1};
+    size_t a = planner.add_buffer(4, 0, 1);
+    size_t b = planner.add_buffer(4, 0, 3);
+    size_t c = planner.add_buffer(8, 2, 3);
+    planner.plan();
+
+    EXPECT_EQ(12, planner.get_lower_bound());
+    EXPECT_EQ(12, planner.max_allocated());
+    // Buffers live at the same step do not overlap
+    EXPECT_TRUE(planner.get_offset(a) + 4 <= planner.get_offset(b) ||
+                planner.get_offset(b) + 4 <= planner.get_offset(a));
+    EXPECT_TRUE(planner.get_offset(c) + 8 <= planner.get_offset(b) ||
+                planner.get_offset(b) + 4 <= planner.get_offset(c));
+}
+
+TEST(memory_planner, reuse)
+{
+    pass::MemoryPlanner planner{64};
+    size_t a = planner.add_buffer(4, 0);
+    size_t b = planner.add_buffer(100, 1, 2);
+    size_t c = planner.add_buffer(100, 3);
+    planner.set_last_use(a, 3);
+    planner.plan();
+
+    EXPECT_EQ(3, planner.get_buffer_count());
+    EXPECT_EQ(192, planner.max_allocated());
+    EXPECT_EQ(192, planner.get_lower_bound());
+    EXPECT_EQ(planner.get_offset(b), planner.get_offset(c));
+    EXPECT_NE(planner.get_offset(a), planner.get_offset(b));
+    EXPECT_EQ(0, planner.get_offset(a) % 64);
+    EXPECT_EQ(0, planner.get_offset(b) % 64);
+}
+
+TEST(memory_planner, many_buffers)
+{
+    struct Lifetime
+    {
+        size_t size;
+        size_t first;
+        size_t last;
+    };
+    pass::MemoryPlanner planner{8};
+    vector<Lifetime> buffers;
+    uint64_t seed = 1;
+    auto next = [&seed]() {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<size_t>(seed >> 33);
+    };
+    for (size_t step = 0; step < 2000; step++)
+    {
+        Lifetime buffer{8 * (1 + next() % 100), step, step + next() % 50};
+        planner.add_buffer(buffer.size, buffer.first, buffer.last);
+        buffers.push_back(buffer);
+    }
+    planner.plan();
+
+    EXPECT_GE(planner.max_allocated(), planner.get_lower_bound());
+    // Buffers whose lifetimes overlap must not share memory
+    for (size_t a = 0; a < buffers.size(); a++)
+    {
+        EXPECT_LE(planner.get_offset(a) + buffers[a].size, planner.max_allocated());
+        for (size_t b = a + 1; b < buffers.size(); b++)
+        {
+            if (buffers[a].first <= buffers[b].last && buffers[b].first <= buffers[a].last)
+            {
+                EXPECT_TRUE(planner.get_offset(a) + buffers[a].size <= planner.get_offset(b) ||
+                            planner.get_offset(b) + buffers[b].size <= planner.get_offset(a));
+            }
+        }
+    }
+}
+
+TEST(memory_planner, bad_last_use)
+{
+    pass::MemoryPlanner planner{1};
+
+    EXPECT_THROW(planner.add_buffer(4, 2, 1), std::invalid_argument);
+    size_t a = planner.add_buffer(4, 2);
+    EXPECT_THROW(planner.set_last_use(a, 1), std::invalid_argument);
+}
+
 TEST(memory_layout, basic)
 {
     string dump_file = "memory_layout.txt";
@@ -19,6 +19,7 @@
 #include <iostream>
 #include <list>
 #include <memory>
+#include <typeindex>
 
 #include "gtest/gtest.h"
 #include "ngraph/file_util.hpp"
@@ -747,3 +748,27 @@ TEST(pattern, is_contained_match)
     ASSERT_TRUE(n.match(label_abs2, absn2));
     ASSERT_FALSE(n.is_contained_match());
 }
+
+TEST(pattern, root_types)
+{
+    Shape shape{};
+    auto a = make_shared<op::Parameter>(element::i32, shape);
+    auto label = std::make_shared<pattern::op::Label>(a);
+    auto abs = make_shared<op::Abs>(label);
+
+    auto abs_root = pattern::Matcher(abs).get_root_types();
+    ASSERT_EQ(abs_root.size(), 1);
+    ASSERT_EQ(abs_root.at(0), type_index(typeid(op::Abs)));
+
+    // A label wrapping a sub-pattern has the root type of the sub-pattern
+    auto abs_label = std::make_shared<pattern::op::Label>(abs, nullptr, NodeVector{abs});
+    ASSERT_EQ(pattern::Matcher(abs_label).get_root_types(), abs_root);
+
+    // Patterns whose root can be any node type
+    ASSERT_TRUE(pattern::Matcher(label).get_root_types().empty());
+    auto skip = std::make_shared<pattern::op::Skip>(abs, pattern::has_class<op::Negative>());
+    ASSERT_TRUE(pattern::Matcher(skip).get_root_types().empty());
+    auto any = std::make_shared<pattern::op::Any>(
+        a, pattern::has_class<op::Negative>(), NodeVector{label});
+    ASSERT_TRUE(pattern::Matcher(any).get_root_types().empty());
+}
@@ -14,12 +14,15 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <algorithm>
 #include <fstream>
+#include <iomanip>
 #include <sstream>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+#include "ngraph/cpio.hpp"
 #include "ngraph/file_util.hpp"
 #include "ngraph/ngraph.hpp"
 #include "ngraph/op/constant.hpp"
@@ -41,6 +44,24 @@ using ::testing::ElementsAre;
 using ::testing::NotNull;
 using ::testing::StrEq;
 
+namespace
+{
+    // An op with no entry in the serializer's op tables and no registered serializer
+    class UnregisteredOp : public op::Abs
+    {
+    public:
+        UnregisteredOp(const shared_ptr<Node>& arg)
+            : Abs(arg)
+        {
+        }
+
+        static constexpr NodeTypeInfo type_info{"UnregisteredOp", 0};
+        const NodeTypeInfo& get_type_info() const override { return type_info; }
+    };
+
+    constexpr NodeTypeInfo UnregisteredOp::type_info;
+}
+
 template <typename T>
 T get_or_default(nlohmann::json& j, const std::string& key, const T& default_value)
 {
@@ -194,6 +215,206 @@ TEST(serialize, constant)
     EXPECT_TRUE(found);
 }
 
+TEST(serialize, constant_cpio)
+{
+    const string tmp_file = "serialize_constant_cpio.cpio";
+    Shape shape{2, 2, 2};
+    auto A = op::Constant::create(element::f32, shape, {1, 2, 3, 4, 5, 6, 7, 8});
+    auto B = op::Constant::create(element::i8, Shape{3}, {1, 2, 3});
+    auto C = op::Constant::create(element::f32, shape, {8, 7, 6, 5, 4, 3, 2, 1});
+    auto f = make_shared<Function>(NodeVector{A + C, B}, ParameterVector{});
+    serialize_cpio(tmp_file, f);
+    ASSERT_TRUE(cpio::is_cpio(tmp_file));
+
+    auto check = [](shared_ptr<Function> g) {
+        ASSERT_NE(g, nullptr);
+        size_t count = 0;
+        for (shared_ptr<Node> node : g->get_ops())
+        {
+            if (auto c = as_type_ptr<op::Constant>(node))
+            {
+                count++;
+                EXPECT_EQ(reinterpret_cast<size_t>(c->get_data_ptr()) % 64, 0);
+                if (c->get_element_type() == element::i8)
+                {
+                    EXPECT_EQ((vector<int8_t>{1, 2, 3}), c->get_vector<int8_t>());
+                }
+                else
+                {
+                    auto v = c->get_vector<float>();
+                    EXPECT_TRUE(v == (vector<float>{1, 2, 3, 4, 5, 6, 7, 8}) ||
+                                v == (vector<float>{8, 7, 6, 5, 4, 3, 2, 1}));
+                }
+            }
+        }
+        EXPECT_EQ(count, 3);
+    };
+
+    // Memory mapped
+    check(deserialize(tmp_file));
+
+    // Stream
+    {
+        ifstream in(tmp_file, ios_base::binary | ios_base::in);
+        check(deserialize(in));
+    }
+    file_util::remove_file(tmp_file);
+}
+
+// Node names are regenerated when a graph is loaded, so graphs are compared by structure
+static void expect_same_graph(const shared_ptr<Function>& expected,
+                              const shared_ptr<Function>& actual)
+{
+    auto expected_ops = expected->get_ordered_ops();
+    auto actual_ops = actual->get_ordered_ops();
+    ASSERT_EQ(expected_ops.size(), actual_ops.size());
+    auto actual_it = actual_ops.begin();
+    for (const shared_ptr<Node>& node : expected_ops)
+    {
+        const shared_ptr<Node>& other = *actual_it++;
+        EXPECT_EQ(node->description(), other->description());
+        EXPECT_EQ(node->get_friendly_name(), other->get_friendly_name());
+        ASSERT_EQ(node->get_output_size(), other->get_output_size());
+        for (size_t i = 0; i < node->get_output_size(); i++)
+        {
+            EXPECT_EQ(node->get_output_element_type(i), other->get_output_element_type(i));
+            EXPECT_EQ(node->get_output_shape(i), other->get_output_shape(i));
+        }
+        if (auto c = as_type_ptr<op::Constant>(node))
+        {
+            EXPECT_EQ(c->get_value_strings(),
+                      static_pointer_cast<op::Constant>(other)->get_value_strings());
+        }
+    }
+}
+
+TEST(serialize, binary_format)
+{
+    const string tmp_file = "serialize_binary_format.bin";
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = op::Constant::create(element::f32, shape, {1, 2, 3, 4});
+    auto C = op::Constant::create(element::i32, Shape{3}, {5, 6, 7});
+    auto f = make_shared<Function>(NodeVector{A * B, C}, ParameterVector{A}, "binary");
+    serialize_binary(tmp_file, f);
+
+    // Memory mapped
+    auto g = deserialize(tmp_file);
+    ASSERT_NE(g, nullptr);
+    expect_same_graph(f, g);
+    for (shared_ptr<Node> node : g->get_ops())
+    {
+        if (auto c = as_type_ptr<op::Constant>(node))
+        {
+            EXPECT_EQ(reinterpret_cast<size_t>(c->get_data_ptr()) % 64, 0);
+        }
+    }
+
+    // Stream
+    {
+        ifstream in(tmp_file, ios_base::binary | ios_base::in);
+        auto h = deserialize(in);
+        ASSERT_NE(h, nullptr);
+        expect_same_graph(f, h);
+    }
+    file_util::remove_file(tmp_file);
+
+    // Larger graphs
+    vector<string> models = {"mxnet/LSTM_forward.json", "mxnet/LSTM_backward.json"};
+    for (const string& model : models)
+    {
+        shared_ptr<Function> m = deserialize(file_util::path_join(SERIALIZED_ZOO, model));
+        stringstream ss;
+        serialize_binary(ss, m);
+        expect_same_graph(m, deserialize(ss));
+    }
+}
+
+#ifdef __linux__
+// Returns a memory figure from /proc/self/status in kB
+static size_t get_process_memory(const string& key)
+{
+    ifstream status("/proc/self/status");
+    string line;
+    while (getline(status, line))
+    {
+        if (line.compare(0, key.size(), key) == 0)
+        {
+            return stoul(line.substr(key.size()));
+        }
+    }
+    return 0;
+}
+#endif
+
+// Compares the load time and peak memory of the json, cpio and binary formats
+TEST(benchmark, serialize_formats)
+{
+    const string cpio_file = "benchmark_serialize_formats.cpio";
+    const string binary_file = "benchmark_serialize_formats.bin";
+
+    vector<string> models;
+    file_util::iterate_files(SERIALIZED_ZOO,
+                             [&](const string& file, bool is_dir) {
+                                 if (!is_dir && file_util::get_file_ext(file) == ".json")
+                                 {
+                                     models.push_back(file);
+                                 }
+                             },
+                             true);
+    sort(models.begin(), models.end());
+
+    // Returns the load time in ms and the peak memory increase in kB
+    auto measure = [](const string& path) {
+#ifdef __linux__
+        // Reset the peak resident set size to the current value
+        {
+            ofstream clear_refs("/proc/self/clear_refs");
+            clear_refs << "5";
+        }
+        size_t base_memory = get_process_memory("VmRSS:");
+#endif
+        stopwatch timer;
+        timer.start();
+        shared_ptr<Function> f = deserialize(path);
+        timer.stop();
+        size_t peak_memory = 0;
+#ifdef __linux__
+        peak_memory = get_process_memory("VmHWM:") - base_memory;
+#endif
+        return make_pair(timer.get_milliseconds(), peak_memory);
+    };
+
+    cout << setw(10) << "json ms" << setw(10) << "json kB" << setw(10) << "cpio ms"
+         << setw(10) << "cpio kB" << setw(10) << "bin ms" << setw(10) << "bin kB"
+         << "  model\n";
+    for (const string& model : models)
+    {
+        {
+            shared_ptr<Function> f;
+            try
+            {
+                f = deserialize(model);
+            }
+            catch (const exception&)
+            {
+                continue;
+            }
+            serialize_cpio(cpio_file, f);
+            serialize_binary(binary_file, f);
+        }
+        auto json_result = measure(model);
+        auto cpio_result = measure(cpio_file);
+        auto binary_result = measure(binary_file);
+        cout << setw(10) << json_result.first << setw(10) << json_result.second << setw(10)
+             << cpio_result.first << setw(10) << cpio_result.second << setw(10)
+             << binary_result.first << setw(10) << binary_result.second << "  "
+             << file_util::get_file_name(model) << "\n";
+    }
+    file_util::remove_file(cpio_file);
+    file_util::remove_file(binary_file);
+}
+
 TEST(benchmark, serialize)
 {
     stopwatch timer;
@@ -440,3 +661,37 @@ TEST(serialize, opset1_pad)
     EXPECT_EQ(g_pad->get_version(), 1);
     EXPECT_EQ(dynamic_cast<const op::v1::Pad*>(g_pad.get())->get_pad_mode(), pad_mode);
 }
+
+TEST(serialize, hash_function)
+{
+    auto make_f = [](const vector<float>& weights, size_t concat_axis) {
+        auto A = make_shared<op::Parameter>(element::f32, Shape{2, 2});
+        auto W = op::Constant::create(element::f32, Shape{2, 2}, weights);
+        auto C = make_shared<op::Concat>(NodeVector{A + W, A}, concat_axis);
+        return make_shared<Function>(C, ParameterVector{A});
+    };
+
+    string h = hash_function(make_f({1, 2, 3, 4}, 0));
+
+    // Identical structure with different (auto-generated) node names
+    EXPECT_EQ(h, hash_function(make_f({1, 2, 3, 4}, 0)));
+    // Different constant data
+    EXPECT_NE(h, hash_function(make_f({1, 2, 3, 5}, 0)));
+    // Different attribute
+    EXPECT_NE(h, hash_function(make_f({1, 2, 3, 4}, 1)));
+}
+
+TEST(serialize, unregistered_op)
+{
+    auto A = make_shared<op::Parameter>(element::f32, Shape{2});
+    auto f = make_shared<Function>(make_shared<UnregisteredOp>(A), ParameterVector{A});
+
+    // The json dump is for inspection, so it writes the op without attributes
+    EXPECT_NO_THROW(serialize(f));
+    // The formats meant to be loaded or compared could not restore the op
+    stringstream cpio_out;
+    EXPECT_THROW(serialize_cpio(cpio_out, f), unsupported_op);
+    stringstream binary_out;
+    EXPECT_THROW(serialize_binary(binary_out, f), unsupported_op);
+    EXPECT_THROW(hash_function(f), unsupported_op);
+}
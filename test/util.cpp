@@ -394,6 +394,59 @@ TEST(graph_util, test_subgraph_topological_sort_control_dependencies)
     ASSERT_EQ(expected, sorted);
 }
 
+TEST(graph_util, ordered_ops_follow_graph_edits)
+{
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto add = A + B;
+    auto abs = make_shared<op::Abs>(add);
+    auto f = make_shared<Function>(NodeVector{abs}, ParameterVector{A, B});
+    auto fresh_sort = [&f](bool include_control_deps) {
+        NodeVector roots{f->get_results().begin(), f->get_results().end()};
+        roots.insert(roots.end(), f->get_parameters().begin(), f->get_parameters().end());
+        return topological_sort(roots, include_control_deps);
+    };
+
+    auto ordered = f->get_shared_ordered_ops();
+    ASSERT_EQ(*ordered, fresh_sort(true));
+    ASSERT_EQ(f->get_shared_ordered_ops(), ordered);
+
+    // Edits of another graph keep the order
+    auto other_param = make_shared<op::Parameter>(element::f32, shape);
+    auto other = make_shared<op::Abs>(other_param);
+    auto other_user = make_shared<op::Negative>(other);
+    replace_node(other, make_shared<op::Negative>(other_param));
+    ASSERT_EQ(f->get_shared_ordered_ops(), ordered);
+
+    // An edit drops the order, which releases the nodes it removed
+    auto neg = make_shared<op::Negative>(add);
+    weak_ptr<Node> removed = abs;
+    replace_node(abs, neg);
+    abs = nullptr;
+    ordered = nullptr;
+    ASSERT_TRUE(removed.expired());
+    ASSERT_EQ(f->get_ordered_ops(), fresh_sort(true));
+
+    insert_new_node_between(add, neg, make_shared<op::Abs>(add));
+    ASSERT_EQ(f->get_ordered_ops(), fresh_sort(true));
+
+    auto C = make_shared<op::Parameter>(element::f32, shape);
+    auto D = make_shared<op::Abs>(C);
+    neg->add_control_dependency(D);
+    ASSERT_EQ(f->get_ordered_ops(false), fresh_sort(false));
+    ASSERT_EQ(f->get_ordered_ops(true), fresh_sort(true));
+    auto with_control_deps = f->get_ordered_ops();
+    ASSERT_EQ(count(with_control_deps.begin(), with_control_deps.end(), D), 1);
+
+    neg->remove_control_dependency(D);
+    ASSERT_EQ(f->get_ordered_ops(), fresh_sort(true));
+
+    auto A2 = make_shared<op::Parameter>(element::f32, shape);
+    f->replace_parameter(0, A2);
+    ASSERT_EQ(f->get_ordered_ops(), fresh_sort(true));
+}
+
 TEST(util, enum_mask_construction)
 {
     enum class Type : uint32_t